@@ -25,9 +25,11 @@
 #include "2d/renderer/Batcher2d.h"
 #include "application/ApplicationManager.h"
 #include "base/TypeDef.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Scene.h"
 #include "editor-support/MiddlewareManager.h"
+#include "profiler/Profiler.h"
 #include "renderer/pipeline/Define.h"
 #include "scene/Pass.h"
 
@@ -53,9 +55,14 @@ Batcher2d::~Batcher2d() { // NOLINT
         delete iter.second;
     }
 
-    for (auto* drawBatch : _batches) {
+    for (auto* drawBatch : _transientBatches) {
         delete drawBatch;
     }
+    for (auto& cache : _rootNodeBatchCaches) {
+        for (auto* drawBatch : cache.batches) {
+            delete drawBatch;
+        }
+    }
     _attributes.clear();
 
     if (_maskClearModel != nullptr) {
@@ -71,7 +78,12 @@ Batcher2d::~Batcher2d() { // NOLINT
 }
 
 void Batcher2d::syncMeshBuffersToNative(uint16_t accId, ccstd::vector<UIMeshBuffer*>&& buffers) {
-    _meshBuffersMap[accId] = std::move(buffers);
+    auto& meshBuffers = _meshBuffersMap[accId];
+    // middleware syncs the same buffers every frame, cached batches only go stale when the list changes
+    if (meshBuffers != buffers) {
+        invalidateBatchCaches();
+        meshBuffers = std::move(buffers);
+    }
 }
 
 UIMeshBuffer* Batcher2d::getMeshBuffer(uint16_t accId, uint16_t bufferId) { // NOLINT(bugprone-easily-swappable-parameters)
@@ -94,11 +106,30 @@ void Batcher2d::syncRootNodesToNative(ccstd::vector<Node*>&& rootNodes) {
 }
 
 void Batcher2d::fillBuffersAndMergeBatches() {
+    syncRootNodeBatchCaches();
+    _reusedRootNodeCount = 0;
+    prepareRootNodes();
+
     size_t index = 0;
-    for (auto* rootNode : _rootNodeArr) {
-        // _batches will add by generateBatch
-        walk(rootNode, 1, false);
-        generateBatch(_currEntity, _currDrawInfo);
+    for (size_t rootIndex = 0; rootIndex < _rootNodeArr.size(); ++rootIndex) {
+        auto* rootNode = _rootNodeArr[rootIndex];
+        auto& cache = _rootNodeBatchCaches[rootIndex];
+        // the vertex data of prepared root nodes is already written, so they have to be merged again
+        const bool prepared = !_walkCommands.empty() && !_walkCommands[rootIndex].empty();
+        if (!prepared && _incrementalBatchingEnabled && reuseRootNodeBatches(cache)) {
+            ++_reusedRootNodeCount;
+        } else {
+            releaseRootNodeBatches(cache);
+            beginRecording(cache);
+            // _batches will add by generateBatch
+            if (prepared) {
+                replayWalk(_walkCommands[rootIndex]);
+            } else {
+                walk(rootNode, 1, false);
+            }
+            generateBatch(_currEntity, _currDrawInfo);
+            endRecording(cache, index);
+        }
 
         auto* scene = rootNode->getScene()->getRenderScene();
         size_t const count = _batches.size();
@@ -110,11 +141,12 @@ void Batcher2d::fillBuffersAndMergeBatches() {
 }
 
 void Batcher2d::walk(Node* node, float parentOpacity, bool parentOpacityDirty) { // NOLINT(misc-no-recursion)
+    auto* entity = static_cast<RenderEntity*>(node->getUserData());
+    const int32_t record = _recordingCache ? recordNode(node, entity) : -1;
     if (!node->isActiveInHierarchy()) {
         return;
     }
     bool breakWalk = false;
-    auto* entity = static_cast<RenderEntity*>(node->getUserData());
     bool opacityDirty = false;
     if (entity) {
         if (entity->getColorDirty() || parentOpacityDirty) {
@@ -131,6 +163,7 @@ void Batcher2d::walk(Node* node, float parentOpacity, bool parentOpacityDirty) {
             uint32_t size = entity->getRenderDrawInfosSize();
             for (uint32_t i = 0; i < size; i++) {
                 auto* drawInfo = entity->getRenderDrawInfoAt(i);
+                fillVertexData(entity, drawInfo, node);
                 handleDrawInfo(entity, drawInfo, node);
             }
             entity->setVBColorDirty(false);
@@ -143,10 +176,15 @@ void Batcher2d::walk(Node* node, float parentOpacity, bool parentOpacityDirty) {
     if (!breakWalk) {
         const auto& children = node->getChildren();
         float thisOpacity = entity ? entity->getOpacity() : parentOpacity;
+        const int32_t parentRecord = _recordParent;
+        uint32_t childIndex = 0;
         for (const auto& child : children) {
+            _recordParent = record;
+            _recordChildIndex = childIndex++;
             // we should find parent opacity recursively upwards if it doesn't have an entity.
             walk(child, thisOpacity, opacityDirty || parentOpacityDirty);
         }
+        _recordParent = parentRecord;
     }
 
     // post assembler
@@ -155,6 +193,123 @@ void Batcher2d::walk(Node* node, float parentOpacity, bool parentOpacityDirty) {
     }
 }
 
+void Batcher2d::prepareRootNodes() {
+    _preparingRootNodes.clear();
+    if (!_parallelWalkEnabled) {
+        _walkCommands.clear();
+        return;
+    }
+
+    const auto rootCount = static_cast<uint32_t>(_rootNodeArr.size());
+    _walkCommands.resize(rootCount);
+    for (uint32_t i = 0; i < rootCount; ++i) {
+        _walkCommands[i].clear();
+        auto* entity = static_cast<RenderEntity*>(_rootNodeArr[i]->getUserData());
+        if (entity && entity->getRenderEntityType() == RenderEntityType::CROSSED) {
+            // nested render roots are visited by the walk of their parent root as well, keep the serial order
+            _preparingRootNodes.clear();
+            return;
+        }
+        const auto& cache = _rootNodeBatchCaches[i];
+        if (_incrementalBatchingEnabled && cache.valid && isRootNodeCacheUpToDate(cache)) {
+            // most likely reused, walked on this thread otherwise
+            continue;
+        }
+        // resolve the transforms above the subtree here, so that workers only write nodes of their own subtree
+        _rootNodeArr[i]->getWorldMatrix();
+        _preparingRootNodes.emplace_back(i);
+    }
+
+    const auto prepare = [this](uint32_t i) {
+        const uint32_t rootIndex = _preparingRootNodes[i];
+        int32_t nodeCount = 0;
+        prepareWalk(_rootNodeArr[rootIndex], 1, false, -1, 0, nodeCount, _walkCommands[rootIndex]);
+    };
+    const auto prepareCount = static_cast<uint32_t>(_preparingRootNodes.size());
+    if (prepareCount > 1 && JobSystem::getInstance()->threadCount() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, prepareCount, 1U, prepare);
+        g.run();
+        g.waitForAll();
+    } else {
+        for (uint32_t i = 0; i < prepareCount; ++i) {
+            prepare(i);
+        }
+    }
+}
+
+void Batcher2d::prepareWalk(Node* node, float parentOpacity, bool parentOpacityDirty, int32_t recordParent, uint32_t childIndex, int32_t& nodeCount, ccstd::vector<WalkCommand>& commands) { // NOLINT(misc-no-recursion)
+    // mirrors walk(), but only does the work which doesn't depend on the batching states
+    auto* entity = static_cast<RenderEntity*>(node->getUserData());
+    const int32_t record = nodeCount++;
+    commands.push_back({WalkCommand::Type::NODE, recordParent, childIndex, node, entity, nullptr});
+    if (!node->isActiveInHierarchy()) {
+        return;
+    }
+    bool breakWalk = false;
+    bool opacityDirty = false;
+    if (entity) {
+        if (entity->getColorDirty() || parentOpacityDirty) {
+            float localOpacity = entity->getLocalOpacity();
+            float localColorAlpha = entity->getColorAlpha();
+            entity->setOpacity(parentOpacity * localOpacity * localColorAlpha);
+            entity->setColorDirty(false);
+            entity->setVBColorDirty(true);
+            opacityDirty = true;
+        }
+        if (math::isEqualF(entity->getOpacity(), 0)) {
+            breakWalk = true;
+        } else if (entity->isEnabled()) {
+            uint32_t size = entity->getRenderDrawInfosSize();
+            for (uint32_t i = 0; i < size; i++) {
+                auto* drawInfo = entity->getRenderDrawInfoAt(i);
+                fillVertexData(entity, drawInfo, node);
+                commands.push_back({WalkCommand::Type::DRAW, -1, 0, node, entity, drawInfo});
+            }
+            entity->setVBColorDirty(false);
+        }
+        if (entity->getRenderEntityType() == RenderEntityType::CROSSED) {
+            breakWalk = true;
+        }
+    }
+
+    if (!breakWalk) {
+        const auto& children = node->getChildren();
+        float thisOpacity = entity ? entity->getOpacity() : parentOpacity;
+        uint32_t index = 0;
+        for (const auto& child : children) {
+            prepareWalk(child, thisOpacity, opacityDirty || parentOpacityDirty, record, index++, nodeCount, commands);
+        }
+    }
+
+    // only masks have post render work
+    if (entity && entity->isEnabled() && entity->getIsMask()) {
+        commands.push_back({WalkCommand::Type::POST_RENDER, -1, 0, node, entity, nullptr});
+    }
+}
+
+void Batcher2d::replayWalk(const ccstd::vector<WalkCommand>& commands) {
+    for (const auto& command : commands) {
+        switch (command.type) {
+            case WalkCommand::Type::NODE:
+                if (_recordingCache) {
+                    _recordParent = command.recordParent;
+                    _recordChildIndex = command.childIndex;
+                    recordNode(command.node, command.entity);
+                }
+                break;
+            case WalkCommand::Type::DRAW:
+                handleDrawInfo(command.entity, command.drawInfo, command.node);
+                break;
+            case WalkCommand::Type::POST_RENDER:
+                if (_stencilManager->getMaskStackSize() > 0) {
+                    handlePostRender(command.entity);
+                }
+                break;
+        }
+    }
+}
+
 void Batcher2d::handlePostRender(RenderEntity* entity) {
     bool isMask = entity->getIsMask();
     if (isMask) {
@@ -163,12 +318,21 @@ void Batcher2d::handlePostRender(RenderEntity* entity) {
         _stencilManager->exitMask();
     }
 }
-CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node) {
+CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* /*node*/) {
     ccstd::hash_t dataHash = drawInfo->getDataHash();
     if (drawInfo->getIsMeshBuffer()) {
         dataHash = 0;
     }
 
+    if (_recordingCache) {
+        // masks, local transforms and standalone mesh data have side effects beyond the batches
+        if (drawInfo->getIsMeshBuffer() || entity->getIsMask() || entity->getIsSubMask() || entity->getUseLocal()) {
+            stopRecording();
+        } else {
+            recordDrawInfo(drawInfo);
+        }
+    }
+
     // may slow
     bool isMask = entity->getIsMask();
     if (isMask) {
@@ -207,15 +371,9 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
         }
     }
 
+    // vertex positions and colors are filled by fillVertexData() before
     if (!drawInfo->getIsMeshBuffer()) {
-        if (node->getChangedFlags() || node->isTransformDirty() || drawInfo->getVertDirty()) {
-            fillVertexBuffers(entity, drawInfo);
-            drawInfo->setVertDirty(false);
-        }
-        if (entity->getVBColorDirty()) {
-            fillColors(entity, drawInfo);
-        }
-
+        markVertexRange(drawInfo);
         fillIndexBuffers(drawInfo);
     }
 
@@ -225,6 +383,7 @@ CC_FORCE_INLINE void Batcher2d::handleComponentDraw(RenderEntity* entity, Render
 }
 
 CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    stopRecording();
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
 
@@ -270,6 +429,7 @@ CC_FORCE_INLINE void Batcher2d::handleModelDraw(RenderEntity* entity, RenderDraw
 }
 
 CC_FORCE_INLINE void Batcher2d::handleMiddlewareDraw(RenderEntity* entity, RenderDrawInfo* drawInfo) {
+    stopRecording();
     auto layer = entity->getNode()->getLayer();
     Material* material = drawInfo->getMaterial();
     auto* texture = drawInfo->getTexture();
@@ -294,6 +454,7 @@ CC_FORCE_INLINE void Batcher2d::handleMiddlewareDraw(RenderEntity* entity, Rende
 }
 
 CC_FORCE_INLINE void Batcher2d::handleSubNode(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT
+    stopRecording();
     if (drawInfo->getSubNode()) {
         walk(drawInfo->getSubNode(), entity->getOpacity(), false);
     }
@@ -344,10 +505,8 @@ void Batcher2d::generateBatch(RenderEntity* entity, RenderDrawInfo* drawInfo) {
         indexCount = drawInfo->getIbCount();
         _meshRenderDrawInfo.emplace_back(drawInfo);
     } else {
+        // the written ranges of the mesh buffer are marked by handleComponentDraw
         UIMeshBuffer* currMeshBuffer = drawInfo->getMeshBuffer();
-
-        currMeshBuffer->setDirty(true);
-
         ia = currMeshBuffer->requireFreeIA(getDevice());
         indexCount = currMeshBuffer->getIndexOffset() - _indexStart;
         if (ia == nullptr) {
@@ -480,6 +639,8 @@ void Batcher2d::releaseDescriptorSetCache(gfx::Texture* texture, gfx::Sampler* s
     }
     auto iter = _descriptorSetCache.find(hash);
     if (iter != _descriptorSetCache.end()) {
+        // cached batches may refer to the descriptor set
+        invalidateBatchCaches();
         delete iter->second;
         _descriptorSetCache.erase(hash);
     }
@@ -493,6 +654,7 @@ bool Batcher2d::initialize() {
 void Batcher2d::update() {
     fillBuffersAndMergeBatches();
     resetRenderStates();
+    CC_PROFILE_RENDER_UPDATE(Batcher2dReusedRootNodes, _reusedRootNodeCount);
 }
 
 void Batcher2d::uploadBuffers() {
@@ -500,24 +662,27 @@ void Batcher2d::uploadBuffers() {
         return;
     }
 
+    uint32_t uploadedBytes = 0;
     for (auto& meshRenderData : _meshRenderDrawInfo) {
-        meshRenderData->uploadBuffers();
+        uploadedBytes += meshRenderData->uploadBuffers();
     }
 
     for (auto& map : _meshBuffersMap) {
         for (auto& buffer : map.second) {
-            buffer->uploadBuffers();
+            uploadedBytes += buffer->uploadBuffers();
             buffer->reset();
         }
     }
+    CC_PROFILE_RENDER_UPDATE(UIMeshBufferUploadBytes, uploadedBytes);
     updateDescriptorSet();
 }
 
 void Batcher2d::reset() {
-    for (auto& batch : _batches) {
+    for (auto& batch : _transientBatches) {
         batch->clear();
         _drawBatchPool.free(batch);
     }
+    _transientBatches.clear();
     _batches.clear();
 
     for (auto& meshRenderData : _meshRenderDrawInfo) {
@@ -546,6 +711,231 @@ void Batcher2d::reset() {
     // stencilManager
 }
 
+Batcher2d::BatchState Batcher2d::captureBatchState() const {
+    BatchState state;
+    state.hash = _currHash;
+    state.samplerHash = _currSamplerHash;
+    state.material = _currMaterial;
+    state.texture = _currTexture;
+    state.sampler = _currSampler;
+    state.entity = _currEntity;
+    state.drawInfo = _currDrawInfo;
+    state.meshBuffer = _currMeshBuffer;
+    state.indexStart = _indexStart;
+    state.layer = _currLayer;
+    state.stencilStage = _stencilManager->getStencilStage();
+    state.currStencilStage = _currStencilStage;
+    return state;
+}
+
+void Batcher2d::restoreBatchState(const BatchState& state) {
+    _currHash = state.hash;
+    _currSamplerHash = state.samplerHash;
+    _currMaterial = state.material;
+    _currTexture = state.texture;
+    _currSampler = state.sampler;
+    _currEntity = state.entity;
+    _currDrawInfo = state.drawInfo;
+    _currMeshBuffer = state.meshBuffer;
+    _indexStart = state.indexStart;
+    _currLayer = state.layer;
+    _currStencilStage = state.currStencilStage;
+}
+
+void Batcher2d::syncRootNodeBatchCaches() {
+    bool changed = _rootNodeBatchCaches.size() != _rootNodeArr.size();
+    for (size_t i = 0; !changed && i < _rootNodeArr.size(); ++i) {
+        changed = _rootNodeBatchCaches[i].rootNode != _rootNodeArr[i];
+    }
+    if (changed) {
+        // keep the caches of root nodes which are still there
+        ccstd::vector<RootNodeBatchCache> caches(_rootNodeArr.size());
+        for (size_t i = 0; i < _rootNodeArr.size(); ++i) {
+            caches[i].rootNode = _rootNodeArr[i];
+            for (auto& cache : _rootNodeBatchCaches) {
+                if (cache.rootNode == _rootNodeArr[i]) {
+                    caches[i] = std::move(cache);
+                    cache.rootNode = nullptr;
+                    break;
+                }
+            }
+        }
+        for (auto& cache : _rootNodeBatchCaches) {
+            releaseRootNodeBatches(cache);
+        }
+        _rootNodeBatchCaches = std::move(caches);
+    }
+
+    _dirtyMeshBuffers.clear();
+    for (auto& map : _meshBuffersMap) {
+        for (auto* buffer : map.second) {
+            if (buffer && buffer->getDirty()) {
+                _dirtyMeshBuffers.emplace_back(buffer);
+            }
+        }
+    }
+}
+
+bool Batcher2d::isRootNodeCacheUpToDate(const RootNodeBatchCache& cache) const {
+    for (const auto& record : cache.nodes) {
+        if (record.parent >= 0) {
+            const auto& siblings = cache.nodes[record.parent].node->getChildren();
+            if (record.childIndex >= siblings.size() || siblings[record.childIndex] != record.node) {
+                return false;
+            }
+        }
+        Node* node = record.node;
+        if (node->isActiveInHierarchy() != record.active || node->getChildren().size() != record.childCount) {
+            return false;
+        }
+        if (!record.active) {
+            continue;
+        }
+        if (node->getLayer() != record.layer || node->getChangedFlags() || node->isTransformDirty()) {
+            return false;
+        }
+        auto* entity = static_cast<RenderEntity*>(node->getUserData());
+        if (entity != record.entity || (entity && entity->isBatchDirty())) {
+            return false;
+        }
+    }
+
+    for (const auto& record : cache.drawInfos) {
+        const auto* material = record.drawInfo->getMaterial();
+        if (record.drawInfo->isBatchDirty() || (material ? material->getHash() : 0) != record.materialHash) {
+            return false;
+        }
+    }
+
+    for (const auto& range : cache.meshBuffers) {
+        if (range.buffer->getByteOffset() != range.byteOffset ||
+            std::find(_dirtyMeshBuffers.begin(), _dirtyMeshBuffers.end(), range.buffer) != _dirtyMeshBuffers.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Batcher2d::reuseRootNodeBatches(RootNodeBatchCache& cache) {
+    if (!cache.valid || !(cache.entryState == captureBatchState()) || !isRootNodeCacheUpToDate(cache)) {
+        return false;
+    }
+    for (const auto& range : cache.meshBuffers) {
+        if (range.buffer->getIndexOffset() != range.indexBegin) {
+            return false;
+        }
+    }
+
+    // the index data of the subtree is still in place, only the offsets need to be restored
+    for (const auto& range : cache.meshBuffers) {
+        range.buffer->setIndexOffset(range.indexEnd);
+    }
+    _batches.insert(_batches.end(), cache.batches.begin(), cache.batches.end());
+    restoreBatchState(cache.exitState);
+
+    // material properties change without changing the hash, upload them as DrawBatch2D::fillPass does
+    const Material* lastMaterial = nullptr;
+    for (const auto& record : cache.drawInfos) {
+        auto* material = record.drawInfo->getMaterial();
+        if (!material || material == lastMaterial) {
+            continue;
+        }
+        lastMaterial = material;
+        for (const auto& pass : *material->getPasses()) {
+            pass->update();
+        }
+    }
+    return true;
+}
+
+void Batcher2d::beginRecording(RootNodeBatchCache& cache) {
+    cache.valid = false;
+    cache.nodes.clear();
+    cache.drawInfos.clear();
+    cache.meshBuffers.clear();
+    if (!_incrementalBatchingEnabled) {
+        return;
+    }
+    cache.cacheable = true;
+    cache.entryState = captureBatchState();
+    _recordingCache = &cache;
+    _recordParent = -1;
+    _recordChildIndex = 0;
+}
+
+void Batcher2d::endRecording(RootNodeBatchCache& cache, size_t batchBegin) {
+    _recordingCache = nullptr;
+    const auto batchEnd = _batches.begin() + static_cast<std::ptrdiff_t>(_batches.size());
+    const auto batchStart = _batches.begin() + static_cast<std::ptrdiff_t>(batchBegin);
+    if (!_incrementalBatchingEnabled || !cache.cacheable) {
+        _transientBatches.insert(_transientBatches.end(), batchStart, batchEnd);
+        cache.nodes.clear();
+        cache.drawInfos.clear();
+        cache.meshBuffers.clear();
+        return;
+    }
+
+    cache.batches.assign(batchStart, batchEnd);
+    cache.exitState = captureBatchState();
+    for (auto& range : cache.meshBuffers) {
+        range.indexEnd = range.buffer->getIndexOffset();
+    }
+    for (const auto& record : cache.nodes) {
+        if (record.active && record.entity) {
+            record.entity->markBatchClean();
+        }
+    }
+    for (const auto& record : cache.drawInfos) {
+        record.drawInfo->markBatchClean();
+    }
+    cache.valid = true;
+}
+
+void Batcher2d::releaseRootNodeBatches(RootNodeBatchCache& cache) {
+    for (auto* batch : cache.batches) {
+        batch->clear();
+        _drawBatchPool.free(batch);
+    }
+    cache.batches.clear();
+    cache.valid = false;
+}
+
+void Batcher2d::invalidateBatchCaches() {
+    for (auto& cache : _rootNodeBatchCaches) {
+        if (!cache.batches.empty()) {
+            // the batches may still be in use for this frame, hand them over to reset()
+            _transientBatches.insert(_transientBatches.end(), cache.batches.begin(), cache.batches.end());
+            cache.batches.clear();
+        }
+        cache.valid = false;
+    }
+}
+
+int32_t Batcher2d::recordNode(Node* node, RenderEntity* entity) {
+    auto& records = _recordingCache->nodes;
+    auto& record = records.emplace_back();
+    record.node = node;
+    record.entity = entity;
+    record.parent = _recordParent;
+    record.childIndex = _recordChildIndex;
+    record.childCount = static_cast<uint32_t>(node->getChildren().size());
+    record.layer = node->getLayer();
+    record.active = node->isActiveInHierarchy();
+    return static_cast<int32_t>(records.size() - 1);
+}
+
+void Batcher2d::recordDrawInfo(RenderDrawInfo* drawInfo) {
+    const auto* material = drawInfo->getMaterial();
+    _recordingCache->drawInfos.push_back({drawInfo, material ? material->getHash() : 0});
+
+    auto* buffer = drawInfo->getMeshBuffer();
+    auto& ranges = _recordingCache->meshBuffers;
+    auto iter = std::find_if(ranges.begin(), ranges.end(), [buffer](const MeshBufferRange& range) { return range.buffer == buffer; });
+    if (iter == ranges.end()) {
+        ranges.push_back({buffer, buffer->getIndexOffset(), 0, buffer->getByteOffset()});
+    }
+}
+
 void Batcher2d::insertMaskBatch(RenderEntity* entity) {
     generateBatch(_currEntity, _currDrawInfo);
     resetRenderStates();
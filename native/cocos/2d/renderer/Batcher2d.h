@@ -74,7 +74,127 @@ public:
     void generateBatchForMiddleware(RenderEntity* entity, RenderDrawInfo* drawInfo);
     void resetRenderStates();
 
+    /**
+     * @en Whether to reuse the batches of root nodes whose subtrees did not change since the last frame.
+     * @zh 是否复用自上一帧以来没有变化的根节点子树的合批结果。
+     */
+    inline void setIncrementalBatchingEnabled(bool enabled) {
+        if (!enabled) {
+            invalidateBatchCaches();
+        }
+        _incrementalBatchingEnabled = enabled;
+    }
+    inline bool isIncrementalBatchingEnabled() const { return _incrementalBatchingEnabled; }
+    /**
+     * @en Number of root nodes whose batches were reused in the last update.
+     * @zh 上一次更新中复用合批结果的根节点数量。
+     */
+    inline uint32_t getReusedRootNodeCount() const { return _reusedRootNodeCount; }
+    void invalidateBatchCaches();
+
+    /**
+     * @en Whether to fill the vertex data of root nodes on job system workers. The batches are still merged
+     * in the order of the root nodes on the calling thread, so the results are the same as the serial walk.
+     * @zh 是否在 JobSystem 的工作线程上填充各个根节点的顶点数据。合批仍在调用线程上按根节点顺序进行，结果与串行遍历一致。
+     */
+    inline void setParallelWalkEnabled(bool enabled) { _parallelWalkEnabled = enabled; }
+    inline bool isParallelWalkEnabled() const { return _parallelWalkEnabled; }
+
 private:
+    // the batching states carried from one draw info to the next
+    struct BatchState {
+        ccstd::hash_t hash{0};
+        ccstd::hash_t samplerHash{0};
+        Material* material{nullptr};
+        gfx::Texture* texture{nullptr};
+        gfx::Sampler* sampler{nullptr};
+        RenderEntity* entity{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+        UIMeshBuffer* meshBuffer{nullptr};
+        uint32_t indexStart{0};
+        uint32_t layer{0};
+        StencilStage stencilStage{StencilStage::DISABLED};
+        StencilStage currStencilStage{StencilStage::DISABLED};
+
+        bool operator==(const BatchState& rhs) const {
+            return hash == rhs.hash && samplerHash == rhs.samplerHash && material == rhs.material && texture == rhs.texture &&
+                   sampler == rhs.sampler && entity == rhs.entity && drawInfo == rhs.drawInfo && meshBuffer == rhs.meshBuffer &&
+                   indexStart == rhs.indexStart && layer == rhs.layer && stencilStage == rhs.stencilStage && currStencilStage == rhs.currStencilStage;
+        }
+    };
+
+    // a node visited by the walk, children are checked through their parent so that removed nodes are never accessed
+    struct NodeRecord {
+        Node* node{nullptr};
+        RenderEntity* entity{nullptr};
+        int32_t parent{-1};
+        uint32_t childIndex{0};
+        uint32_t childCount{0};
+        uint32_t layer{0};
+        bool active{false};
+    };
+
+    struct DrawInfoRecord {
+        RenderDrawInfo* drawInfo{nullptr};
+        ccstd::hash_t materialHash{0};
+    };
+
+    struct MeshBufferRange {
+        UIMeshBuffer* buffer{nullptr};
+        uint32_t indexBegin{0};
+        uint32_t indexEnd{0};
+        uint32_t byteOffset{0};
+    };
+
+    // batches of a root node, reused as long as nothing in the subtree changes
+    struct RootNodeBatchCache {
+        Node* rootNode{nullptr};
+        bool valid{false};
+        bool cacheable{false};
+        BatchState entryState;
+        BatchState exitState;
+        ccstd::vector<scene::DrawBatch2D*> batches;
+        ccstd::vector<NodeRecord> nodes;
+        ccstd::vector<DrawInfoRecord> drawInfos;
+        ccstd::vector<MeshBufferRange> meshBuffers;
+    };
+
+    // a node, draw info or mask exit visited by the walk, replayed in order to merge the batches
+    struct WalkCommand {
+        enum class Type : uint8_t {
+            NODE,
+            DRAW,
+            POST_RENDER,
+        };
+        Type type{Type::NODE};
+        // NODE only, the record of the parent node and the index in its children
+        int32_t recordParent{-1};
+        uint32_t childIndex{0};
+        Node* node{nullptr};
+        RenderEntity* entity{nullptr};
+        RenderDrawInfo* drawInfo{nullptr};
+    };
+
+    void prepareRootNodes();
+    void prepareWalk(Node* node, float parentOpacity, bool parentOpacityDirty, int32_t recordParent, uint32_t childIndex, int32_t& nodeCount, ccstd::vector<WalkCommand>& commands);
+    void replayWalk(const ccstd::vector<WalkCommand>& commands);
+
+    BatchState captureBatchState() const;
+    void restoreBatchState(const BatchState& state);
+    void syncRootNodeBatchCaches();
+    bool isRootNodeCacheUpToDate(const RootNodeBatchCache& cache) const;
+    bool reuseRootNodeBatches(RootNodeBatchCache& cache);
+    void beginRecording(RootNodeBatchCache& cache);
+    void endRecording(RootNodeBatchCache& cache, size_t batchBegin);
+    void releaseRootNodeBatches(RootNodeBatchCache& cache);
+    int32_t recordNode(Node* node, RenderEntity* entity);
+    void recordDrawInfo(RenderDrawInfo* drawInfo);
+    inline void stopRecording() {
+        if (_recordingCache) {
+            _recordingCache->cacheable = false;
+        }
+    }
+
     bool _isInit = false;
 
     inline void fillIndexBuffers(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
@@ -87,11 +207,38 @@ private:
         uint32_t indexCount = drawInfo->getIbCount();
 
         memcpy(&ib[indexOffset], indexb, indexCount * sizeof(uint16_t));
+        buffer->markIndexRange(indexOffset, indexOffset + indexCount);
         indexOffset += indexCount;
 
         buffer->setIndexOffset(indexOffset);
     }
 
+    inline void markVertexRange(RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
+        // uvs and colors may be written by the script side as well, so the whole vertex range of the draw info is uploaded
+        UIMeshBuffer* buffer = drawInfo->getMeshBuffer();
+        const float* vbBuffer = drawInfo->getVbBuffer();
+        if (vbBuffer == nullptr || buffer->getVData() == nullptr) {
+            return;
+        }
+        auto byteBegin = static_cast<uint32_t>(vbBuffer - buffer->getVData()) * sizeof(float);
+        auto byteSize = drawInfo->getVbCount() * drawInfo->getStride() * sizeof(float);
+        buffer->markVertexRange(byteBegin, byteBegin + byteSize);
+    }
+
+    // vertex positions and colors only depend on the draw info itself, so they may be filled on any thread
+    inline void fillVertexData(RenderEntity* entity, RenderDrawInfo* drawInfo, Node* node) { // NOLINT(readability-convert-member-functions-to-static)
+        if (drawInfo->getEnumDrawInfoType() != RenderDrawInfoType::COMP || drawInfo->getIsMeshBuffer()) {
+            return;
+        }
+        if (node->getChangedFlags() || node->isTransformDirty() || drawInfo->getVertDirty()) {
+            fillVertexBuffers(entity, drawInfo);
+            drawInfo->setVertDirty(false);
+        }
+        if (entity->getVBColorDirty()) {
+            fillColors(entity, drawInfo);
+        }
+    }
+
     inline void fillVertexBuffers(RenderEntity* entity, RenderDrawInfo* drawInfo) { // NOLINT(readability-convert-member-functions-to-static)
         Node* node = entity->getNode();
         const Mat4& matrix = node->getWorldMatrix();
@@ -146,10 +293,28 @@ private:
     // weak reference
     ccstd::vector<Node*> _rootNodeArr;
 
-    // manage memory manually
+    // weak reference, batches of this frame, owned by _transientBatches or _rootNodeBatchCaches
     ccstd::vector<scene::DrawBatch2D*> _batches;
+    // manage memory manually, batches released in reset()
+    ccstd::vector<scene::DrawBatch2D*> _transientBatches;
     memop::Pool<scene::DrawBatch2D> _drawBatchPool;
 
+    // index aligned with _rootNodeArr
+    ccstd::vector<RootNodeBatchCache> _rootNodeBatchCaches;
+    // weak reference
+    RootNodeBatchCache* _recordingCache{nullptr};
+    int32_t _recordParent{-1};
+    uint32_t _recordChildIndex{0};
+    // weak reference, mesh buffers marked dirty by JS before the walk
+    ccstd::vector<UIMeshBuffer*> _dirtyMeshBuffers;
+    uint32_t _reusedRootNodeCount{0};
+    bool _incrementalBatchingEnabled{true};
+
+    // index aligned with _rootNodeArr, empty for root nodes walked on the calling thread
+    ccstd::vector<ccstd::vector<WalkCommand>> _walkCommands;
+    ccstd::vector<uint32_t> _preparingRootNodes;
+    bool _parallelWalkEnabled{false};
+
     // weak reference
     gfx::Device* _device{nullptr}; // use getDevice()
 
@@ -47,6 +47,7 @@ RenderDrawInfo::~RenderDrawInfo() {
 void RenderDrawInfo::changeMeshBuffer() {
     CC_ASSERT(Root::getInstance()->getBatcher2D());
     _meshBuffer = Root::getInstance()->getBatcher2D()->getMeshBuffer(_drawInfoAttrs._accId, _drawInfoAttrs._bufferId);
+    _batchDirty = true;
 }
 
 gfx::InputAssembler* RenderDrawInfo::requestIA(gfx::Device* device) {
@@ -54,9 +55,9 @@ gfx::InputAssembler* RenderDrawInfo::requestIA(gfx::Device* device) {
     return initIAInfo(device);
 }
 
-void RenderDrawInfo::uploadBuffers() {
+uint32_t RenderDrawInfo::uploadBuffers() {
     CC_ASSERT(_drawInfoAttrs._isMeshBuffer && _drawInfoAttrs._drawInfoType == RenderDrawInfoType::COMP);
-    if (_drawInfoAttrs._vbCount == 0 || _drawInfoAttrs._ibCount == 0) return;
+    if (_drawInfoAttrs._vbCount == 0 || _drawInfoAttrs._ibCount == 0) return 0;
     uint32_t size = _drawInfoAttrs._vbCount * 9 * sizeof(float); // magic Number
     gfx::Buffer* vBuffer = _ia->getVertexBuffers()[0];
     vBuffer->resize(size);
@@ -65,6 +66,7 @@ void RenderDrawInfo::uploadBuffers() {
     uint32_t iSize = _drawInfoAttrs._ibCount * 2;
     iBuffer->resize(iSize);
     iBuffer->update(_iDataBuffer);
+    return size + iSize;
 }
 
 void RenderDrawInfo::resetMeshIA() { // NOLINT(readability-make-member-function-const)
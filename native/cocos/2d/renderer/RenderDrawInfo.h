@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #pragma once
+#include <cstring>
 #include "2d/renderer/UIMeshBuffer.h"
 #include "base/Ptr.h"
 #include "base/Macros.h"
@@ -122,10 +123,12 @@ public:
     inline Material* getMaterial() const { return _material; }
     inline void setMaterial(Material* material) {
         _material = material;
+        _batchDirty = true;
     }
 
     inline void setMeshBuffer(UIMeshBuffer* meshBuffer) {
         _meshBuffer = meshBuffer;
+        _batchDirty = true;
     }
     inline UIMeshBuffer* getMeshBuffer() const {
         return _meshBuffer;
@@ -136,6 +139,7 @@ public:
     }
     inline void setVDataBuffer(float* vDataBuffer) {
         _vDataBuffer = vDataBuffer;
+        _batchDirty = true;
     }
     inline uint16_t* getIDataBuffer() const {
         return _iDataBuffer;
@@ -143,6 +147,7 @@ public:
 
     inline void setIDataBuffer(uint16_t* iDataBuffer) {
         _iDataBuffer = iDataBuffer;
+        _batchDirty = true;
     }
 
     inline gfx::Texture* getTexture() const {
@@ -151,6 +156,7 @@ public:
 
     inline void setTexture(gfx::Texture* texture) {
         _texture = texture;
+        _batchDirty = true;
     }
 
     inline gfx::Sampler* getSampler() const {
@@ -159,6 +165,7 @@ public:
 
     inline void setSampler(gfx::Sampler* sampler) {
         _sampler = sampler;
+        _batchDirty = true;
     }
 
     inline float* getVbBuffer() const {
@@ -167,6 +174,7 @@ public:
 
     inline void setVbBuffer(float* vbBuffer) {
         _vbBuffer = vbBuffer;
+        _batchDirty = true;
     }
 
     inline uint16_t* getIbBuffer() const {
@@ -175,6 +183,7 @@ public:
 
     inline void setIbBuffer(uint16_t* ibBuffer) {
         _ibBuffer = ibBuffer;
+        _batchDirty = true;
     }
 
     inline scene::Model* getModel() const {
@@ -186,6 +195,7 @@ public:
         CC_ASSERT_EQ(_drawInfoAttrs._drawInfoType, RenderDrawInfoType::MODEL);
         if (_drawInfoAttrs._drawInfoType == RenderDrawInfoType::MODEL) {
             _model = model;
+            _batchDirty = true;
         }
     }
 
@@ -196,6 +206,7 @@ public:
     inline void setSubNode(Node* node) {
         CC_ASSERT_EQ(_drawInfoAttrs._drawInfoType, RenderDrawInfoType::SUB_NODE);
         _subNode = node;
+        _batchDirty = true;
     }
 
     void changeMeshBuffer();
@@ -205,6 +216,7 @@ public:
     inline void setRender2dBufferToNative(uint8_t* buffer) { // NOLINT(bugprone-easily-swappable-parameters)
         CC_ASSERT(_drawInfoAttrs._drawInfoType == RenderDrawInfoType::COMP && !_drawInfoAttrs._isMeshBuffer);
         _sharedBuffer = buffer;
+        _batchDirty = true;
     }
 
     inline Render2dLayout* getRender2dLayout(uint32_t dataOffset) const {
@@ -215,7 +227,8 @@ public:
     inline se::Object* getAttrSharedBufferForJS() const { return _attrSharedBufferActor.getSharedArrayBufferObject(); }
 
     gfx::InputAssembler* requestIA(gfx::Device* device);
-    void uploadBuffers();
+    // Returns the number of bytes uploaded to the gpu buffers.
+    uint32_t uploadBuffers();
     void resetMeshIA();
 
     inline gfx::DescriptorSet* getLocalDes() { return _localDSBF->ds; }
@@ -245,6 +258,20 @@ public:
         _subNode = nullptr;
         _model = nullptr;
         _sharedBuffer = nullptr;
+        _batchDirty = true;
+    }
+
+    /**
+     * @en Whether anything that affects the generated batches changed since the last markBatchClean,
+     * either through the native setters or through the attributes shared with JS.
+     * @zh 自上次调用 markBatchClean 以来，是否有影响合批结果的数据发生变化，包括原生接口的修改与 JS 共享属性的修改。
+     */
+    inline bool isBatchDirty() const {
+        return _batchDirty || memcmp(&_drawInfoAttrs, &_batchDrawInfoAttrs, sizeof(DrawInfoAttrs)) != 0;
+    }
+    inline void markBatchClean() {
+        memcpy(&_batchDrawInfoAttrs, &_drawInfoAttrs, sizeof(DrawInfoAttrs));
+        _batchDirty = false;
     }
 
 private:
@@ -266,6 +293,8 @@ private:
         uint32_t _ibCount{0};
         ccstd::hash_t _dataHash{0};
     } _drawInfoAttrs{};
+    // snapshot of _drawInfoAttrs when the batches were cached by Batcher2d
+    DrawInfoAttrs _batchDrawInfoAttrs{};
 
     bindings::NativeMemorySharedToScriptActor _attrSharedBufferActor;
     // weak reference
@@ -291,6 +320,7 @@ private:
         uint8_t* _sharedBuffer;
     };
     LocalDSBF* _localDSBF{nullptr};
+    bool _batchDirty{true};
 
     // ia
     IntrusivePtr<gfx::InputAssembler> _ia;
@@ -24,6 +24,7 @@
 
 #pragma once
 #include <array>
+#include <cstring>
 #include "2d/renderer/RenderDrawInfo.h"
 #include "2d/renderer/StencilManager.h"
 #include "base/Macros.h"
@@ -89,6 +90,7 @@ public:
     inline bool getUseLocal() const { return _entityAttrLayout.useLocal; }
     inline void setUseLocal(bool useLocal) {
         _entityAttrLayout.useLocal = useLocal;
+        _batchDirty = true;
     }
 
     inline Node* getNode() const { return _node; }
@@ -112,9 +114,9 @@ public:
     void setStaticDrawInfoSize(uint32_t size);
 
     RenderDrawInfo* getStaticRenderDrawInfo(uint32_t index);
-    std::array<RenderDrawInfo, RenderEntity::STATIC_DRAW_INFO_CAPACITY>& getStaticRenderDrawInfos();
+    const std::array<RenderDrawInfo, RenderEntity::STATIC_DRAW_INFO_CAPACITY>& getStaticRenderDrawInfos() const;
     RenderDrawInfo* getDynamicRenderDrawInfo(uint32_t index);
-    ccstd::vector<RenderDrawInfo*>& getDynamicRenderDrawInfos();
+    const ccstd::vector<RenderDrawInfo*>& getDynamicRenderDrawInfos() const;
 
     inline se::Object* getEntitySharedBufferForJS() const { return _entitySharedBufferActor.getSharedArrayBufferObject(); }
     inline bool getColorDirty() const { return _entityAttrLayout.colorDirtyBit != 0; }
@@ -134,6 +136,19 @@ public:
         return _renderEntityType == RenderEntityType::STATIC ? &(_staticDrawInfos[index]) : _dynamicDrawInfos[index];
     }
 
+    /**
+     * @en Whether anything that affects the generated batches changed since the last markBatchClean,
+     * either through the native setters or through the attributes shared with JS.
+     * @zh 自上次调用 markBatchClean 以来，是否有影响合批结果的数据发生变化，包括原生接口的修改与 JS 共享属性的修改。
+     */
+    inline bool isBatchDirty() const {
+        return _batchDirty || memcmp(&_entityAttrLayout, &_batchEntityAttrLayout, sizeof(EntityAttrLayout)) != 0;
+    }
+    inline void markBatchClean() {
+        memcpy(&_batchEntityAttrLayout, &_entityAttrLayout, sizeof(EntityAttrLayout));
+        _batchDirty = false;
+    }
+
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderEntity);
     // weak reference
@@ -143,6 +158,8 @@ private:
     Node* _renderTransform{nullptr};
 
     EntityAttrLayout _entityAttrLayout;
+    // snapshot of _entityAttrLayout when the batches were cached by Batcher2d
+    EntityAttrLayout _batchEntityAttrLayout;
     float _opacity{1.0F};
 
     bindings::NativeMemorySharedToScriptActor _entitySharedBufferActor;
@@ -154,5 +171,6 @@ private:
     RenderEntityType _renderEntityType{RenderEntityType::STATIC};
     uint8_t _staticDrawInfoSize{0};
     bool _vbColorDirty{true};
+    bool _batchDirty{true};
 };
 } // namespace cc
@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "2d/renderer/UIMeshBuffer.h"
+#include <algorithm>
 #include "renderer/gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -91,31 +92,65 @@ gfx::InputAssembler* UIMeshBuffer::requireFreeIA(gfx::Device* device) {
     return createNewIA(device);
 }
 
-void UIMeshBuffer::uploadBuffers() {
-    uint32_t byteOffset = getByteOffset();
-    bool dirty = getDirty();
-    if (_meshBufferLayout == nullptr || byteOffset == 0 || !dirty || !_ia) {
-        return;
+static uint32_t uploadRange(gfx::Buffer* buffer, const uint8_t* data, uint32_t usedSize, uint32_t begin, uint32_t end, bool full) {
+    if (usedSize > buffer->getSize()) {
+        // resizing drops the previous contents
+        buffer->resize(usedSize);
+        full = true;
+    }
+    if (full || !buffer->isRangeUpdateSupported()) {
+        buffer->update(data, usedSize);
+        return usedSize;
     }
+    end = std::min(end, usedSize);
+    if (begin >= end) {
+        return 0;
+    }
+    buffer->updateRange(data + begin, begin, end - begin);
+    return end - begin;
+}
 
-    uint32_t indexCount = getIndexOffset();
+uint32_t UIMeshBuffer::uploadBuffers() {
+    const uint32_t vertexBegin = _dirtyVertexBegin;
+    const uint32_t vertexEnd = _dirtyVertexEnd;
+    const uint32_t indexBegin = _dirtyIndexBegin;
+    const uint32_t indexEnd = _dirtyIndexEnd;
+    _dirtyVertexBegin = _dirtyIndexBegin = UINT32_MAX;
+    _dirtyVertexEnd = _dirtyIndexEnd = 0;
+
+    if (_meshBufferLayout == nullptr || !_ia) {
+        return 0;
+    }
     uint32_t byteCount = getByteOffset();
+    uint32_t indexCount = getIndexOffset();
+    bool dirty = getDirty();
+    if (byteCount == 0 || (!dirty && vertexBegin >= vertexEnd && indexBegin >= indexEnd)) {
+        return 0;
+    }
 
+    uint32_t uploadedBytes = 0;
     gfx::BufferList vBuffers = _ia->getVertexBuffers();
     if (!vBuffers.empty()) {
-        gfx::Buffer* vBuffer = vBuffers[0];
-        if (byteCount > vBuffer->getSize()) {
-            vBuffer->resize(byteCount);
-        }
-        vBuffer->update(_vData);
+        uploadedBytes += uploadRange(vBuffers[0], reinterpret_cast<const uint8_t*>(_vData), byteCount, vertexBegin, vertexEnd, dirty);
     }
-    gfx::Buffer* iBuffer = _ia->getIndexBuffer();
-    if (indexCount * 2 > iBuffer->getSize()) {
-        iBuffer->resize(indexCount * 2);
+    if (indexCount > 0) {
+        constexpr uint32_t indexBytes = sizeof(uint16_t);
+        uploadedBytes += uploadRange(_ia->getIndexBuffer(), reinterpret_cast<const uint8_t*>(_iData), indexCount * indexBytes,
+                                     indexBegin * indexBytes, indexEnd * indexBytes, dirty);
     }
-    iBuffer->update(_iData);
 
     setDirty(false);
+    return uploadedBytes;
+}
+
+void UIMeshBuffer::markVertexRange(uint32_t byteBegin, uint32_t byteEnd) {
+    _dirtyVertexBegin = std::min(_dirtyVertexBegin, byteBegin);
+    _dirtyVertexEnd = std::max(_dirtyVertexEnd, byteEnd);
+}
+
+void UIMeshBuffer::markIndexRange(uint32_t indexBegin, uint32_t indexEnd) {
+    _dirtyIndexBegin = std::min(_dirtyIndexBegin, indexBegin);
+    _dirtyIndexEnd = std::max(_dirtyIndexEnd, indexEnd);
 }
 
 // use less
@@ -53,7 +53,8 @@ public:
     void reset();
     void destroy();
     void setDirty();
-    void uploadBuffers();
+    // Returns the number of bytes uploaded to the gpu buffers.
+    uint32_t uploadBuffers();
     void syncSharedBufferToNative(uint32_t* buffer);
     void resetIA();
     void recycleIA(gfx::InputAssembler* ia);
@@ -70,6 +71,9 @@ public:
     void setIndexOffset(uint32_t indexOffset);
     inline bool getDirty() const { return _meshBufferLayout->dirtyMark != 0; }
     void setDirty(bool dirty) const;
+    // Native writes only upload the marked ranges, the dirty mark uploads all the data in use.
+    void markVertexRange(uint32_t byteBegin, uint32_t byteEnd);
+    void markIndexRange(uint32_t indexBegin, uint32_t indexEnd);
     inline const ccstd::vector<gfx::Attribute>& getAttributes() const {
         return _attributes;
     }
@@ -88,6 +92,11 @@ private:
     uint32_t _initVDataCount{0};
     uint32_t _initIDataCount{0};
 
+    uint32_t _dirtyVertexBegin{UINT32_MAX};
+    uint32_t _dirtyVertexEnd{0};
+    uint32_t _dirtyIndexBegin{UINT32_MAX};
+    uint32_t _dirtyIndexEnd{0};
+
     ccstd::vector<gfx::Attribute> _attributes;
     IntrusivePtr<gfx::InputAssembler> _ia;
     IntrusivePtr<gfx::Buffer> _vb;
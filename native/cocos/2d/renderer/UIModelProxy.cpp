@@ -138,7 +138,7 @@ void UIModelProxy::updateModels(scene::Model* model) {
 
 void UIModelProxy::attachDrawInfo() {
     auto* entity = static_cast<RenderEntity*>(_node->getUserData());
-    auto& drawInfos = entity->getDynamicRenderDrawInfos();
+    const auto& drawInfos = entity->getDynamicRenderDrawInfos();
     if (drawInfos.size() != _models.size()) return;
     for (size_t i = 0; i < drawInfos.size(); i++) {
         drawInfos[i]->setModel(_models[i]);
@@ -24,9 +24,11 @@
 
 #include "3d/assets/MorphRendering.h"
 
+#include <cstring>
 #include <memory>
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Morph.h"
+#include "3d/assets/SparseMorph.h"
 #include "base/RefCounted.h"
 #include "core/DataView.h"
 #include "core/TypedArray.h"
@@ -168,7 +170,7 @@ struct GpuMorphAttribute {
 };
 
 struct CpuMorphAttributeTarget {
-    Float32Array displacements;
+    SparseMorphTarget displacements;
 };
 
 using CpuMorphAttributeTargetList = ccstd::vector<CpuMorphAttributeTarget>;
@@ -333,10 +335,12 @@ public:
 
     SubMeshMorphRenderingInstance *createInstance() override;
     const ccstd::vector<CpuMorphAttribute> &getData() const;
+    inline uint32_t getVerticesCount() const { return _verticesCount; }
 
 private:
     ccstd::vector<CpuMorphAttribute> _attributes;
     gfx::Device *_gfxDevice{nullptr};
+    uint32_t _verticesCount{0};
 };
 
 class GpuComputing final : public SubMeshMorphRendering {
@@ -373,32 +377,52 @@ public:
     }
 
     void setWeights(const ccstd::vector<float> &weights) override {
+        // morph textures already hold the result of these weights
+        if (_weightsApplied && weights == _weights) {
+            return;
+        }
+        _weights = weights;
+        _weightsApplied = true;
+
+        const uint32_t nVertices = _owner->getVerticesCount();
         for (size_t iAttribute = 0; iAttribute < _attributes.size(); ++iAttribute) {
             const auto &myAttribute = _attributes[iAttribute];
             Float32Array &valueView = myAttribute.morphTexture->getValueView();
+            auto *values = reinterpret_cast<float *>(valueView.buffer()->getData() + valueView.byteOffset());
             const auto &attributeMorph = _owner->getData()[iAttribute];
             CC_ASSERT(weights.size() == attributeMorph.targets.size());
+
+            // reset the vertices written last time, or everything if that is cheaper
+            uint32_t nWritten = 0;
+            for (uint32_t iTarget : _appliedTargets) {
+                nWritten += attributeMorph.targets[iTarget].displacements.size();
+            }
+            if (nWritten >= nVertices) {
+                memset(values, 0, sizeof(float) * 4 * nVertices);
+            } else {
+                for (uint32_t iTarget : _appliedTargets) {
+                    for (uint32_t iVertex : attributeMorph.targets[iTarget].displacements.indices) {
+                        memset(values + 4 * iVertex, 0, sizeof(float) * 4);
+                    }
+                }
+            }
+
             for (size_t iTarget = 0; iTarget < attributeMorph.targets.size(); ++iTarget) {
-                const auto &targetDisplacements = attributeMorph.targets[iTarget].displacements;
                 const float weight = weights[iTarget];
-                const uint32_t nVertices = targetDisplacements.length() / 3;
-                if (iTarget == 0) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] = targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] = targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] = targetDisplacements[3 * iVertex + 2] * weight;
-                    }
-                } else if (std::fabs(weight) >= std::numeric_limits<float>::epsilon()) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] += targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] += targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] += targetDisplacements[3 * iVertex + 2] * weight;
-                    }
+                if (std::fabs(weight) >= std::numeric_limits<float>::epsilon()) {
+                    accumulateSparseMorph(attributeMorph.targets[iTarget].displacements, weight, values);
                 }
             }
 
             myAttribute.morphTexture->updatePixels();
         }
+
+        _appliedTargets.clear();
+        for (size_t iTarget = 0; iTarget < weights.size(); ++iTarget) {
+            if (std::fabs(weights[iTarget]) >= std::numeric_limits<float>::epsilon()) {
+                _appliedTargets.emplace_back(static_cast<uint32_t>(iTarget));
+            }
+        }
     }
 
     ccstd::vector<scene::IMacroPatch> requiredPatches() override {
@@ -442,6 +466,10 @@ private:
     ccstd::vector<GpuMorphAttribute> _attributes;
     IntrusivePtr<CpuComputing> _owner;
     IntrusivePtr<MorphUniforms> _morphUniforms;
+    ccstd::vector<float> _weights;
+    // targets with a non-zero weight in _weights
+    ccstd::vector<uint32_t> _appliedTargets;
+    bool _weightsApplied{false};
 };
 
 class GpuComputingRenderingInstance final : public SubMeshMorphRenderingInstance {
@@ -513,9 +541,9 @@ CpuComputing::CpuComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph
         uint32_t i = 0;
         for (const auto &attributeDisplacement : subMeshMorph.targets) {
             const Mesh::IBufferView &displacementsView = attributeDisplacement.displacements[attributeIndex];
-            attr.targets[i].displacements = Float32Array(mesh->getData().buffer(),
-                                                         mesh->getData().byteOffset() + displacementsView.offset,
-                                                         attributeDisplacement.displacements[attributeIndex].count);
+            const auto *displacements = reinterpret_cast<const float *>(mesh->getData().buffer()->getData() + mesh->getData().byteOffset() + displacementsView.offset);
+            _verticesCount = displacementsView.count / 3;
+            attr.targets[i].displacements.build(displacements, _verticesCount);
 
             ++i;
         }
@@ -527,7 +555,7 @@ CpuComputing::CpuComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph
 SubMeshMorphRenderingInstance *CpuComputing::createInstance() {
     return ccnew CpuComputingRenderingInstance(
         this,
-        _attributes[0].targets[0].displacements.length() / 3,
+        _verticesCount,
         _gfxDevice);
 }
 
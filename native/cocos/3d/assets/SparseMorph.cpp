@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "3d/assets/SparseMorph.h"
+#include "math/SIMD.h"
+
+namespace cc {
+
+void SparseMorphTarget::build(const float *displacements, uint32_t vertexCount) {
+    indices.clear();
+    deltas.clear();
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const float x = displacements[3 * i + 0];
+        const float y = displacements[3 * i + 1];
+        const float z = displacements[3 * i + 2];
+        if (x == 0.F && y == 0.F && z == 0.F) {
+            continue;
+        }
+        indices.emplace_back(i);
+        deltas.insert(deltas.end(), {x, y, z, 0.F});
+    }
+    indices.shrink_to_fit();
+    deltas.shrink_to_fit();
+}
+
+void accumulateSparseMorph(const SparseMorphTarget &target, float weight, float *dst) {
+    const uint32_t count = target.size();
+    const uint32_t *indices = target.indices.data();
+    const float *deltas = target.deltas.data();
+#if defined(CC_SIMD_SSE)
+    const __m128 w = _mm_set1_ps(weight);
+    for (uint32_t i = 0; i < count; ++i) {
+        float *texel = dst + 4 * indices[i];
+        _mm_storeu_ps(texel, _mm_add_ps(_mm_loadu_ps(texel), _mm_mul_ps(_mm_loadu_ps(deltas + 4 * i), w)));
+    }
+#elif defined(CC_SIMD_NEON64)
+    for (uint32_t i = 0; i < count; ++i) {
+        float *texel = dst + 4 * indices[i];
+        vst1q_f32(texel, vfmaq_n_f32(vld1q_f32(texel), vld1q_f32(deltas + 4 * i), weight));
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        float *texel = dst + 4 * indices[i];
+        const float *delta = deltas + 4 * i;
+        texel[0] += delta[0] * weight;
+        texel[1] += delta[1] * weight;
+        texel[2] += delta[2] * weight;
+    }
+#endif
+}
+
+} // namespace cc
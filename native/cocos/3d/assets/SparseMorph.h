@@ -0,0 +1,56 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Displacements of one attribute of a morph target with the undisplaced vertices dropped,
+ * stored as an index stream and a delta stream.
+ */
+struct SparseMorphTarget {
+    // vertices with a non-zero displacement, in increasing order
+    ccstd::vector<uint32_t> indices;
+    // 4 floats per index: the displacement padded with 0, so that it is added to a vec4 texel at once
+    ccstd::vector<float> deltas;
+
+    /**
+     * Build from dense displacements of 3 floats per vertex.
+     */
+    void build(const float *displacements, uint32_t vertexCount);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(indices.size()); }
+};
+
+/**
+ * Add weight * delta to the vec4 of each displaced vertex in dst, with SSE or NEON where available.
+ */
+void accumulateSparseMorph(const SparseMorphTarget &target, float weight, float *dst);
+
+} // namespace cc
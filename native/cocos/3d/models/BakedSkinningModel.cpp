@@ -22,6 +22,9 @@
  THE SOFTWARE.
 ****************************************************************************/
 #include "3d/models/BakedSkinningModel.h"
+
+#include <algorithm>
+
 #include "3d/assets/Mesh.h"
 //#include "3d/skeletal-animation/DataPoolManager.h"
 #include "core/Root.h"
@@ -62,10 +65,12 @@ void BakedSkinningModel::destroy() {
     if (_jointMedium.buffer != nullptr) {
         CC_SAFE_DESTROY_NULL(_jointMedium.buffer);
     }
-    if (_jointMedium.texture.has_value()) {
-        CC_SAFE_DELETE(_jointMedium.texture.value());
-    }
+    // stop listening to the handle before it is deleted
+    auto texture = _jointMedium.texture;
     applyJointTexture(ccstd::nullopt);
+    if (texture.has_value()) {
+        CC_SAFE_DELETE(texture.value());
+    }
     Super::destroy();
 }
 
@@ -134,14 +139,20 @@ void BakedSkinningModel::updateUBOs(uint32_t stamp) {
 
 void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture) {
     auto oldTex = _jointMedium.texture;
-    if (oldTex.has_value() && texture.has_value() && (&oldTex.value() != &texture.value())) {
+    if (oldTex.has_value() && oldTex.value() && (!texture.has_value() || oldTex.value() != texture.value())) {
         //        _dataPoolManager->jointTexturePool->releaseHandle(oldTex.value());
+        auto &owners = oldTex.value()->owners;
+        owners.erase(std::remove(owners.begin(), owners.end(), this), owners.end());
     }
     _jointMedium.texture = texture;
     if (!texture.has_value()) {
         return;
     }
     auto *textureHandle = texture.value();
+    auto &owners = textureHandle->owners;
+    if (std::find(owners.begin(), owners.end(), this) == owners.end()) {
+        owners.emplace_back(this);
+    }
     auto *buffer = _jointMedium.buffer.get();
     auto &jointTextureInfo = _jointMedium.jointTextureInfo;
     jointTextureInfo[0] = static_cast<float>(textureHandle->handle.texture->getWidth());
@@ -160,6 +171,10 @@ void BakedSkinningModel::applyJointTexture(const ccstd::optional<IJointTextureHa
     }
 }
 
+void BakedSkinningModel::onJointTextureRelocated(IJointTextureHandle *handle) {
+    applyJointTexture(handle);
+}
+
 ccstd::vector<scene::IMacroPatch> BakedSkinningModel::getMacroPatches(index_t subModelIndex) {
     auto patches = Super::getMacroPatches(subModelIndex);
     patches.reserve(patches.size() + myPatches.size());
@@ -235,8 +250,9 @@ void BakedSkinningModel::syncDataForJS(const ccstd::vector<ccstd::optional<geome
     _jointMedium.animInfo.frameDataBytes = animInfoData.byteLength();
 
     if (_jointMedium.texture.has_value()) {
-        delete _jointMedium.texture.value();
-        _jointMedium.texture = ccstd::nullopt;
+        auto *texture = _jointMedium.texture.value();
+        applyJointTexture(ccstd::nullopt);
+        delete texture;
     }
     IJointTextureHandle *textureInfo = IJointTextureHandle::createJoinTextureHandle();
     textureInfo->handle.texture = tex;
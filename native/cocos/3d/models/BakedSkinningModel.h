@@ -47,7 +47,7 @@ struct BakedJointInfo {
     ccstd::vector<ccstd::optional<geometry::AABB>> boundsInfo;
 };
 
-class BakedSkinningModel final : public MorphModel {
+class BakedSkinningModel final : public MorphModel, public IJointTextureOwner {
 public:
     using Super = MorphModel;
     BakedSkinningModel();
@@ -83,8 +83,9 @@ public:
 
     void setUploadedAnimForJS(bool value) { _isUploadedAnim = value; }
 
-protected:
     void applyJointTexture(const ccstd::optional<IJointTextureHandle *> &texture);
+    void onJointTextureRelocated(IJointTextureHandle *handle) override;
+    inline const BakedJointInfo &getJointMedium() const { return _jointMedium; }
 
 private:
     BakedJointInfo _jointMedium;
@@ -23,10 +23,12 @@
 ****************************************************************************/
 #include "3d/models/SkinningModel.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Skeleton.h"
+#include "core/animation/SkinningPalette.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/gfx-base/GFXBuffer.h"
@@ -78,6 +80,7 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
     _bufferIndices.clear();
     _joints.clear();
+    initJointPalette();
 
     if (!skeleton || !skinningRoot || !mesh) return;
     auto jointCount = static_cast<uint32_t>(skeleton->getJoints().size());
@@ -113,53 +116,93 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
         jointInfo.indices = std::move(indices);
         _joints.emplace_back(std::move(jointInfo));
     }
+    initJointPalette();
+}
+
+void SkinningModel::initJointPalette() {
+    _jointWorlds.clear();
+    _jointBounds.clear();
+    _paletteWorlds.clear();
+    _paletteBindposes.clear();
+    _paletteDsts.clear();
+    _bufferUploadSizes.assign(_dataArray.size(), 0);
+    // the real-time joint texture stores the three rows of a joint in three texture rows
+    const uint32_t jointStride = _realTimeTextureMode ? 4 : JOINT_PALETTE_STRIDE;
+    for (const JointInfo &jointInfo : _joints) {
+        const Mat4 *world = jointInfo.transform ? &jointInfo.transform->world : &Mat4::IDENTITY;
+        _jointWorlds.emplace_back(world);
+        _jointBounds.emplace_back(jointInfo.bound);
+        for (size_t i = 0; i < jointInfo.buffers.size(); ++i) {
+            const index_t buffer = jointInfo.buffers[i];
+            const index_t index = jointInfo.indices[i];
+            _paletteWorlds.emplace_back(world);
+            _paletteBindposes.emplace_back(&jointInfo.bindpose);
+            _paletteDsts.emplace_back(_dataArray[buffer] + index * jointStride);
+            const auto usedSize = static_cast<uint32_t>((index + 1) * JOINT_PALETTE_STRIDE * sizeof(float));
+            _bufferUploadSizes[buffer] = std::max(_bufferUploadSizes[buffer], usedSize);
+        }
+    }
 }
 
 void SkinningModel::updateTransform(uint32_t stamp) {
+    syncJointTransforms(stamp);
+    updateJointBounds();
+}
+
+void SkinningModel::updateUBOs(uint32_t stamp) {
+    Super::updateUBOs(stamp);
+    writeJointPalette();
+    uploadJointBuffers();
+}
+
+void SkinningModel::syncJointTransforms(uint32_t stamp) {
     auto *root = getTransform();
     if (root->getChangedFlags() || root->isTransformDirty()) {
         root->updateWorldTransform();
         _localDataUpdated = true;
     }
-    Vec3 v3Min{INFINITY, INFINITY, INFINITY};
-    Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
-    geometry::AABB ab1;
-    Vec3 v31;
-    Vec3 v32;
+    _rootWorldMatrix = root->getWorldMatrix();
+    // joint transforms are pooled and shared by all models bound to the same hierarchy
     for (JointInfo &jointInfo : _joints) {
-        auto &transform = jointInfo.transform;
-        Mat4 worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
-        jointInfo.bound->transform(worldMatrix, &ab1);
-        ab1.getBoundary(&v31, &v32);
-        Vec3::min(v3Min, v31, &v3Min);
-        Vec3::max(v3Max, v32, &v3Max);
+        cc::getWorldMatrix(jointInfo.transform, static_cast<int32_t>(stamp));
     }
+}
+
+void SkinningModel::updateJointPalette() {
+    updateJointBounds();
+    writeJointPalette();
+}
+
+void SkinningModel::flushJointBuffers(uint32_t stamp) {
+    Super::updateUBOs(stamp);
+    uploadJointBuffers();
+}
+
+void SkinningModel::updateJointBounds() {
+    Vec3 v3Min;
+    Vec3 v3Max;
+    computeJointBounds(_jointWorlds.data(), _jointBounds.data(), static_cast<uint32_t>(_jointBounds.size()), &v3Min, &v3Max);
     if (_modelBounds && _modelBounds->isValid() && _worldBounds) {
         geometry::AABB::fromPoints(v3Min, v3Max, _modelBounds);
-        _modelBounds->transform(root->getWorldMatrix(), _worldBounds);
+        _modelBounds->transform(_rootWorldMatrix, _worldBounds);
         _worldBoundsDirty = true;
     }
 }
 
-void SkinningModel::updateUBOs(uint32_t stamp) {
-    Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4 mat4;
-    for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]);
-            bIdx++;
-        }
-        bIdx = 0;
-    }
+void SkinningModel::writeJointPalette() {
+    const uint32_t rowStride = _realTimeTextureMode ? 4 * REALTIME_JOINT_TEXTURE_WIDTH : 4;
+    computeJointPalettes(_paletteWorlds.data(), _paletteBindposes.data(), _paletteDsts.data(), static_cast<uint32_t>(_paletteDsts.size()), rowStride);
+}
+
+void SkinningModel::uploadJointBuffers() {
     if (_realTimeTextureMode) {
         updateRealTimeJointTextureBuffer();
-    } else {
-        bIdx = 0;
-        for (gfx::Buffer *buffer : _buffers) {
-            buffer->update(_dataArray[bIdx], buffer->getSize());
-            bIdx++;
+        return;
+    }
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        // only the joints in use are uploaded, the rest of the uniform block is never read
+        if (_bufferUploadSizes[i] > 0) {
+            _buffers[i]->update(_dataArray[i], _bufferUploadSizes[i]);
         }
     }
 }
@@ -187,13 +230,6 @@ ccstd::vector<scene::IMacroPatch> SkinningModel::getMacroPatches(index_t subMode
     return myPatches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3] = mat.m[12];
-    dst[base + 7] = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     uint32_t idx = _bufferIndices[submodelIdx];
@@ -269,7 +305,6 @@ void SkinningModel::initRealTimeJointTexture() {
         textureFormat = gfx::Format::RGBA8;
         texWidth = texWidth * 4;
     }
-    uint32_t length = 4 * REALTIME_JOINT_TEXTURE_WIDTH * REALTIME_JOINT_TEXTURE_HEIGHT;
     const size_t count = _dataArray.size();
     for (size_t i = 0; i < count; i++) {
         gfx::TextureInfo textureInfo;
@@ -280,7 +315,6 @@ void SkinningModel::initRealTimeJointTexture() {
         IntrusivePtr<gfx::Texture> texture = device->createTexture(textureInfo);
         _realTimeJointTexture->textures.push_back(texture);
     }
-    _realTimeJointTexture->buffer = new float[length];
 }
 
 void SkinningModel::bindRealTimeJointTexture(uint32_t idx, gfx::DescriptorSet *descriptorset) {
@@ -306,22 +340,10 @@ void SkinningModel::updateRealTimeJointTextureBuffer() {
     uint32_t bIdx = 0;
     uint32_t width = REALTIME_JOINT_TEXTURE_WIDTH;
     uint32_t height = REALTIME_JOINT_TEXTURE_HEIGHT;
+    auto *device = gfx::Device::getInstance();
     for (const auto &texture : _realTimeJointTexture->textures) {
-        auto *buffer = _realTimeJointTexture->buffer;
-        auto *dst = buffer;
-        auto *src = _dataArray[bIdx];
-        uint32_t count = width;
-        for (uint32_t i = 0; i < count; i++) {
-            dst = buffer + (4 * i);
-            memcpy(dst, src, 16);
-            src = src + 4;
-            dst = buffer + (4 * (i + width));
-            memcpy(dst, src, 16);
-            src = src + 4;
-            dst = buffer + 4 * (i + 2 * width);
-            memcpy(dst, src, 16);
-            src = src + 4;
-        }
+        // the palette kernel already wrote the texture layout
+        const float *buffer = _dataArray[bIdx];
         uint32_t buffOffset = 0;
         gfx::TextureSubresLayers layer;
         gfx::Offset texOffset;
@@ -333,7 +355,6 @@ void SkinningModel::updateRealTimeJointTextureBuffer() {
             texOffset,
             extent,
             layer};
-        auto *device = gfx::Device::getInstance();
 
         device->copyBuffersToTexture(reinterpret_cast<const uint8_t *const *>(&buffer), texture, &region, 1);
         bIdx++;
@@ -341,6 +362,9 @@ void SkinningModel::updateRealTimeJointTextureBuffer() {
 }
 
 void SkinningModel::releaseData() {
+    _paletteDsts.clear();
+    _paletteWorlds.clear();
+    _paletteBindposes.clear();
     if (!_dataArray.empty()) {
         for (auto *data : _dataArray) {
             CC_SAFE_DELETE_ARRAY(data);
@@ -64,11 +64,20 @@ public:
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
+    // Split steps of updateTransform & updateUBOs used by RenderScene's skinning phase,
+    // syncJointTransforms and flushJointBuffers must run on main thread, updateJointPalette is safe on job workers.
+    void syncJointTransforms(uint32_t stamp);
+    void updateJointPalette();
+    void flushJointBuffers(uint32_t stamp);
+
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
     void ensureEnoughBuffers(uint32_t count);
     void updateRealTimeJointTextureBuffer();
     void initRealTimeJointTexture();
+    void initJointPalette();
+    void updateJointBounds();
+    void writeJointPalette();
+    void uploadJointBuffers();
     void bindRealTimeJointTexture(uint32_t idx, gfx::DescriptorSet *descriptorset);
     void releaseData();
 
@@ -76,6 +85,17 @@ private:
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
     ccstd::vector<JointInfo> _joints;
     ccstd::vector<float *> _dataArray;
+    // inputs of the batched bounds kernel, one entry per joint
+    ccstd::vector<const Mat4 *> _jointWorlds;
+    ccstd::vector<const geometry::AABB *> _jointBounds;
+    // inputs of the batched palette kernel, one entry per joint and buffer pair
+    ccstd::vector<const Mat4 *> _paletteWorlds;
+    ccstd::vector<const Mat4 *> _paletteBindposes;
+    ccstd::vector<float *> _paletteDsts;
+    // bytes of each joint buffer actually referenced by the joints
+    ccstd::vector<uint32_t> _bufferUploadSizes;
+    // world matrix of the skinning root, read by updateJointBounds on job workers
+    Mat4 _rootWorldMatrix;
     bool _realTimeTextureMode = false;
     RealTimeJointTexture *_realTimeJointTexture = nullptr;
 
@@ -23,6 +23,9 @@
 ****************************************************************************/
 
 #include "3d/skeletal-animation/SkeletalAnimationUtils.h"
+
+#include <algorithm>
+
 #include "3d/assets/Mesh.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/pipeline/Define.h"
@@ -139,21 +142,32 @@ JointTexturePool::JointTexturePool(gfx::Device *device) {
     const auto &format = selectJointsMediumFormat(_device);
     _formatSize = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(format)].size;
     _pixelsPerJoint = 48 / _formatSize;
-    _pool = ccnew TextureBufferPool(device);
+    _pool = createPool();
+    _customPool = createPool();
+}
+
+IntrusivePtr<TextureBufferPool> JointTexturePool::createPool() const {
+    IntrusivePtr<TextureBufferPool> pool = ccnew TextureBufferPool(_device);
     ITextureBufferPoolInfo poolInfo;
-    poolInfo.format = format;
+    poolInfo.format = selectJointsMediumFormat(_device);
     poolInfo.roundUpFn = roundUpType{roundUpTextureSize};
-    _pool->initialize(poolInfo);
-    _customPool = ccnew TextureBufferPool(device);
-    ITextureBufferPoolInfo customPoolInfo;
-    customPoolInfo.format = format;
-    customPoolInfo.roundUpFn = roundUpType{roundUpTextureSize};
-    _customPool->initialize(customPoolInfo);
+    pool->initialize(poolInfo);
+    return pool;
 }
 
 void JointTexturePool::clear() {
     CC_SAFE_DESTROY(_pool);
     _textureBuffers.clear();
+    // referenced handles are deleted by their last release
+    for (auto *handle : _allocatedHandles) {
+        if (handle->refCount) {
+            handle->readyToBeDeleted = true;
+        } else {
+            CC_SAFE_DELETE(handle);
+        }
+    }
+    _allocatedHandles.clear();
+    _unusedHandles.clear();
 }
 
 void JointTexturePool::registerCustomTextureLayouts(const ccstd::vector<ICustomJointTextureLayout> &layouts) {
@@ -176,8 +190,9 @@ void JointTexturePool::registerCustomTextureLayouts(const ccstd::vector<ICustomJ
 ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(Skeleton *skeleton, Mesh *mesh, Node *skinningRoot) {
     ccstd::hash_t hash = skeleton->getHash() ^ 0; // may not equal to skeleton.hash
     ccstd::optional<IJointTextureHandle *> texture;
-    if (_textureBuffers.find(hash) != _textureBuffers.end()) {
-        texture = _textureBuffers[hash];
+    auto iter = _textureBuffers.find(hash);
+    if (iter != _textureBuffers.end()) {
+        texture = iter->second;
     }
 
     const ccstd::vector<ccstd::string> &joints = skeleton->getJoints();
@@ -188,11 +203,11 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
     if (!texture.has_value()) {
         uint32_t bufSize = jointCount * 12;
         ITextureBufferHandle handle;
+        evictUnusedHandles(bufSize * Float32Array::BYTES_PER_ELEMENT);
         if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
             handle = _customPool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT, _chunkIdxMap[hash]);
         } else {
             handle = _pool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT);
-            return texture;
         }
         IJointTextureHandle *textureHandle = IJointTextureHandle::createJoinTextureHandle();
         textureHandle->pixelOffset = handle.start / _formatSize;
@@ -203,8 +218,13 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
         textureHandle->handle = handle;
         texture = textureHandle;
         textureBuffer = Float32Array(bufSize);
+        textureHandle->data = textureBuffer;
+        _allocatedHandles.emplace_back(textureHandle);
         buildTexture = true;
     } else {
+        if (!texture.value()->refCount) {
+            _unusedHandles.erase(std::find(_unusedHandles.begin(), _unusedHandles.end(), texture.value()));
+        }
         texture.value()->refCount++;
     }
 
@@ -212,13 +232,13 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
     Mat4 mat4;
     Vec3 v34;
     Vec3 v33;
-    Vec3 v3Min(-INF, -INF, -INF);
+    Vec3 v3Min(INF, INF, INF);
     Vec3 v3Max(-INF, -INF, -INF);
     auto boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
     for (uint32_t j = 0, offset = 0; j < jointCount; ++j, offset += 12) {
         auto *node = skinningRoot->getChildByPath(joints[j]);
         Mat4 mat = node ? *getWorldTransformUntilRoot(node, skinningRoot, &mat4) : skeleton->getInverseBindposes()[j];
-        if (j < boneSpaceBounds.size()) {
+        if (j < boneSpaceBounds.size() && boneSpaceBounds[j]) {
             auto *bound = boneSpaceBounds[j].get();
             bound->transform(mat, &ab1);
             ab1.getBoundary(&v33, &v34);
@@ -234,11 +254,12 @@ ccstd::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(S
         }
     }
 
-    ccstd::vector<geometry::AABB> bounds;
-    texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())] = bounds;
+    auto &bounds = texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())];
+    bounds.resize(1);
     geometry::AABB::fromPoints(v3Min, v3Max, &bounds[0]);
     if (buildTexture) {
-        _pool->update(texture.value()->handle, textureBuffer.buffer());
+        auto *pool = isCustomHandle(texture.value()) ? _customPool.get() : _pool.get();
+        pool->update(texture.value()->handle, textureBuffer.buffer());
         _textureBuffers[hash] = texture.value();
     }
 
@@ -347,33 +368,125 @@ void JointTexturePool::releaseHandle(IJointTextureHandle *handle) {
     if (handle->refCount > 0) {
         handle->refCount--;
     }
-    if (!handle->refCount && handle->readyToBeDeleted) {
-        ccstd::hash_t hash = handle->skeletonHash ^ handle->clipHash;
-        if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
-            _customPool->free(handle->handle);
-        } else {
-            _pool->free(handle->handle);
-        }
-        if (_textureBuffers[hash] == handle) {
-            _textureBuffers.erase(hash);
-            CC_SAFE_DELETE(handle);
-        }
+    if (handle->refCount) {
+        return;
     }
+    if (handle->readyToBeDeleted) {
+        destroyHandle(handle);
+        return;
+    }
+    // keep the texture for reuse until it is evicted
+    _unusedHandles.emplace_back(handle);
+    evictUnusedHandles(0);
 }
 
 void JointTexturePool::releaseSkeleton(Skeleton *skeleton) {
-    for (const auto &texture : _textureBuffers) {
-        auto *handle = texture.second;
+    ccstd::vector<IJointTextureHandle *> handles;
+    for (auto *handle : _allocatedHandles) {
         if (handle->skeletonHash == skeleton->getHash()) {
-            handle->readyToBeDeleted = true;
-            if (handle->refCount > 0) {
-                // delete handle record immediately so new allocations with the same asset could work
-                _textureBuffers.erase(handle->skeletonHash ^ handle->clipHash);
-            } else {
-                releaseHandle(handle);
+            handles.emplace_back(handle);
+        }
+    }
+    for (auto *handle : handles) {
+        handle->readyToBeDeleted = true;
+        if (handle->refCount > 0) {
+            // delete handle record immediately so new allocations with the same asset could work
+            auto iter = _textureBuffers.find(handle->skeletonHash ^ handle->clipHash);
+            if (iter != _textureBuffers.end() && iter->second == handle) {
+                _textureBuffers.erase(iter);
             }
+        } else {
+            destroyHandle(handle);
+        }
+    }
+}
+
+void JointTexturePool::setMemoryBudget(uint32_t bytes) {
+    _memoryBudget = bytes;
+    evictUnusedHandles(0);
+}
+
+uint32_t JointTexturePool::compact() {
+    while (!_unusedHandles.empty()) {
+        destroyHandle(_unusedHandles.front());
+        ++_evictionCount;
+    }
+
+    ccstd::vector<IJointTextureHandle *> handles;
+    for (auto *handle : _allocatedHandles) {
+        if (!isCustomHandle(handle)) {
+            handles.emplace_back(handle);
+        }
+    }
+    // allocating the largest textures first packs the chunks tighter
+    std::stable_sort(handles.begin(), handles.end(), [](const IJointTextureHandle *a, const IJointTextureHandle *b) {
+        return a->data.byteLength() > b->data.byteLength();
+    });
+
+    IntrusivePtr<TextureBufferPool> pool = createPool();
+    for (auto *handle : handles) {
+        handle->handle = pool->alloc(handle->data.byteLength());
+        handle->pixelOffset = handle->handle.start / _formatSize;
+        handle->version++;
+        pool->update(handle->handle, handle->data.buffer());
+    }
+    // owners still reference the old textures until they are rebound
+    for (auto *handle : handles) {
+        for (auto *owner : handle->owners) {
+            owner->onJointTextureRelocated(handle);
         }
     }
+    _pool->destroy();
+    _pool = pool;
+    _relocationCount += static_cast<uint32_t>(handles.size());
+    return static_cast<uint32_t>(handles.size());
+}
+
+JointTexturePoolStats JointTexturePool::getStats() const {
+    JointTexturePoolStats stats;
+    stats.unusedHandles = static_cast<uint32_t>(_unusedHandles.size());
+    stats.liveHandles = static_cast<uint32_t>(_allocatedHandles.size()) - stats.unusedHandles;
+    stats.usedBytes = _pool->getUsedSize() + _customPool->getUsedSize();
+    stats.capacityBytes = _pool->getCapacity() + _customPool->getCapacity();
+    stats.chunkCount = _pool->getChunkCount() + _customPool->getChunkCount();
+    stats.evictionCount = _evictionCount;
+    stats.relocationCount = _relocationCount;
+    return stats;
+}
+
+bool JointTexturePool::isCustomHandle(const IJointTextureHandle *handle) const {
+    return _chunkIdxMap.find(handle->skeletonHash ^ handle->clipHash) != _chunkIdxMap.end();
+}
+
+void JointTexturePool::evictUnusedHandles(uint32_t requiredBytes) {
+    if (!_memoryBudget) {
+        return;
+    }
+    while (!_unusedHandles.empty() && _pool->getUsedSize() + _customPool->getUsedSize() + requiredBytes > _memoryBudget) {
+        destroyHandle(_unusedHandles.front());
+        ++_evictionCount;
+    }
+}
+
+void JointTexturePool::destroyHandle(IJointTextureHandle *handle) {
+    if (isCustomHandle(handle)) {
+        _customPool->free(handle->handle);
+    } else {
+        _pool->free(handle->handle);
+    }
+    auto iter = _textureBuffers.find(handle->skeletonHash ^ handle->clipHash);
+    if (iter != _textureBuffers.end() && iter->second == handle) {
+        _textureBuffers.erase(iter);
+    }
+    auto unusedIter = std::find(_unusedHandles.begin(), _unusedHandles.end(), handle);
+    if (unusedIter != _unusedHandles.end()) {
+        _unusedHandles.erase(unusedIter);
+    }
+    auto allocatedIter = std::find(_allocatedHandles.begin(), _allocatedHandles.end(), handle);
+    if (allocatedIter != _allocatedHandles.end()) {
+        _allocatedHandles.erase(allocatedIter);
+    }
+    CC_SAFE_DELETE(handle);
 }
 
 // TODO(xwx): AnimationClip not define
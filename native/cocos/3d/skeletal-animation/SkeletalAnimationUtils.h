@@ -57,6 +57,15 @@ struct IInternalJointAnimInfo {
     ccstd::optional<Mat4> bindposeCorrection;       // correction factor from the original bindpose
 };
 
+class IJointTextureHandle;
+
+class IJointTextureOwner {
+public:
+    virtual ~IJointTextureOwner() = default;
+    // called by JointTexturePool::compact once the handle has its new pixelOffset and texture, before the old texture is destroyed
+    virtual void onJointTextureRelocated(IJointTextureHandle *handle) = 0;
+};
+
 class IJointTextureHandle {
 public:
     uint32_t pixelOffset{0};
@@ -64,7 +73,13 @@ public:
     ccstd::hash_t clipHash{0U};
     ccstd::hash_t skeletonHash{0U};
     bool readyToBeDeleted{false};
+    // increased whenever JointTexturePool::compact moves the handle
+    uint32_t version{0};
+    // objects bound to the texture of this handle, rebound when the handle moves
+    ccstd::vector<IJointTextureOwner *> owners;
     ITextureBufferHandle handle;
+    // texture data kept on CPU, so that the handle can be moved to another chunk
+    Float32Array data;
     ccstd::unordered_map<uint32_t, ccstd::vector<geometry::AABB>> bounds;
     ccstd::optional<ccstd::vector<IInternalJointAnimInfo>> animInfos;
 
@@ -76,6 +91,16 @@ private:
     IJointTextureHandle() = default;
 };
 
+struct JointTexturePoolStats {
+    uint32_t liveHandles{0};      // handles referenced by models
+    uint32_t unusedHandles{0};    // handles kept for reuse after their last release, evicted first
+    uint32_t usedBytes{0};        // bytes of all allocated handles
+    uint32_t capacityBytes{0};    // bytes of all joint textures
+    uint32_t chunkCount{0};       // number of joint textures
+    uint32_t evictionCount{0};    // unused handles evicted since creation
+    uint32_t relocationCount{0};  // handles moved by compaction since creation
+};
+
 class JointTexturePool : public RefCounted {
 public:
     JointTexturePool() = default;
@@ -108,14 +133,53 @@ public:
 
     void releaseSkeleton(Skeleton *skeleton);
 
+    /**
+     * @en
+     * Set the memory budget of all joint textures in bytes, 0 means unlimited.
+     * Textures no longer referenced are kept for reuse, and the least recently used ones
+     * are evicted when an allocation would exceed the budget. Referenced textures are never evicted.
+     * @zh
+     * 设置所有骨骼贴图的内存预算（字节），0 表示不限制。
+     * 不再被引用的贴图会被保留以便复用，当分配会超出预算时，优先淘汰最久未使用的贴图。被引用的贴图永远不会被淘汰。
+     */
+    void setMemoryBudget(uint32_t bytes);
+    inline uint32_t getMemoryBudget() const { return _memoryBudget; }
+
+    /**
+     * @en
+     * Evict all unused textures and move the live ones of the default pool into as few chunks as possible.
+     * Moved handles get a new pixelOffset and texture and their version increased,
+     * and their owners are rebound before the old textures are destroyed.
+     * Textures allocated from custom layouts keep their place.
+     * @zh
+     * 淘汰所有未使用的贴图，并将默认池中仍在使用的贴图重新紧凑地分配到尽量少的分块中。
+     * 被移动的句柄会获得新的 pixelOffset 与贴图，并且其 version 会增加，其持有者会在旧贴图销毁前重新绑定。自定义布局中分配的贴图保持不动。
+     * @return @en The number of moved handles. @zh 被移动的句柄数量。
+     */
+    uint32_t compact();
+
+    JointTexturePoolStats getStats() const;
+
     // void releaseAnimationClip (AnimationClip* clip); // TODO(xwx): AnimationClip not define
 
 private:
     // const IInternalJointAnimInfo &createAnimInfos(Skeleton *skeleton, AnimationClip *clip, Node *skinningRoot); // TODO(xwx): AnimationClip not define
 
+    IntrusivePtr<TextureBufferPool> createPool() const;
+    bool isCustomHandle(const IJointTextureHandle *handle) const;
+    void evictUnusedHandles(uint32_t requiredBytes);
+    void destroyHandle(IJointTextureHandle *handle);
+
     gfx::Device *_device{nullptr};
     IntrusivePtr<TextureBufferPool> _pool;
     ccstd::unordered_map<ccstd::hash_t, IJointTextureHandle *> _textureBuffers;
+    // all handles holding texture memory, including those no longer in _textureBuffers
+    ccstd::vector<IJointTextureHandle *> _allocatedHandles;
+    // unreferenced handles in least recently used order
+    ccstd::vector<IJointTextureHandle *> _unusedHandles;
+    uint32_t _memoryBudget{0};
+    uint32_t _evictionCount{0};
+    uint32_t _relocationCount{0};
     uint32_t _formatSize{0};
     uint32_t _pixelsPerJoint{0};
     IntrusivePtr<TextureBufferPool> _customPool;
@@ -569,6 +569,26 @@ void AudioEngine::addTask(const std::function<void()> &task) {
     }
 }
 
+void AudioEngine::setCacheMemoryBudget(uint64_t bytes) {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
+    lazyInit();
+    if (sAudioEngineImpl) {
+        sAudioEngineImpl->setCacheMemoryBudget(bytes);
+    }
+#else
+    CC_UNUSED_PARAM(bytes);
+#endif
+}
+
+AudioCacheStats AudioEngine::getCacheStats() {
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX
+    if (sAudioEngineImpl) {
+        return sAudioEngineImpl->getCacheStats();
+    }
+#endif
+    return {};
+}
+
 int AudioEngine::getPlayingAudioCount() {
     return static_cast<int>(sAudioIDInfoMap.size());
 }
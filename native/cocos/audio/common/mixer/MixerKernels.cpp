@@ -0,0 +1,275 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define USE_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+    #define USE_NEON
+    #include <arm_neon.h>
+#endif
+
+#include "audio/common/mixer/MixerKernels.h"
+
+#include "audio/common/utils/include/primitives.h"
+
+namespace cc {
+namespace mixer {
+
+namespace {
+constexpr float FRACTION_SCALE = 1.F / 4294967296.F;
+
+inline float fractionOf(uint64_t position) {
+    return static_cast<float>(position & 0xFFFFFFFFULL) * FRACTION_SCALE;
+}
+
+#if defined(USE_SSE2) || defined(USE_NEON)
+// top 24 bits of the fraction, exact in a float and positive as a signed integer
+constexpr float FRACTION_BITS_SCALE = 1.F / 16777216.F;
+
+inline int32_t fractionBits(uint64_t position) {
+    return static_cast<int32_t>((position & 0xFFFFFFFFULL) >> 8);
+}
+#endif
+
+#if defined(USE_NEON)
+inline int32x4_t roundToI32(float32x4_t value) {
+    #if defined(__aarch64__)
+    return vcvtnq_s32_f32(value);
+    #else
+    // ARMv7 has no rounding conversion, add 0.5 away from zero before truncating
+    const uint32x4_t negative = vcltq_f32(value, vdupq_n_f32(0.F));
+    const float32x4_t half = vbslq_f32(negative, vdupq_n_f32(-0.5F), vdupq_n_f32(0.5F));
+    return vcvtq_s32_f32(vaddq_f32(value, half));
+    #endif
+}
+#endif
+} // namespace
+
+void mixMonoToStereo(float *out, const float *in, uint32_t frames, float gainL, float gainR, float incL, float incR) {
+    uint32_t i = 0;
+#if defined(USE_SSE2)
+    // four mono frames fill two stereo vectors
+    __m128 gain0 = _mm_setr_ps(gainL, gainR, gainL + incL, gainR + incR);
+    __m128 gain1 = _mm_setr_ps(gainL + 2.F * incL, gainR + 2.F * incR, gainL + 3.F * incL, gainR + 3.F * incR);
+    const __m128 step = _mm_setr_ps(4.F * incL, 4.F * incR, 4.F * incL, 4.F * incR);
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 x = _mm_loadu_ps(in + i);
+        float *dst = out + 2 * i;
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_unpacklo_ps(x, x), gain0)));
+        _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_loadu_ps(dst + 4), _mm_mul_ps(_mm_unpackhi_ps(x, x), gain1)));
+        gain0 = _mm_add_ps(gain0, step);
+        gain1 = _mm_add_ps(gain1, step);
+    }
+#elif defined(USE_NEON)
+    float32x4_t gain0 = {gainL, gainR, gainL + incL, gainR + incR};
+    float32x4_t gain1 = {gainL + 2.F * incL, gainR + 2.F * incR, gainL + 3.F * incL, gainR + 3.F * incR};
+    const float32x4_t step = {4.F * incL, 4.F * incR, 4.F * incL, 4.F * incR};
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4_t x = vld1q_f32(in + i);
+        const float32x4x2_t xx = vzipq_f32(x, x);
+        float *dst = out + 2 * i;
+        vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), xx.val[0], gain0));
+        vst1q_f32(dst + 4, vmlaq_f32(vld1q_f32(dst + 4), xx.val[1], gain1));
+        gain0 = vaddq_f32(gain0, step);
+        gain1 = vaddq_f32(gain1, step);
+    }
+#endif
+    for (; i < frames; ++i) {
+        const float gl = gainL + static_cast<float>(i) * incL;
+        const float gr = gainR + static_cast<float>(i) * incR;
+        out[2 * i] += in[i] * gl;
+        out[2 * i + 1] += in[i] * gr;
+    }
+}
+
+void mixStereo(float *out, const float *in, uint32_t frames, float gainL, float gainR, float incL, float incR) {
+    uint32_t i = 0;
+#if defined(USE_SSE2)
+    // two stereo frames per vector
+    __m128 gain0 = _mm_setr_ps(gainL, gainR, gainL + incL, gainR + incR);
+    __m128 gain1 = _mm_setr_ps(gainL + 2.F * incL, gainR + 2.F * incR, gainL + 3.F * incL, gainR + 3.F * incR);
+    const __m128 step = _mm_setr_ps(4.F * incL, 4.F * incR, 4.F * incL, 4.F * incR);
+    for (; i + 4 <= frames; i += 4) {
+        const float *src = in + 2 * i;
+        float *dst = out + 2 * i;
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(_mm_loadu_ps(src), gain0)));
+        _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_loadu_ps(dst + 4), _mm_mul_ps(_mm_loadu_ps(src + 4), gain1)));
+        gain0 = _mm_add_ps(gain0, step);
+        gain1 = _mm_add_ps(gain1, step);
+    }
+#elif defined(USE_NEON)
+    float32x4_t gain0 = {gainL, gainR, gainL + incL, gainR + incR};
+    float32x4_t gain1 = {gainL + 2.F * incL, gainR + 2.F * incR, gainL + 3.F * incL, gainR + 3.F * incR};
+    const float32x4_t step = {4.F * incL, 4.F * incR, 4.F * incL, 4.F * incR};
+    for (; i + 4 <= frames; i += 4) {
+        const float *src = in + 2 * i;
+        float *dst = out + 2 * i;
+        vst1q_f32(dst, vmlaq_f32(vld1q_f32(dst), vld1q_f32(src), gain0));
+        vst1q_f32(dst + 4, vmlaq_f32(vld1q_f32(dst + 4), vld1q_f32(src + 4), gain1));
+        gain0 = vaddq_f32(gain0, step);
+        gain1 = vaddq_f32(gain1, step);
+    }
+#endif
+    for (; i < frames; ++i) {
+        const float gl = gainL + static_cast<float>(i) * incL;
+        const float gr = gainR + static_cast<float>(i) * incR;
+        out[2 * i] += in[2 * i] * gl;
+        out[2 * i + 1] += in[2 * i + 1] * gr;
+    }
+}
+
+uint32_t resampleLinear(float *out, uint32_t outFrames, const float *in, uint32_t inFrames, uint32_t channelCount, uint64_t *position, uint64_t step) {
+    uint64_t pos = *position;
+    uint32_t i = 0;
+    if (inFrames == 0) {
+        return 0;
+    }
+
+    if (channelCount == 1) {
+#if defined(USE_SSE2) || defined(USE_NEON)
+        // gather four neighbour pairs, interpolate them at once
+        for (; i + 4 <= outFrames && ((pos + 3 * step) >> 32) + 1 < inFrames; i += 4) {
+            const float *p0 = in + (pos >> 32);
+            const float *p1 = in + ((pos + step) >> 32);
+            const float *p2 = in + ((pos + 2 * step) >> 32);
+            const float *p3 = in + ((pos + 3 * step) >> 32);
+    #if defined(USE_SSE2)
+            const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(fractionBits(pos), fractionBits(pos + step),
+                                                                       fractionBits(pos + 2 * step), fractionBits(pos + 3 * step))),
+                                        _mm_set1_ps(FRACTION_BITS_SCALE));
+            const __m128 a = _mm_setr_ps(p0[0], p1[0], p2[0], p3[0]);
+            const __m128 b = _mm_setr_ps(p0[1], p1[1], p2[1], p3[1]);
+            _mm_storeu_ps(out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f)));
+    #else
+            const int32x4_t bits = {fractionBits(pos), fractionBits(pos + step), fractionBits(pos + 2 * step), fractionBits(pos + 3 * step)};
+            const float32x4_t f = vmulq_n_f32(vcvtq_f32_s32(bits), FRACTION_BITS_SCALE);
+            const float32x4_t a = {p0[0], p1[0], p2[0], p3[0]};
+            const float32x4_t b = {p0[1], p1[1], p2[1], p3[1]};
+            vst1q_f32(out + i, vmlaq_f32(a, vsubq_f32(b, a), f));
+    #endif
+            pos += 4 * step;
+        }
+#endif
+        for (; i < outFrames; ++i) {
+            const auto idx = static_cast<uint32_t>(pos >> 32);
+            if (idx >= inFrames) {
+                break;
+            }
+            const float a = in[idx];
+            const float b = idx + 1 < inFrames ? in[idx + 1] : a;
+            out[i] = a + (b - a) * fractionOf(pos);
+            pos += step;
+        }
+    } else {
+#if defined(USE_SSE2) || defined(USE_NEON)
+        // two stereo frames per vector, a frame and its neighbour are adjacent in memory
+        for (; i + 2 <= outFrames && ((pos + step) >> 32) + 1 < inFrames; i += 2) {
+            const float *p0 = in + 2 * (pos >> 32);
+            const float *p1 = in + 2 * ((pos + step) >> 32);
+            const int32_t f0 = fractionBits(pos);
+            const int32_t f1 = fractionBits(pos + step);
+    #if defined(USE_SSE2)
+            const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(f0, f0, f1, f1)), _mm_set1_ps(FRACTION_BITS_SCALE));
+            const __m128 x0 = _mm_loadu_ps(p0); // l0 r0 l0' r0'
+            const __m128 x1 = _mm_loadu_ps(p1);
+            const __m128 a = _mm_movelh_ps(x0, x1);
+            const __m128 b = _mm_movehl_ps(x1, x0);
+            _mm_storeu_ps(out + 2 * i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), f)));
+    #else
+            const int32x4_t bits = {f0, f0, f1, f1};
+            const float32x4_t f = vmulq_n_f32(vcvtq_f32_s32(bits), FRACTION_BITS_SCALE);
+            const float32x4_t x0 = vld1q_f32(p0);
+            const float32x4_t x1 = vld1q_f32(p1);
+            const float32x4_t a = vcombine_f32(vget_low_f32(x0), vget_low_f32(x1));
+            const float32x4_t b = vcombine_f32(vget_high_f32(x0), vget_high_f32(x1));
+            vst1q_f32(out + 2 * i, vmlaq_f32(a, vsubq_f32(b, a), f));
+    #endif
+            pos += 2 * step;
+        }
+#endif
+        for (; i < outFrames; ++i) {
+            const auto idx = static_cast<uint32_t>(pos >> 32);
+            if (idx >= inFrames) {
+                break;
+            }
+            const uint32_t next = idx + 1 < inFrames ? idx + 1 : idx;
+            const float fraction = fractionOf(pos);
+            out[2 * i] = in[2 * idx] + (in[2 * next] - in[2 * idx]) * fraction;
+            out[2 * i + 1] = in[2 * idx + 1] + (in[2 * next + 1] - in[2 * idx + 1]) * fraction;
+            pos += step;
+        }
+    }
+
+    *position = pos;
+    return i;
+}
+
+void convertFromI16(float *out, const int16_t *in, size_t count) {
+    size_t i = 0;
+#if defined(USE_SSE2)
+    const __m128 scale = _mm_set1_ps(1.F / 32768.F);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        // place each sample in the high half of a 32-bit lane, then shift back with sign extension
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(USE_NEON)
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t x = vld1q_s16(in + i);
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), 1.F / 32768.F));
+        vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), 1.F / 32768.F));
+    }
+#endif
+    memcpy_to_float_from_i16(out + i, in + i, count - i);
+}
+
+void convertToI16(int16_t *out, const float *in, size_t count) {
+    size_t i = 0;
+#if defined(USE_SSE2)
+    // cvtps rounds to nearest, packs saturates to the int16 range
+    const __m128 scale = _mm_set1_ps(32768.F);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+        const __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(lo, hi));
+    }
+#elif defined(USE_NEON)
+    // vcvtq truncates, round to nearest like the SSE2 and scalar paths
+    const float32x4_t scale = vdupq_n_f32(32768.F);
+    for (; i + 8 <= count; i += 8) {
+        const int32x4_t lo = roundToI32(vmulq_f32(vld1q_f32(in + i), scale));
+        const int32x4_t hi = roundToI32(vmulq_f32(vld1q_f32(in + i + 4), scale));
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+#endif
+    memcpy_to_i16_from_float(out + i, in + i, count - i);
+}
+
+} // namespace mixer
+} // namespace cc
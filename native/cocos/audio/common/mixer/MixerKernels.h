@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cc {
+namespace mixer {
+
+/**
+ * Platform neutral kernels of the software mixer, vectorized with SSE2 or NEON where available.
+ * Samples are 32-bit floats in [-1, 1], multi-channel data is interleaved.
+ */
+
+/**
+ * Accumulates mono input into interleaved stereo output. The gains start at gainL/gainR and
+ * change by incL/incR after every frame, which gives a linear volume ramp.
+ */
+void mixMonoToStereo(float *out, const float *in, uint32_t frames, float gainL, float gainR, float incL, float incR);
+
+/** Same as mixMonoToStereo for interleaved stereo input. */
+void mixStereo(float *out, const float *in, uint32_t frames, float gainL, float gainR, float incL, float incR);
+
+/**
+ * Linearly interpolating sample rate converter.
+ * position is the read position in 32.32 fixed point frames and advanced by step per output frame,
+ * step is (inputRate << 32) / outputRate. The frame after the last input frame repeats the last one.
+ * channelCount must be 1 or 2.
+ * @return The number of frames written, less than outFrames if the input ran out.
+ */
+uint32_t resampleLinear(float *out, uint32_t outFrames, const float *in, uint32_t inFrames, uint32_t channelCount, uint64_t *position, uint64_t step);
+
+/** Converts signed 16-bit samples to float. */
+void convertFromI16(float *out, const int16_t *in, size_t count);
+
+/** Converts float samples to signed 16-bit, clamping values outside [-1, 1]. */
+void convertToI16(int16_t *out, const float *in, size_t count);
+
+/** Number of frames resampleLinear reads from position for outFrames frames, including the interpolation neighbour. */
+inline uint32_t getResampleInputFrames(uint64_t position, uint64_t step, uint32_t outFrames) {
+    const uint64_t lastPosition = position + step * (outFrames > 0 ? outFrames - 1 : 0);
+    return static_cast<uint32_t>((lastPosition >> 32) - (position >> 32)) + 2;
+}
+
+} // namespace mixer
+} // namespace cc
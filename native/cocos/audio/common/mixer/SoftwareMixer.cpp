@@ -0,0 +1,260 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "audio/common/mixer/SoftwareMixer.h"
+#include <algorithm>
+#include <cstring>
+#include "audio/common/mixer/MixerKernels.h"
+
+namespace cc {
+
+SoftwareMixer::SoftwareMixer(uint32_t sampleRate)
+: _sampleRate(sampleRate) {
+    CC_ASSERT(sampleRate > 0);
+    _block.resize(BLOCK_FRAMES * OUTPUT_CHANNEL_COUNT);
+}
+
+int SoftwareMixer::addTrack(const TrackSource &source, bool loop) {
+    if (source.data == nullptr || source.frameCount == 0 || source.sampleRate == 0 ||
+        source.channelCount == 0 || source.channelCount > OUTPUT_CHANNEL_COUNT) {
+        return INVALID_TRACK;
+    }
+
+    int id = 0;
+    if (!_freeTracks.empty()) {
+        id = _freeTracks.back();
+        _freeTracks.pop_back();
+    } else {
+        id = static_cast<int>(_tracks.size());
+        _tracks.emplace_back();
+    }
+
+    Track &track = _tracks[id];
+    track = Track{};
+    track.source = source;
+    track.step = (static_cast<uint64_t>(source.sampleRate) << 32) / _sampleRate;
+    track.used = true;
+    track.loop = loop;
+    return id;
+}
+
+void SoftwareMixer::removeTrack(int track) {
+    if (Track *t = getTrack(track)) {
+        t->used = false;
+        _freeTracks.push_back(track);
+    }
+}
+
+void SoftwareMixer::removeAllTracks() {
+    _tracks.clear();
+    _freeTracks.clear();
+}
+
+void SoftwareMixer::setVolume(int track, float left, float right, uint32_t rampFrames) {
+    Track *t = getTrack(track);
+    if (t == nullptr) {
+        return;
+    }
+
+    t->targetVolume[0] = left;
+    t->targetVolume[1] = right;
+    if (rampFrames == 0) {
+        t->volume[0] = left;
+        t->volume[1] = right;
+        t->volumeInc[0] = 0.F;
+        t->volumeInc[1] = 0.F;
+        t->rampFramesLeft = 0;
+    } else {
+        t->volumeInc[0] = (left - t->volume[0]) / static_cast<float>(rampFrames);
+        t->volumeInc[1] = (right - t->volume[1]) / static_cast<float>(rampFrames);
+        t->rampFramesLeft = rampFrames;
+    }
+}
+
+void SoftwareMixer::setLoop(int track, bool loop) {
+    if (Track *t = getTrack(track)) {
+        t->loop = loop;
+    }
+}
+
+void SoftwareMixer::setPaused(int track, bool paused) {
+    if (Track *t = getTrack(track)) {
+        t->paused = paused;
+    }
+}
+
+void SoftwareMixer::setPosition(int track, uint32_t frame) {
+    if (Track *t = getTrack(track)) {
+        t->position = static_cast<uint64_t>(std::min(frame, t->source.frameCount)) << 32;
+        t->finished = false;
+    }
+}
+
+uint32_t SoftwareMixer::getPosition(int track) const {
+    const Track *t = getTrack(track);
+    return t != nullptr ? static_cast<uint32_t>(t->position >> 32) : 0;
+}
+
+bool SoftwareMixer::isFinished(int track) const {
+    const Track *t = getTrack(track);
+    return t == nullptr || t->finished;
+}
+
+uint32_t SoftwareMixer::getActiveTrackCount() const {
+    return static_cast<uint32_t>(std::count_if(_tracks.begin(), _tracks.end(), [](const Track &t) {
+        return t.used && !t.finished;
+    }));
+}
+
+void SoftwareMixer::render(float *out, uint32_t frameCount) {
+    memset(out, 0, sizeof(float) * frameCount * OUTPUT_CHANNEL_COUNT);
+    for (auto &track : _tracks) {
+        if (track.used && !track.paused && !track.finished) {
+            mixTrack(track, out, frameCount);
+        }
+    }
+}
+
+void SoftwareMixer::render(int16_t *out, uint32_t frameCount) {
+    _renderBuffer.resize(static_cast<size_t>(frameCount) * OUTPUT_CHANNEL_COUNT);
+    render(_renderBuffer.data(), frameCount);
+    mixer::convertToI16(out, _renderBuffer.data(), _renderBuffer.size());
+}
+
+SoftwareMixer::Track *SoftwareMixer::getTrack(int track) {
+    if (track < 0 || track >= static_cast<int>(_tracks.size()) || !_tracks[track].used) {
+        return nullptr;
+    }
+    return &_tracks[track];
+}
+
+const SoftwareMixer::Track *SoftwareMixer::getTrack(int track) const {
+    return const_cast<SoftwareMixer *>(this)->getTrack(track);
+}
+
+void SoftwareMixer::mixTrack(Track &track, float *out, uint32_t frameCount) {
+    constexpr uint64_t UNITY_STEP = 1ULL << 32;
+    const TrackSource &source = track.source;
+    uint32_t done = 0;
+    while (done < frameCount && !track.finished) {
+        const auto frame = static_cast<uint32_t>(track.position >> 32);
+        if (source.format == SampleFormat::FLOAT && track.step == UNITY_STEP && frame < source.frameCount) {
+            // float data at the mixer rate is mixed in place
+            const uint32_t count = std::min(frameCount - done, source.frameCount - frame);
+            applyVolume(track, out + done * OUTPUT_CHANNEL_COUNT, getSourceFrames(track, frame, count), count);
+            track.position += static_cast<uint64_t>(count) << 32;
+            done += count;
+            if (track.loop && frame + count == source.frameCount) {
+                track.position = 0;
+            }
+            continue;
+        }
+
+        const uint32_t count = std::min(BLOCK_FRAMES, frameCount - done);
+        const uint32_t read = readTrack(track, _block.data(), count);
+        applyVolume(track, out + done * OUTPUT_CHANNEL_COUNT, _block.data(), read);
+        done += read;
+    }
+}
+
+uint32_t SoftwareMixer::readTrack(Track &track, float *dst, uint32_t frameCount) {
+    const TrackSource &source = track.source;
+    const uint32_t channelCount = source.channelCount;
+    constexpr uint64_t UNITY_STEP = 1ULL << 32;
+
+    uint32_t produced = 0;
+    while (produced < frameCount) {
+        const auto frame = static_cast<uint32_t>(track.position >> 32);
+        if (frame >= source.frameCount) {
+            if (!track.loop) {
+                track.finished = true;
+                break;
+            }
+            track.position -= static_cast<uint64_t>(source.frameCount) << 32;
+            continue;
+        }
+
+        const uint32_t available = source.frameCount - frame;
+        if (track.step == UNITY_STEP) {
+            const uint32_t count = std::min(frameCount - produced, available);
+            memcpy(dst + produced * channelCount, getSourceFrames(track, frame, count), sizeof(float) * count * channelCount);
+            track.position += static_cast<uint64_t>(count) << 32;
+            produced += count;
+        } else {
+            const uint32_t wanted = frameCount - produced;
+            const uint32_t inFrames = std::min(mixer::getResampleInputFrames(track.position, track.step, wanted), available);
+            // resample relative to the first frame of the window
+            uint64_t position = track.position & 0xFFFFFFFFULL;
+            produced += mixer::resampleLinear(dst + produced * channelCount, wanted, getSourceFrames(track, frame, inFrames),
+                                              inFrames, channelCount, &position, track.step);
+            track.position = (static_cast<uint64_t>(frame) << 32) + position;
+        }
+    }
+
+    // keep the position of a looping track inside the source
+    while (track.loop && (track.position >> 32) >= source.frameCount) {
+        track.position -= static_cast<uint64_t>(source.frameCount) << 32;
+    }
+    return produced;
+}
+
+const float *SoftwareMixer::getSourceFrames(const Track &track, uint32_t first, uint32_t count) {
+    const TrackSource &source = track.source;
+    const size_t offset = static_cast<size_t>(first) * source.channelCount;
+    if (source.format == SampleFormat::FLOAT) {
+        return static_cast<const float *>(source.data) + offset;
+    }
+
+    const size_t sampleCount = static_cast<size_t>(count) * source.channelCount;
+    if (_convertBuffer.size() < sampleCount) {
+        _convertBuffer.resize(sampleCount);
+    }
+    mixer::convertFromI16(_convertBuffer.data(), static_cast<const int16_t *>(source.data) + offset, sampleCount);
+    return _convertBuffer.data();
+}
+
+void SoftwareMixer::applyVolume(Track &track, float *out, const float *in, uint32_t frameCount) {
+    const auto mix = track.source.channelCount == 1 ? mixer::mixMonoToStereo : mixer::mixStereo;
+    const uint32_t channelCount = track.source.channelCount;
+
+    const uint32_t rampFrames = std::min(frameCount, track.rampFramesLeft);
+    if (rampFrames > 0) {
+        mix(out, in, rampFrames, track.volume[0], track.volume[1], track.volumeInc[0], track.volumeInc[1]);
+        track.rampFramesLeft -= rampFrames;
+        for (uint32_t c = 0; c < OUTPUT_CHANNEL_COUNT; ++c) {
+            track.volume[c] = track.rampFramesLeft == 0 ? track.targetVolume[c] : track.volume[c] + track.volumeInc[c] * static_cast<float>(rampFrames);
+            if (track.rampFramesLeft == 0) {
+                track.volumeInc[c] = 0.F;
+            }
+        }
+    }
+
+    const uint32_t rest = frameCount - rampFrames;
+    if (rest > 0 && (track.volume[0] != 0.F || track.volume[1] != 0.F)) {
+        mix(out + rampFrames * OUTPUT_CHANNEL_COUNT, in + rampFrames * channelCount, rest, track.volume[0], track.volume[1], 0.F, 0.F);
+    }
+}
+
+} // namespace cc
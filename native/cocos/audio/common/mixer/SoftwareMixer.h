@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * @brief A platform neutral software mixer that renders any number of PCM tracks into one
+ * interleaved stereo float buffer. It resamples tracks to the mixer's sample rate and applies
+ * per-channel volume with linear ramps, using the SIMD kernels in MixerKernels.h.
+ * Rendering doesn't need an audio device, so it can run offline or headless.
+ * @note Not thread safe, tracks must be set up on the thread that calls render().
+ */
+class CC_DLL SoftwareMixer final {
+public:
+    enum class SampleFormat : uint8_t {
+        I16,
+        FLOAT,
+    };
+
+    /** PCM data of a track, interleaved. The mixer doesn't copy it, it must outlive the track. */
+    struct TrackSource {
+        const void *data{nullptr};
+        uint32_t frameCount{0};
+        uint32_t channelCount{1};
+        uint32_t sampleRate{0};
+        SampleFormat format{SampleFormat::I16};
+    };
+
+    static constexpr int INVALID_TRACK = -1;
+    static constexpr uint32_t OUTPUT_CHANNEL_COUNT = 2;
+
+    explicit SoftwareMixer(uint32_t sampleRate);
+    ~SoftwareMixer() = default;
+
+    /**
+     * @brief Adds a mono or stereo track that starts playing from its first frame at the next render.
+     * @return The track id, or INVALID_TRACK if the source is invalid.
+     */
+    int addTrack(const TrackSource &source, bool loop = false);
+    void removeTrack(int track);
+    void removeAllTracks();
+
+    /**
+     * @brief Sets the volume of the left and right output channel.
+     * @param rampFrames The number of output frames to linearly move from the current volume to the new one, 0 to change it immediately.
+     */
+    void setVolume(int track, float left, float right, uint32_t rampFrames = 0);
+    void setLoop(int track, bool loop);
+    void setPaused(int track, bool paused);
+    /** Sets the playback position of the track in its own frames. */
+    void setPosition(int track, uint32_t frame);
+    uint32_t getPosition(int track) const;
+    /** A non-looping track is finished once all its frames are rendered. Finished tracks stay allocated until removed. */
+    bool isFinished(int track) const;
+    uint32_t getActiveTrackCount() const;
+
+    /** Mixes the next frameCount frames of all tracks into out, which holds frameCount * OUTPUT_CHANNEL_COUNT floats. */
+    void render(float *out, uint32_t frameCount);
+    /** Same as render(float *, uint32_t), clamped to signed 16-bit samples. */
+    void render(int16_t *out, uint32_t frameCount);
+
+    inline uint32_t getSampleRate() const { return _sampleRate; }
+
+private:
+    struct Track {
+        TrackSource source;
+        uint64_t position{0}; // 32.32 fixed point frames
+        uint64_t step{0};     // (source rate << 32) / mixer rate
+        float volume[OUTPUT_CHANNEL_COUNT]{1.F, 1.F};
+        float volumeInc[OUTPUT_CHANNEL_COUNT]{0.F, 0.F};
+        float targetVolume[OUTPUT_CHANNEL_COUNT]{1.F, 1.F};
+        uint32_t rampFramesLeft{0};
+        bool used{false};
+        bool loop{false};
+        bool paused{false};
+        bool finished{false};
+    };
+
+    static constexpr uint32_t BLOCK_FRAMES = 256;
+
+    Track *getTrack(int track);
+    const Track *getTrack(int track) const;
+    void mixTrack(Track &track, float *out, uint32_t frameCount);
+    uint32_t readTrack(Track &track, float *dst, uint32_t frameCount);
+    const float *getSourceFrames(const Track &track, uint32_t first, uint32_t count);
+    void applyVolume(Track &track, float *out, const float *in, uint32_t frameCount);
+
+    uint32_t _sampleRate{0};
+    ccstd::vector<Track> _tracks;
+    ccstd::vector<int> _freeTracks;
+    ccstd::vector<float> _block;
+    ccstd::vector<float> _convertBuffer;
+    ccstd::vector<float> _renderBuffer;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(SoftwareMixer);
+};
+
+} // namespace cc
@@ -15,6 +15,7 @@
  */
 
 #include "audio/common/utils/include/primitives.h"
+#include <cstring>
 #include "audio/common/utils/private/private.h"
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #include "audio/android/cutils/bitops.h" /* for popcount() */
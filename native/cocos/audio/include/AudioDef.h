@@ -44,3 +44,17 @@ struct PCMHeader {
     uint32_t channelCount{0};
     AudioDataFormat dataFormat{AudioDataFormat::UNKNOWN};
 };
+
+/**
+ * Statistics of the decoded PCM cache, only collected on platforms whose AudioEngine keeps one (oalsoft).
+ */
+struct AudioCacheStats {
+    uint32_t hits{0};
+    uint32_t misses{0};
+    uint32_t evictions{0};
+    uint64_t evictedBytes{0};
+    // decoded bytes currently held by cached sounds
+    uint64_t memoryUsage{0};
+    // 0 means unlimited
+    uint64_t memoryBudget{0};
+};
@@ -300,6 +300,19 @@ public:
      */
     static void preload(const ccstd::string &filePath, const std::function<void(bool isSuccess)> &callback);
 
+    /**
+     * Sets the memory budget in bytes of the decoded audio cache, 0 for unlimited.
+     * When the budget is exceeded, the least recently used sounds that aren't playing are uncached
+     * and decoded again the next time they are played.
+     * @note Only the oalsoft platforms (Windows, Linux, OHOS, QNX) cache decoded audio.
+     */
+    static void setCacheMemoryBudget(uint64_t bytes);
+
+    /**
+     * Gets the hit, miss and eviction statistics of the decoded audio cache.
+     */
+    static AudioCacheStats getCacheStats();
+
     /**
      * Gets playing audio count.
      */
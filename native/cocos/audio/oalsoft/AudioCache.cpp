@@ -75,6 +75,10 @@ AudioCache::~AudioCache() {
     _readDataTaskMutex.lock();
     _readDataTaskMutex.unlock();
 
+    if (_memoryUsageCounter != nullptr) {
+        _memoryUsageCounter->fetch_sub(_accountedMemorySize, std::memory_order_relaxed);
+    }
+
     if (_pcmData) {
         if (_state == State::READY) {
             if (_alBufferId != INVALID_AL_BUFFER_ID && alIsBuffer(_alBufferId)) {
@@ -250,6 +254,11 @@ void AudioCache::readDataTask(unsigned int selfId) {
         }
     }
 
+    if (_memoryUsageCounter != nullptr) {
+        _accountedMemorySize = getMemorySize();
+        _memoryUsageCounter->fetch_add(_accountedMemorySize, std::memory_order_relaxed);
+    }
+
     //IDEA: Why to invoke play callback first? Should it be after 'load' callback?
     invokingPlayCallbacks();
     invokingLoadCallbacks();
@@ -259,6 +268,14 @@ void AudioCache::readDataTask(unsigned int selfId) {
     ALOGVV("readDataTask end, cache id=%u", selfId);
 }
 
+size_t AudioCache::getMemorySize() const {
+    size_t size = _pcmData != nullptr ? static_cast<size_t>(_totalFrames) * _bytesPerFrame : 0;
+    for (auto bufferSize : _queBufferSize) {
+        size += static_cast<size_t>(bufferSize);
+    }
+    return size;
+}
+
 void AudioCache::addPlayCallback(const std::function<void()> &callback) {
     std::lock_guard<std::mutex> lk(_playCallbackMutex);
     switch (_state) {
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <sys/types.h>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -65,6 +66,8 @@ public:
 
     uint32_t getChannelCount() const { return _channelCount; }
     bool isStreaming() const { return _isStreaming; }
+    // bytes of decoded pcm data held by the cache
+    size_t getMemorySize() const;
 
 protected:
     void setSkipReadDataTask(bool isSkip) { _isSkipReadDataTask = isSkip; };
@@ -114,8 +117,17 @@ protected:
     bool _isLoadingFinished{false};
     bool _isSkipReadDataTask{false};
 
+    // LRU eviction related stuff, only accessed in Cocos thread.
+    // Players pin the cache they play from, pinned caches are never evicted.
+    uint32_t _pinCount{0};
+    uint64_t _lastUseStamp{0};
+    // Running usage of the engine, the size is added when loading finishes and removed on destruction.
+    std::atomic<uint64_t> *_memoryUsageCounter{nullptr};
+    size_t _accountedMemorySize{0};
+
     friend class AudioEngineImpl;
     friend class AudioPlayer;
+    friend class AudioStreamer;
 };
 
 } // namespace cc
@@ -125,9 +125,13 @@ using namespace cc; //NOLINT
 static ALCdevice *sALDevice = nullptr;
 static ALCcontext *sALContext = nullptr;
 
+// decoded pcm kept in the cache before the least recently used sounds are uncached
+static constexpr uint64_t DEFAULT_CACHE_MEMORY_BUDGET = 64ULL * 1024 * 1024;
+
 AudioEngineImpl::AudioEngineImpl()
 : _lazyInitLoop(true),
   _currentAudioID(0) {
+    _cacheStats.memoryBudget = DEFAULT_CACHE_MEMORY_BUDGET;
 }
 
 AudioEngineImpl::~AudioEngineImpl() {
@@ -135,6 +139,8 @@ AudioEngineImpl::~AudioEngineImpl() {
         sche->unschedule("AudioEngine", this);
     }
 
+    _streamer.stop();
+
     if (sALContext) {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
 
@@ -174,8 +180,12 @@ bool AudioEngineImpl::init() {
                 _alSourceUsed[src] = false;
             }
 
-            _scheduler = CC_CURRENT_ENGINE()->getScheduler();
+            // there is no application in the unit tests, nothing is scheduled then
+            if (CC_CURRENT_APPLICATION()) {
+                _scheduler = CC_CURRENT_ENGINE()->getScheduler();
+            }
             ret = AudioDecoderManager::init();
+            _streamer.start();
             CC_LOG_DEBUG("OpenAL was initialized successfully!");
         }
     } while (false);
@@ -186,9 +196,15 @@ bool AudioEngineImpl::init() {
 AudioCache *AudioEngineImpl::preload(const ccstd::string &filePath, const std::function<void(bool)> &callback) {
     AudioCache *audioCache = nullptr;
 
+    // Evict before looking up, the returned cache must stay alive until its player pins it.
+    _isCacheEvictionDirty = true;
+    evictCaches();
+
     auto it = _audioCaches.find(filePath);
     if (it == _audioCaches.end()) {
+        ++_cacheStats.misses;
         audioCache = &_audioCaches[filePath];
+        audioCache->_memoryUsageCounter = &_cacheMemoryUsage;
         audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
         unsigned int cacheId = audioCache->_id;
         auto isCacheDestroyed = audioCache->_isDestroyed;
@@ -201,8 +217,10 @@ AudioCache *AudioEngineImpl::preload(const ccstd::string &filePath, const std::f
             audioCache->readDataTask(cacheId);
         });
     } else {
+        ++_cacheStats.hits;
         audioCache = &it->second;
     }
+    audioCache->_lastUseStamp = ++_cacheUseStamp;
 
     if (audioCache && callback) {
         audioCache->addLoadCallback(callback);
@@ -237,6 +255,7 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
     player->_alSource = alSource;
     player->_loop = loop;
     player->_volume = volume;
+    player->_streamer = &_streamer;
 
     auto audioCache = preload(filePath, nullptr);
     if (audioCache == nullptr) {
@@ -245,6 +264,7 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
     }
 
     player->setCache(audioCache);
+    ++audioCache->_pinCount;
     _threadMutex.lock();
     _audioPlayers[_currentAudioID] = player;
     _threadMutex.unlock();
@@ -480,6 +500,13 @@ void AudioEngineImpl::setFinishCallback(int audioID, const std::function<void(in
     _audioPlayers[audioID]->_finishCallbak = callback;
 }
 
+uint32_t AudioEngineImpl::getUnderrunCount(int audioID) {
+    if (!checkAudioIdValid(audioID)) {
+        return 0;
+    }
+    return _audioPlayers[audioID]->getUnderrunCount();
+}
+
 void AudioEngineImpl::update(float /*dt*/) {
     ALint sourceState;
     int audioID;
@@ -499,9 +526,10 @@ void AudioEngineImpl::update(float /*dt*/) {
             _threadMutex.lock();
             it = _audioPlayers.erase(it);
             _threadMutex.unlock();
-            delete player;
+            releasePlayer(player);
             _alSourceUsed[alSource] = false;
-        } else if (player->_ready && sourceState == AL_STOPPED) {
+        } else if (player->_ready && sourceState == AL_STOPPED && (!player->_streamingSource || player->_isStreamEnded)) {
+            // A streaming source also stops when it runs dry, the streamer restarts it until the stream has ended.
             ccstd::string filePath;
             if (player->_finishCallbak) {
                 auto &audioInfo = AudioEngine::sAudioIDInfoMap[audioID];
@@ -517,13 +545,15 @@ void AudioEngineImpl::update(float /*dt*/) {
             if (player->_finishCallbak) {
                 player->_finishCallbak(audioID, filePath); //IDEA: callback will delay 50ms
             }
-            delete player;
+            releasePlayer(player);
             _alSourceUsed[alSource] = false;
         } else {
             ++it;
         }
     }
 
+    evictCaches();
+
     if (_audioPlayers.empty()) {
         _lazyInitLoop = true;
         if (auto sche = _scheduler.lock()) {
@@ -540,6 +570,62 @@ void AudioEngineImpl::uncacheAll() {
     _audioCaches.clear();
 }
 
+void AudioEngineImpl::setCacheMemoryBudget(uint64_t bytes) {
+    _cacheStats.memoryBudget = bytes;
+    _isCacheEvictionDirty = true;
+    evictCaches();
+}
+
+AudioCacheStats AudioEngineImpl::getCacheStats() const {
+    AudioCacheStats stats = _cacheStats;
+    stats.memoryUsage = _cacheMemoryUsage.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AudioEngineImpl::releasePlayer(AudioPlayer *player) {
+    if (player->_audioCache != nullptr) {
+        --player->_audioCache->_pinCount;
+        _isCacheEvictionDirty = true;
+    }
+    delete player;
+}
+
+void AudioEngineImpl::evictCaches() {
+    const uint64_t memoryUsage = _cacheMemoryUsage.load(std::memory_order_relaxed);
+    if (_cacheStats.memoryBudget == 0 || memoryUsage <= _cacheStats.memoryBudget) {
+        return;
+    }
+    // Nothing was loaded or released since the last pass failed to get under the budget.
+    if (!_isCacheEvictionDirty && memoryUsage == _unevictableMemoryUsage) {
+        return;
+    }
+    _isCacheEvictionDirty = false;
+
+    ccstd::vector<std::pair<uint64_t, const ccstd::string *>> candidates;
+    for (const auto &item : _audioCaches) {
+        const AudioCache &cache = item.second;
+        // Caches that are loading, playing or whose preload callbacks are pending stay.
+        if (cache._isLoadingFinished && cache._pinCount == 0 && cache._loadCallbacks.empty()) {
+            candidates.emplace_back(cache._lastUseStamp, &item.first);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto &candidate : candidates) {
+        if (_cacheMemoryUsage.load(std::memory_order_relaxed) <= _cacheStats.memoryBudget) {
+            break;
+        }
+        auto it = _audioCaches.find(*candidate.second);
+        const uint64_t size = it->second._accountedMemorySize;
+        ALOGV("evict audio cache %s, %u bytes", candidate.second->c_str(), static_cast<uint32_t>(size));
+        _cacheStats.evictedBytes += size;
+        ++_cacheStats.evictions;
+        // the destructor takes the size off _cacheMemoryUsage
+        _audioCaches.erase(it);
+    }
+    _unevictableMemoryUsage = _cacheMemoryUsage.load(std::memory_order_relaxed);
+}
+
 bool AudioEngineImpl::checkAudioIdValid(int audioID) {
     return _audioPlayers.find(audioID) != _audioPlayers.end();
 }
@@ -29,6 +29,7 @@
 #include "audio/include/AudioDef.h"
 #include "audio/oalsoft/AudioCache.h"
 #include "audio/oalsoft/AudioPlayer.h"
+#include "audio/oalsoft/AudioStreamer.h"
 #include "base/std/container/unordered_map.h"
 #include "cocos/base/RefCounted.h"
 #include "cocos/base/std/any.h"
@@ -60,27 +61,46 @@ public:
 
     void uncache(const ccstd::string &filePath);
     void uncacheAll();
+    void setCacheMemoryBudget(uint64_t bytes);
+    AudioCacheStats getCacheStats() const;
     AudioCache *preload(const ccstd::string &filePath, const std::function<void(bool)> &callback);
     void update(float dt);
     PCMHeader getPCMHeader(const char *url);
     ccstd::vector<uint8_t> getOriginalPCMBuffer(const char *url, uint32_t channelID);
+    // number of times the streaming source of audioID ran dry and was restarted
+    uint32_t getUnderrunCount(int audioID);
+    // underruns summed over all streamed sounds played so far
+    uint32_t getTotalUnderrunCount() const { return _streamer.getUnderrunCount(); }
 
 private:
     bool checkAudioIdValid(int audioID);
     void play2dImpl(AudioCache *cache, int audioID);
+    void releasePlayer(AudioPlayer *player);
+    void evictCaches();
 
     ALuint _alSources[MAX_AUDIOINSTANCES];
 
     //source,used
     ccstd::unordered_map<ALuint, bool> _alSourceUsed;
 
+    // decoded bytes of the loaded caches, declared before _audioCaches so it outlives them
+    std::atomic<uint64_t> _cacheMemoryUsage{0};
+    // usage left by the last eviction pass that could not get under the budget
+    uint64_t _unevictableMemoryUsage{0};
+    bool _isCacheEvictionDirty{false};
+
     //filePath,bufferInfo
     ccstd::unordered_map<ccstd::string, AudioCache> _audioCaches;
+    uint64_t _cacheUseStamp{0};
+    AudioCacheStats _cacheStats;
 
     //audioID,AudioInfo
     ccstd::unordered_map<int, AudioPlayer *> _audioPlayers;
     std::mutex _threadMutex;
 
+    // refills the buffer queues of all streaming players
+    AudioStreamer _streamer;
+
     bool _lazyInitLoop;
 
     int _currentAudioID;
@@ -26,13 +26,13 @@
 #define LOG_TAG "AudioPlayer"
 
 #include "audio/oalsoft/AudioPlayer.h"
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
-#include "audio/common/decoder/AudioDecoder.h"
-#include "audio/common/decoder/AudioDecoderManager.h"
+#include <thread>
 #include "audio/oalsoft/AudioCache.h"
+#include "audio/oalsoft/AudioStreamer.h"
 #include "base/Log.h"
-#include "base/memory/Memory.h"
 
 using namespace cc; // NOLINT
 
@@ -48,9 +48,12 @@ AudioPlayer::AudioPlayer()
   _ready(false),
   _currTime(0.0F),
   _streamingSource(false),
-  _rotateBufferThread(nullptr),
+  _streamer(nullptr),
   _timeDirty(false),
-  _isRotateThreadExited(false),
+  _isStreamEnded(false),
+  _isStreamAdded(false),
+  _isStreamReleased(false),
+  _underrunCount(0),
   _id(++gIdIndex) {
     memset(_bufferIds, 0, sizeof(_bufferIds));
 }
@@ -89,21 +92,12 @@ void AudioPlayer::destroy() {
         _play2dMutex.lock();
         _play2dMutex.unlock();
 
-        if (_streamingSource) {
-            if (_rotateBufferThread != nullptr) {
-                while (!_isRotateThreadExited) {
-                    _sleepCondition.notify_one();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-                }
-
-                if (_rotateBufferThread->joinable()) {
-                    _rotateBufferThread->join();
-                }
-
-                delete _rotateBufferThread;
-                _rotateBufferThread = nullptr;
-                CC_LOG_DEBUG("rotateBufferThread exited!");
+        if (_streamingSource && !_isStreamReleased && _streamer != nullptr) {
+            _streamer->removeVoice(this);
+            while (!_isStreamReleased) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
+            CC_LOG_DEBUG("streaming voice released!");
         }
     } while (false);
 
@@ -172,25 +166,25 @@ bool AudioPlayer::play2d() {
             _streamingSource = true;
         }
 
-        {
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed) {
-                break;
-            }
+        if (_isDestroyed) {
+            break;
+        }
 
-            if (_streamingSource) {
-                alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
-                CHECK_AL_ERROR_DEBUG();
-                _rotateBufferThread = ccnew std::thread(&AudioPlayer::rotateBufferThread, this,
-                                                        _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1);
-            } else {
-                alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
-                CHECK_AL_ERROR_DEBUG();
+        if (_streamingSource) {
+            alSourceQueueBuffers(_alSource, QUEUEBUFFER_NUM, _bufferIds);
+            CHECK_AL_ERROR_DEBUG();
+            if (_streamer == nullptr || !_streamer->addVoice(this, _audioCache->_queBufferFrames * QUEUEBUFFER_NUM + 1)) {
+                ALOGE("%s: audio streamer isn't running, player id=%u", __FUNCTION__, _id);
+                _isStreamReleased = true;
+                break;
             }
-
-            alSourcePlay(_alSource);
+        } else {
+            alSourcei(_alSource, AL_BUFFER, _audioCache->_alBufferId);
+            CHECK_AL_ERROR_DEBUG();
         }
 
+        alSourcePlay(_alSource);
+
         auto alError = alGetError();
         if (alError != AL_NO_ERROR) {
             ALOGE("%s:alSourcePlay error code:%x", __FUNCTION__, alError);
@@ -217,87 +211,6 @@ bool AudioPlayer::play2d() {
     return ret;
 }
 
-void AudioPlayer::rotateBufferThread(int offsetFrame) {
-    char *tmpBuffer = nullptr;
-    AudioDecoder *decoder = AudioDecoderManager::createDecoder(_audioCache->_fileFullPath.c_str());
-    do {
-        BREAK_IF(decoder == nullptr || !decoder->open(_audioCache->_fileFullPath.c_str()));
-
-        uint32_t framesRead = 0;
-        const uint32_t framesToRead = _audioCache->_queBufferFrames;
-        const uint32_t bufferSize = framesToRead * decoder->getBytesPerFrame();
-        tmpBuffer = static_cast<char *>(malloc(bufferSize));
-        memset(tmpBuffer, 0, bufferSize);
-
-        if (offsetFrame != 0) {
-            decoder->seek(offsetFrame);
-        }
-
-        ALint sourceState;
-        ALint bufferProcessed = 0;
-        bool needToExitThread = false;
-
-        while (!_isDestroyed) {
-            alGetSourcei(_alSource, AL_SOURCE_STATE, &sourceState);
-            if (sourceState == AL_PLAYING) {
-                alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
-                while (bufferProcessed > 0) {
-                    bufferProcessed--;
-                    if (_timeDirty) {
-                        _timeDirty = false;
-                        offsetFrame = static_cast<int>(_currTime * decoder->getSampleRate());
-                        decoder->seek(offsetFrame);
-                    } else {
-                        _currTime += QUEUEBUFFER_TIME_STEP;
-                        if (_currTime > _audioCache->_duration) {
-                            if (_loop) {
-                                _currTime = 0.0F;
-                            } else {
-                                _currTime = _audioCache->_duration;
-                            }
-                        }
-                    }
-
-                    framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-
-                    if (framesRead == 0) {
-                        if (_loop) {
-                            decoder->seek(0);
-                            framesRead = decoder->readFixedFrames(framesToRead, tmpBuffer);
-                        } else {
-                            needToExitThread = true;
-                            break;
-                        }
-                    }
-
-                    ALuint bid;
-                    alSourceUnqueueBuffers(_alSource, 1, &bid);
-                    alBufferData(bid, _audioCache->_format, tmpBuffer, framesRead * decoder->getBytesPerFrame(),
-                                 decoder->getSampleRate());
-                    alSourceQueueBuffers(_alSource, 1, &bid);
-                }
-            }
-
-            std::unique_lock<std::mutex> lk(_sleepMutex);
-            if (_isDestroyed || needToExitThread) {
-                break;
-            }
-
-            _sleepCondition.wait_for(lk, std::chrono::milliseconds(75));
-        }
-
-    } while (false);
-
-    CC_LOG_INFO("Exit rotate buffer thread ...");
-    if (decoder != nullptr) {
-        decoder->close();
-    }
-    AudioDecoderManager::destroyDecoder(decoder);
-    free(tmpBuffer);
-    _isRotateThreadExited = true;
-    CC_LOG_INFO("%s exited.\n", __FUNCTION__);
-}
-
 bool AudioPlayer::setLoop(bool loop) {
     if (!_isDestroyed) {
         _loop = loop;
@@ -25,10 +25,9 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <atomic>
 #include <functional>
 #include <mutex>
-#include <thread>
 #include "base/std/container/string.h"
 #ifdef OPENAL_PLAIN_INCLUDES
     #include <al.h>
@@ -45,6 +44,7 @@ namespace cc {
 
 class AudioCache;
 class AudioEngineImpl;
+class AudioStreamer;
 
 class CC_DLL AudioPlayer {
 public:
@@ -57,38 +57,42 @@ public:
     bool setTime(float time);
     float getTime() { return _currTime; }
     bool setLoop(bool loop);
+    // number of times the streaming source ran dry and was restarted
+    uint32_t getUnderrunCount() const { return _underrunCount; }
 
 protected:
     void setCache(AudioCache *cache);
-    void rotateBufferThread(int offsetFrame);
     bool play2d();
 
     AudioCache *_audioCache;
 
     float _volume;
-    bool _loop;
+    std::atomic<bool> _loop;
     std::function<void(int, const ccstd::string &)> _finishCallbak;
 
-    bool _isDestroyed;
+    std::atomic<bool> _isDestroyed;
     bool _removeByAudioEngine;
     bool _ready;
     ALuint _alSource;
 
-    //play by circular buffer
-    float _currTime;
+    //play by circular buffer, refilled by the streamer
+    std::atomic<float> _currTime;
     bool _streamingSource;
     ALuint _bufferIds[3];
-    std::thread *_rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
-    bool _timeDirty;
-    bool _isRotateThreadExited;
+    AudioStreamer *_streamer;
+    std::atomic<bool> _timeDirty;
+    std::atomic<bool> _isStreamEnded;
+    // set before the streamer command that registers the voice is enqueued
+    std::atomic<bool> _isStreamAdded;
+    std::atomic<bool> _isStreamReleased;
+    std::atomic<uint32_t> _underrunCount;
 
     std::mutex _play2dMutex;
 
     unsigned int _id;
 
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 };
 
 } // namespace cc
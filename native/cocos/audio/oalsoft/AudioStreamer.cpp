@@ -0,0 +1,261 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#define LOG_TAG "AudioStreamer"
+
+#include "audio/oalsoft/AudioStreamer.h"
+#include <algorithm>
+#include "audio/common/decoder/AudioDecoder.h"
+#include "audio/common/decoder/AudioDecoderManager.h"
+#include "audio/oalsoft/AudioCache.h"
+#include "audio/oalsoft/AudioPlayer.h"
+#include "base/Log.h"
+
+namespace cc {
+
+namespace {
+// Service a voice slightly after its current buffer is due so that OpenAL has marked it as processed.
+constexpr std::chrono::milliseconds DEADLINE_SLACK{2};
+} // namespace
+
+AudioStreamer::~AudioStreamer() {
+    stop();
+}
+
+void AudioStreamer::start() {
+    if (_running.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    _thread = std::thread(&AudioStreamer::threadLoop, this);
+}
+
+void AudioStreamer::stop() {
+    if (!_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    _wakeUp.signal();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    // Release the voices registered while the thread was shutting down.
+    processCommands();
+    for (auto &voice : _voices) {
+        releaseVoice(voice);
+    }
+    _voices.clear();
+    for (auto *player : _pendingRemovals) {
+        player->_isStreamReleased.store(true, std::memory_order_release);
+    }
+    _pendingRemovals.clear();
+}
+
+bool AudioStreamer::addVoice(AudioPlayer *player, uint32_t offsetFrame) {
+    if (!isRunning()) {
+        return false;
+    }
+    player->_isStreamAdded.store(true, std::memory_order_release);
+    _commands.enqueue({CommandType::ADD, player, offsetFrame});
+    _wakeUp.signal();
+    return true;
+}
+
+void AudioStreamer::removeVoice(AudioPlayer *player) {
+    _commands.enqueue({CommandType::REMOVE, player, 0});
+    _wakeUp.signal();
+}
+
+void AudioStreamer::threadLoop() {
+    while (_running.load(std::memory_order_acquire)) {
+        processCommands();
+
+        auto now = Clock::now();
+        auto nextDeadline = Clock::time_point::max();
+        for (auto &voice : _voices) {
+            if (voice.deadline <= now) {
+                serviceVoice(voice, now);
+            }
+            nextDeadline = std::min(nextDeadline, voice.deadline);
+        }
+
+        if (nextDeadline == Clock::time_point::max()) {
+            _wakeUp.wait();
+        } else {
+            auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(nextDeadline - Clock::now()).count();
+            if (timeout > 0) {
+                _wakeUp.wait(timeout);
+            }
+        }
+    }
+
+    for (auto &voice : _voices) {
+        releaseVoice(voice);
+    }
+    _voices.clear();
+}
+
+void AudioStreamer::processCommands() {
+    Command command;
+    while (_commands.try_dequeue(command)) {
+        if (command.type == CommandType::ADD) {
+            auto pending = std::find(_pendingRemovals.begin(), _pendingRemovals.end(), command.player);
+            if (pending != _pendingRemovals.end()) {
+                // The player was destroyed before its voice was registered.
+                *pending = _pendingRemovals.back();
+                _pendingRemovals.pop_back();
+                command.player->_isStreamReleased.store(true, std::memory_order_release);
+                continue;
+            }
+            Voice voice;
+            voice.player = command.player;
+            if (!openVoice(voice, command.offsetFrame)) {
+                // Let the source play out the buffers it already has.
+                voice.ended = true;
+                voice.deadline = Clock::time_point::max();
+                command.player->_isStreamEnded.store(true, std::memory_order_release);
+            }
+            _voices.emplace_back(std::move(voice));
+        } else {
+            processRemove(command.player);
+        }
+    }
+}
+
+void AudioStreamer::processRemove(AudioPlayer *player) {
+    auto iter = std::find_if(_voices.begin(), _voices.end(), [&](const Voice &voice) {
+        return voice.player == player;
+    });
+    if (iter != _voices.end()) {
+        releaseVoice(*iter);
+        *iter = std::move(_voices.back());
+        _voices.pop_back();
+    } else if (player->_isStreamAdded.load(std::memory_order_acquire)) {
+        // ADD was enqueued by another thread (the cache loading task) and the queue only keeps
+        // the order of a single producer, so it may still be in flight. The player is released
+        // when its ADD arrives, and stays alive until then since destroy() waits for the release.
+        _pendingRemovals.push_back(player);
+    } else {
+        player->_isStreamReleased.store(true, std::memory_order_release);
+    }
+}
+
+bool AudioStreamer::openVoice(Voice &voice, uint32_t offsetFrame) {
+    const AudioCache *cache = voice.player->_audioCache;
+    voice.decoder = AudioDecoderManager::createDecoder(cache->_fileFullPath.c_str());
+    if (voice.decoder == nullptr || !voice.decoder->open(cache->_fileFullPath.c_str())) {
+        ALOGE("%s: failed to open decoder for %s", __FUNCTION__, cache->_fileFullPath.c_str());
+        return false;
+    }
+
+    voice.framesPerBuffer = cache->_queBufferFrames;
+    voice.sampleRate = voice.decoder->getSampleRate();
+    if (voice.framesPerBuffer == 0 || voice.sampleRate == 0) {
+        return false;
+    }
+    voice.buffer.assign(static_cast<size_t>(voice.framesPerBuffer) * voice.decoder->getBytesPerFrame(), 0);
+    if (offsetFrame != 0) {
+        voice.decoder->seek(offsetFrame);
+    }
+    voice.deadline = Clock::now();
+    return true;
+}
+
+void AudioStreamer::releaseVoice(Voice &voice) {
+    if (voice.decoder != nullptr) {
+        voice.decoder->close();
+        AudioDecoderManager::destroyDecoder(voice.decoder);
+        voice.decoder = nullptr;
+    }
+    voice.player->_isStreamReleased.store(true, std::memory_order_release);
+}
+
+void AudioStreamer::serviceVoice(Voice &voice, Clock::time_point now) {
+    AudioPlayer *player = voice.player;
+    const AudioCache *cache = player->_audioCache;
+    const ALuint alSource = player->_alSource;
+    const std::chrono::microseconds bufferDuration{static_cast<int64_t>(voice.framesPerBuffer) * 1000000 / voice.sampleRate};
+
+    ALint sourceState = AL_INITIAL;
+    alGetSourcei(alSource, AL_SOURCE_STATE, &sourceState);
+    if (sourceState != AL_PLAYING && sourceState != AL_STOPPED) {
+        // Nothing is consumed while paused, check again after a buffer's worth of time.
+        voice.deadline = now + bufferDuration;
+        return;
+    }
+
+    ALint bufferProcessed = 0;
+    alGetSourcei(alSource, AL_BUFFERS_PROCESSED, &bufferProcessed);
+    while (bufferProcessed > 0) {
+        bufferProcessed--;
+        if (player->_timeDirty.exchange(false, std::memory_order_acq_rel)) {
+            voice.decoder->seek(static_cast<uint32_t>(player->_currTime * static_cast<float>(voice.sampleRate)));
+        } else {
+            float currTime = player->_currTime + QUEUEBUFFER_TIME_STEP;
+            if (currTime > cache->_duration) {
+                currTime = player->_loop ? 0.0F : cache->_duration;
+            }
+            player->_currTime = currTime;
+        }
+
+        uint32_t framesRead = voice.decoder->readFixedFrames(voice.framesPerBuffer, voice.buffer.data());
+        if (framesRead == 0) {
+            if (player->_loop) {
+                voice.decoder->seek(0);
+                framesRead = voice.decoder->readFixedFrames(voice.framesPerBuffer, voice.buffer.data());
+            } else {
+                voice.ended = true;
+                player->_isStreamEnded.store(true, std::memory_order_release);
+                break;
+            }
+        }
+
+        ALuint bid;
+        alSourceUnqueueBuffers(alSource, 1, &bid);
+        alBufferData(bid, cache->_format, voice.buffer.data(), static_cast<ALsizei>(framesRead * voice.decoder->getBytesPerFrame()),
+                     static_cast<ALsizei>(voice.sampleRate));
+        alSourceQueueBuffers(alSource, 1, &bid);
+    }
+
+    if (voice.ended) {
+        voice.deadline = Clock::time_point::max();
+        return;
+    }
+
+    if (sourceState == AL_STOPPED) {
+        // The source consumed every queued buffer before it was refilled, restart it with the new data.
+        player->_underrunCount.fetch_add(1, std::memory_order_relaxed);
+        _underrunCount.fetch_add(1, std::memory_order_relaxed);
+        ALOGW("%s: voice of player id=%u ran dry, restarting", __FUNCTION__, player->_id);
+        alSourcePlay(alSource);
+    }
+
+    // The next buffer is processed once the one being played is finished.
+    ALint sampleOffset = 0;
+    alGetSourcei(alSource, AL_SAMPLE_OFFSET, &sampleOffset);
+    const uint32_t remainingFrames = voice.framesPerBuffer - static_cast<uint32_t>(sampleOffset) % voice.framesPerBuffer;
+    voice.deadline = now + std::chrono::microseconds(static_cast<int64_t>(remainingFrames) * 1000000 / voice.sampleRate) + DEADLINE_SLACK;
+}
+
+} // namespace cc
@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "concurrentqueue/concurrentqueue.h"
+#include "concurrentqueue/lightweightsemaphore.h"
+
+namespace cc {
+
+class AudioDecoder;
+class AudioPlayer;
+
+/**
+ * One service thread that keeps the OpenAL buffer queues of all streaming players filled.
+ * Players are registered and released through a lock-free command queue, and every voice
+ * is serviced when its current buffer is expected to be consumed instead of by polling.
+ */
+class AudioStreamer final {
+public:
+    AudioStreamer() = default;
+    ~AudioStreamer();
+
+    void start();
+    void stop();
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    /**
+     * Start streaming the source of the player, which has its first QUEUEBUFFER_NUM buffers queued.
+     * Decoding continues from offsetFrame. Returns false if the service isn't running.
+     */
+    bool addVoice(AudioPlayer *player, uint32_t offsetFrame);
+    /**
+     * Stop streaming the source of the player. AudioPlayer::_isStreamReleased is set once the
+     * service no longer touches the player or its source.
+     */
+    void removeVoice(AudioPlayer *player);
+
+    /** Number of times a voice ran dry and had to be restarted, summed over all voices. */
+    uint32_t getUnderrunCount() const { return _underrunCount.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class CommandType : uint8_t {
+        ADD,
+        REMOVE
+    };
+
+    struct Command {
+        CommandType type{CommandType::ADD};
+        AudioPlayer *player{nullptr};
+        uint32_t offsetFrame{0};
+    };
+
+    struct Voice {
+        AudioPlayer *player{nullptr};
+        AudioDecoder *decoder{nullptr};
+        ccstd::vector<char> buffer;
+        uint32_t framesPerBuffer{0};
+        uint32_t sampleRate{0};
+        Clock::time_point deadline;
+        bool ended{false};
+    };
+
+    void threadLoop();
+    void processCommands();
+    void processRemove(AudioPlayer *player);
+    bool openVoice(Voice &voice, uint32_t offsetFrame);
+    void releaseVoice(Voice &voice);
+    void serviceVoice(Voice &voice, Clock::time_point now);
+
+    moodycamel::ConcurrentQueue<Command> _commands;
+    moodycamel::LightweightSemaphore _wakeUp;
+    ccstd::vector<Voice> _voices;
+    // REMOVE commands dequeued before the ADD of the same player, see processRemove()
+    ccstd::vector<AudioPlayer *> _pendingRemovals;
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+    std::atomic<uint32_t> _underrunCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AudioStreamer);
+};
+
+} // namespace cc
@@ -24,11 +24,17 @@
 ****************************************************************************/
 
 #include "base/ThreadPool.h"
+#include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <memory>
 #include "base/memory/Memory.h"
 #include "platform/StdC.h"
 
+#if defined(__linux__)
+    #include <sched.h>
+#endif
+
 #ifdef __ANDROID__
     #include <android/log.h>
     #define LOG_TAG   "ThreadPool"
@@ -107,95 +113,79 @@ LegacyThreadPool::~LegacyThreadPool() {
 
 // number of idle threads
 int LegacyThreadPool::getIdleThreadNum() const {
-    auto *thiz = const_cast<LegacyThreadPool *>(this);
-    std::lock_guard<std::mutex> lk(thiz->_idleThreadNumMutex);
     return _idleThreadNum;
 }
 
-void LegacyThreadPool::init() {
-    _lastShrinkTime = std::chrono::high_resolution_clock::now();
+int LegacyThreadPool::getPriorityLane(TaskType type) {
+    switch (type) {
+        case TaskType::AUDIO: return 0;
+        case TaskType::IO: return 1;
+        case TaskType::NETWORK: return 2;
+        case TaskType::DEFAULT: return 3;
+        default: return 4;
+    }
+}
 
-    _maxThreadNum = std::max(_minThreadNum, _maxThreadNum);
+void LegacyThreadPool::init() {
+    _maxThreadNum = std::max(std::max(_minThreadNum, _maxThreadNum), 1);
 
-    _threads.resize(_maxThreadNum);
-    _abortFlags.resize(_maxThreadNum);
-    _idleFlags.resize(_maxThreadNum);
-    _initedFlags.resize(_maxThreadNum);
+    for (auto &affinity : _laneAffinity) {
+        affinity = -1;
+    }
 
-    for (int i = 0; i < _maxThreadNum; ++i) {
-        _idleFlags[i] = std::make_shared<std::atomic<bool>>(false);
-        if (i < _minThreadNum) {
-            _abortFlags[i] = std::make_shared<std::atomic<bool>>(false);
-            setThread(i);
-            _initedFlags[i] = std::make_shared<std::atomic<bool>>(true);
-            ++_initedThreadNum;
-        } else {
-            _abortFlags[i] = std::make_shared<std::atomic<bool>>(true);
-            _initedFlags[i] = std::make_shared<std::atomic<bool>>(false);
-        }
+    _workers.resize(_maxThreadNum);
+    for (auto &worker : _workers) {
+        worker = std::make_unique<Worker>();
+    }
+    for (int i = 0; i < _minThreadNum; ++i) {
+        setThread(i);
     }
 }
 
 bool LegacyThreadPool::tryShrinkPool() {
     LOGD("shrink pool, _idleThreadNum = %d \n", getIdleThreadNum());
 
-    auto before = std::chrono::high_resolution_clock::now();
-
-    ccstd::vector<int> threadIDsToJoin;
-    int maxThreadNumToJoin = std::min(_initedThreadNum - _minThreadNum, _shrinkStep);
+    std::lock_guard<std::mutex> poolLock(_poolMutex);
+    int threadNumToShrink = std::min(_initedThreadNum - _minThreadNum, _shrinkStep);
 
-    for (int i = 0; i < _maxThreadNum; ++i) {
-        if ((int)threadIDsToJoin.size() >= maxThreadNumToJoin) {
-            break;
-        }
-
-        if (*_idleFlags[i]) {
-            *_abortFlags[i] = true;
-            threadIDsToJoin.push_back(i);
+    // the aborted threads retire by themselves and are joined when their slots are reused,
+    // joining them here could dead lock with a task which is stretching the pool.
+    for (int i = _maxThreadNum - 1; i >= _minThreadNum && threadNumToShrink > 0; --i) {
+        auto &worker = *_workers[i];
+        if (worker.thread && worker.idle && !worker.abort) {
+            worker.abort = true;
+            --threadNumToShrink;
         }
     }
 
     {
-        // stop the detached threads that were waiting
+        // stop the threads that were waiting
         std::unique_lock<std::mutex> lock(_mutex);
         _cv.notify_all();
     }
 
-    for (const auto &threadID : threadIDsToJoin) { // wait for the computing threads to finish
-        if (_threads[threadID]->joinable()) {
-            _threads[threadID]->join();
-        }
-
-        _threads[threadID].reset();
-        *_initedFlags[threadID] = false;
-        --_initedThreadNum;
-    }
-
-    auto after = std::chrono::high_resolution_clock::now();
-
-    float seconds = TIME_MINUS(after, before);
-
-    LOGD("shrink %d threads, waste: %f seconds\n", (int)threadIDsToJoin.size(), seconds);
-
     return (_initedThreadNum <= _minThreadNum);
 }
 
 void LegacyThreadPool::stretchPool(int count) {
     auto before = std::chrono::high_resolution_clock::now();
 
+    std::lock_guard<std::mutex> poolLock(_poolMutex);
     int oldThreadCount = _initedThreadNum;
     int newThreadCount = 0;
 
-    for (int i = 0; i < _maxThreadNum; ++i) {
-        if (!*_initedFlags[i]) {
-            *_abortFlags[i] = false;
+    for (int i = 0; i < _maxThreadNum && newThreadCount < count; ++i) {
+        auto &worker = *_workers[i];
+        bool running = false;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            running = worker.running;
+        }
+        if (!running) {
+            // the thread may be retired by itself, join it before reuse the slot
+            joinThread(i);
             setThread(i);
-            *_initedFlags[i] = true;
-            ++_initedThreadNum;
-
-            if (++newThreadCount >= count) {
-                break;
-            }
+            ++newThreadCount;
         }
     }
 
@@ -203,91 +193,101 @@ void LegacyThreadPool::stretchPool(int count) {
         auto after = std::chrono::high_resolution_clock::now();
         float seconds = TIME_MINUS(after, before);
 
-        LOGD("stretch pool from %d to %d, waste %f seconds\n", oldThreadCount, _initedThreadNum,
+        LOGD("stretch pool from %d to %d, waste %f seconds\n", oldThreadCount, static_cast<int>(_initedThreadNum),
              seconds);
     }
 }
 
+bool LegacyThreadPool::pushToWorker(int tid, Task &task) {
+    auto &worker = *_workers[tid];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.running) {
+        return false;
+    }
+    worker.lanes[getPriorityLane(task.type)].emplace_back(std::move(task));
+    return true;
+}
+
 void LegacyThreadPool::pushTask(const std::function<void(int)> &runnable,
                                 TaskType type /* = DEFAULT*/) {
-    if (!_isFixedSize) {
-        _idleThreadNumMutex.lock();
-        int idleNum = _idleThreadNum;
-        _idleThreadNumMutex.unlock();
-
-        if (idleNum > _minThreadNum) {
-            if (_taskQueue.empty()) {
-                auto now = std::chrono::high_resolution_clock::now();
-                float seconds = TIME_MINUS(now, _lastShrinkTime);
-                if (seconds > _shrinkInterval) {
-                    tryShrinkPool();
-                    _lastShrinkTime = now;
-                }
-            }
-        } else if (idleNum == 0) {
-            stretchPool(_stretchStep);
-        }
+    if (_isDone) {
+        return;
     }
 
-    auto callback = ccnew std::function<void(int)>([runnable](int tid) {
-        runnable(tid);
-    });
+    if (!_isFixedSize && _idleThreadNum == 0 && _initedThreadNum < _maxThreadNum) {
+        stretchPool(_stretchStep);
+    }
 
-    Task task;
-    task.type = type;
-    task.callback = callback;
-    _taskQueue.push(task);
+    Task task{type, runnable};
+    ++_taskNum;
+    bool pushed = false;
+    const int affinity = _laneAffinity[getPriorityLane(type)];
+    if (affinity >= 0) {
+        pushed = pushToWorker(affinity, task);
+    }
+    const auto start = _nextWorker.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < _maxThreadNum && !pushed; ++i) {
+        pushed = pushToWorker(static_cast<int>((start + i) % _maxThreadNum), task);
+    }
+    if (!pushed) {
+        // all threads are retired, wake one up for the task
+        stretchPool(1);
+        for (int i = 0; i < _maxThreadNum && !pushed; ++i) {
+            pushed = pushToWorker(i, task);
+        }
+    }
+    CC_ASSERT(pushed);
 
-    {
+    notifyTaskPushed();
+}
+
+void LegacyThreadPool::notifyTaskPushed() {
+    ++_taskEpoch;
+    if (_idleThreadNum > 0) {
         std::unique_lock<std::mutex> lock(_mutex);
         _cv.notify_one();
     }
 }
 
 void LegacyThreadPool::stopAllTasks() {
-    Task task;
-    while (_taskQueue.pop(task)) {
-        delete task.callback; // empty the queue
+    for (auto &worker : _workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        for (auto &lane : worker->lanes) {
+            _taskNum -= static_cast<int>(lane.size());
+            lane.clear();
+        }
     }
 }
 
 void LegacyThreadPool::stopTasksByType(TaskType type) {
-    Task task;
-
-    ccstd::vector<Task> notStopTasks;
-    notStopTasks.reserve(_taskQueue.size());
-
-    while (_taskQueue.pop(task)) {
-        if (task.type == type) { // Delete the task from queue
-            delete task.callback;
-        } else { // If task type isn't match, push it into a vector, then insert to task queue again
-            notStopTasks.push_back(task);
-        }
-    }
-
-    if (!notStopTasks.empty()) {
-        for (const auto &t : notStopTasks) {
-            _taskQueue.push(t);
-        }
+    const int laneIndex = getPriorityLane(type);
+    for (auto &worker : _workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        auto &lane = worker->lanes[laneIndex];
+        auto iter = std::remove_if(lane.begin(), lane.end(), [type](const Task &task) {
+            return task.type == type;
+        });
+        _taskNum -= static_cast<int>(std::distance(iter, lane.end()));
+        lane.erase(iter, lane.end());
     }
 }
 
 void LegacyThreadPool::joinThread(int tid) {
-    if (tid < 0 || tid >= (int)_threads.size()) {
+    if (tid < 0 || tid >= (int)_workers.size()) {
         LOGD("Invalid thread id %d\n", tid);
         return;
     }
 
     // wait for the computing threads to finish
-    if (*_initedFlags[tid] && _threads[tid]->joinable()) {
-        _threads[tid]->join();
-        *_initedFlags[tid] = false;
-        --_initedThreadNum;
+    auto &worker = *_workers[tid];
+    if (worker.thread && worker.thread->joinable()) {
+        worker.thread->join();
     }
+    worker.thread.reset();
 }
 
 int LegacyThreadPool::getTaskNum() const {
-    return (int)_taskQueue.size();
+    return _taskNum;
 }
 
 void LegacyThreadPool::setFixedSize(bool isFixedSize) {
@@ -312,6 +312,20 @@ void LegacyThreadPool::setStretchStep(int step) {
     }
 }
 
+void LegacyThreadPool::setTaskTypeAffinity(TaskType type, int threadId) {
+    _laneAffinity[getPriorityLane(type)] = (threadId >= 0 && threadId < _maxThreadNum) ? threadId : -1;
+}
+
+void LegacyThreadPool::setThreadCoreAffinity(int threadId, int core) {
+    if (threadId < 0 || threadId >= _maxThreadNum) {
+        LOGD("Invalid thread id %d\n", threadId);
+        return;
+    }
+    auto &worker = *_workers[threadId];
+    worker.coreAffinity = core;
+    worker.coreAffinityDirty = true;
+}
+
 void LegacyThreadPool::stop() {
     if (_isDone || _isStop) {
         return;
@@ -324,57 +338,195 @@ void LegacyThreadPool::stop() {
         _cv.notify_all(); // stop all waiting threads
     }
 
-    for (int i = 0, n = static_cast<int>(_threads.size()); i < n; ++i) {
+    for (int i = 0, n = static_cast<int>(_workers.size()); i < n; ++i) {
         joinThread(i);
     }
     // if there were no threads in the pool but some functors in the queue, the functors are not deleted by the threads
     // therefore delete them here
     stopAllTasks();
-    _threads.clear();
-    _abortFlags.clear();
+    _workers.clear();
 }
 
-void LegacyThreadPool::setThread(int tid) {
-    std::shared_ptr<std::atomic<bool>> abortPtr(
-        _abortFlags[tid]); // a copy of the shared ptr to the flag
-    auto f = [this, tid, abortPtr /* a copy of the shared ptr to the abort */]() {
-        std::atomic<bool> &abort = *abortPtr;
-        Task task;
-        bool isPop = _taskQueue.pop(task);
-        while (true) {
-            while (isPop) { // if there is anything in the queue
-                std::unique_ptr<std::function<void(int)>> func(
-                    task.callback); // at return, delete the function even if an exception occurred
-                (*task.callback)(tid);
-                if (abort) {
-                    return; // the thread is wanted to stop, return even if the queue is not empty yet
+bool LegacyThreadPool::popTask(int tid, Task &task) {
+    auto &worker = *_workers[tid];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (auto &lane : worker.lanes) {
+        if (!lane.empty()) {
+            task = std::move(lane.front());
+            lane.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LegacyThreadPool::stealTask(int tid, Task &task) {
+    // take the highest priority task of all the other threads, from the back of their lanes
+    bool contended = false;
+    for (int laneIndex = 0; laneIndex < PRIORITY_LANE_COUNT; ++laneIndex) {
+        for (int i = 1; i < _maxThreadNum; ++i) {
+            auto &victim = *_workers[(tid + i) % _maxThreadNum];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                contended = true;
+                continue;
+            }
+            auto &lane = victim.lanes[laneIndex];
+            if (!lane.empty()) {
+                task = std::move(lane.back());
+                lane.pop_back();
+                ++_stolenTaskNum;
+                return true;
+            }
+        }
+    }
+    if (!contended) {
+        return false;
+    }
+
+    // a busy deque is not an empty one, look again with blocking locks before going to sleep
+    for (int laneIndex = 0; laneIndex < PRIORITY_LANE_COUNT; ++laneIndex) {
+        for (int i = 1; i < _maxThreadNum; ++i) {
+            auto &victim = *_workers[(tid + i) % _maxThreadNum];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto &lane = victim.lanes[laneIndex];
+            if (!lane.empty()) {
+                task = std::move(lane.back());
+                lane.pop_back();
+                ++_stolenTaskNum;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool LegacyThreadPool::retire(int tid) {
+    auto &worker = *_workers[tid];
+    ccstd::vector<Task> leftovers;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            bool hasTask = false;
+            for (const auto &lane : worker.lanes) {
+                hasTask |= !lane.empty();
+            }
+            if (!hasTask) {
+                // no task can be pushed to this thread from now on
+                worker.running = false;
+                break;
+            }
+            for (auto &lane : worker.lanes) {
+                for (auto &task : lane) {
+                    leftovers.emplace_back(std::move(task));
+                }
+                lane.clear();
+            }
+        }
+
+        // hand the tasks pushed in the meantime over to the running threads
+        size_t remaining = 0;
+        for (auto &task : leftovers) {
+            bool pushed = false;
+            for (int i = 1; i < _maxThreadNum && !pushed; ++i) {
+                pushed = pushToWorker((tid + i) % _maxThreadNum, task);
+            }
+            if (!pushed) {
+                leftovers[remaining++] = std::move(task);
+            }
+        }
+        if (remaining < leftovers.size()) {
+            notifyTaskPushed();
+        }
+        if (remaining > 0) {
+            // nobody else is running, keep the thread alive for the tasks
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            for (size_t i = 0; i < remaining; ++i) {
+                worker.lanes[getPriorityLane(leftovers[i].type)].emplace_front(std::move(leftovers[i]));
+            }
+            return false;
+        }
+        leftovers.clear();
+    }
+    --_initedThreadNum;
+    return true;
+}
+
+void LegacyThreadPool::run(int tid) {
+    auto &worker = *_workers[tid];
+    // threads below _minThreadNum start before the pool is configured, they never read the shrink settings
+    const bool canShrink = tid >= _minThreadNum && !_isFixedSize;
+    const auto shrinkInterval = std::chrono::milliseconds(canShrink ? static_cast<int64_t>(_shrinkInterval * 1000) : 0);
+    Task task;
+    while (true) {
+        if (worker.coreAffinityDirty.exchange(false)) {
+#if defined(__linux__)
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            const int core = worker.coreAffinity;
+            if (core >= 0) {
+                CPU_SET(core, &cpuSet);
+            } else {
+                for (int i = 0, n = static_cast<int>(std::thread::hardware_concurrency()); i < n; ++i) {
+                    CPU_SET(i, &cpuSet);
                 }
+            }
+            sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#endif
+        }
 
-                isPop = _taskQueue.pop(task);
+        // read before looking for tasks, so a task pushed during the search is not slept through
+        const uint32_t taskEpoch = _taskEpoch;
+        if (popTask(tid, task) || stealTask(tid, task)) {
+            --_taskNum;
+            task.callback(tid);
+            task.callback = nullptr;
+            if (worker.abort) {
+                // the thread is wanted to stop, its own tasks are handed over to the others
+                if (retire(tid)) {
+                    return;
+                }
+                worker.abort = false;
             }
-            // the queue is empty here, wait for the next command
-            std::unique_lock<std::mutex> lock(_mutex);
-            _idleThreadNumMutex.lock();
-            ++_idleThreadNum;
-            _idleThreadNumMutex.unlock();
-
-            *_idleFlags[tid] = true;
-            _cv.wait(lock, [this, &task, &isPop, &abort]() {
-                isPop = _taskQueue.pop(task);
-                return isPop || _isDone || abort;
-            });
-            *_idleFlags[tid] = false;
-            _idleThreadNumMutex.lock();
-            --_idleThreadNum;
-            _idleThreadNumMutex.unlock();
-
-            if (!isPop) {
-                return; // if the queue is empty and isDone == true or *flag then return
+            continue;
+        }
+
+        // there is no task to pop or steal here, wait until one is pushed or the next command
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++_idleThreadNum;
+        worker.idle = true;
+        auto predicate = [this, &worker, taskEpoch]() {
+            return _taskEpoch != taskEpoch || _isDone || worker.abort;
+        };
+        bool woken = true;
+        if (canShrink) {
+            woken = _cv.wait_for(lock, shrinkInterval, predicate);
+        } else {
+            _cv.wait(lock, predicate);
+        }
+        worker.idle = false;
+        --_idleThreadNum;
+
+        // when done, the tasks still queued belong to running threads, retire hands over this thread's own ones
+        if (!woken || worker.abort || _isDone) {
+            lock.unlock();
+            if (retire(tid)) {
+                return;
             }
+            worker.abort = false;
         }
-    };
-    _threads[tid].reset(
-        ccnew std::thread(f)); // compiler may not support std::make_unique()
+    }
+}
+
+void LegacyThreadPool::setThread(int tid) {
+    auto &worker = *_workers[tid];
+    worker.abort = false;
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.running = true;
+    }
+    ++_initedThreadNum;
+    worker.thread.reset(ccnew std::thread([this, tid]() { run(tid); })); // compiler may not support std::make_unique()
 }
 
 } // namespace cc
@@ -33,10 +33,18 @@
 #include <mutex>
 #include <thread>
 #include "base/Utils.h"
-#include "base/std/container/queue.h"
+#include "base/std/container/array.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
+/*
+ * A work-stealing thread pool. Every thread owns a task deque with one priority lane per task type,
+ * tasks are pushed to threads in round robin (or to the thread bound by setTaskTypeAffinity),
+ * idle threads steal from others, so producers and consumers don't contend on one global lock.
+ * Lanes are served in the order AUDIO, IO, NETWORK, DEFAULT, USER.
+ */
 class CC_DLL LegacyThreadPool {
 public:
     enum class TaskType {
@@ -59,6 +67,7 @@ public:
 
     /*
      * Creates a cached thread pool
+     * Threads are stretched when all of them are busy, threads beyond minThreadNum exit after being idle for shrinkInterval seconds.
      * @note The return value has to be delete while it doesn't needed
      */
     static LegacyThreadPool *newCachedThreadPool(int minThreadNum, int maxThreadNum, int shrinkInterval,
@@ -82,7 +91,7 @@ public:
     /* Pushs a task to thread pool
      *  @param runnable The callback of the task executed in sub thread
      *  @param type The task type, it's TASK_TYPE_DEFAULT if this argument isn't assigned
-     *  @note This function has to be invoked in cocos thread
+     *  @note This function is thread safe
      */
     void pushTask(const std::function<void(int /*threadId*/)> &runnable, TaskType type = TaskType::DEFAULT);
 
@@ -107,13 +116,50 @@ public:
     // Gets the task number
     int getTaskNum() const;
 
-    /* 
+    // Gets the number of tasks executed by a thread other than the one they were pushed to
+    inline uint64_t getStolenTaskNum() const { return _stolenTaskNum; }
+
+    /*
      * Trys to shrink pool
      * @note This method is only available for cached thread pool
      */
     bool tryShrinkPool();
 
+    /*
+     * Prefers to push tasks of the type to the thread, e.g. to keep AUDIO tasks on one thread.
+     * Other threads could still steal them while they are idle.
+     * @param threadId The thread index in [0, getMaxThreadNum()), -1 to clear the hint
+     */
+    void setTaskTypeAffinity(TaskType type, int threadId);
+
+    /*
+     * Hints to bind the thread to a cpu core, it takes effect the next time the thread wakes up.
+     * @param core The cpu core index, -1 to clear the hint
+     * @note Only Linux and Android support it, it's ignored on other platforms
+     */
+    void setThreadCoreAffinity(int threadId, int core);
+
 private:
+    static constexpr int PRIORITY_LANE_COUNT = 5;
+
+    struct Task {
+        TaskType type;
+        std::function<void(int)> callback;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        // guarded by mutex
+        ccstd::array<ccstd::deque<Task>, PRIORITY_LANE_COUNT> lanes;
+        // guarded by mutex, whether the thread is alive and accepts new tasks
+        bool running{false};
+        std::unique_ptr<std::thread> thread;
+        std::atomic<bool> abort{false};
+        std::atomic<bool> idle{false};
+        std::atomic<int> coreAffinity{-1};
+        std::atomic<bool> coreAffinityDirty{false};
+    };
+
     LegacyThreadPool(int minNum, int maxNum);
 
     LegacyThreadPool(const LegacyThreadPool &);
@@ -124,6 +170,8 @@ private:
 
     LegacyThreadPool &operator=(LegacyThreadPool &&) noexcept;
 
+    static int getPriorityLane(TaskType type);
+
     void init();
 
     void stop();
@@ -142,71 +190,44 @@ private:
 
     void stretchPool(int count);
 
-    ccstd::vector<std::unique_ptr<std::thread>> _threads;
-    ccstd::vector<std::shared_ptr<std::atomic<bool>>> _abortFlags;
-    ccstd::vector<std::shared_ptr<std::atomic<bool>>> _idleFlags;
-    ccstd::vector<std::shared_ptr<std::atomic<bool>>> _initedFlags;
-
-    template <typename T>
-    class ThreadSafeQueue {
-    public:
-        bool push(T const &value) {
-            std::unique_lock<std::mutex> lock(this->mutex);
-            this->q.push(value);
-            return true;
-        }
-
-        // deletes the retrieved element, do not use for non integral types
-        bool pop(T &v) {
-            std::unique_lock<std::mutex> lock(this->mutex);
-            if (this->q.empty())
-                return false;
-            v = this->q.front();
-            this->q.pop();
-            return true;
-        }
-
-        bool empty() const {
-            auto thiz = const_cast<ThreadSafeQueue *>(this);
-            std::unique_lock<std::mutex> lock(thiz->mutex);
-            return this->q.empty();
-        }
-
-        size_t size() const {
-            auto thiz = const_cast<ThreadSafeQueue *>(this);
-            std::unique_lock<std::mutex> lock(thiz->mutex);
-            return this->q.size();
-        }
-
-    private:
-        ccstd::queue<T> q;
-        std::mutex mutex;
-    };
+    bool pushToWorker(int tid, Task &task);
 
-    struct Task {
-        TaskType type;
-        std::function<void(int)> *callback;
-    };
+    bool popTask(int tid, Task &task);
+
+    bool stealTask(int tid, Task &task);
+
+    void run(int tid);
+
+    bool retire(int tid);
+
+    void notifyTaskPushed();
+
+    ccstd::vector<std::unique_ptr<Worker>> _workers;
+    ccstd::array<std::atomic<int>, PRIORITY_LANE_COUNT> _laneAffinity;
 
     static LegacyThreadPool *_instance;
 
-    ThreadSafeQueue<Task> _taskQueue;
     std::atomic<bool> _isDone{false};
     std::atomic<bool> _isStop{false};
 
-    //IDEA: std::atomic<int> isn't supported by ndk-r10e while compiling with `armeabi` arch.
-    // So using a mutex here instead.
-    int _idleThreadNum{0}; // how many threads are waiting
-    std::mutex _idleThreadNumMutex;
+    std::atomic<int> _taskNum{0};
+    // bumped whenever a task becomes available, idle threads sleep until it changes
+    std::atomic<uint32_t> _taskEpoch{0};
+    std::atomic<int> _idleThreadNum{0}; // how many threads are waiting
+    std::atomic<int> _initedThreadNum{0};
+    std::atomic<uint32_t> _nextWorker{0};
+    std::atomic<uint64_t> _stolenTaskNum{0};
 
+    // only used to park idle threads, tasks are never accessed under this lock
     std::mutex _mutex;
     std::condition_variable _cv;
 
+    // guards stretching and shrinking
+    std::mutex _poolMutex;
+
     int _minThreadNum{0};
     int _maxThreadNum{0};
-    int _initedThreadNum{0};
 
-    std::chrono::time_point<std::chrono::high_resolution_clock> _lastShrinkTime;
     float _shrinkInterval{5};
     int _shrinkStep{2};
     int _stretchStep{2};
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "base/threading/FrameArena.h"
+#include <algorithm>
+#include "boost/container/pmr/global_resource.hpp"
+
+namespace cc {
+
+FrameArenaResource::FrameArenaResource(size_t capacity, boost::container::pmr::memory_resource *upstream) noexcept
+: _allocator(ccnew ThreadSafeLinearAllocator(capacity)),
+  _upstream(upstream ? upstream : boost::container::pmr::new_delete_resource()) {
+}
+
+FrameArenaResource::~FrameArenaResource() {
+    reset();
+    CC_SAFE_DELETE(_allocator);
+}
+
+void FrameArenaResource::reset() noexcept {
+    std::lock_guard<std::mutex> lock(_fallbackMutex);
+    for (const auto &fallback : _fallbacks) {
+        _upstream->deallocate(fallback.ptr, fallback.size, fallback.alignment);
+    }
+    _fallbacks.clear();
+
+    if (_fallbackSize > 0) {
+        // grow to hold everything of the last use in one go
+        const size_t capacity = std::max(_allocator->getCapacity() * 2, _allocator->getUsedSize() + _fallbackSize);
+        CC_SAFE_DELETE(_allocator);
+        _allocator = ccnew ThreadSafeLinearAllocator(capacity);
+        _fallbackSize = 0;
+    } else {
+        _allocator->recycle();
+    }
+    _fallbackCount.store(0, std::memory_order_relaxed);
+}
+
+void *FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void *ptr = _allocator->allocate<uint8_t>(std::max(bytes, static_cast<std::size_t>(1)), alignment);
+    if (ptr) {
+        return ptr;
+    }
+
+    ptr = _upstream->allocate(bytes, alignment);
+    std::lock_guard<std::mutex> lock(_fallbackMutex);
+    _fallbacks.push_back({ptr, bytes, alignment});
+    _fallbackSize += bytes + alignment;
+    _fallbackCount.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void FrameArenaResource::do_deallocate(void * /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) {
+    // released by reset()
+}
+
+bool FrameArenaResource::do_is_equal(const boost::container::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+FrameArena *FrameArena::getInstance() {
+    static FrameArena instance;
+    return &instance;
+}
+
+FrameArena::~FrameArena() {
+    for (auto &frameArenas : _arenas) {
+        for (auto &arena : frameArenas) {
+            delete arena.exchange(nullptr);
+        }
+    }
+}
+
+uint32_t FrameArena::getThreadSlot() noexcept {
+    static std::atomic<uint32_t> threadCount{0};
+    thread_local const uint32_t slot = std::min(threadCount.fetch_add(1, std::memory_order_relaxed), MAX_THREAD_COUNT);
+    return slot;
+}
+
+boost::container::pmr::memory_resource *FrameArena::getThreadResource() noexcept {
+    auto &arena = _arenas[_frameIndex.load(std::memory_order_relaxed)][getThreadSlot()];
+    FrameArenaResource *resource = arena.load(std::memory_order_acquire);
+    if (!resource) {
+        auto *newResource = ccnew FrameArenaResource(DEFAULT_ARENA_CAPACITY);
+        if (arena.compare_exchange_strong(resource, newResource, std::memory_order_acq_rel)) {
+            resource = newResource;
+            _arenaCreationCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // the shared slot was created by another thread
+            delete newResource;
+        }
+    }
+    return resource;
+}
+
+void FrameArena::beginFrame() noexcept {
+    const uint32_t lastFrameIndex = _frameIndex.load(std::memory_order_relaxed);
+    _heapAllocationCount = _arenaCreationCount.exchange(0, std::memory_order_relaxed);
+    _usedSize = 0;
+    _capacity = 0;
+    for (const auto &arena : _arenas[lastFrameIndex]) {
+        const auto *resource = arena.load(std::memory_order_acquire);
+        if (resource) {
+            _heapAllocationCount += resource->getFallbackCount();
+            _usedSize += resource->getUsedSize();
+            _capacity += resource->getCapacity();
+        }
+    }
+
+    // the arenas of FRAME_BUFFER_COUNT frames ago are free to reuse now
+    const uint32_t frameIndex = (lastFrameIndex + 1) % FRAME_BUFFER_COUNT;
+    for (auto &arena : _arenas[frameIndex]) {
+        auto *resource = arena.load(std::memory_order_acquire);
+        if (resource) {
+            resource->reset();
+        }
+    }
+    _frameIndex.store(frameIndex, std::memory_order_release);
+}
+
+} // namespace cc
@@ -0,0 +1,129 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+#include "base/threading/ThreadSafeLinearAllocator.h"
+#include "boost/container/pmr/memory_resource.hpp"
+#include "boost/container/pmr/polymorphic_allocator.hpp"
+
+namespace cc {
+
+// A memory resource on top of a linear allocator, so that ccstd::pmr containers could allocate from it.
+// Deallocation is a no-op, everything is released at once by reset().
+// When the linear allocator is exhausted, allocations fall back to the upstream resource,
+// and the linear allocator grows at next reset() to cover them.
+class FrameArenaResource final : public boost::container::pmr::memory_resource {
+public:
+    explicit FrameArenaResource(size_t capacity, boost::container::pmr::memory_resource *upstream = nullptr) noexcept;
+    ~FrameArenaResource() override;
+    FrameArenaResource(FrameArenaResource const &) = delete;
+    FrameArenaResource(FrameArenaResource &&) = delete;
+    FrameArenaResource &operator=(FrameArenaResource const &) = delete;
+    FrameArenaResource &operator=(FrameArenaResource &&) = delete;
+
+    void reset() noexcept;
+
+    inline size_t getCapacity() const noexcept { return _allocator->getCapacity(); }
+    inline size_t getUsedSize() const noexcept { return _allocator->getUsedSize(); }
+    // number of allocations made from the upstream resource since last reset
+    inline uint32_t getFallbackCount() const noexcept { return _fallbackCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Fallback {
+        void *ptr{nullptr};
+        size_t size{0};
+        size_t alignment{0};
+    };
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const boost::container::pmr::memory_resource &other) const noexcept override;
+
+    ThreadSafeLinearAllocator *_allocator{nullptr};
+    boost::container::pmr::memory_resource *_upstream{nullptr};
+    std::mutex _fallbackMutex;
+    ccstd::vector<Fallback> _fallbacks;
+    size_t _fallbackSize{0};
+    std::atomic<uint32_t> _fallbackCount{0};
+};
+
+// Frame scoped linear arenas, one per thread and per buffered frame.
+// Memory allocated in a frame stays valid until beginFrame() has been called FRAME_BUFFER_COUNT more times,
+// so the frame could still be read by the render thread while the next ones are being recorded.
+// Usage: ccstd::pmr::vector<T> list(FrameArena::getInstance()->getThreadResource());
+class CC_DLL FrameArena final {
+public:
+    static constexpr uint32_t FRAME_BUFFER_COUNT = 3;
+    static constexpr uint32_t MAX_THREAD_COUNT = 32;
+    static constexpr size_t DEFAULT_ARENA_CAPACITY = 256 * 1024;
+
+    static FrameArena *getInstance();
+
+    FrameArena() = default;
+    ~FrameArena();
+    FrameArena(FrameArena const &) = delete;
+    FrameArena(FrameArena &&) = delete;
+    FrameArena &operator=(FrameArena const &) = delete;
+    FrameArena &operator=(FrameArena &&) = delete;
+
+    // should be called at the frame boundary while no other thread is allocating from the arenas
+    void beginFrame() noexcept;
+
+    // memory resource of the calling thread in current frame
+    boost::container::pmr::memory_resource *getThreadResource() noexcept;
+
+    template <typename T>
+    inline boost::container::pmr::polymorphic_allocator<T> getThreadAllocator() noexcept {
+        return boost::container::pmr::polymorphic_allocator<T>(getThreadResource());
+    }
+
+    // statistics of the last finished frame
+    // general heap allocations made on behalf of the arenas, i.e. arena creations and fallbacks after exhausted
+    inline uint32_t getHeapAllocationCount() const noexcept { return _heapAllocationCount; }
+    inline size_t getUsedSize() const noexcept { return _usedSize; }
+    inline size_t getCapacity() const noexcept { return _capacity; }
+
+private:
+    // threads beyond MAX_THREAD_COUNT share the last slot, which works since the linear allocator is thread safe
+    static constexpr uint32_t SLOT_COUNT = MAX_THREAD_COUNT + 1;
+
+    static uint32_t getThreadSlot() noexcept;
+
+    ccstd::array<ccstd::array<std::atomic<FrameArenaResource *>, SLOT_COUNT>, FRAME_BUFFER_COUNT> _arenas{};
+    std::atomic<uint32_t> _frameIndex{0};
+    std::atomic<uint32_t> _arenaCreationCount{0};
+    uint32_t _heapAllocationCount{0};
+    size_t _usedSize{0};
+    size_t _capacity{0};
+};
+
+} // namespace cc
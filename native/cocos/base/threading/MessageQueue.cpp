@@ -117,6 +117,7 @@ MessageQueue::MessageQueue() {
 }
 
 void MessageQueue::kick() noexcept {
+    mergeRecordedMessages();
     pushMessages();
 
     std::lock_guard<std::mutex> lock(_mutex);
@@ -124,6 +125,9 @@ void MessageQueue::kick() noexcept {
 }
 
 void MessageQueue::kickAndWait() noexcept {
+    // recorded messages should be finished before the producer is unblocked
+    mergeRecordedMessages();
+
     EventSem event;
     EventSem *const pEvent = &event;
 
@@ -226,6 +230,45 @@ uint8_t *MessageQueue::allocateImpl(uint32_t allocatedSize, uint32_t const reque
     return allocateImpl(allocatedSize, requestSize);
 }
 
+void MessageQueue::setMultiProducerMode(uint32_t const recorderCount) noexcept {
+    mergeRecordedMessages();
+    while (_recorders.size() > recorderCount) {
+        CC_SAFE_DELETE(_recorders.back());
+        _recorders.pop_back();
+    }
+    while (_recorders.size() < recorderCount) {
+        _recorders.emplace_back(ccnew MessageRecorder(this));
+    }
+}
+
+void MessageQueue::mergeRecordedMessages() noexcept {
+    // splice in the order of recorder index, so the result doesn't depend on thread scheduling
+    for (auto *recorder : _recorders) {
+        if (!recorder->_messageCount) {
+            continue;
+        }
+
+        // the recorded chain returns to where the next message of this queue will be written
+        recorder->close(_writer.currentMemoryChunk, reinterpret_cast<Message *>(_writer.currentMemoryChunk + _writer.offset));
+
+        if (_immediateMode) {
+            Message *msg = recorder->_firstMessage;
+            for (uint32_t i = 0; i < recorder->_messageCount; ++i) {
+                Message *const next = msg->getNext();
+                msg->execute();
+                msg->~Message();
+                msg = next;
+            }
+        } else {
+            _writer.lastMessage->_next = recorder->_firstMessage;
+            _writer.lastMessage = recorder->_lastMessage;
+            _writer.pendingMessageCount += recorder->_messageCount;
+        }
+
+        recorder->reset();
+    }
+}
+
 void MessageQueue::pushMessages() noexcept {
     _writer.writtenMessageCount.fetch_add(_writer.pendingMessageCount, std::memory_order_acq_rel);
     _writer.pendingMessageCount = 0;
@@ -274,9 +317,86 @@ Message *MessageQueue::readMessage() noexcept {
 }
 
 MessageQueue::~MessageQueue() {
+    for (auto *recorder : _recorders) {
+        CC_SAFE_DELETE(recorder);
+    }
+    _recorders.clear();
     recycleMemoryChunk(_writer.currentMemoryChunk);
 }
 
+MessageRecorder::MessageRecorder(MessageQueue *const queue) noexcept
+: _queue(queue) {
+}
+
+MessageRecorder::~MessageRecorder() {
+    // messages never merged into the queue are destroyed without being executed,
+    // the chunk switch messages among them recycle every chunk but the current one
+    Message *msg = _firstMessage;
+    for (uint32_t i = 0; i < _messageCount; ++i) {
+        Message *const next = msg->getNext();
+        msg->~Message();
+        msg = next;
+    }
+    if (_currentMemoryChunk) {
+        _queue->recycleMemoryChunk(_currentMemoryChunk);
+    }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+uint8_t *MessageRecorder::allocateImpl(uint32_t const requestSize) noexcept {
+    uint32_t const alignedSize = align(requestSize, 16);
+    CC_ASSERT(alignedSize + SWITCH_CHUNK_MEMORY_REQUIREMENT <= MessageQueue::MEMORY_CHUNK_SIZE);
+
+    if (!_currentMemoryChunk) {
+        _currentMemoryChunk = MessageQueue::MemoryAllocator::getInstance().request();
+        _offset = 0;
+
+        // head of the chain, data could be allocated before any message like the sentinel of the queue
+        DummyMessage *const head = allocate<DummyMessage>(1);
+        ccnew_placement(head) DummyMessage;
+    }
+
+    uint32_t const newOffset = _offset + alignedSize;
+
+    // always leave room for the switch message which links to the next chunk or back to the queue
+    if (newOffset + sizeof(MemoryChunkSwitchMessage) <= MessageQueue::MEMORY_CHUNK_SIZE) {
+        uint8_t *const allocatedMemory = _currentMemoryChunk + _offset;
+        _offset = newOffset;
+        return allocatedMemory;
+    }
+    uint8_t *const newChunk = MessageQueue::MemoryAllocator::getInstance().request();
+    auto *const switchMessage = reinterpret_cast<MemoryChunkSwitchMessage *>(_currentMemoryChunk + _offset);
+    ccnew_placement(switchMessage) MemoryChunkSwitchMessage(_queue, newChunk, _currentMemoryChunk);
+    switchMessage->_next = reinterpret_cast<Message *>(newChunk); // point to start position
+    _lastMessage = switchMessage;
+    ++_messageCount;
+    _currentMemoryChunk = newChunk;
+    _offset = 0;
+
+    DummyMessage *const head = allocate<DummyMessage>(1);
+    ccnew_placement(head) DummyMessage;
+
+    return allocateImpl(requestSize);
+}
+
+void MessageRecorder::close(uint8_t *const nextChunk, Message *const next) noexcept {
+    // the tail releases the last recorded chunk once the consumer has passed it
+    auto *const tail = reinterpret_cast<MemoryChunkSwitchMessage *>(_currentMemoryChunk + _offset);
+    ccnew_placement(tail) MemoryChunkSwitchMessage(_queue, nextChunk, _currentMemoryChunk);
+    tail->_next = next;
+    _lastMessage = tail;
+    ++_messageCount;
+}
+
+void MessageRecorder::reset() noexcept {
+    // the recorded chunks are owned by the queue now
+    _currentMemoryChunk = nullptr;
+    _firstMessage = nullptr;
+    _lastMessage = nullptr;
+    _offset = 0;
+    _messageCount = 0;
+}
+
 void MessageQueue::consumerThreadLoop() noexcept {
 #if CC_PLATFORM == CC_PLATFORM_ANDROID && CC_SUPPORT_ADPF == 1
     // add tid to PerformanceHintManager
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include "../memory/Memory.h"
 #include "Event.h"
+#include "base/std/container/vector.h"
 #include "concurrentqueue/concurrentqueue.h"
 
 namespace cc {
@@ -63,6 +64,7 @@ private:
     Message *_next; // explicitly assigned beforehand, don't init the member here
 
     friend class MessageQueue;
+    friend class MessageRecorder;
 };
 
 // structs may be padded
@@ -88,8 +90,58 @@ struct ALIGNAS(64) ReaderContext final {
     bool flushingFinished{false};
 };
 
+class MessageQueue;
+
+// Records messages into its own memory chunks without touching the queue, so each worker thread
+// could record into a different recorder at the same time. Could be passed to ENQUEUE_MESSAGE_* like a queue.
+// The recorded messages are spliced into the queue by MessageQueue::kick(), after all the recording has finished.
+class ALIGNAS(64) MessageRecorder final {
+public:
+    explicit MessageRecorder(MessageQueue *queue) noexcept;
+    ~MessageRecorder();
+    MessageRecorder(MessageRecorder const &) = delete;
+    MessageRecorder(MessageRecorder &&) = delete;
+    MessageRecorder &operator=(MessageRecorder const &) = delete;
+    MessageRecorder &operator=(MessageRecorder &&) = delete;
+
+    // message allocation
+    template <typename T>
+    std::enable_if_t<std::is_base_of<Message, T>::value, T *>
+    allocate(uint32_t count) noexcept;
+
+    // general-purpose allocation
+    template <typename T>
+    std::enable_if_t<!std::is_base_of<Message, T>::value, T *>
+    allocate(uint32_t count) noexcept;
+    template <typename T>
+    T *allocateAndCopy(uint32_t count, void const *data) noexcept;
+    template <typename T>
+    T *allocateAndZero(uint32_t count) noexcept;
+
+    // messages are always recorded, they are executed when the queue merges them
+    inline bool isImmediateMode() const noexcept { return false; }
+
+    inline uint32_t getMessageCount() const noexcept { return _messageCount; }
+
+private:
+    uint8_t *allocateImpl(uint32_t requestSize) noexcept;
+    void close(uint8_t *nextChunk, Message *next) noexcept;
+    void reset() noexcept;
+
+    MessageQueue *_queue{nullptr};
+    uint8_t *_currentMemoryChunk{nullptr};
+    Message *_firstMessage{nullptr};
+    Message *_lastMessage{nullptr};
+    uint32_t _offset{0};
+    uint32_t _messageCount{0};
+
+    friend class MessageQueue;
+};
+
 // A single-producer single-consumer circular buffer queue.
 // Both the messages and their submitting data should be allocated from here.
+// In multi-producer mode, other threads could record messages through the recorders returned by getRecorder(),
+// which are merged in the order of recorder index when kicking.
 class ALIGNAS(64) MessageQueue final {
 public:
     static constexpr uint32_t MEMORY_CHUNK_SIZE = 4096 * 16;
@@ -133,6 +185,13 @@ public:
 
     inline void setImmediateMode(bool immediateMode) noexcept { _immediateMode = immediateMode; }
 
+    // multi-producer mode, 0 to disable it, should be called on the producer thread while no one is recording
+    void setMultiProducerMode(uint32_t recorderCount) noexcept;
+    inline bool isMultiProducerMode() const noexcept { return !_recorders.empty(); }
+    inline uint32_t getRecorderCount() const noexcept { return static_cast<uint32_t>(_recorders.size()); }
+    // each recorder should be written by one thread at a time
+    inline MessageRecorder *getRecorder(uint32_t index) const noexcept { return _recorders[index]; }
+
 private:
     class ALIGNAS(64) MemoryAllocator final {
     public:
@@ -164,6 +223,7 @@ private:
 #endif
 
     uint8_t *allocateImpl(uint32_t allocatedSize, uint32_t requestSize) noexcept;
+    void mergeRecordedMessages() noexcept;
     void pushMessages() noexcept;
 
     // consumer thread specifics
@@ -181,8 +241,10 @@ private:
     bool _workerAttached{false};
     bool _freeChunksByUser{true}; // recycled chunks will be stashed until explicit free instruction
     std::thread *_consumerThread{nullptr};
+    ccstd::vector<MessageRecorder *> _recorders;
 
     friend class MemoryChunkSwitchMessage;
+    friend class MessageRecorder;
 };
 
 class DummyMessage final : public Message {
@@ -253,6 +315,43 @@ T *MessageQueue::allocateAndZero(uint32_t const count) noexcept {
     return allocatedMemory;
 }
 
+template <typename T>
+std::enable_if_t<std::is_base_of<Message, T>::value, T *>
+MessageRecorder::allocate(uint32_t const /*count*/) noexcept {
+    T *const msg = reinterpret_cast<T *>(allocateImpl(sizeof(T)));
+    msg->_next = reinterpret_cast<Message *>(_currentMemoryChunk + _offset);
+    if (!_firstMessage) {
+        _firstMessage = msg;
+    }
+    ++_messageCount;
+    _lastMessage = msg;
+    return msg;
+}
+
+template <typename T>
+std::enable_if_t<!std::is_base_of<Message, T>::value, T *>
+MessageRecorder::allocate(uint32_t const count) noexcept {
+    uint32_t const requestSize = sizeof(T) * count;
+    CC_ASSERT(requestSize);
+    uint8_t *const allocatedMemory = allocateImpl(requestSize);
+    _lastMessage->_next = reinterpret_cast<Message *>(_currentMemoryChunk + _offset);
+    return reinterpret_cast<T *>(allocatedMemory);
+}
+
+template <typename T>
+T *MessageRecorder::allocateAndCopy(uint32_t const count, void const *data) noexcept {
+    T *const allocatedMemory = allocate<T>(count);
+    memcpy(allocatedMemory, data, sizeof(T) * count);
+    return allocatedMemory;
+}
+
+template <typename T>
+T *MessageRecorder::allocateAndZero(uint32_t const count) noexcept {
+    T *const allocatedMemory = allocate<T>(count);
+    memset(allocatedMemory, 0, sizeof(T) * count);
+    return allocatedMemory;
+}
+
 // utility macros for the producer thread to enqueue messages
 
 #define WRITE_MESSAGE(queue, MessageName, Params)                                \
@@ -25,6 +25,7 @@
 #include "core/Root.h"
 #include "2d/renderer/Batcher2d.h"
 #include "application/ApplicationManager.h"
+#include "base/threading/FrameArena.h"
 #include "bindings/event/EventDispatcher.h"
 #include "pipeline/custom/RenderingModule.h"
 #include "platform/interfaces/modules/IScreen.h"
@@ -317,7 +318,8 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
         }
         _pipeline->setBloomEnabled(false);
 
-        if (!_pipeline->activate(_mainRenderWindow->getSwapchain())) {
+        // headless roots, e.g. in native tests, have no main window
+        if (!_pipeline->activate(_mainRenderWindow ? _mainRenderWindow->getSwapchain() : nullptr)) {
             _pipeline = nullptr;
             return false;
         }
@@ -382,6 +384,11 @@ void Root::frameSync() {
 }
 
 void Root::frameMoveBegin() {
+    auto *frameArena = FrameArena::getInstance();
+    frameArena->beginFrame();
+    CC_PROFILE_RENDER_UPDATE(FrameArenaHeapAllocations, frameArena->getHeapAllocationCount());
+    CC_PROFILE_RENDER_UPDATE(FrameArenaUsedSize, frameArena->getUsedSize());
+
     for (const auto &scene : _scenes) {
         scene->removeBatches();
     }
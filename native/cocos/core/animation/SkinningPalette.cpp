@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/animation/SkinningPalette.h"
+
+#include <algorithm>
+#include <cmath>
+#include "core/geometry/AABB.h"
+#include "math/Mat4.h"
+#include "math/SIMD.h"
+#include "math/Vec3.h"
+
+namespace cc {
+
+void computeJointPalettes(const Mat4 *const *worlds, const Mat4 *const *bindposes, float *const *dsts, uint32_t count, uint32_t rowStride) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const float *w = worlds[i]->m;
+        const float *b = bindposes[i]->m;
+        float *dst = dsts[i];
+#if defined(CC_SIMD_SSE)
+        const __m128 w0 = _mm_loadu_ps(w);
+        const __m128 w1 = _mm_loadu_ps(w + 4);
+        const __m128 w2 = _mm_loadu_ps(w + 8);
+        const __m128 w3 = _mm_loadu_ps(w + 12);
+        __m128 c[4];
+        for (uint32_t j = 0; j < 4; ++j) {
+            const float *col = b + j * 4;
+            c[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, _mm_set1_ps(col[0])), _mm_mul_ps(w1, _mm_set1_ps(col[1]))),
+                              _mm_add_ps(_mm_mul_ps(w2, _mm_set1_ps(col[2])), _mm_mul_ps(w3, _mm_set1_ps(col[3]))));
+        }
+        // (c.x, c.y, c.z, t) where t is the matching lane of the translation column
+        const __m128 t0 = _mm_shuffle_ps(c[0], c[3], _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 t1 = _mm_shuffle_ps(c[1], c[3], _MM_SHUFFLE(1, 1, 2, 2));
+        const __m128 t2 = _mm_shuffle_ps(c[2], c[3], _MM_SHUFFLE(2, 2, 2, 2));
+        _mm_storeu_ps(dst, _mm_shuffle_ps(c[0], t0, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(dst + rowStride, _mm_shuffle_ps(c[1], t1, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(dst + 2 * rowStride, _mm_shuffle_ps(c[2], t2, _MM_SHUFFLE(2, 0, 1, 0)));
+#elif defined(CC_SIMD_NEON64)
+        const float32x4_t w0 = vld1q_f32(w);
+        const float32x4_t w1 = vld1q_f32(w + 4);
+        const float32x4_t w2 = vld1q_f32(w + 8);
+        const float32x4_t w3 = vld1q_f32(w + 12);
+        float32x4_t c[4];
+        for (uint32_t j = 0; j < 4; ++j) {
+            const float32x4_t col = vld1q_f32(b + j * 4);
+            c[j] = vfmaq_laneq_f32(vfmaq_laneq_f32(vfmaq_laneq_f32(vmulq_laneq_f32(w0, col, 0), w1, col, 1), w2, col, 2), w3, col, 3);
+        }
+        vst1q_f32(dst, vsetq_lane_f32(vgetq_lane_f32(c[3], 0), c[0], 3));
+        vst1q_f32(dst + rowStride, vsetq_lane_f32(vgetq_lane_f32(c[3], 1), c[1], 3));
+        vst1q_f32(dst + 2 * rowStride, vsetq_lane_f32(vgetq_lane_f32(c[3], 2), c[2], 3));
+#else
+        const float *t = b + 12;
+        for (uint32_t r = 0; r < 3; ++r) {
+            const float *col = b + r * 4;
+            float *row = dst + r * rowStride;
+            for (uint32_t k = 0; k < 3; ++k) {
+                row[k] = w[k] * col[0] + w[4 + k] * col[1] + w[8 + k] * col[2] + w[12 + k] * col[3];
+            }
+            row[3] = w[r] * t[0] + w[4 + r] * t[1] + w[8 + r] * t[2] + w[12 + r] * t[3];
+        }
+#endif
+    }
+}
+
+void computeJointBounds(const Mat4 *const *worlds, const geometry::AABB *const *bounds, uint32_t count, Vec3 *outMin, Vec3 *outMax) {
+#if defined(CC_SIMD_SSE)
+    __m128 vMin = _mm_set1_ps(INFINITY);
+    __m128 vMax = _mm_set1_ps(-INFINITY);
+    const __m128 signMask = _mm_set1_ps(-0.F);
+    for (uint32_t i = 0; i < count; ++i) {
+        const float *m = worlds[i]->m;
+        const Vec3 &center = bounds[i]->getCenter();
+        const Vec3 &extent = bounds[i]->getHalfExtents();
+        const __m128 m0 = _mm_loadu_ps(m);
+        const __m128 m1 = _mm_loadu_ps(m + 4);
+        const __m128 m2 = _mm_loadu_ps(m + 8);
+        const __m128 m3 = _mm_loadu_ps(m + 12);
+        const __m128 c = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, _mm_set1_ps(center.x)), _mm_mul_ps(m1, _mm_set1_ps(center.y))),
+                                    _mm_add_ps(_mm_mul_ps(m2, _mm_set1_ps(center.z)), m3));
+        const __m128 e = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, m0), _mm_set1_ps(extent.x)),
+                                               _mm_mul_ps(_mm_andnot_ps(signMask, m1), _mm_set1_ps(extent.y))),
+                                    _mm_mul_ps(_mm_andnot_ps(signMask, m2), _mm_set1_ps(extent.z)));
+        vMin = _mm_min_ps(vMin, _mm_sub_ps(c, e));
+        vMax = _mm_max_ps(vMax, _mm_add_ps(c, e));
+    }
+    float lanes[8];
+    _mm_storeu_ps(lanes, vMin);
+    _mm_storeu_ps(lanes + 4, vMax);
+    outMin->set(lanes[0], lanes[1], lanes[2]);
+    outMax->set(lanes[4], lanes[5], lanes[6]);
+#elif defined(CC_SIMD_NEON64)
+    float32x4_t vMin = vdupq_n_f32(INFINITY);
+    float32x4_t vMax = vdupq_n_f32(-INFINITY);
+    for (uint32_t i = 0; i < count; ++i) {
+        const float *m = worlds[i]->m;
+        const Vec3 &center = bounds[i]->getCenter();
+        const Vec3 &extent = bounds[i]->getHalfExtents();
+        const float32x4_t m0 = vld1q_f32(m);
+        const float32x4_t m1 = vld1q_f32(m + 4);
+        const float32x4_t m2 = vld1q_f32(m + 8);
+        const float32x4_t m3 = vld1q_f32(m + 12);
+        const float32x4_t c = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(m3, m0, center.x), m1, center.y), m2, center.z);
+        const float32x4_t e = vfmaq_n_f32(vfmaq_n_f32(vmulq_n_f32(vabsq_f32(m0), extent.x), vabsq_f32(m1), extent.y), vabsq_f32(m2), extent.z);
+        vMin = vminq_f32(vMin, vsubq_f32(c, e));
+        vMax = vmaxq_f32(vMax, vaddq_f32(c, e));
+    }
+    outMin->set(vgetq_lane_f32(vMin, 0), vgetq_lane_f32(vMin, 1), vgetq_lane_f32(vMin, 2));
+    outMax->set(vgetq_lane_f32(vMax, 0), vgetq_lane_f32(vMax, 1), vgetq_lane_f32(vMax, 2));
+#else
+    float vMin[3] = {INFINITY, INFINITY, INFINITY};
+    float vMax[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < count; ++i) {
+        const float *m = worlds[i]->m;
+        const Vec3 &center = bounds[i]->getCenter();
+        const Vec3 &extent = bounds[i]->getHalfExtents();
+        for (uint32_t r = 0; r < 3; ++r) {
+            const float c = m[r] * center.x + m[4 + r] * center.y + m[8 + r] * center.z + m[12 + r];
+            const float e = std::abs(m[r]) * extent.x + std::abs(m[4 + r]) * extent.y + std::abs(m[8 + r]) * extent.z;
+            vMin[r] = std::min(vMin[r], c - e);
+            vMax[r] = std::max(vMax[r], c + e);
+        }
+    }
+    outMin->set(vMin[0], vMin[1], vMin[2]);
+    outMax->set(vMax[0], vMax[1], vMax[2]);
+#endif
+}
+
+} // namespace cc
@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+
+namespace cc {
+
+class Mat4;
+class Vec3;
+namespace geometry {
+class AABB;
+}
+
+/**
+ * @en Number of floats of one joint in a skinning palette, a 4x3 matrix stored as three rows.
+ * @zh 蒙皮矩阵调色板中单个骨骼所占的浮点数个数，即按三行存储的 4x3 矩阵。
+ */
+constexpr uint32_t JOINT_PALETTE_STRIDE = 12;
+
+/**
+ * @en
+ * Compute worlds[i] * bindposes[i] for all joints in one pass with SIMD, and write the results
+ * in the layout of UBOSkinning and the real-time joint texture: row r of joint i holds column r
+ * of the product with the r-th translation component in its fourth lane, and is written to
+ * dsts[i] + r * rowStride.
+ * @zh
+ * 使用 SIMD 一次性计算所有骨骼的 worlds[i] * bindposes[i]，并按 UBOSkinning 与实时骨骼贴图的布局写出：
+ * 第 i 个骨骼的第 r 行为乘积的第 r 列，第四个分量为平移的第 r 个分量，写入 dsts[i] + r * rowStride。
+ * @param rowStride @en Distance in floats between two rows of one joint, 4 for uniform buffers.
+ * @zh 同一骨骼相邻两行之间相隔的浮点数个数，uniform buffer 为 4。
+ */
+void computeJointPalettes(const Mat4 *const *worlds, const Mat4 *const *bindposes, float *const *dsts, uint32_t count, uint32_t rowStride);
+
+/**
+ * @en
+ * Transform bounds[i] by worlds[i] for all joints and merge the results with vectorized min/max.
+ * outMin and outMax are left at +/-infinity when count is 0.
+ * @zh
+ * 将所有 bounds[i] 变换到 worlds[i] 下，并用向量化的 min/max 合并结果。count 为 0 时 outMin 与 outMax 为正负无穷。
+ */
+void computeJointBounds(const Mat4 *const *worlds, const geometry::AABB *const *bounds, uint32_t count, Vec3 *outMin, Vec3 *outMax);
+
+} // namespace cc
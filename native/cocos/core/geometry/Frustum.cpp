@@ -25,6 +25,7 @@
 #include "core/geometry/Frustum.h"
 #include <cmath>
 #include "core/geometry/Enums.h"
+#include "core/geometry/FrustumCulling.h"
 #include "scene/Define.h"
 
 namespace cc {
@@ -160,6 +161,10 @@ void Frustum::split(float near, float far, float aspect, float fov, const Mat4 &
     createPerspective(this, fov, aspect, near, far, transform);
 }
 
+void Frustum::cullAABBs(const AABBSoA &aabbs, uint8_t *outMask) const {
+    aabbsFrustum(aabbs, *this, outMask);
+}
+
 void Frustum::updatePlanes() {
     // left plane
     planes[0]->define(vertices[1], vertices[6], vertices[5]);
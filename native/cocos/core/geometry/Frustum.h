@@ -35,6 +35,8 @@
 namespace cc {
 namespace geometry {
 
+class AABBSoA;
+
 class Frustum final : public ShapeBase {
 public:
     /**
@@ -196,6 +198,18 @@ public:
         setType(accurate ? ShapeEnum::SHAPE_FRUSTUM_ACCURATE : ShapeEnum::SHAPE_FRUSTUM);
     }
 
+    /**
+     * @en
+     * Cull a batch of bounding boxes against this frustum with SIMD.
+     * outMask[i] is set to 1 if box i is not completely outside this frustum, otherwise 0.
+     * @zh
+     * 使用 SIMD 批量剔除包围盒。
+     * 若第 i 个包围盒不完全在此视锥体外，则 outMask[i] 为 1，否则为 0。
+     * @param aabbs @en The bounding boxes. @zh 包围盒集合。
+     * @param outMask @en At least aabbs.size() bytes. @zh 长度至少为 aabbs.size() 的输出数组。
+     */
+    void cullAABBs(const AABBSoA &aabbs, uint8_t *outMask) const;
+
     ccstd::array<Vec3, 8> vertices;
     ccstd::array<Plane *, 6> planes;
 
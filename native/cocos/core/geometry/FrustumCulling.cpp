@@ -0,0 +1,301 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "core/geometry/FrustumCulling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "base/Macros.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "core/geometry/Plane.h"
+#include "math/SIMD.h"
+
+namespace cc {
+namespace geometry {
+
+uint32_t FrustumSoA::addFrustum(const Frustum &frustum) {
+    CC_ASSERT(_frustumCount < MAX_FRUSTUM_COUNT);
+    const uint32_t base = _frustumCount * PLANES_PER_FRUSTUM;
+    for (uint32_t i = 0; i < PLANES_PER_FRUSTUM; ++i) {
+        const uint32_t idx = base + i;
+        if (i < frustum.planes.size()) {
+            const Plane &plane = *frustum.planes[i];
+            _nx[idx] = plane.n.x;
+            _ny[idx] = plane.n.y;
+            _nz[idx] = plane.n.z;
+            _d[idx] = plane.d;
+        } else {
+            // padding plane, every box is completely inside it
+            _nx[idx] = _ny[idx] = _nz[idx] = 0.0F;
+            _d[idx] = -std::numeric_limits<float>::max();
+        }
+        _absNx[idx] = std::abs(_nx[idx]);
+        _absNy[idx] = std::abs(_ny[idx]);
+        _absNz[idx] = std::abs(_nz[idx]);
+    }
+    return _frustumCount++;
+}
+
+// Same plane test as aabbPlane in Intersect.cpp, frustum plane normals point to the inside:
+// outside if dot(n, c) + r < d, inside if dot(n, c) - r > d, where r = dot(|n|, halfExtents).
+void FrustumSoA::aabbFrustums(const AABB &aabb, uint32_t *visibleMask, uint32_t *insideMask) const {
+    const Vec3 &c = aabb.center;
+    const Vec3 &h = aabb.halfExtents;
+    uint32_t visible = 0;
+    uint32_t inside = 0;
+
+#if defined(CC_SIMD_SSE)
+    const __m128 cx = _mm_set1_ps(c.x);
+    const __m128 cy = _mm_set1_ps(c.y);
+    const __m128 cz = _mm_set1_ps(c.z);
+    const __m128 hx = _mm_set1_ps(h.x);
+    const __m128 hy = _mm_set1_ps(h.y);
+    const __m128 hz = _mm_set1_ps(h.z);
+    for (uint32_t f = 0; f < _frustumCount; ++f) {
+        __m128 anyOutside = _mm_setzero_ps();
+        __m128 allInside = _mm_cmpeq_ps(anyOutside, anyOutside);
+        for (uint32_t i = f * PLANES_PER_FRUSTUM; i < (f + 1) * PLANES_PER_FRUSTUM; i += 4) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_load_ps(_nx + i)), _mm_mul_ps(cy, _mm_load_ps(_ny + i))), _mm_mul_ps(cz, _mm_load_ps(_nz + i)));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, _mm_load_ps(_absNx + i)), _mm_mul_ps(hy, _mm_load_ps(_absNy + i))), _mm_mul_ps(hz, _mm_load_ps(_absNz + i)));
+            const __m128 d = _mm_load_ps(_d + i);
+            anyOutside = _mm_or_ps(anyOutside, _mm_cmplt_ps(_mm_add_ps(dot, r), d));
+            allInside = _mm_and_ps(allInside, _mm_cmpgt_ps(_mm_sub_ps(dot, r), d));
+        }
+        if (_mm_movemask_ps(anyOutside) == 0) {
+            visible |= 1U << f;
+        }
+        if (_mm_movemask_ps(allInside) == 0xF) {
+            inside |= 1U << f;
+        }
+    }
+#elif defined(CC_SIMD_NEON64)
+    const float32x4_t cx = vdupq_n_f32(c.x);
+    const float32x4_t cy = vdupq_n_f32(c.y);
+    const float32x4_t cz = vdupq_n_f32(c.z);
+    const float32x4_t hx = vdupq_n_f32(h.x);
+    const float32x4_t hy = vdupq_n_f32(h.y);
+    const float32x4_t hz = vdupq_n_f32(h.z);
+    for (uint32_t f = 0; f < _frustumCount; ++f) {
+        uint32x4_t anyOutside = vdupq_n_u32(0);
+        uint32x4_t allInside = vdupq_n_u32(~0U);
+        for (uint32_t i = f * PLANES_PER_FRUSTUM; i < (f + 1) * PLANES_PER_FRUSTUM; i += 4) {
+            const float32x4_t dot = vmlaq_f32(vmlaq_f32(vmulq_f32(cx, vld1q_f32(_nx + i)), cy, vld1q_f32(_ny + i)), cz, vld1q_f32(_nz + i));
+            const float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(hx, vld1q_f32(_absNx + i)), hy, vld1q_f32(_absNy + i)), hz, vld1q_f32(_absNz + i));
+            const float32x4_t d = vld1q_f32(_d + i);
+            anyOutside = vorrq_u32(anyOutside, vcltq_f32(vaddq_f32(dot, r), d));
+            allInside = vandq_u32(allInside, vcgtq_f32(vsubq_f32(dot, r), d));
+        }
+        if (vmaxvq_u32(anyOutside) == 0) {
+            visible |= 1U << f;
+        }
+        if (vminvq_u32(allInside) != 0) {
+            inside |= 1U << f;
+        }
+    }
+#else
+    for (uint32_t f = 0; f < _frustumCount; ++f) {
+        bool anyOutside = false;
+        bool allInside = true;
+        for (uint32_t i = f * PLANES_PER_FRUSTUM; i < (f + 1) * PLANES_PER_FRUSTUM; ++i) {
+            const float dot = c.x * _nx[i] + c.y * _ny[i] + c.z * _nz[i];
+            const float r = h.x * _absNx[i] + h.y * _absNy[i] + h.z * _absNz[i];
+            anyOutside = anyOutside || (dot + r < _d[i]);
+            allInside = allInside && (dot - r > _d[i]);
+        }
+        if (!anyOutside) {
+            visible |= 1U << f;
+        }
+        if (allInside) {
+            inside |= 1U << f;
+        }
+    }
+#endif
+
+    *visibleMask = visible;
+    *insideMask = inside;
+}
+
+namespace {
+// half extents of an empty box, it's outside of any plane
+constexpr float EMPTY_HALF_EXTENT = -std::numeric_limits<float>::max();
+
+inline uint32_t alignToLanes(uint32_t size) {
+    return (size + AABBSoA::LANE_COUNT - 1) / AABBSoA::LANE_COUNT * AABBSoA::LANE_COUNT;
+}
+} // namespace
+
+uint32_t AABBSoA::add(const AABB &aabb) {
+    resizeLanes(_size + 1);
+    set(_size - 1, aabb);
+    return _size - 1;
+}
+
+uint32_t AABBSoA::addEmpty() {
+    resizeLanes(_size + 1);
+    return _size - 1;
+}
+
+void AABBSoA::set(uint32_t index, const AABB &aabb) {
+    CC_ASSERT(index < _size);
+    _centerX[index] = aabb.center.x;
+    _centerY[index] = aabb.center.y;
+    _centerZ[index] = aabb.center.z;
+    _halfExtentX[index] = aabb.halfExtents.x;
+    _halfExtentY[index] = aabb.halfExtents.y;
+    _halfExtentZ[index] = aabb.halfExtents.z;
+}
+
+void AABBSoA::setEmpty(uint32_t index) {
+    CC_ASSERT(index < _size);
+    _centerX[index] = _centerY[index] = _centerZ[index] = 0.0F;
+    _halfExtentX[index] = _halfExtentY[index] = _halfExtentZ[index] = EMPTY_HALF_EXTENT;
+}
+
+void AABBSoA::erase(uint32_t index) {
+    CC_ASSERT(index < _size);
+    for (auto *arr : {&_centerX, &_centerY, &_centerZ, &_halfExtentX, &_halfExtentY, &_halfExtentZ}) {
+        arr->erase(arr->begin() + index);
+    }
+    resizeLanes(_size - 1);
+}
+
+void AABBSoA::clear() {
+    resizeLanes(0);
+}
+
+void AABBSoA::resizeLanes(uint32_t size) {
+    // new boxes and padding lanes are empty boxes
+    const uint32_t laneCount = alignToLanes(size);
+    _centerX.resize(laneCount, 0.0F);
+    _centerY.resize(laneCount, 0.0F);
+    _centerZ.resize(laneCount, 0.0F);
+    _halfExtentX.resize(laneCount, EMPTY_HALF_EXTENT);
+    _halfExtentY.resize(laneCount, EMPTY_HALF_EXTENT);
+    _halfExtentZ.resize(laneCount, EMPTY_HALF_EXTENT);
+    _size = size;
+}
+
+void aabbsFrustum(const AABBSoA &aabbs, const Frustum &frustum, uint8_t *outMask) {
+    const uint32_t size = aabbs.size();
+    const float *cx = aabbs.getCenterX();
+    const float *cy = aabbs.getCenterY();
+    const float *cz = aabbs.getCenterZ();
+    const float *hx = aabbs.getHalfExtentX();
+    const float *hy = aabbs.getHalfExtentY();
+    const float *hz = aabbs.getHalfExtentZ();
+    constexpr uint32_t PLANE_COUNT = 6;
+
+#if defined(CC_SIMD_SSE)
+    __m128 nx[PLANE_COUNT];
+    __m128 ny[PLANE_COUNT];
+    __m128 nz[PLANE_COUNT];
+    __m128 absNx[PLANE_COUNT];
+    __m128 absNy[PLANE_COUNT];
+    __m128 absNz[PLANE_COUNT];
+    __m128 d[PLANE_COUNT];
+    for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+        const Plane &plane = *frustum.planes[p];
+        nx[p] = _mm_set1_ps(plane.n.x);
+        ny[p] = _mm_set1_ps(plane.n.y);
+        nz[p] = _mm_set1_ps(plane.n.z);
+        absNx[p] = _mm_set1_ps(std::abs(plane.n.x));
+        absNy[p] = _mm_set1_ps(std::abs(plane.n.y));
+        absNz[p] = _mm_set1_ps(std::abs(plane.n.z));
+        d[p] = _mm_set1_ps(plane.d);
+    }
+    for (uint32_t i = 0; i < size; i += AABBSoA::LANE_COUNT) {
+        const __m128 x = _mm_loadu_ps(cx + i);
+        const __m128 y = _mm_loadu_ps(cy + i);
+        const __m128 z = _mm_loadu_ps(cz + i);
+        const __m128 ex = _mm_loadu_ps(hx + i);
+        const __m128 ey = _mm_loadu_ps(hy + i);
+        const __m128 ez = _mm_loadu_ps(hz + i);
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, nx[p]), _mm_mul_ps(y, ny[p])), _mm_mul_ps(z, nz[p]));
+            const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, absNx[p]), _mm_mul_ps(ey, absNy[p])), _mm_mul_ps(ez, absNz[p]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), d[p]));
+        }
+        const int bits = _mm_movemask_ps(outside);
+        const uint32_t count = std::min(AABBSoA::LANE_COUNT, size - i);
+        for (uint32_t j = 0; j < count; ++j) {
+            outMask[i + j] = (bits >> j) & 1 ? 0 : 1;
+        }
+    }
+#elif defined(CC_SIMD_NEON64)
+    float32x4_t nx[PLANE_COUNT];
+    float32x4_t ny[PLANE_COUNT];
+    float32x4_t nz[PLANE_COUNT];
+    float32x4_t absNx[PLANE_COUNT];
+    float32x4_t absNy[PLANE_COUNT];
+    float32x4_t absNz[PLANE_COUNT];
+    float32x4_t d[PLANE_COUNT];
+    for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+        const Plane &plane = *frustum.planes[p];
+        nx[p] = vdupq_n_f32(plane.n.x);
+        ny[p] = vdupq_n_f32(plane.n.y);
+        nz[p] = vdupq_n_f32(plane.n.z);
+        absNx[p] = vdupq_n_f32(std::abs(plane.n.x));
+        absNy[p] = vdupq_n_f32(std::abs(plane.n.y));
+        absNz[p] = vdupq_n_f32(std::abs(plane.n.z));
+        d[p] = vdupq_n_f32(plane.d);
+    }
+    for (uint32_t i = 0; i < size; i += AABBSoA::LANE_COUNT) {
+        const float32x4_t x = vld1q_f32(cx + i);
+        const float32x4_t y = vld1q_f32(cy + i);
+        const float32x4_t z = vld1q_f32(cz + i);
+        const float32x4_t ex = vld1q_f32(hx + i);
+        const float32x4_t ey = vld1q_f32(hy + i);
+        const float32x4_t ez = vld1q_f32(hz + i);
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < PLANE_COUNT; ++p) {
+            const float32x4_t dot = vmlaq_f32(vmlaq_f32(vmulq_f32(x, nx[p]), y, ny[p]), z, nz[p]);
+            const float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(ex, absNx[p]), ey, absNy[p]), ez, absNz[p]);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), d[p]));
+        }
+        uint32_t lanes[AABBSoA::LANE_COUNT];
+        vst1q_u32(lanes, outside);
+        const uint32_t count = std::min(AABBSoA::LANE_COUNT, size - i);
+        for (uint32_t j = 0; j < count; ++j) {
+            outMask[i + j] = lanes[j] ? 0 : 1;
+        }
+    }
+#else
+    for (uint32_t i = 0; i < size; ++i) {
+        bool outside = false;
+        for (uint32_t p = 0; p < PLANE_COUNT && !outside; ++p) {
+            const Plane &plane = *frustum.planes[p];
+            const float dot = cx[i] * plane.n.x + cy[i] * plane.n.y + cz[i] * plane.n.z;
+            const float r = hx[i] * std::abs(plane.n.x) + hy[i] * std::abs(plane.n.y) + hz[i] * std::abs(plane.n.z);
+            outside = dot + r < plane.d;
+        }
+        outMask[i] = outside ? 0 : 1;
+    }
+#endif
+}
+
+} // namespace geometry
+} // namespace cc
@@ -0,0 +1,157 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace geometry {
+
+class AABB;
+class Frustum;
+
+/**
+ * @en
+ * Planes of several frustums stored as structure of arrays, so that one AABB can be tested
+ * against all of them in a single pass with SIMD.
+ * @zh
+ * 以 SoA 形式存储的多个视锥体的平面，可以用 SIMD 一次性测试一个 AABB 与所有视锥体的相交情况。
+ */
+class FrustumSoA final {
+public:
+    static constexpr uint32_t MAX_FRUSTUM_COUNT = 8;
+
+    /**
+     * @en Remove all frustums.
+     * @zh 清空所有视锥体。
+     */
+    inline void clear() { _frustumCount = 0; }
+
+    /**
+     * @en Append a frustum, return its index which is also its bit in the result masks.
+     * @zh 添加一个视锥体，返回其索引，即其在结果掩码中的位。
+     */
+    uint32_t addFrustum(const Frustum &frustum);
+
+    inline uint32_t getFrustumCount() const { return _frustumCount; }
+
+    /**
+     * @en
+     * Test an AABB against all frustums.
+     * Bit i of visibleMask is set if the AABB is not completely outside frustum i,
+     * bit i of insideMask is set if the AABB is completely inside frustum i.
+     * @zh
+     * 测试 AABB 与所有视锥体的关系。
+     * 若 AABB 不完全在第 i 个视锥体外，则 visibleMask 的第 i 位为 1；
+     * 若 AABB 完全在第 i 个视锥体内，则 insideMask 的第 i 位为 1。
+     */
+    void aabbFrustums(const AABB &aabb, uint32_t *visibleMask, uint32_t *insideMask) const;
+
+private:
+    // 6 planes per frustum, padded to two 4-wide vectors with planes that always pass.
+    static constexpr uint32_t PLANES_PER_FRUSTUM = 8;
+    static constexpr uint32_t MAX_PLANE_COUNT = MAX_FRUSTUM_COUNT * PLANES_PER_FRUSTUM;
+
+    alignas(16) float _nx[MAX_PLANE_COUNT]{};
+    alignas(16) float _ny[MAX_PLANE_COUNT]{};
+    alignas(16) float _nz[MAX_PLANE_COUNT]{};
+    alignas(16) float _absNx[MAX_PLANE_COUNT]{};
+    alignas(16) float _absNy[MAX_PLANE_COUNT]{};
+    alignas(16) float _absNz[MAX_PLANE_COUNT]{};
+    alignas(16) float _d[MAX_PLANE_COUNT]{};
+    uint32_t _frustumCount{0};
+};
+
+/**
+ * @en
+ * Axis aligned bounding boxes stored as structure of arrays for batched culling.
+ * Arrays are padded to a multiple of LANE_COUNT so that SIMD kernels can always load full vectors.
+ * @zh
+ * 以 SoA 形式存储的轴对齐包围盒，用于批量剔除。
+ * 数组长度补齐到 LANE_COUNT 的整数倍，以便 SIMD 内核总是读取完整的向量。
+ */
+class AABBSoA final {
+public:
+    static constexpr uint32_t LANE_COUNT = 4;
+
+    /**
+     * @en Append a box, return its index.
+     * @zh 添加一个包围盒，返回其索引。
+     */
+    uint32_t add(const AABB &aabb);
+
+    /**
+     * @en Append an empty box which is never visible, return its index.
+     * @zh 添加一个永远不可见的空包围盒，返回其索引。
+     */
+    uint32_t addEmpty();
+
+    void set(uint32_t index, const AABB &aabb);
+    void setEmpty(uint32_t index);
+
+    /**
+     * @en Remove the box at index, following boxes are moved forward by one.
+     * @zh 移除指定索引的包围盒，其后的包围盒索引减一。
+     */
+    void erase(uint32_t index);
+    void clear();
+
+    inline uint32_t size() const { return _size; }
+    inline const float *getCenterX() const { return _centerX.data(); }
+    inline const float *getCenterY() const { return _centerY.data(); }
+    inline const float *getCenterZ() const { return _centerZ.data(); }
+    inline const float *getHalfExtentX() const { return _halfExtentX.data(); }
+    inline const float *getHalfExtentY() const { return _halfExtentY.data(); }
+    inline const float *getHalfExtentZ() const { return _halfExtentZ.data(); }
+
+private:
+    void resizeLanes(uint32_t size);
+
+    ccstd::vector<float> _centerX;
+    ccstd::vector<float> _centerY;
+    ccstd::vector<float> _centerZ;
+    ccstd::vector<float> _halfExtentX;
+    ccstd::vector<float> _halfExtentY;
+    ccstd::vector<float> _halfExtentZ;
+    uint32_t _size{0};
+};
+
+/**
+ * @en
+ * Batched aabb-frustum intersect detect, same test as aabbFrustum.
+ * outMask[i] is set to 1 if box i is not completely outside the frustum, otherwise 0.
+ * @zh
+ * 批量的 aabb-frustum 相交检测，与 aabbFrustum 的判定一致。
+ * 若第 i 个包围盒不完全在视锥体外，则 outMask[i] 为 1，否则为 0。
+ * @param aabbs @en The bounding boxes. @zh 包围盒集合。
+ * @param frustum @en The frustum. @zh 视锥体。
+ * @param outMask @en At least aabbs.size() bytes. @zh 长度至少为 aabbs.size() 的输出数组。
+ */
+void aabbsFrustum(const AABBSoA &aabbs, const Frustum &frustum, uint8_t *outMask);
+
+} // namespace geometry
+} // namespace cc
@@ -40,6 +40,8 @@ uint32_t Node::clearFrame{0};
 uint32_t Node::clearRound{1000};
 const uint32_t Node::TRANSFORM_ON{1 << 0};
 uint32_t Node::globalFlagChangeVersion{0};
+uint32_t Node::hierarchyVersion{0};
+ccstd::vector<Node *> Node::dirtyTransformRoots;
 
 namespace {
 const ccstd::string EMPTY_NODE_NAME;
@@ -171,6 +173,7 @@ void Node::setParent(Node *parent, bool isKeepWorld /* = false */) {
 #endif
     _parent = newParent;
     _siblingIndex = 0;
+    ++hierarchyVersion;
     onSetParent(oldParent, isKeepWorld);
     emit<ParentChanged>(oldParent);
     if (oldParent) {
@@ -258,6 +261,7 @@ bool Node::onPreDestroyBase() {
             index_t childIdx = getIdxOfChild(_parent->_children, this);
             if (childIdx != -1) {
                 _parent->_children.erase(_parent->_children.begin() + childIdx);
+                ++hierarchyVersion;
             }
             _siblingIndex = 0;
             _parent->updateSiblingIndex();
@@ -493,6 +497,11 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { // NOLINT(misc-n
         parent->updateWorldTransformRecursive(dirtyBits);
     }
     dirtyBits |= currDirtyBits;
+    updateWorldTransformFromParent(dirtyBits);
+}
+
+void Node::updateWorldTransformFromParent(uint32_t dirtyBits) {
+    Node *parent = getParent();
     bool positionDirty = dirtyBits & static_cast<uint32_t>(TransformBit::POSITION);
     bool rotationScaleSkewDirty = dirtyBits & static_cast<uint32_t>(TransformBit::RSS);
     if (parent) {
@@ -503,8 +512,9 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { // NOLINT(misc-n
             _worldMatrix.m[14] = _worldPosition.z;
         }
         if (rotationScaleSkewDirty) {
-            static Mat4 tempMat4;
-            static Mat4 localMatrix;
+            // Temporaries live on the stack, nodes of the same level may be resolved on different threads.
+            Mat4 tempMat4;
+            Mat4 localMatrix;
             Mat4 *originalWorldMatrix = &_worldMatrix;
             Mat4::fromRTS(_localRotation, _localPosition, _localScale, &localMatrix);
             if (_hasSkewComp) {
@@ -541,7 +551,7 @@ void Node::updateWorldTransformRecursive(uint32_t &dirtyBits) { // NOLINT(misc-n
             }
         }
     }
-    
+
     _transformFlags = (static_cast<uint32_t>(TransformBit::NONE));
 }
 
@@ -569,6 +579,10 @@ void Node::invalidateChildren(TransformBit dirtyBit) { // NOLINT(misc-no-recursi
     const uint32_t hasChangedFlags = getChangedFlags();
     const uint32_t transformFlags = _transformFlags;
     if (isValid() && (transformFlags & hasChangedFlags & curDirtyBit) != curDirtyBit) {
+        // the root of a dirty subtree, children of dirty nodes are reached through it
+        if (!transformFlags && (!_parent || !_parent->_transformFlags) && dirtyTransformRoots.size() < MAX_DIRTY_TRANSFORM_ROOTS) {
+            dirtyTransformRoots.emplace_back(this);
+        }
         _transformFlags = (transformFlags | curDirtyBit);
         setChangedFlags(hasChangedFlags | curDirtyBit);
 
@@ -1022,11 +1036,13 @@ void Node::onHierarchyChanged(Node *oldParent) {
 //
 void Node::_setChildren(ccstd::vector<IntrusivePtr<Node>> &&children) {
     _children = std::move(children);
+    ++hierarchyVersion;
 }
 
 void Node::destruct() {
     CCObject::destruct();
     _children.clear();
+    ++hierarchyVersion;
     _scene = nullptr;
     _userData = nullptr;
 }
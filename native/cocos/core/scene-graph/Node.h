@@ -617,6 +617,7 @@ private:
 
     void inverseTransformPointRecursive(Vec3 &out) const;
     void updateWorldTransformRecursive(uint32_t &superDirtyBits);
+    void updateWorldTransformFromParent(uint32_t dirtyBits);
     void updateLocalMatrixBySkew(Mat4 *outLocalMatrix);
 
     inline void notifyLocalPositionUpdated() {
@@ -646,6 +647,12 @@ private:
 
     // increase on every frame, used to identify the frame
     static uint32_t globalFlagChangeVersion;
+    // increase on every parent or children change, used to invalidate cached hierarchies
+    static uint32_t hierarchyVersion;
+    // nodes dirtied by invalidateChildren while their parent was up to date, handed out to every TransformSolver on the next solve
+    static ccstd::vector<Node *> dirtyTransformRoots;
+    // dirtyTransformRoots stops growing at this size, a full solve is needed then
+    static constexpr uint32_t MAX_DIRTY_TRANSFORM_ROOTS{4096};
 
     static uint32_t clearFrame;
     static uint32_t clearRound;
@@ -690,6 +697,7 @@ private:
 
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformSolver;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Node);
 };
@@ -28,6 +28,7 @@
 #include "core/Root.h"
 //#include "core/scene-graph/NodeActivator.h"
 #include "engine/EngineEvents.h"
+#include "scene/RenderScene.h"
 
 namespace cc {
 
@@ -37,13 +38,18 @@ Scene::Scene(const ccstd::string &name)
     //    _activeInHierarchy = false;
     if (Root::getInstance() != nullptr) {
         _renderScene = Root::getInstance()->createScene({});
+        _renderScene->setRootNode(this);
     }
     _globals = ccnew SceneGlobals();
 }
 
 Scene::Scene() : Scene("") {}
 
-Scene::~Scene() = default;
+Scene::~Scene() {
+    if (_renderScene != nullptr) {
+        _renderScene->setRootNode(nullptr);
+    }
+}
 
 void Scene::setSceneGlobals(SceneGlobals *globals) { _globals = globals; }
 
@@ -105,6 +111,7 @@ bool Scene::destroy() {
     }
 
     if (_renderScene != nullptr) {
+        _renderScene->setRootNode(nullptr);
         Root::getInstance()->destroyScene(_renderScene);
     }
 
@@ -0,0 +1,284 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "core/scene-graph/TransformSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include "base/job-system/JobSystem.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+namespace {
+constexpr uint32_t PARALLEL_SOLVE_THRESHOLD = 4096; // solve a level in parallel if it has more nodes than this value
+constexpr uint32_t PARALLEL_SOLVE_CHUNK_SIZE = 1024;
+} // namespace
+
+ccstd::vector<TransformSolver *> TransformSolver::solvers;
+
+TransformSolver::TransformSolver() {
+    solvers.emplace_back(this);
+}
+
+TransformSolver::~TransformSolver() {
+    solvers.erase(std::find(solvers.begin(), solvers.end(), this));
+}
+
+void TransformSolver::distributeDirtyRoots() {
+    // roots dirtied since the last solve of any solver, each solver keeps the ones of its own hierarchy
+    const bool overflowed = Node::dirtyTransformRoots.size() >= Node::MAX_DIRTY_TRANSFORM_ROOTS;
+    for (auto *solver : solvers) {
+        solver->takeDirtyRoots(overflowed);
+    }
+    Node::dirtyTransformRoots.clear();
+}
+
+void TransformSolver::takeDirtyRoots(bool overflowed) {
+    // a hierarchy that is going to be rebuilt is walked completely anyway
+    if (!_root || _hierarchyVersion != Node::hierarchyVersion || _dirtyRootsOverflowed) {
+        return;
+    }
+    if (overflowed) {
+        _dirtyRoots.clear();
+        _dirtyRootsOverflowed = true;
+        return;
+    }
+    // nodes are only looked up here, the dirty roots may contain nodes of other hierarchies or destroyed ones
+    for (const Node *node : Node::dirtyTransformRoots) {
+        auto iter = _nodeIndices.find(node);
+        if (iter == _nodeIndices.end()) {
+            continue;
+        }
+        if (_dirtyRoots.size() >= Node::MAX_DIRTY_TRANSFORM_ROOTS) {
+            _dirtyRoots.clear();
+            _dirtyRootsOverflowed = true;
+            return;
+        }
+        _dirtyRoots.emplace_back(iter->second);
+    }
+}
+
+void TransformSolver::reset() {
+    _nodes.clear();
+    _parentIndices.clear();
+    _levelOffsets.clear();
+    _childOffsets.clear();
+    _nodeIndices.clear();
+    _dirtyBits.clear();
+    _visitStamps.clear();
+    _dirtyRoots.clear();
+    _dirtyRootsOverflowed = false;
+    _root = nullptr;
+    _updatedNodeCount = 0;
+    _visitedNodeCount = 0;
+}
+
+void TransformSolver::rebuild(Node *root) {
+    _nodes.clear();
+    _parentIndices.clear();
+    _levelOffsets.clear();
+    _childOffsets.clear();
+    _nodeIndices.clear();
+
+    _nodes.emplace_back(root);
+    _parentIndices.emplace_back(-1);
+    _levelOffsets.emplace_back(0);
+
+    // breadth first, the nodes of the previous level are the parents of the current one
+    uint32_t levelBegin = 0;
+    while (levelBegin < _nodes.size()) {
+        const auto levelEnd = static_cast<uint32_t>(_nodes.size());
+        _levelOffsets.emplace_back(levelEnd);
+        for (uint32_t i = levelBegin; i < levelEnd; ++i) {
+            _childOffsets.emplace_back(static_cast<uint32_t>(_nodes.size()));
+            for (const auto &child : _nodes[i]->_children) {
+                if (child) {
+                    _nodes.emplace_back(child.get());
+                    _parentIndices.emplace_back(static_cast<int32_t>(i));
+                }
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    _childOffsets.emplace_back(static_cast<uint32_t>(_nodes.size()));
+
+    const auto nodeCount = static_cast<uint32_t>(_nodes.size());
+    _nodeIndices.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        _nodeIndices.emplace(_nodes[i], i);
+    }
+
+    _dirtyBits.assign(nodeCount, 0);
+    _visitStamps.assign(nodeCount, 0);
+    _visitStamp = 0;
+    _dirtyRoots.clear();
+    _dirtyRootsOverflowed = false;
+    _root = root;
+    _hierarchyVersion = Node::hierarchyVersion;
+}
+
+void TransformSolver::collectDirtySubtrees() {
+    _subtreeRoots.assign(_dirtyRoots.begin(), _dirtyRoots.end());
+    _subtreeNodes.clear();
+    _subtreeLevelOffsets.clear();
+
+    if (_nodes[0]->_transformFlags) {
+        _subtreeRoots.emplace_back(0);
+    }
+    // breadth first order puts ancestors before their descendants
+    std::sort(_subtreeRoots.begin(), _subtreeRoots.end());
+
+    if (++_visitStamp == 0) {
+        std::fill(_visitStamps.begin(), _visitStamps.end(), 0);
+        _visitStamp = 1;
+    }
+    uint32_t rootCount = 0;
+    for (const uint32_t rootIndex : _subtreeRoots) {
+        // already reached from a previous root
+        if (_visitStamps[rootIndex] == _visitStamp) {
+            continue;
+        }
+        _visitStamps[rootIndex] = _visitStamp;
+        _subtreeRoots[rootCount++] = rootIndex;
+
+        auto next = static_cast<uint32_t>(_subtreeNodes.size());
+        for (uint32_t i = _childOffsets[rootIndex]; i < _childOffsets[rootIndex + 1]; ++i) {
+            _subtreeNodes.emplace_back(i);
+        }
+        while (next < _subtreeNodes.size()) {
+            const uint32_t index = _subtreeNodes[next++];
+            _visitStamps[index] = _visitStamp;
+            for (uint32_t i = _childOffsets[index]; i < _childOffsets[index + 1]; ++i) {
+                _subtreeNodes.emplace_back(i);
+            }
+        }
+    }
+    _subtreeRoots.resize(rootCount);
+
+    // sorted indices are depth sorted, split them with the levels of the whole hierarchy
+    std::sort(_subtreeNodes.begin(), _subtreeNodes.end());
+    for (const uint32_t levelOffset : _levelOffsets) {
+        _subtreeLevelOffsets.emplace_back(static_cast<uint32_t>(std::lower_bound(_subtreeNodes.begin(), _subtreeNodes.end(), levelOffset) - _subtreeNodes.begin()));
+    }
+}
+
+void TransformSolver::solveRoot(uint32_t index) {
+    // a subtree root may have a dirty parent outside of the walked nodes
+    Node *node = _nodes[index];
+    const uint32_t dirtyBits = node->_transformFlags;
+    node->updateWorldTransform();
+    _dirtyBits[index] = dirtyBits;
+    if (dirtyBits) {
+        ++_updatedNodeCount;
+    }
+    ++_visitedNodeCount;
+}
+
+uint32_t TransformSolver::solveRange(const uint32_t *indices, uint32_t begin, uint32_t end) {
+    uint32_t updatedCount = 0;
+    for (uint32_t k = begin; k < end; ++k) {
+        const uint32_t i = indices ? indices[k] : k;
+        Node *node = _nodes[i];
+        uint32_t dirtyBits = node->_transformFlags;
+        if (!dirtyBits) {
+            _dirtyBits[i] = 0;
+            continue;
+        }
+        // same as the recursive update: only a dirty parent passes its bits down
+        const int32_t parentIndex = _parentIndices[i];
+        if (parentIndex >= 0) {
+            dirtyBits |= _dirtyBits[parentIndex];
+        }
+        _dirtyBits[i] = dirtyBits;
+        node->updateWorldTransformFromParent(dirtyBits);
+        ++updatedCount;
+    }
+    return updatedCount;
+}
+
+void TransformSolver::solveLevels(const uint32_t *indices, const ccstd::vector<uint32_t> &levelOffsets, bool parallel) {
+    auto *jobSystem = JobSystem::getInstance();
+    // level 0 only holds the root, which is resolved by solveRoot
+    for (size_t level = 1; level + 1 < levelOffsets.size(); ++level) {
+        const uint32_t begin = levelOffsets[level];
+        const uint32_t end = levelOffsets[level + 1];
+        _visitedNodeCount += end - begin;
+        if (!parallel || end - begin <= PARALLEL_SOLVE_THRESHOLD) {
+            _updatedNodeCount += solveRange(indices, begin, end);
+            continue;
+        }
+
+        // nodes of a level only read their parents, which are resolved by the previous level
+        std::atomic<uint32_t> updatedCount{0};
+        const uint32_t chunkCount = (end - begin + PARALLEL_SOLVE_CHUNK_SIZE - 1) / PARALLEL_SOLVE_CHUNK_SIZE;
+        JobGraph g(jobSystem);
+        g.createForEachIndexJob(0U, chunkCount, 1U, [this, indices, begin, end, &updatedCount](uint32_t chunk) {
+            const uint32_t chunkBegin = begin + chunk * PARALLEL_SOLVE_CHUNK_SIZE;
+            const uint32_t chunkEnd = std::min(chunkBegin + PARALLEL_SOLVE_CHUNK_SIZE, end);
+            updatedCount.fetch_add(solveRange(indices, chunkBegin, chunkEnd), std::memory_order_relaxed);
+        });
+        g.run();
+        g.waitForAll();
+        _updatedNodeCount += updatedCount.load(std::memory_order_relaxed);
+    }
+}
+
+void TransformSolver::solve(Node *root) {
+    _updatedNodeCount = 0;
+    _visitedNodeCount = 0;
+    distributeDirtyRoots();
+    if (!root) {
+        reset();
+        return;
+    }
+    // the dirty roots are incomplete after a hierarchy change, or once they overflowed
+    bool fullSolve = _dirtyRootsOverflowed;
+    if (root != _root || _hierarchyVersion != Node::hierarchyVersion) {
+        rebuild(root);
+        fullSolve = true;
+    }
+
+    if (!fullSolve && _dirtyRoots.empty() && !root->_transformFlags) {
+        return;
+    }
+
+    const bool parallel = _parallelEnabled && JobSystem::getInstance()->threadCount() > 1;
+    if (fullSolve) {
+        solveRoot(0);
+        solveLevels(nullptr, _levelOffsets, parallel);
+    } else {
+        collectDirtySubtrees();
+        for (const uint32_t index : _subtreeRoots) {
+            solveRoot(index);
+        }
+        solveLevels(_subtreeNodes.data(), _subtreeLevelOffsets, parallel);
+    }
+
+    _dirtyRoots.clear();
+    _dirtyRootsOverflowed = false;
+}
+
+} // namespace cc
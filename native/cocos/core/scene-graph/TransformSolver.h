@@ -0,0 +1,128 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Resolves the world transforms of a node hierarchy breadth first.
+ * Nodes are kept in depth sorted arrays which are rebuilt only when the hierarchy changes.
+ * Only the subtrees under Node::dirtyTransformRoots are walked, level by level, and large levels are split across job system workers.
+ * Every solver keeps the dirty roots of its own hierarchy, so solvers of different hierarchies don't hide them from each other.
+ * The whole hierarchy is walked after a rebuild, or when the dirty roots overflowed.
+ * The result is the same as calling Node::updateWorldTransform on every node.
+ * @zh 以广度优先的方式解算节点树的世界变换。
+ * 节点按深度排序存储在连续数组中，仅在层级结构变化时重建。
+ * 只逐层遍历 Node::dirtyTransformRoots 下的子树，节点较多的层会拆分到 JobSystem 的工作线程上。
+ * 每个解算器保存各自节点树的脏根节点，不同节点树的解算器之间互不影响。
+ * 重建后，或脏根节点溢出时，遍历整个节点树。
+ * 结果与对每个节点调用 Node::updateWorldTransform 相同。
+ */
+class CC_DLL TransformSolver final {
+public:
+    TransformSolver();
+    ~TransformSolver();
+
+    /**
+     * @en Resolve the world transforms of root and all its descendants.
+     * @zh 解算根节点及其所有子孙节点的世界变换。
+     */
+    void solve(Node *root);
+    /**
+     * @en Drop the cached hierarchy, it is rebuilt on the next solve.
+     * @zh 清除缓存的层级结构，下次解算时重建。
+     */
+    void reset();
+
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline uint32_t getLevelCount() const { return _levelOffsets.empty() ? 0 : static_cast<uint32_t>(_levelOffsets.size() - 1); }
+    /**
+     * @en Number of nodes whose world transform was recomputed in the last solve.
+     * @zh 上一次解算中重新计算世界变换的节点数量。
+     */
+    inline uint32_t getUpdatedNodeCount() const { return _updatedNodeCount; }
+    /**
+     * @en Number of nodes walked in the last solve, dirty or not.
+     * @zh 上一次解算中遍历的节点数量，包括不脏的节点。
+     */
+    inline uint32_t getVisitedNodeCount() const { return _visitedNodeCount; }
+
+    /**
+     * @en Whether to resolve large levels on job system workers.
+     * @zh 是否在 JobSystem 的工作线程上解算节点较多的层。
+     */
+    inline void setParallelEnabled(bool val) { _parallelEnabled = val; }
+    inline bool isParallelEnabled() const { return _parallelEnabled; }
+
+private:
+    static void distributeDirtyRoots();
+    void takeDirtyRoots(bool overflowed);
+    void rebuild(Node *root);
+    void collectDirtySubtrees();
+    void solveRoot(uint32_t index);
+    void solveLevels(const uint32_t *indices, const ccstd::vector<uint32_t> &levelOffsets, bool parallel);
+    uint32_t solveRange(const uint32_t *indices, uint32_t begin, uint32_t end);
+
+    // depth sorted, nodes of level i are in [_levelOffsets[i], _levelOffsets[i + 1])
+    ccstd::vector<Node *> _nodes;
+    ccstd::vector<int32_t> _parentIndices;
+    ccstd::vector<uint32_t> _levelOffsets;
+    // children of node i are in [_childOffsets[i], _childOffsets[i + 1])
+    ccstd::vector<uint32_t> _childOffsets;
+    ccstd::unordered_map<const Node *, uint32_t> _nodeIndices;
+    // accumulated dirty bits of the last solve, 0 for nodes that were up to date
+    ccstd::vector<uint32_t> _dirtyBits;
+
+    // all alive solvers, Node::dirtyTransformRoots is handed out to each of them
+    static ccstd::vector<TransformSolver *> solvers;
+
+    // indices of the dirty subtree roots taken from Node::dirtyTransformRoots since the last solve
+    ccstd::vector<uint32_t> _dirtyRoots;
+    bool _dirtyRootsOverflowed{false};
+
+    // descendants of the dirty subtree roots, depth sorted like _nodes
+    ccstd::vector<uint32_t> _subtreeRoots;
+    ccstd::vector<uint32_t> _subtreeNodes;
+    ccstd::vector<uint32_t> _subtreeLevelOffsets;
+    ccstd::vector<uint32_t> _visitStamps;
+    uint32_t _visitStamp{0};
+
+    Node *_root{nullptr};
+    uint32_t _hierarchyVersion{0};
+    uint32_t _updatedNodeCount{0};
+    uint32_t _visitedNodeCount{0};
+    bool _parallelEnabled{true};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformSolver);
+};
+
+} // namespace cc
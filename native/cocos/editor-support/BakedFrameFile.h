@@ -0,0 +1,220 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "MappedFile.h"
+#include "MiddlewareMacro.h"
+#include "base/std/container/string.h"
+
+MIDDLEWARE_BEGIN
+
+/**
+ * File format of baked animation caches, shared by the Spine and DragonBones runtimes.
+ * A header is followed by the frame, bone, color, segment, vertex and index arrays back to back,
+ * so a mapped file is read in place. Arrays is the FrameArrays struct of a runtime, its frames
+ * hold offsets and counts into the other arrays and its segments refer to textures by index.
+ */
+template <typename Arrays>
+class BakedFrameFile {
+public:
+    using Frame = typename decltype(Arrays::frames)::value_type;
+    using Bone = typename decltype(Arrays::bones)::value_type;
+    using Color = typename decltype(Arrays::colors)::value_type;
+    using Segment = typename decltype(Arrays::segments)::value_type;
+
+    // stored as raw bytes, Color4B declares its own assignment so trivially copyable is too strict
+    static_assert(std::is_standard_layout<Frame>::value && std::is_standard_layout<Bone>::value &&
+                      std::is_standard_layout<Color>::value && std::is_standard_layout<Segment>::value,
+                  "baked frames are stored as raw bytes");
+
+    // frames of an animation, either in the owned arrays or in a mapped file
+    struct View {
+        const Frame *frames{nullptr};
+        std::size_t frameCount{0};
+        const Bone *bones{nullptr};
+        const Color *colors{nullptr};
+        const Segment *segments{nullptr};
+        const float *vertices{nullptr};
+        const uint16_t *indices{nullptr};
+    };
+
+    static View view(const Arrays &arrays) {
+        View ret;
+        ret.frames = arrays.frames.data();
+        ret.frameCount = arrays.frames.size();
+        ret.bones = arrays.bones.data();
+        ret.colors = arrays.colors.data();
+        ret.segments = arrays.segments.data();
+        ret.vertices = arrays.vertices.data();
+        ret.indices = arrays.indices.data();
+        return ret;
+    }
+
+    /**
+     * Writes the arrays to path through MappedFile::write. The magic tells the runtimes' files apart,
+     * the signature and texture count must be passed to read again.
+     */
+    static bool write(const Arrays &arrays, bool isComplete, float totalTime, const ccstd::string &path, uint32_t magic, uint64_t signature, uint32_t textureCount) {
+        if (arrays.frames.empty()) return false;
+        for (const auto &segment : arrays.segments) {
+            // textures added after the table was built have no stable index
+            if (segment.textureIndex < 0 || segment.textureIndex >= static_cast<int>(textureCount)) return false;
+        }
+
+        Header header;
+        header.magic = magic;
+        header.signature = signature;
+        header.textureCount = textureCount;
+        header.isComplete = isComplete ? 1 : 0;
+        header.totalTime = totalTime;
+        header.frameCount = static_cast<uint32_t>(arrays.frames.size());
+        header.boneCount = static_cast<uint32_t>(arrays.bones.size());
+        header.colorCount = static_cast<uint32_t>(arrays.colors.size());
+        header.segmentCount = static_cast<uint32_t>(arrays.segments.size());
+        header.vertexFloatCount = static_cast<uint32_t>(arrays.vertices.size());
+        header.indexCount = static_cast<uint32_t>(arrays.indices.size());
+
+        std::vector<uint8_t> buffer(getFileSize(header));
+        uint8_t *dst = buffer.data();
+        memcpy(dst, &header, sizeof(Header));
+        dst += sizeof(Header);
+        appendBytes(dst, arrays.frames);
+        appendBytes(dst, arrays.bones);
+        appendBytes(dst, arrays.colors);
+        appendBytes(dst, arrays.segments);
+        appendBytes(dst, arrays.vertices);
+        appendBytes(dst, arrays.indices);
+        return MappedFile::write(path, buffer.data(), buffer.size());
+    }
+
+    // validates a mapped file and points out at its arrays, a damaged file must not make render read out of the mapping
+    static bool read(const MappedFile &file, uint32_t magic, uint64_t signature, uint32_t textureCount, View *out, bool *isComplete, float *totalTime) {
+        if (file.getSize() < sizeof(Header)) return false;
+
+        Header header;
+        memcpy(&header, file.getData(), sizeof(Header));
+        if (header.magic != magic || header.version != FORMAT_VERSION ||
+            header.signature != signature || header.textureCount != textureCount || header.frameCount == 0) {
+            return false;
+        }
+        if (getFileSize(header) != file.getSize()) return false;
+
+        const uint8_t *src = file.getData() + sizeof(Header);
+        const auto *frames = viewBytes<Frame>(src, header.frameCount);
+        const auto *bones = viewBytes<Bone>(src, header.boneCount);
+        const auto *colors = viewBytes<Color>(src, header.colorCount);
+        const auto *segments = viewBytes<Segment>(src, header.segmentCount);
+        const auto *vertices = viewBytes<float>(src, header.vertexFloatCount);
+        const auto *indices = viewBytes<uint16_t>(src, header.indexCount);
+
+        for (uint32_t i = 0; i < header.frameCount; i++) {
+            const auto &frame = frames[i];
+            if (!inRange(frame.boneOffset, frame.boneCount, header.boneCount) ||
+                !inRange(frame.colorOffset, frame.colorCount, header.colorCount) ||
+                !inRange(frame.segmentOffset, frame.segmentCount, header.segmentCount) ||
+                !inRange(frame.vertexFloatOffset, frame.vertexFloatCount, header.vertexFloatCount) ||
+                !inRange(frame.indexOffset, frame.indexCount, header.indexCount)) {
+                return false;
+            }
+            int64_t vertexFloats = 0;
+            int64_t indexCount = 0;
+            for (uint32_t s = frame.segmentOffset, e = frame.segmentOffset + frame.segmentCount; s < e; s++) {
+                const auto &segment = segments[s];
+                const auto segmentVertexFloats = static_cast<int64_t>(segment.vertexFloatCount);
+                const auto segmentIndexCount = static_cast<int64_t>(segment.indexCount);
+                if (segment.textureIndex < 0 || segment.textureIndex >= static_cast<int>(textureCount) ||
+                    segmentVertexFloats < 0 || segmentIndexCount < 0) {
+                    return false;
+                }
+                vertexFloats += segmentVertexFloats;
+                indexCount += segmentIndexCount;
+            }
+            if (vertexFloats > frame.vertexFloatCount || indexCount > frame.indexCount) return false;
+        }
+
+        out->frames = frames;
+        out->frameCount = header.frameCount;
+        out->bones = bones;
+        out->colors = colors;
+        out->segments = segments;
+        out->vertices = vertices;
+        out->indices = indices;
+        *isComplete = header.isComplete != 0;
+        *totalTime = header.totalTime;
+        return true;
+    }
+
+private:
+    // bump when the header or the array layout changes, older files are then baked again
+    static constexpr uint32_t FORMAT_VERSION{2};
+
+    struct Header {
+        uint32_t magic{0};
+        uint32_t version{FORMAT_VERSION};
+        uint64_t signature{0};
+        uint32_t textureCount{0};
+        uint32_t isComplete{0};
+        float totalTime{0.0F};
+        uint32_t frameCount{0};
+        uint32_t boneCount{0};
+        uint32_t colorCount{0};
+        uint32_t segmentCount{0};
+        uint32_t vertexFloatCount{0};
+        uint32_t indexCount{0};
+    };
+
+    static std::size_t getFileSize(const Header &header) {
+        return sizeof(Header) +
+               static_cast<std::size_t>(header.frameCount) * sizeof(Frame) +
+               static_cast<std::size_t>(header.boneCount) * sizeof(Bone) +
+               static_cast<std::size_t>(header.colorCount) * sizeof(Color) +
+               static_cast<std::size_t>(header.segmentCount) * sizeof(Segment) +
+               static_cast<std::size_t>(header.vertexFloatCount) * sizeof(float) +
+               static_cast<std::size_t>(header.indexCount) * sizeof(uint16_t);
+    }
+
+    static bool inRange(uint32_t offset, uint32_t count, uint32_t total) {
+        return offset <= total && count <= total - offset;
+    }
+
+    template <typename T>
+    static void appendBytes(uint8_t *&dst, const std::vector<T> &src) {
+        if (src.empty()) return;
+        memcpy(dst, src.data(), src.size() * sizeof(T));
+        dst += src.size() * sizeof(T);
+    }
+
+    template <typename T>
+    static const T *viewBytes(const uint8_t *&src, uint32_t count) {
+        const auto *ret = reinterpret_cast<const T *>(src);
+        src += count * sizeof(T);
+        return ret;
+    }
+};
+
+MIDDLEWARE_END
@@ -0,0 +1,192 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MIDDLEWARE_BEGIN
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+
+namespace {
+std::wstring toWidePath(const ccstd::string &path) {
+    const int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (length <= 0) {
+        return {};
+    }
+    std::wstring widePath(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+    return widePath;
+}
+} // namespace
+
+bool MappedFile::open(const ccstd::string &path) {
+    close();
+    const std::wstring widePath = toWidePath(path);
+    if (widePath.empty()) {
+        return false;
+    }
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<const uint8_t *>(data);
+    _size = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (_data) {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+    }
+    _data = nullptr;
+    _size = 0;
+    _file = nullptr;
+    _mapping = nullptr;
+}
+
+bool MappedFile::write(const ccstd::string &path, const uint8_t *data, std::size_t size) {
+    const std::wstring widePath = toWidePath(path);
+    const std::wstring tempPath = toWidePath(path + ".tmp");
+    if (widePath.empty() || tempPath.empty()) {
+        return false;
+    }
+    HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool succeeded = true;
+    while (size > 0 && succeeded) {
+        DWORD written = 0;
+        const auto chunk = static_cast<DWORD>(std::min<std::size_t>(size, 1U << 30U));
+        succeeded = WriteFile(file, data, chunk, &written, nullptr) && written == chunk;
+        data += written;
+        size -= written;
+    }
+    CloseHandle(file);
+    if (!succeeded || !MoveFileExW(tempPath.c_str(), widePath.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileW(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool MappedFile::open(const ccstd::string &path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void *data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    _data = static_cast<const uint8_t *>(data);
+    _size = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (_data) {
+        munmap(const_cast<uint8_t *>(_data), _size);
+    }
+    _data = nullptr;
+    _size = 0;
+}
+
+bool MappedFile::write(const ccstd::string &path, const uint8_t *data, std::size_t size) {
+    const ccstd::string tempPath = path + ".tmp";
+    const int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool succeeded = true;
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written <= 0) {
+            succeeded = false;
+            break;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    succeeded = ::close(fd) == 0 && succeeded;
+    if (!succeeded || rename(tempPath.c_str(), path.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+MIDDLEWARE_END
@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "MiddlewareMacro.h"
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+
+MIDDLEWARE_BEGIN
+
+/**
+ * Read only view of a whole file mapped into memory, used to load baked animation caches
+ * without copying them. The mapping lives until close or destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    bool open(const ccstd::string &path);
+    void close();
+
+    /**
+     * Writes the bytes next to path and renames the result over it, so a reader
+     * never maps a partially written file.
+     */
+    static bool write(const ccstd::string &path, const uint8_t *data, std::size_t size);
+
+    inline bool isOpen() const { return _data != nullptr; }
+    inline const uint8_t *getData() const { return _data; }
+    inline std::size_t getSize() const { return _size; }
+
+private:
+    const uint8_t *_data{nullptr};
+    std::size_t _size{0};
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS
+    void *_file{nullptr};
+    void *_mapping{nullptr};
+#endif
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(MappedFile);
+};
+
+/**
+ * 64 bit FNV-1a hash used to name baked animation caches and to tell whether a cache
+ * file still matches the data it was baked from.
+ */
+class CacheHash {
+public:
+    inline void add(const void *data, std::size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (std::size_t i = 0; i < size; i++) {
+            _value = (_value ^ bytes[i]) * PRIME;
+        }
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_arithmetic<T>::value>::type add(T value) {
+        add(&value, sizeof(T));
+    }
+
+    inline void add(const char *str) {
+        std::size_t size = 0;
+        while (str && str[size]) size++;
+        add(size);
+        add(str, size);
+    }
+
+    inline void add(const ccstd::string &str) {
+        add(str.size());
+        add(str.data(), str.size());
+    }
+
+    inline uint64_t get() const { return _value; }
+
+private:
+    static constexpr uint64_t PRIME{0x100000001b3ULL};
+    uint64_t _value{0xcbf29ce484222325ULL};
+};
+
+MIDDLEWARE_END
@@ -23,6 +23,7 @@
 ****************************************************************************/
 
 #include "MeshBuffer.h"
+#include <algorithm>
 #include "2d/renderer/UIMeshBuffer.h"
 
 MIDDLEWARE_BEGIN
@@ -103,6 +104,10 @@ void MeshBuffer::uploadIB() {
     auto *rIB = _ibArr[_bufferPos];
     rIB->reset();
     if (rIB->getCapacity() < length) {
+        if (_growthLocked) {
+            _overflowed = true;
+            return;
+        }
         rIB->resize(length, false);
     }
     rIB->writeBytes(reinterpret_cast<const char *>(_ib.getBuffer()), _ib.length());
@@ -111,6 +116,11 @@ void MeshBuffer::uploadIB() {
 }
 
 void MeshBuffer::next() {
+    if (_growthLocked && _bufferPos + 1U >= _uiMeshBufferArr.size()) {
+        // keep writing into the current buffer, the content is discarded by the owner of the locked pass
+        _overflowed = true;
+        return;
+    }
     _bufferPos++;
     if (_ibArr.size() <= _bufferPos) {
         auto *rIB = new IOTypedArray(se::Object::TypedArrayType::UINT16, _ib.getCapacity());
@@ -133,6 +143,23 @@ void MeshBuffer::reset() {
     _ib.reset();
 }
 
+void MeshBuffer::lockGrowth() {
+    while (_uiMeshBufferArr.size() < _reservedCount) {
+        _ibArr.push_back(new IOTypedArray(se::Object::TypedArrayType::UINT16, _ib.getCapacity()));
+        _vbArr.push_back(new IOTypedArray(se::Object::TypedArrayType::FLOAT32, _vb.getCapacity()));
+        addUIMeshBuffer();
+    }
+    _growthLocked = true;
+    _overflowed = false;
+}
+
+bool MeshBuffer::unlockGrowth() {
+    _growthLocked = false;
+    // one spare buffer beyond the last pass, after an overflow this is one more than was allocated
+    _reservedCount = std::max(_reservedCount, static_cast<std::size_t>(_bufferPos) + 2);
+    return _overflowed;
+}
+
 void MeshBuffer::addUIMeshBuffer() {
     UIMeshBuffer *uiMeshBuffer = new UIMeshBuffer();
     ccstd::vector<gfx::Attribute> attrs;
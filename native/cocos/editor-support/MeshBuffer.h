@@ -95,6 +95,16 @@ public:
     void uploadIB();
     void reset();
 
+    /**
+     * Typed arrays can only be created on main thread, so before the buffer is filled on a job system worker
+     * the buffers it may need are allocated here and further growth is disabled until unlockGrowth.
+     */
+    void lockGrowth();
+    /**
+     * Enables growth again, returns true if the locked pass ran out of buffers and its content is invalid.
+     */
+    bool unlockGrowth();
+
 private:
     void next();
     void clear();
@@ -107,6 +117,9 @@ private:
     ccstd::vector<IOTypedArray *> _vbArr;
     ccstd::vector<cc::UIMeshBuffer *> _uiMeshBufferArr;
     uint16_t _bufferPos = 0;
+    std::size_t _reservedCount = 2;
+    bool _growthLocked = false;
+    bool _overflowed = false;
     IOBuffer _vb;
     IOBuffer _ib;
     int _vertexFormat = 0;
@@ -26,10 +26,19 @@
 #include <algorithm>
 #include "2d/renderer/Batcher2d.h"
 #include "SeApi.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
+#include "profiler/Profiler.h"
 
 MIDDLEWARE_BEGIN
 
+namespace {
+constexpr std::size_t PARALLEL_THRESHOLD = 32; // update and render in parallel if more instances than this value
+
+// mesh buffers of the segment filled by the current worker, null on main thread
+thread_local ccstd::unordered_map<int, MeshBuffer *> *segmentMeshBuffers = nullptr;
+} // namespace
+
 MiddlewareManager *MiddlewareManager::instance = nullptr;
 
 MiddlewareManager::MiddlewareManager() : _renderInfo(se::Object::TypedArrayType::UINT32),
@@ -43,9 +52,22 @@ MiddlewareManager::~MiddlewareManager() {
         delete buffer;
     }
     _mbMap.clear();
+
+    for (auto &segment : _segments) {
+        for (auto it : segment.mbMap) {
+            delete it.second;
+        }
+    }
+    _segments.clear();
 }
 
 MeshBuffer *MiddlewareManager::getMeshBuffer(int format) {
+    if (segmentMeshBuffers) {
+        // created on main thread before the parallel render
+        auto it = segmentMeshBuffers->find(format);
+        CC_ASSERT(it != segmentMeshBuffers->end());
+        return it->second;
+    }
     MeshBuffer *mb = _mbMap[format];
     if (!mb) {
         mb = new MeshBuffer(format);
@@ -55,17 +77,34 @@ MeshBuffer *MiddlewareManager::getMeshBuffer(int format) {
 }
 
 void MiddlewareManager::updateOperateCache() {
-    for (auto &iter: _operateCacheMap) {
-        auto it = std::find(_updateList.begin(), _updateList.end(), iter.first);
+    bool removed = false;
+    for (auto &iter : _operateCacheMap) {
+        auto *editor = iter.first;
+        auto it = _updateIndexMap.find(editor);
         if (iter.second) {
-            if (it == _updateList.end()) {
-                _updateList.push_back(iter.first);
+            if (it == _updateIndexMap.end()) {
+                _updateIndexMap.emplace(editor, _updateList.size());
+                _updateList.push_back(editor);
             }
-        } else if (it != _updateList.end()) {
-            _updateList.erase(it);
+        } else if (it != _updateIndexMap.end()) {
+            _updateList[it->second] = nullptr;
+            _updateIndexMap.erase(it);
+            removed = true;
         }
     }
     _operateCacheMap.clear();
+
+    if (removed) {
+        // compact once per frame and keep the order of the remaining middleware
+        std::size_t count = 0;
+        for (auto *editor : _updateList) {
+            if (editor) {
+                _updateIndexMap[editor] = count;
+                _updateList[count++] = editor;
+            }
+        }
+        _updateList.resize(count);
+    }
 }
 
 void MiddlewareManager::update(float dt) {
@@ -76,12 +115,41 @@ void MiddlewareManager::update(float dt) {
         attachBuffer->writeUint32(0);
     }
 
+    if (_parallelEnabled && _updateList.size() > PARALLEL_THRESHOLD && JobSystem::getInstance()->threadCount() > 1) {
+        updateParallelly(dt);
+        return;
+    }
+
     for (size_t i = 0, len = _updateList.size(); i < len; ++i) {
         auto *editor = _updateList[i];
         editor->update(dt);
     }
 }
 
+void MiddlewareManager::updateParallelly(float dt) {
+    CC_PROFILE(MiddlewareManagerUpdateParallelly);
+    _parallelList.clear();
+    for (auto *editor : _updateList) {
+        if (editor->isParallelUpdateSafe()) {
+            _parallelList.push_back(editor);
+        } else {
+            editor->update(dt);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(_parallelList.size());
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, count, 1U, [this, dt](uint32_t i) {
+        _parallelList[i]->updateParallelly(dt);
+    });
+    g.run();
+    g.waitForAll();
+
+    for (auto *editor : _parallelList) {
+        editor->dispatchEvents();
+    }
+}
+
 void MiddlewareManager::render(float dt) {
     for (auto it : _mbMap) {
         auto *buffer = it.second;
@@ -89,11 +157,19 @@ void MiddlewareManager::render(float dt) {
             buffer->reset();
         }
     }
+    for (auto &segment : _segments) {
+        for (auto it : segment.mbMap) {
+            it.second->reset();
+        }
+    }
 
-
-    for (size_t i = 0, len = _updateList.size(); i < len; ++i) {
-        auto *editor = _updateList[i];
-        editor->render(dt);
+    if (_parallelEnabled && _updateList.size() > PARALLEL_THRESHOLD && JobSystem::getInstance()->threadCount() > 1) {
+        renderParallelly(dt);
+    } else {
+        for (size_t i = 0, len = _updateList.size(); i < len; ++i) {
+            auto *editor = _updateList[i];
+            editor->render(dt);
+        }
     }
 
     for (auto it : _mbMap) {
@@ -113,10 +189,91 @@ void MiddlewareManager::render(float dt) {
         for (auto &item : uiBufArray) {
             uiMeshArray.push_back((UIMeshBuffer *)item);
         }
+        // merge: buffers of the parallel render follow the shared ones in segment order
+        for (auto &segment : _segments) {
+            auto iter = segment.mbMap.find(it.first);
+            if (iter == segment.mbMap.end()) {
+                continue;
+            }
+            auto *segmentBuffer = iter->second;
+            segmentBuffer->uploadIB();
+            segmentBuffer->uploadVB();
+            for (auto &item : segmentBuffer->uiMeshBuffers()) {
+                uiMeshArray.push_back((UIMeshBuffer *)item);
+            }
+        }
         batch2d->syncMeshBuffersToNative(accID, std::move(uiMeshArray));
     }
 }
 
+void MiddlewareManager::renderParallelly(float dt) {
+    CC_PROFILE(MiddlewareManagerRenderParallelly);
+    _parallelList.clear();
+    _parallelFormats.clear();
+    for (auto *editor : _updateList) {
+        int format = 0;
+        if (editor->prepareParallelRender(format)) {
+            _parallelList.push_back(editor);
+            _parallelFormats.push_back(format);
+        } else {
+            editor->render(dt);
+        }
+    }
+
+    const auto count = static_cast<uint32_t>(_parallelList.size());
+    const auto segmentCount = std::min(JobSystem::getInstance()->threadCount(), count);
+    if (_segments.size() < segmentCount) {
+        _segments.resize(segmentCount);
+    }
+    // contiguous ranges of the update list, typed arrays of the mesh buffers are created here on main thread
+    for (uint32_t s = 0; s < segmentCount; ++s) {
+        auto &segment = _segments[s];
+        segment.begin = count * s / segmentCount;
+        segment.end = count * (s + 1) / segmentCount;
+        for (uint32_t i = segment.begin; i < segment.end; ++i) {
+            const int format = _parallelFormats[i];
+            auto &mb = segment.mbMap[format];
+            if (!mb) {
+                mb = new MeshBuffer(format);
+                getMeshBuffer(format);
+            }
+        }
+        for (auto it : segment.mbMap) {
+            it.second->lockGrowth();
+        }
+    }
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, segmentCount, 1U, [this, dt](uint32_t s) {
+        auto &segment = _segments[s];
+        segmentMeshBuffers = &segment.mbMap;
+        for (uint32_t i = segment.begin; i < segment.end; ++i) {
+            _parallelList[i]->render(dt);
+        }
+        segmentMeshBuffers = nullptr;
+    });
+    g.run();
+    g.waitForAll();
+
+    for (uint32_t s = 0; s < segmentCount; ++s) {
+        auto &segment = _segments[s];
+        bool overflowed = false;
+        for (auto it : segment.mbMap) {
+            overflowed |= it.second->unlockGrowth();
+        }
+        if (!overflowed) {
+            continue;
+        }
+        // more buffers are reserved for the next frame, this frame the segment is rendered again into the shared buffers
+        for (auto it : segment.mbMap) {
+            it.second->reset();
+        }
+        for (uint32_t i = segment.begin; i < segment.end; ++i) {
+            _parallelList[i]->render(dt);
+        }
+    }
+}
+
 void MiddlewareManager::addTimer(IMiddleware *editor) {
     _operateCacheMap[editor] = true;
 }
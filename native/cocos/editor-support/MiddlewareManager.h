@@ -30,6 +30,7 @@
 #include "MiddlewareMacro.h"
 #include "SharedBufferManager.h"
 #include "base/RefCounted.h"
+#include "base/std/container/unordered_map.h"
 
 MIDDLEWARE_BEGIN
 
@@ -42,6 +43,21 @@ public:
     virtual ~IMiddleware() = default;
     virtual void update(float dt) = 0;
     virtual void render(float dt) = 0;
+
+    /**
+     * Whether updateParallelly can run on a job system worker. It must only touch the instance itself
+     * and defer script callbacks to dispatchEvents, which is called on main thread in update order.
+     */
+    virtual bool isParallelUpdateSafe() const { return false; }
+    virtual void updateParallelly(float dt) { update(dt); }
+    virtual void dispatchEvents() {}
+
+    /**
+     * Called on main thread before render runs on a job system worker, to create everything render
+     * can only create on main thread. Returns false to keep render on main thread this frame,
+     * otherwise outputs the vertex format that render requests from MiddlewareManager::getMeshBuffer.
+     */
+    virtual bool prepareParallelRender(int & /*vertexFormat*/) { return false; }
 };
 
 /**
@@ -94,6 +110,15 @@ public:
      */
     void removeTimer(IMiddleware *editor);
 
+    /**
+     * @brief Whether to update and render middleware on job system workers when there are many instances.
+     * Only instances which report themselves safe leave main thread, see IMiddleware.
+     * During a parallel render each worker fills its own mesh buffer segment, instances are assigned to
+     * segments in update order, so the result does not depend on scheduling.
+     */
+    void setParallelEnabled(bool enabled) { _parallelEnabled = enabled; }
+    bool isParallelEnabled() const { return _parallelEnabled; }
+
     MeshBuffer *getMeshBuffer(int format);
 
     se_object_ptr getVBTypedArray(int format, int bufferPos);
@@ -109,12 +134,28 @@ public:
     ~MiddlewareManager();
 
 private:
+    struct RenderSegment {
+        ccstd::unordered_map<int, MeshBuffer *> mbMap;
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
     void updateOperateCache();
+    void updateParallelly(float dt);
+    void renderParallelly(float dt);
 
     ccstd::vector<IMiddleware *> _updateList;
+    // index of each middleware in _updateList
+    ccstd::unordered_map<IMiddleware *, std::size_t> _updateIndexMap;
     ccstd::unordered_map<IMiddleware *, bool> _operateCacheMap;
     ccstd::unordered_map<int, MeshBuffer *> _mbMap;
 
+    // reused between frames by the parallel update and render
+    ccstd::vector<IMiddleware *> _parallelList;
+    ccstd::vector<int> _parallelFormats;
+    ccstd::vector<RenderSegment> _segments;
+    bool _parallelEnabled = false;
+
     SharedBufferManager _renderInfo;
     SharedBufferManager _attachInfo;
 
@@ -22,7 +22,10 @@
  */
 
 #include "ArmatureCache.h"
+#include <cstdio>
 #include "CCFactory.h"
+#include "CCTextureAtlasData.h"
+#include "base/ThreadPool.h"
 #include "base/TypeDef.h"
 #include "base/memory/Memory.h"
 
@@ -34,79 +37,95 @@ DRAGONBONES_NAMESPACE_BEGIN
 
 float ArmatureCache::FrameTime = 1.0F / 60.0F;
 float ArmatureCache::MaxCacheTime = 120.0F;
-
-ArmatureCache::SegmentData::SegmentData() = default;
-
-ArmatureCache::SegmentData::~SegmentData() {
-    CC_SAFE_RELEASE_NULL(_texture);
-}
-
-void ArmatureCache::SegmentData::setTexture(cc::middleware::Texture2D *value) {
-    CC_SAFE_ADD_REF(value);
-    CC_SAFE_RELEASE(_texture);
-    _texture = value;
+std::string ArmatureCache::cacheDirectory;
+
+namespace {
+constexpr uint32_t CACHE_FILE_MAGIC = 0x434b4244; // "DBKC"
+
+void hashTransform(CacheHash &hash, const Transform &transform) {
+    hash.add(transform.x);
+    hash.add(transform.y);
+    hash.add(transform.skew);
+    hash.add(transform.rotation);
+    hash.add(transform.scaleX);
+    hash.add(transform.scaleY);
 }
 
-cc::middleware::Texture2D *ArmatureCache::SegmentData::getTexture() const {
-    return _texture;
-}
-
-ArmatureCache::FrameData::FrameData() = default;
-
-ArmatureCache::FrameData::~FrameData() {
-    for (auto &bone : _bones) {
-        delete bone;
+// baked frames only stay valid while the armature data and its atlas are unchanged
+uint64_t computeContentHash(const ArmatureData *armatureData, const std::vector<TextureAtlasData *> *atlasDataList) {
+    CacheHash hash;
+    const auto *data = armatureData->parent;
+    if (data) {
+        hash.add(data->name);
+        hash.add(data->version);
+        hash.add(data->frameRate);
+        // the parsers lay the int, float, frame int, frame float and frame arrays out back to back,
+        // they hold mesh vertices and every key frame value
+        const auto *begin = reinterpret_cast<const char *>(data->intArray);
+        const auto *end = reinterpret_cast<const char *>(data->timelineArray);
+        if (begin && end > begin) {
+            hash.add(begin, static_cast<std::size_t>(end - begin));
+        }
     }
-    _bones.clear();
 
-    for (auto &color : _colors) {
-        delete color;
+    hash.add(armatureData->name);
+    hash.add(armatureData->frameRate);
+    hash.add(armatureData->scale);
+    hash.add(armatureData->sortedBones.size());
+    for (const auto *bone : armatureData->sortedBones) {
+        hash.add(bone->name);
+        hash.add(bone->length);
+        hashTransform(hash, bone->transform);
     }
-    _colors.clear();
-
-    for (auto &segment : _segments) {
-        delete segment;
+    hash.add(armatureData->sortedSlots.size());
+    for (const auto *slot : armatureData->sortedSlots) {
+        hash.add(slot->name);
+        hash.add(static_cast<int>(slot->blendMode));
+        hash.add(slot->displayIndex);
+        hash.add(slot->zOrder);
     }
-    _segments.clear();
-}
-
-ArmatureCache::BoneData *ArmatureCache::FrameData::buildBoneData(std::size_t index) {
-    if (index > _bones.size()) return nullptr;
-    if (index == _bones.size()) {
-        auto *boneData = new BoneData;
-        _bones.push_back(boneData);
+    hash.add(armatureData->animations.size());
+    for (const auto &it : armatureData->animations) {
+        const auto *animation = it.second;
+        hash.add(animation->name);
+        hash.add(animation->duration);
+        hash.add(animation->frameCount);
+        hash.add(animation->playTimes);
+        hash.add(animation->frameIntOffset);
+        hash.add(animation->frameFloatOffset);
+        hash.add(animation->frameOffset);
     }
-    return _bones[index];
-}
 
-std::size_t ArmatureCache::FrameData::getBoneCount() const {
-    return _bones.size();
-}
-
-ArmatureCache::ColorData *ArmatureCache::FrameData::buildColorData(std::size_t index) {
-    if (index > _colors.size()) return nullptr;
-    if (index == _colors.size()) {
-        auto *colorData = new ColorData;
-        _colors.push_back(colorData);
-    }
-    return _colors[index];
-}
-
-std::size_t ArmatureCache::FrameData::getColorCount() const {
-    return _colors.size();
-}
-
-ArmatureCache::SegmentData *ArmatureCache::FrameData::buildSegmentData(std::size_t index) {
-    if (index > _segments.size()) return nullptr;
-    if (index == _segments.size()) {
-        auto *segmentData = new SegmentData;
-        _segments.push_back(segmentData);
+    if (atlasDataList) {
+        hash.add(atlasDataList->size());
+        for (const auto *atlasData : *atlasDataList) {
+            hash.add(atlasData->name);
+            hash.add(atlasData->width);
+            hash.add(atlasData->height);
+            hash.add(atlasData->scale);
+            for (const auto &it : atlasData->textures) {
+                const auto *texture = it.second;
+                hash.add(texture->name);
+                hash.add(texture->rotated);
+                hash.add(texture->region.x);
+                hash.add(texture->region.y);
+                hash.add(texture->region.width);
+                hash.add(texture->region.height);
+            }
+        }
     }
-    return _segments[index];
+    return hash.get();
 }
-
-std::size_t ArmatureCache::FrameData::getSegmentCount() const {
-    return _segments.size();
+} // namespace
+
+void ArmatureCache::BoneData::toMat4(cc::Mat4 &out) const {
+    out.setIdentity();
+    out.m[0] = a;
+    out.m[1] = b;
+    out.m[4] = -c;
+    out.m[5] = -d;
+    out.m[12] = tx;
+    out.m[13] = ty;
 }
 
 ArmatureCache::AnimationData::AnimationData() = default;
@@ -116,38 +135,49 @@ ArmatureCache::AnimationData::~AnimationData() {
 }
 
 void ArmatureCache::AnimationData::reset() {
-    for (auto &frame : _frames) {
-        delete frame;
-    }
-    _frames.clear();
+    _arrays = FrameArrays();
+    _file.close();
+    bindArrays();
     _isComplete = false;
     _totalTime = 0.0F;
 }
 
+void ArmatureCache::AnimationData::bindArrays() {
+    _view = cc::middleware::BakedFrameFile<FrameArrays>::view(_arrays);
+}
+
 bool ArmatureCache::AnimationData::needUpdate(int toFrameIdx) const {
-    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || _frames.size() < toFrameIdx + 1);
+    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || _view.frameCount < toFrameIdx + 1);
 }
 
-ArmatureCache::FrameData *ArmatureCache::AnimationData::buildFrameData(std::size_t frameIdx) {
-    if (frameIdx > _frames.size()) {
+const ArmatureCache::FrameData *ArmatureCache::AnimationData::getFrameData(std::size_t frameIdx) const {
+    if (frameIdx >= _view.frameCount) {
         return nullptr;
     }
-    if (frameIdx == _frames.size()) {
-        auto *frameData = new FrameData();
-        _frames.push_back(frameData);
-    }
-    return _frames[frameIdx];
+    return _view.frames + frameIdx;
 }
 
-ArmatureCache::FrameData *ArmatureCache::AnimationData::getFrameData(std::size_t frameIdx) const {
-    if (frameIdx >= _frames.size()) {
-        return nullptr;
+bool ArmatureCache::AnimationData::save(const std::string &path, uint64_t signature, uint32_t textureCount) const {
+    if (_file.isOpen()) return false;
+    return writeFile(_arrays, _isComplete, _totalTime, path, signature, textureCount);
+}
+
+bool ArmatureCache::AnimationData::writeFile(const FrameArrays &arrays, bool isComplete, float totalTime, const std::string &path, uint64_t signature, uint32_t textureCount) {
+    return cc::middleware::BakedFrameFile<FrameArrays>::write(arrays, isComplete, totalTime, path, CACHE_FILE_MAGIC, signature, textureCount);
+}
+
+bool ArmatureCache::AnimationData::load(const std::string &path, uint64_t signature, uint32_t textureCount) {
+    reset();
+    if (!_file.open(path)) return false;
+    if (!bindFile(signature, textureCount)) {
+        reset();
+        return false;
     }
-    return _frames[frameIdx];
+    return true;
 }
 
-std::size_t ArmatureCache::AnimationData::getFrameCount() const {
-    return _frames.size();
+bool ArmatureCache::AnimationData::bindFile(uint64_t signature, uint32_t textureCount) {
+    return cc::middleware::BakedFrameFile<FrameArrays>::read(_file, CACHE_FILE_MAGIC, signature, textureCount, &_view, &_isComplete, &_totalTime);
 }
 
 ArmatureCache::ArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID) {
@@ -155,6 +185,20 @@ ArmatureCache::ArmatureCache(const std::string &armatureName, const std::string
     if (_armatureDisplay) {
         _armatureDisplay->addRef();
     }
+    _cacheKey = armatureName + "|" + armatureKey + "|" + atlasUUID;
+
+    // atlas pages come first in a fixed order, so saved texture indices stay valid
+    auto *atlasDataList = dragonBones::CCFactory::getFactory()->getTextureAtlasData(atlasUUID);
+    if (atlasDataList) {
+        for (auto *atlasData : *atlasDataList) {
+            auto *texture = static_cast<CCTextureAtlasData *>(atlasData)->getRenderTexture();
+            if (texture) findTexture(texture);
+        }
+    }
+    if (_armatureDisplay) {
+        _contentHash = computeContentHash(_armatureDisplay->getArmature()->getArmatureData(), atlasDataList);
+    }
+    _atlasTextureCount = static_cast<uint32_t>(_textures.size());
 }
 
 ArmatureCache::~ArmatureCache() {
@@ -167,6 +211,64 @@ ArmatureCache::~ArmatureCache() {
         delete animationCache.second;
     }
     _animationCaches.clear();
+
+    for (auto *texture : _textures) {
+        CC_SAFE_RELEASE(texture);
+    }
+    _textures.clear();
+}
+
+int ArmatureCache::findTexture(cc::middleware::Texture2D *texture) {
+    // an armature rarely uses more than a few atlas pages
+    for (std::size_t i = 0, n = _textures.size(); i < n; i++) {
+        if (_textures[i] == texture) return static_cast<int>(i);
+    }
+    texture->addRef();
+    _textures.push_back(texture);
+    return static_cast<int>(_textures.size()) - 1;
+}
+
+cc::middleware::Texture2D *ArmatureCache::getTexture(int index) const {
+    if (index < 0 || index >= static_cast<int>(_textures.size())) return nullptr;
+    return _textures[index];
+}
+
+uint64_t ArmatureCache::computeSignature(const std::string &animationName) const {
+    CacheHash hash;
+    hash.add(_contentHash);
+    hash.add(animationName);
+    hash.add(FrameTime);
+    hash.add(MaxCacheTime);
+    hash.add(_atlasTextureCount);
+    return hash.get();
+}
+
+std::string ArmatureCache::getCachePath(uint64_t signature) const {
+    if (cacheDirectory.empty()) return "";
+    CacheHash keyHash;
+    keyHash.add(_cacheKey);
+    char name[48];
+    snprintf(name, sizeof(name), "%016llx-%016llx.dbc", static_cast<unsigned long long>(keyHash.get()), static_cast<unsigned long long>(signature)); // NOLINT(google-runtime-int)
+    auto path = cacheDirectory;
+    if (path.back() != '/') path += '/';
+    return path + name;
+}
+
+void ArmatureCache::saveAnimationData(AnimationData *animationData) {
+    auto signature = computeSignature(animationData->_animationName);
+    auto path = getCachePath(signature);
+    if (path.empty() || animationData->isMapped()) return;
+
+    // write a copy on the io thread, the frames in memory keep serving this session
+    auto arrays = std::make_shared<FrameArrays>(animationData->_arrays);
+    auto isComplete = animationData->_isComplete;
+    auto totalTime = animationData->_totalTime;
+    auto textureCount = _atlasTextureCount;
+    LegacyThreadPool::getDefaultThreadPool()->pushTask(
+        [=](int /*tid*/) {
+            AnimationData::writeFile(*arrays, isComplete, totalTime, path, signature, textureCount);
+        },
+        LegacyThreadPool::TaskType::IO);
 }
 
 ArmatureCache::AnimationData *ArmatureCache::buildAnimationData(const std::string &animationName) {
@@ -183,6 +285,12 @@ ArmatureCache::AnimationData *ArmatureCache::buildAnimationData(const std::strin
         aniData = new AnimationData();
         aniData->_animationName = animationName;
         _animationCaches[animationName] = aniData;
+
+        auto signature = computeSignature(animationName);
+        auto path = getCachePath(signature);
+        if (!path.empty()) {
+            aniData->load(path, signature, _atlasTextureCount);
+        }
     } else {
         aniData = it->second;
     }
@@ -229,11 +337,32 @@ void ArmatureCache::updateToFrame(const std::string &animationName, int toFrameI
             animationData->_isComplete = true;
         }
     } while (animationData->needUpdate(toFrameIdx));
+
+    if (!animationData->needUpdate(-1)) {
+        saveAnimationData(animationData);
+    }
+}
+
+void ArmatureCache::bakeAllAnimations() {
+    if (!_armatureDisplay) return;
+    const auto &names = _armatureDisplay->getArmature()->getAnimation()->getAnimationNames();
+    for (const auto &name : names) {
+        if (buildAnimationData(name)) {
+            updateToFrame(name);
+        }
+    }
 }
 
 void ArmatureCache::renderAnimationFrame(AnimationData *animationData) {
-    std::size_t frameIndex = animationData->getFrameCount();
-    _frameData = animationData->buildFrameData(frameIndex);
+    _frameArrays = &animationData->_arrays;
+    auto &out = *_frameArrays;
+    out.frames.emplace_back();
+    auto frameIndex = out.frames.size() - 1;
+    auto boneBase = static_cast<uint32_t>(out.bones.size());
+    auto segmentBase = static_cast<uint32_t>(out.segments.size());
+    auto indexBase = static_cast<uint32_t>(out.indices.size());
+    _frameVertexBase = static_cast<uint32_t>(out.vertices.size());
+    _frameColorBase = static_cast<uint32_t>(out.colors.size());
 
     _preColor = Color4B(0, 0, 0, 0);
     _color = Color4B(255, 255, 255, 255);
@@ -244,29 +373,39 @@ void ArmatureCache::renderAnimationFrame(AnimationData *animationData) {
     _preISegWritePos = -1;
     _curISegLen = 0;
     _curVSegLen = 0;
-    _materialLen = 0;
 
     auto *armature = _armatureDisplay->getArmature();
     traverseArmature(armature);
 
     if (_preISegWritePos != -1) {
-        SegmentData *preSegmentData = _frameData->buildSegmentData(_materialLen - 1);
-        preSegmentData->indexCount = _curISegLen;
-        preSegmentData->vertexFloatCount = _curVSegLen;
+        SegmentData &preSegmentData = out.segments.back();
+        preSegmentData.indexCount = _curISegLen;
+        preSegmentData.vertexFloatCount = _curVSegLen;
     }
 
-    auto colorCount = _frameData->getColorCount();
-    if (colorCount > 0) {
-        ColorData *preColorData = _frameData->buildColorData(colorCount - 1);
-        preColorData->vertexFloatOffset = static_cast<int>(_frameData->vb.getCurPos()) / sizeof(float);
+    if (out.colors.size() > _frameColorBase) {
+        out.colors.back().vertexFloatOffset = static_cast<uint32_t>(out.vertices.size()) - _frameVertexBase;
     }
 
-    _frameData = nullptr;
+    FrameData &frameData = out.frames[frameIndex];
+    frameData.boneOffset = boneBase;
+    frameData.boneCount = static_cast<uint32_t>(out.bones.size()) - boneBase;
+    frameData.colorOffset = _frameColorBase;
+    frameData.colorCount = static_cast<uint32_t>(out.colors.size()) - _frameColorBase;
+    frameData.segmentOffset = segmentBase;
+    frameData.segmentCount = static_cast<uint32_t>(out.segments.size()) - segmentBase;
+    frameData.vertexFloatOffset = _frameVertexBase;
+    frameData.vertexFloatCount = static_cast<uint32_t>(out.vertices.size()) - _frameVertexBase;
+    frameData.indexOffset = indexBase;
+    frameData.indexCount = static_cast<uint32_t>(out.indices.size()) - indexBase;
+
+    animationData->bindArrays();
+    _frameArrays = nullptr;
 }
 
 void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*= 1.0f*/) {
-    middleware::IOBuffer &vb = _frameData->vb;
-    middleware::IOBuffer &ib = _frameData->ib;
+    std::vector<float> &vb = _frameArrays->vertices;
+    std::vector<uint16_t> &ib = _frameArrays->indices;
 
     const auto &bones = armature->getBones();
     Bone *bone = nullptr;
@@ -280,17 +419,18 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
     auto flush = [&]() {
         // fill pre segment count field
         if (_preISegWritePos != -1) {
-            SegmentData *preSegmentData = _frameData->buildSegmentData(_materialLen - 1);
-            preSegmentData->indexCount = _curISegLen;
-            preSegmentData->vertexFloatCount = _curVSegLen;
+            SegmentData &preSegmentData = _frameArrays->segments.back();
+            preSegmentData.indexCount = _curISegLen;
+            preSegmentData.vertexFloatCount = _curVSegLen;
         }
 
-        SegmentData *segmentData = _frameData->buildSegmentData(_materialLen);
-        segmentData->setTexture(texture);
-        segmentData->blendMode = static_cast<int>(slot->_blendMode);
+        _frameArrays->segments.emplace_back();
+        SegmentData &segmentData = _frameArrays->segments.back();
+        segmentData.textureIndex = findTexture(texture);
+        segmentData.blendMode = static_cast<int>(slot->_blendMode);
 
         // save new segment count pos field
-        _preISegWritePos = static_cast<int>(ib.getCurPos() / sizeof(uint16_t));
+        _preISegWritePos = static_cast<int>(ib.size());
         // reset pre blend mode to current
         _preBlendMode = static_cast<int>(slot->_blendMode);
         // reset pre texture index to current
@@ -299,22 +439,19 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
         _curISegLen = 0;
         // reset vertex segmentation count
         _curVSegLen = 0;
-        // material length increased
-        _materialLen++;
     };
 
     for (auto *i : bones) {
         bone = i;
-        auto boneCount = _frameData->getBoneCount();
-        BoneData *boneData = _frameData->buildBoneData(boneCount);
         auto &boneOriginMat = bone->globalTransformMatrix;
-        auto &matm = boneData->globalTransformMatrix.m;
-        matm[0] = boneOriginMat.a;
-        matm[1] = boneOriginMat.b;
-        matm[4] = -boneOriginMat.c;
-        matm[5] = -boneOriginMat.d;
-        matm[12] = boneOriginMat.tx;
-        matm[13] = boneOriginMat.ty;
+        _frameArrays->bones.emplace_back();
+        BoneData &boneData = _frameArrays->bones.back();
+        boneData.a = boneOriginMat.a;
+        boneData.b = boneOriginMat.b;
+        boneData.c = boneOriginMat.c;
+        boneData.d = boneOriginMat.d;
+        boneData.tx = boneOriginMat.tx;
+        boneData.ty = boneOriginMat.ty;
     }
 
     for (auto *i : slots) {
@@ -340,8 +477,7 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
         if (!texture) continue;
         _curTextureIndex = texture->getRealTextureIndex();
 
-        auto vbSize = slot->triangles.vertCount * sizeof(middleware::V3F_T2F_C4B);
-        vb.checkSpace(vbSize, true);
+        auto vbFloats = slot->triangles.vertCount * VF_XYZUVC;
 
         // If texture or blendMode change,will change material.
         if (_preTextureIndex != _curTextureIndex || _preBlendMode != static_cast<int>(slot->_blendMode)) {
@@ -356,13 +492,11 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
 
         if (preColor != color) {
             preColor = color;
-            auto colorCount = _frameData->getColorCount();
-            if (colorCount > 0) {
-                ColorData *preColorData = _frameData->buildColorData(colorCount - 1);
-                preColorData->vertexFloatOffset = vb.getCurPos() / sizeof(float);
+            if (_frameArrays->colors.size() > _frameColorBase) {
+                _frameArrays->colors.back().vertexFloatOffset = static_cast<uint32_t>(vb.size()) - _frameVertexBase;
             }
-            ColorData *colorData = _frameData->buildColorData(colorCount);
-            colorData->color = color;
+            _frameArrays->colors.emplace_back();
+            _frameArrays->colors.back().color = color;
         }
 
         // Transform component matrix to global matrix
@@ -382,18 +516,16 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
             worldVertex->color.a = color.a;
         }
 
-        vb.writeBytes(reinterpret_cast<char *>(worldTriangles), vbSize);
-
-        auto ibSize = triangles.indexCount * sizeof(uint16_t);
-        ib.checkSpace(ibSize, true);
+        const auto *worldFloats = reinterpret_cast<const float *>(worldTriangles);
+        vb.insert(vb.end(), worldFloats, worldFloats + vbFloats);
 
         auto vertexOffset = _curVSegLen / VF_XYZUVC;
         for (int ii = 0, nn = triangles.indexCount; ii < nn; ii++) {
-            ib.writeUint16(triangles.indices[ii] + vertexOffset);
+            ib.push_back(static_cast<uint16_t>(triangles.indices[ii] + vertexOffset));
         }
 
         _curISegLen += triangles.indexCount;
-        _curVSegLen += static_cast<int32_t>(vbSize / sizeof(float));
+        _curVSegLen += static_cast<int32_t>(vbFloats);
     } // End slot traverse
 }
 
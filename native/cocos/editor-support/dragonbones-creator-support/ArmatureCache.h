@@ -23,8 +23,9 @@
 
 #pragma once
 
+#include <vector>
 #include "CCArmatureDisplay.h"
-#include "IOBuffer.h"
+#include "BakedFrameFile.h"
 #include "base/RefCounted.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
@@ -32,68 +33,53 @@ DRAGONBONES_NAMESPACE_BEGIN
 class ArmatureCache : public cc::RefCounted {
 public:
     struct SegmentData {
-        friend class ArmatureCache;
-
-        SegmentData();
-        ~SegmentData();
-
-        void setTexture(cc::middleware::Texture2D *value);
-        cc::middleware::Texture2D *getTexture() const;
-
-    public:
         int blendMode = 0;
-        std::size_t indexCount = 0;
-        std::size_t vertexFloatCount = 0;
-
-    private:
-        cc::middleware::Texture2D *_texture = nullptr;
+        uint32_t indexCount = 0;
+        uint32_t vertexFloatCount = 0;
+        // index in the texture table of the armature cache, see getTexture
+        int textureIndex = 0;
     };
 
+    // affine part of the bone global transform
     struct BoneData {
-        cc::Mat4 globalTransformMatrix;
+        float a = 1.0F;
+        float b = 0.0F;
+        float c = 0.0F;
+        float d = 1.0F;
+        float tx = 0.0F;
+        float ty = 0.0F;
+
+        void toMat4(cc::Mat4 &out) const;
     };
 
     struct ColorData {
         cc::middleware::Color4B color;
-        std::size_t vertexFloatOffset = 0;
+        // relative to the first vertex float of the frame
+        uint32_t vertexFloatOffset = 0;
     };
 
+    // ranges of one frame in the contiguous arrays of its animation
     struct FrameData {
-        friend class ArmatureCache;
-
-        FrameData();
-        ~FrameData();
-
-        const std::vector<BoneData *> &getBones() const {
-            return _bones;
-        }
-        std::size_t getBoneCount() const;
-
-        const std::vector<ColorData *> &getColors() const {
-            return _colors;
-        }
-        std::size_t getColorCount() const;
-
-        const std::vector<SegmentData *> &getSegments() const {
-            return _segments;
-        }
-        std::size_t getSegmentCount() const;
+        uint32_t boneOffset = 0;
+        uint32_t boneCount = 0;
+        uint32_t colorOffset = 0;
+        uint32_t colorCount = 0;
+        uint32_t segmentOffset = 0;
+        uint32_t segmentCount = 0;
+        uint32_t vertexFloatOffset = 0;
+        uint32_t vertexFloatCount = 0;
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
+    };
 
-    private:
-        // if segment data is empty, it will build new one.
-        SegmentData *buildSegmentData(std::size_t index);
-        // if color data is empty, it will build new one.
-        ColorData *buildColorData(std::size_t index);
-        // if bone data is empty, it will build new one.
-        BoneData *buildBoneData(std::size_t index);
-
-        std::vector<BoneData *> _bones;
-        std::vector<ColorData *> _colors;
-        std::vector<SegmentData *> _segments;
-
-    public:
-        cc::middleware::IOBuffer ib;
-        cc::middleware::IOBuffer vb;
+    // all frames of an animation, each kind of data stored back to back
+    struct FrameArrays {
+        std::vector<FrameData> frames;
+        std::vector<BoneData> bones;
+        std::vector<ColorData> colors;
+        std::vector<SegmentData> segments;
+        std::vector<float> vertices;
+        std::vector<uint16_t> indices;
     };
 
     struct AnimationData {
@@ -103,20 +89,45 @@ public:
         ~AnimationData();
         void reset();
 
-        FrameData *getFrameData(std::size_t frameIdx) const;
-        std::size_t getFrameCount() const;
+        const FrameData *getFrameData(std::size_t frameIdx) const;
+        std::size_t getFrameCount() const { return _view.frameCount; }
+
+        const BoneData *getBones(const FrameData &frame) const { return _view.bones + frame.boneOffset; }
+        const ColorData *getColors(const FrameData &frame) const { return _view.colors + frame.colorOffset; }
+        const SegmentData *getSegments(const FrameData &frame) const { return _view.segments + frame.segmentOffset; }
+        const float *getVertices(const FrameData &frame) const { return _view.vertices + frame.vertexFloatOffset; }
+        const uint16_t *getIndices(const FrameData &frame) const { return _view.indices + frame.indexOffset; }
 
         bool isComplete() const { return _isComplete; }
+        // frames are read from a mapped file rather than baked in this session
+        bool isMapped() const { return _file.isOpen(); }
         bool needUpdate(int toFrameIdx) const;
 
+        /**
+         * Baked frames are written as one blob which load maps into memory, so every
+         * armature sharing the file shares its pages. The signature and texture count
+         * must match the ones passed to save.
+         */
+        bool save(const std::string &path, uint64_t signature, uint32_t textureCount) const;
+        bool load(const std::string &path, uint64_t signature, uint32_t textureCount);
+
+        static bool writeFile(const FrameArrays &arrays, bool isComplete, float totalTime, const std::string &path, uint64_t signature, uint32_t textureCount);
+
     private:
-        // if frame is empty, it will build new one.
-        FrameData *buildFrameData(std::size_t frameIdx);
+        // point the views at the owned arrays
+        void bindArrays();
+        // point the views into the mapped file after validating it
+        bool bindFile(uint64_t signature, uint32_t textureCount);
 
         std::string _animationName;
         bool _isComplete = false;
         float _totalTime = 0.0F;
-        std::vector<FrameData *> _frames;
+
+        FrameArrays _arrays;
+        cc::middleware::MappedFile _file;
+
+        // views of either the owned arrays or the mapped file
+        cc::middleware::BakedFrameFile<FrameArrays>::View _view;
     };
 
     ArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID);
@@ -131,16 +142,37 @@ public:
     void resetAllAnimationData();
     void resetAnimationData(const std::string &animationName);
 
+    /**
+     * Bakes every animation of the armature to the end. With a cache directory set, the
+     * baked frames are saved there, so later runs map them instead of baking.
+     */
+    void bakeAllAnimations();
+
+    cc::middleware::Texture2D *getTexture(int index) const;
+
+    // directory to save baked animations to and load them from, disabled if empty
+    static void setCacheDirectory(const std::string &dir) { cacheDirectory = dir; }
+    static const std::string &getCacheDirectory() { return cacheDirectory; }
+
 private:
     void renderAnimationFrame(AnimationData *animationData);
     void traverseArmature(Armature *armature, float parentOpacity = 1.0F);
+    int findTexture(cc::middleware::Texture2D *texture);
+
+    uint64_t computeSignature(const std::string &animationName) const;
+    std::string getCachePath(uint64_t signature) const;
+    void saveAnimationData(AnimationData *animationData);
 
 public:
     static float FrameTime;    // NOLINT
     static float MaxCacheTime; // NOLINT
 
 private:
-    FrameData *_frameData = nullptr;
+    static std::string cacheDirectory; // NOLINT
+
+    FrameArrays *_frameArrays = nullptr;
+    uint32_t _frameVertexBase = 0;
+    uint32_t _frameColorBase = 0;
     cc::middleware::Color4F _preColor = cc::middleware::Color4F(-1.0F, -1.0F, -1.0F, -1.0F);
     cc::middleware::Color4F _color = cc::middleware::Color4F(1.0F, 1.0F, 1.0F, 1.0F);
     CCArmatureDisplay *_armatureDisplay = nullptr;
@@ -150,9 +182,14 @@ private:
     int _preISegWritePos = -1;
     int _curISegLen = 0;
     int _curVSegLen = 0;
-    int _materialLen = 0;
     std::string _curAnimationName;
+    std::string _cacheKey;
     std::map<std::string, AnimationData *> _animationCaches;
+    // atlas pages first, then textures met while baking; frames refer to them by index
+    std::vector<cc::middleware::Texture2D *> _textures;
+    uint32_t _atlasTextureCount = 0;
+    // hash of the armature data and the atlas regions, part of every cache file signature
+    uint64_t _contentHash = 0;
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -23,6 +23,7 @@
 
 #include "ArmatureCacheMgr.h"
 #include "base/DeferredReleasePool.h"
+#include "platform/FileUtils.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -38,6 +39,19 @@ ArmatureCache *ArmatureCacheMgr::buildArmatureCache(const std::string &armatureN
     return animation;
 }
 
+ArmatureCache *ArmatureCacheMgr::bakeArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID) {
+    ArmatureCache *animation = buildArmatureCache(armatureName, armatureKey, atlasUUID);
+    animation->bakeAllAnimations();
+    return animation;
+}
+
+void ArmatureCacheMgr::setCacheDirectory(const std::string &dir) {
+    if (!dir.empty() && !cc::FileUtils::getInstance()->isDirectoryExist(dir)) {
+        cc::FileUtils::getInstance()->createDirectory(dir);
+    }
+    ArmatureCache::setCacheDirectory(dir);
+}
+
 void ArmatureCacheMgr::removeArmatureCache(const std::string &armatureKey) {
     for (auto it = _caches.begin(); it != _caches.end();) {
         auto found = it->first.find(armatureKey);
@@ -47,6 +47,11 @@ public:
 
     void removeArmatureCache(const std::string &armatureKey);
     ArmatureCache *buildArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID);
+    // builds the shared cache and bakes all of its animations, e.g. while a level loads
+    ArmatureCache *bakeArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID);
+
+    // baked animations are saved to and mapped from this directory, disabled if empty
+    void setCacheDirectory(const std::string &dir);
 
 private:
     static ArmatureCacheMgr *_instance;
@@ -137,15 +137,15 @@ void CCArmatureCacheDisplay::update(float dt) {
 
 void CCArmatureCacheDisplay::render(float /*dt*/) {
     if (!_animationData) return;
-    ArmatureCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
+    const ArmatureCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
     if (!frameData) return;
 
     auto *mgr = MiddlewareManager::getInstance();
     auto *entity = _entity;
     entity->clearDynamicRenderDrawInfos();
 
-    const auto &segments = frameData->getSegments();
-    const auto &colors = frameData->getColors();
+    const ArmatureCache::SegmentData *segments = _animationData->getSegments(*frameData);
+    const ArmatureCache::ColorData *colors = _animationData->getColors(*frameData);
 
     _sharedBufferOffset->reset();
     _sharedBufferOffset->clear();
@@ -157,17 +157,17 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
     // store attach info offset
     _sharedBufferOffset->writeUint32(static_cast<uint32_t>(attachInfo->getCurPos()) / sizeof(uint32_t));
 
-    if (segments.empty() || colors.empty()) return;
+    if (frameData->segmentCount == 0 || frameData->colorCount == 0) return;
 
     middleware::MeshBuffer *mb = mgr->getMeshBuffer(VF_XYZUVC);
     middleware::IOBuffer &vb = mb->getVB();
     middleware::IOBuffer &ib = mb->getIB();
-    const auto &srcVB = frameData->vb;
-    const auto &srcIB = frameData->ib;
+    const auto *srcVB = reinterpret_cast<const char *>(_animationData->getVertices(*frameData));
+    const auto *srcIB = reinterpret_cast<const char *>(_animationData->getIndices(*frameData));
     auto &nodeWorldMat = entity->getNode()->getWorldMatrix();
 
-    int colorOffset = 0;
-    ArmatureCache::ColorData *nowColor = colors[colorOffset++];
+    uint32_t colorOffset = 0;
+    const ArmatureCache::ColorData *nowColor = &colors[colorOffset++];
     auto maxVFOffset = nowColor->vertexFloatOffset;
 
     Color4B color;
@@ -201,7 +201,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         needColor = true;
     }
 
-    auto handleColor = [&](ArmatureCache::ColorData *colorData) {
+    auto handleColor = [&](const ArmatureCache::ColorData *colorData) {
         tempA = colorData->color.a * _nodeColor.a;
         multiplier = _premultipliedAlpha ? tempA / 255.0f : 1.0f;
         tempR = _nodeColor.r * multiplier;
@@ -216,12 +216,13 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
 
     handleColor(nowColor);
     int segmentCount = 0;
-    for (auto *segment : segments) {
+    for (uint32_t segmentIndex = 0; segmentIndex < frameData->segmentCount; segmentIndex++) {
+        const ArmatureCache::SegmentData *segment = &segments[segmentIndex];
         vertexBytes = segment->vertexFloatCount * sizeof(float);
         curDrawInfo = requestDrawInfo(segmentCount++);
         entity->addDynamicRenderDrawInfo(curDrawInfo);
         // fill new texture index
-        curTexture = static_cast<cc::Texture2D *>(segment->getTexture()->getRealTexture());
+        curTexture = static_cast<cc::Texture2D *>(_armatureCache->getTexture(segment->textureIndex)->getRealTexture());
         gfx::Texture *texture = curTexture->getGFXTexture();
         gfx::Sampler *sampler = curTexture->getGFXSampler();
         curDrawInfo->setTexture(texture);
@@ -255,7 +256,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         dstVertexOffset = vb.getCurPos() / sizeof(V3F_T2F_C4B);
         dstVertexBuffer = reinterpret_cast<float *>(vb.getCurBuffer());
         dstColorBuffer = reinterpret_cast<unsigned int *>(vb.getCurBuffer());
-        vb.writeBytes(reinterpret_cast<char *>(srcVB.getBuffer()) + srcVertexBytesOffset, vertexBytes);
+        vb.writeBytes(srcVB + srcVertexBytesOffset, vertexBytes);
         // batch handle
         cc::Vec3 *point = nullptr;
 
@@ -268,8 +269,8 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         if (needColor) {
             auto frameFloatOffset = srcVertexBytesOffset / sizeof(float);
             for (auto colorIndex = 0; colorIndex < segment->vertexFloatCount; colorIndex += VF_XYZUVC, frameFloatOffset += VF_XYZUVC) {
-                if (frameFloatOffset >= maxVFOffset) {
-                    nowColor = colors[colorOffset++];
+                if (frameFloatOffset >= maxVFOffset && colorOffset < frameData->colorCount) {
+                    nowColor = &colors[colorOffset++];
                     handleColor(nowColor);
                     maxVFOffset = nowColor->vertexFloatOffset;
                 }
@@ -285,7 +286,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         ib.checkSpace(indexBytes, true);
         dstIndexOffset = static_cast<int>(ib.getCurPos()) / sizeof(uint16_t);
         dstIndexBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-        ib.writeBytes(reinterpret_cast<char *>(srcIB.getBuffer()) + srcIndexBytesOffset, indexBytes);
+        ib.writeBytes(srcIB + srcIndexBytesOffset, indexBytes);
         for (auto indexPos = 0; indexPos < segment->indexCount; indexPos++) {
             dstIndexBuffer[indexPos] += dstVertexOffset;
         }
@@ -302,13 +303,13 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
     }
 
     if (_useAttach) {
-        const auto &bonesData = frameData->getBones();
-        auto boneCount = frameData->getBoneCount();
+        const ArmatureCache::BoneData *bonesData = _animationData->getBones(*frameData);
+        cc::Mat4 boneMat;
 
-        for (int i = 0; i < boneCount; i++) {
-            auto *bone = bonesData[i];
+        for (uint32_t i = 0, n = frameData->boneCount; i < n; i++) {
+            bonesData[i].toMat4(boneMat);
             attachInfo->checkSpace(sizeof(cc::Mat4), true);
-            attachInfo->writeBytes(reinterpret_cast<const char *>(&bone->globalTransformMatrix), sizeof(cc::Mat4));
+            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMat), sizeof(cc::Mat4));
         }
     }
 }
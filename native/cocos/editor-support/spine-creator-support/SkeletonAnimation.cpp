@@ -131,6 +131,22 @@ void SkeletonAnimation::update(float deltaTime) {
     }
 }
 
+bool SkeletonAnimation::isParallelUpdateSafe() const {
+    // a skeleton not owned by this instance may be posed by others too
+    return _skeleton && _state && _ownsSkeleton;
+}
+
+void SkeletonAnimation::updateParallelly(float deltaTime) {
+    // listeners call into script, queued events are raised in dispatchEvents on main thread
+    _state->disableQueue();
+    update(deltaTime);
+}
+
+void SkeletonAnimation::dispatchEvents() {
+    _state->enableQueue();
+    _state->drainQueue();
+}
+
 void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
     CC_ASSERT(stateData);
 
@@ -51,6 +51,9 @@ public:
     static void setGlobalTimeScale(float timeScale);
 
     virtual void update(float deltaTime) override;
+    bool isParallelUpdateSafe() const override;
+    void updateParallelly(float deltaTime) override;
+    void dispatchEvents() override;
 
     void setAnimationStateData(AnimationStateData *stateData);
     void setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration);
@@ -28,6 +28,11 @@
  *****************************************************************************/
 
 #include "SkeletonCache.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include "base/ThreadPool.h"
 #include "base/memory/Memory.h"
 #include "spine-creator-support/AttachmentVertices.h"
 
@@ -38,79 +43,78 @@ namespace spine {
 
 float SkeletonCache::FrameTime = 1.0F / 60.0F;
 float SkeletonCache::MaxCacheTime = 120.0F;
+bool SkeletonCache::backgroundBuildEnabled = true;
+std::string SkeletonCache::cacheDirectory;
 
-SkeletonCache::SegmentData::SegmentData() = default;
+namespace {
+constexpr uint32_t CACHE_FILE_MAGIC = 0x434b5353; // "SSKC"
 
-SkeletonCache::SegmentData::~SegmentData() {
-    CC_SAFE_RELEASE_NULL(_texture);
+void hashString(CacheHash &hash, const String &str) {
+    hash.add(str.length());
+    hash.add(str.buffer(), str.length());
 }
 
-void SkeletonCache::SegmentData::setTexture(cc::middleware::Texture2D *value) {
-    CC_SAFE_ADD_REF(value);
-    CC_SAFE_RELEASE(_texture);
-    _texture = value;
+// same steps as SkeletonCache::update
+void advance(Skeleton *skeleton, AnimationState *state, float deltaTime) {
+    skeleton->update(deltaTime);
+    state->update(deltaTime);
+    state->apply(*skeleton);
+    skeleton->updateWorldTransform();
 }
-
-cc::middleware::Texture2D *SkeletonCache::SegmentData::getTexture() const {
-    return _texture;
-}
-
-SkeletonCache::FrameData::FrameData() = default;
-
-SkeletonCache::FrameData::~FrameData() {
-    for (auto &bone : _bones) {
-        delete bone;
+} // namespace
+
+// A clone of the skeleton which bakes one animation on a worker thread, frames are published by updateToFrame.
+struct SkeletonCache::BuildTask {
+    ~BuildTask() {
+        delete state;
+        delete stateData;
+        delete skeleton;
+        delete clipper;
     }
-    _bones.clear();
 
-    for (auto &color : _colors) {
-        delete color;
+    void finish() {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        done.store(true, std::memory_order_release);
+        doneCondition.notify_all();
     }
-    _colors.clear();
-
-    for (auto &segment : _segments) {
-        delete segment;
-    }
-    _segments.clear();
-}
 
-SkeletonCache::BoneData *SkeletonCache::FrameData::buildBoneData(std::size_t index) {
-    if (index > _bones.size()) return nullptr;
-    if (index == _bones.size()) {
-        auto *boneData = new BoneData;
-        _bones.push_back(boneData);
+    void wait() {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCondition.wait(lock, [this]() { return done.load(std::memory_order_acquire); });
     }
-    return _bones[index];
-}
-
-std::size_t SkeletonCache::FrameData::getBoneCount() const {
-    return _bones.size();
-}
-
-SkeletonCache::ColorData *SkeletonCache::FrameData::buildColorData(std::size_t index) {
-    if (index > _colors.size()) return nullptr;
-    if (index == _colors.size()) {
-        auto *colorData = new ColorData;
-        _colors.push_back(colorData);
-    }
-    return _colors[index];
-}
 
-std::size_t SkeletonCache::FrameData::getColorCount() const {
-    return _colors.size();
-}
-
-SkeletonCache::SegmentData *SkeletonCache::FrameData::buildSegmentData(std::size_t index) {
-    if (index > _segments.size()) return nullptr;
-    if (index == _segments.size()) {
-        auto *segmentData = new SegmentData;
-        _segments.push_back(segmentData);
-    }
-    return _segments[index];
-}
-
-std::size_t SkeletonCache::FrameData::getSegmentCount() const {
-    return _segments.size();
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    std::atomic<bool> done{false};
+    std::atomic<bool> canceled{false};
+    bool succeeded = false;
+    bool saved = false;
+
+    Skeleton *skeleton = nullptr;
+    AnimationStateData *stateData = nullptr;
+    AnimationState *state = nullptr;
+    TrackEntry *entry = nullptr;
+    SkeletonClipping *clipper = nullptr;
+    // snapshot of the texture table, the worker can't add to it
+    std::vector<cc::middleware::Texture2D *> textures;
+
+    FrameArrays arrays;
+    bool isComplete = false;
+    float totalTime = 0.0F;
+
+    std::string savePath;
+    uint64_t signature = 0;
+    uint32_t textureCount = 0;
+};
+
+void SkeletonCache::BoneData::toMat4(cc::Mat4 &out) const {
+    out.setIdentity();
+    out.m[0] = a;
+    out.m[1] = c;
+    out.m[4] = b;
+    out.m[5] = d;
+    out.m[12] = worldX;
+    out.m[13] = worldY;
 }
 
 SkeletonCache::AnimationData::AnimationData() = default;
@@ -120,47 +124,172 @@ SkeletonCache::AnimationData::~AnimationData() {
 }
 
 void SkeletonCache::AnimationData::reset() {
-    for (auto &frame : _frames) {
-        delete frame;
-    }
-    _frames.clear();
+    _arrays = FrameArrays();
+    _file.close();
+    bindArrays();
     _isComplete = false;
+    _buildFailed = false;
     _totalTime = 0.0F;
 }
 
+void SkeletonCache::AnimationData::bindArrays() {
+    _view = cc::middleware::BakedFrameFile<FrameArrays>::view(_arrays);
+}
+
 bool SkeletonCache::AnimationData::needUpdate(int toFrameIdx) const {
-    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || _frames.size() < toFrameIdx + 1);
+    return !_isComplete && _totalTime <= MaxCacheTime && (toFrameIdx == -1 || _view.frameCount < toFrameIdx + 1);
 }
 
-SkeletonCache::FrameData *SkeletonCache::AnimationData::buildFrameData(std::size_t frameIdx) {
-    if (frameIdx > _frames.size()) {
+const SkeletonCache::FrameData *SkeletonCache::AnimationData::getFrameData(std::size_t frameIdx) const {
+    if (frameIdx >= _view.frameCount) {
         return nullptr;
     }
-    if (frameIdx == _frames.size()) {
-        auto *frameData = new FrameData();
-        _frames.push_back(frameData);
-    }
-    return _frames[frameIdx];
+    return _view.frames + frameIdx;
 }
 
-SkeletonCache::FrameData *SkeletonCache::AnimationData::getFrameData(std::size_t frameIdx) const {
-    if (frameIdx >= _frames.size()) {
-        return nullptr;
+bool SkeletonCache::AnimationData::save(const std::string &path, uint64_t signature, uint32_t textureCount) const {
+    if (_file.isOpen()) return false;
+    return writeFile(_arrays, _isComplete, _totalTime, path, signature, textureCount);
+}
+
+bool SkeletonCache::AnimationData::writeFile(const FrameArrays &arrays, bool isComplete, float totalTime, const std::string &path, uint64_t signature, uint32_t textureCount) {
+    return cc::middleware::BakedFrameFile<FrameArrays>::write(arrays, isComplete, totalTime, path, CACHE_FILE_MAGIC, signature, textureCount);
+}
+
+bool SkeletonCache::AnimationData::load(const std::string &path, uint64_t signature, uint32_t textureCount) {
+    reset();
+    if (!_file.open(path)) return false;
+    if (!bindFile(signature, textureCount)) {
+        reset();
+        return false;
     }
-    return _frames[frameIdx];
+    return true;
 }
 
-std::size_t SkeletonCache::AnimationData::getFrameCount() const {
-    return _frames.size();
+bool SkeletonCache::AnimationData::bindFile(uint64_t signature, uint32_t textureCount) {
+    return cc::middleware::BakedFrameFile<FrameArrays>::read(_file, CACHE_FILE_MAGIC, signature, textureCount, &_view, &_isComplete, &_totalTime);
 }
 
 SkeletonCache::SkeletonCache() = default;
 
 SkeletonCache::~SkeletonCache() {
+    for (auto &animationCache : _animationCaches) {
+        cancelBuild(animationCache.second);
+    }
+    // workers read the skeleton data, which may be released with this cache
+    for (auto &task : _canceledTasks) {
+        task->wait();
+    }
+    _canceledTasks.clear();
+
     for (auto &animationCache : _animationCaches) {
         delete animationCache.second;
     }
     _animationCaches.clear();
+
+    for (auto *texture : _textures) {
+        CC_SAFE_RELEASE(texture);
+    }
+    _textures.clear();
+}
+
+void SkeletonCache::initTextures() {
+    if (!_skeleton || !_textures.empty()) return;
+    auto *skeletonData = _skeleton->getData();
+    // baked frames only stay valid while the skeleton and its atlas are unchanged,
+    // so everything they are derived from goes into the content hash
+    CacheHash hash;
+    hashString(hash, skeletonData->getHash());
+    hashString(hash, skeletonData->getVersion());
+    hash.add(skeletonData->getBones().size());
+    hash.add(skeletonData->getSlots().size());
+    auto &animations = skeletonData->getAnimations();
+    hash.add(animations.size());
+    for (std::size_t i = 0, n = animations.size(); i < n; i++) {
+        hashString(hash, animations[i]->getName());
+        hash.add(animations[i]->getDuration());
+    }
+    auto &skins = skeletonData->getSkins();
+    hash.add(skins.size());
+    for (std::size_t i = 0, n = skins.size(); i < n; i++) {
+        hashString(hash, skins[i]->getName());
+        auto entries = skins[i]->getAttachments();
+        while (entries.hasNext()) {
+            auto &entry = entries.next();
+            Attachment *attachment = entry._attachment;
+            hash.add(entry._slotIndex);
+            hashString(hash, entry._name);
+            AttachmentVertices *attachmentVertices = nullptr;
+            if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+                attachmentVertices = static_cast<AttachmentVertices *>(static_cast<RegionAttachment *>(attachment)->getRendererObject());
+            } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+                attachmentVertices = static_cast<AttachmentVertices *>(static_cast<MeshAttachment *>(attachment)->getRendererObject());
+            }
+            if (attachmentVertices && attachmentVertices->_texture) {
+                auto *texture = attachmentVertices->_texture;
+                hash.add(findTexture(_textures, texture, true));
+                hash.add(texture->getPixelsWide());
+                hash.add(texture->getPixelsHigh());
+                const auto *triangles = attachmentVertices->_triangles;
+                if (triangles) {
+                    hash.add(triangles->vertCount);
+                    for (int v = 0; v < triangles->vertCount; v++) {
+                        hash.add(triangles->verts[v].texCoord.u);
+                        hash.add(triangles->verts[v].texCoord.v);
+                    }
+                    hash.add(triangles->indexCount);
+                    hash.add(triangles->indices, triangles->indexCount * sizeof(uint16_t));
+                }
+            }
+        }
+    }
+    _skinTextureCount = static_cast<uint32_t>(_textures.size());
+    hash.add(_skinTextureCount);
+    _contentHash = hash.get();
+}
+
+int SkeletonCache::findTexture(std::vector<cc::middleware::Texture2D *> &textures, cc::middleware::Texture2D *texture, bool canAdd) {
+    // a skeleton rarely uses more than a few atlas pages
+    for (std::size_t i = 0, n = textures.size(); i < n; i++) {
+        if (textures[i] == texture) return static_cast<int>(i);
+    }
+    if (!canAdd) return -1;
+    texture->addRef();
+    textures.push_back(texture);
+    return static_cast<int>(textures.size()) - 1;
+}
+
+cc::middleware::Texture2D *SkeletonCache::getTexture(int index) const {
+    if (index < 0 || index >= static_cast<int>(_textures.size())) return nullptr;
+    return _textures[index];
+}
+
+uint64_t SkeletonCache::computeSignature(const std::string &animationName) const {
+    CacheHash hash;
+    hash.add(_contentHash);
+    hash.add(animationName);
+    auto *skin = _skeleton->getSkin();
+    hash.add(skin ? skin->getName().buffer() : "");
+    auto &slots = _skeleton->getSlots();
+    hash.add(slots.size());
+    for (std::size_t i = 0, n = slots.size(); i < n; i++) {
+        auto *attachment = slots[i]->getAttachment();
+        hash.add(attachment ? attachment->getName().buffer() : "");
+    }
+    hash.add(FrameTime);
+    hash.add(MaxCacheTime);
+    return hash.get();
+}
+
+std::string SkeletonCache::getCachePath(uint64_t signature) const {
+    if (cacheDirectory.empty()) return "";
+    CacheHash uuidHash;
+    uuidHash.add(_uuid);
+    char name[48];
+    snprintf(name, sizeof(name), "%016llx-%016llx.skc", static_cast<unsigned long long>(uuidHash.get()), static_cast<unsigned long long>(signature)); // NOLINT(google-runtime-int)
+    auto path = cacheDirectory;
+    if (path.back() != '/') path += '/';
+    return path + name;
 }
 
 SkeletonCache::AnimationData *SkeletonCache::buildAnimationData(const std::string &animationName) {
@@ -170,6 +299,7 @@ SkeletonCache::AnimationData *SkeletonCache::buildAnimationData(const std::strin
         auto *animation = findAnimation(animationName);
         if (animation == nullptr) return nullptr;
 
+        initTextures();
         aniData = new AnimationData();
         aniData->_animationName = animationName;
         _animationCaches[animationName] = aniData;
@@ -202,10 +332,30 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
     }
 
     AnimationData *animationData = it->second;
-    if (!animationData || !animationData->needUpdate(toFrameIdx)) {
+    if (!animationData) {
+        return;
+    }
+
+    if (animationData->isBuilding()) {
+        pollBuild(animationData);
+        if (animationData->isBuilding()) return;
+    }
+
+    if (!animationData->needUpdate(toFrameIdx)) {
         return;
     }
 
+    if (animationData->getFrameCount() == 0 && _skeleton) {
+        auto signature = computeSignature(animationName);
+        auto path = getCachePath(signature);
+        if (!path.empty() && animationData->load(path, signature, _skinTextureCount)) {
+            return;
+        }
+        if (backgroundBuildEnabled && !animationData->_buildFailed && startBuild(animationData)) {
+            return;
+        }
+    }
+
     if (_curAnimationName != animationName) {
         updateToFrame(_curAnimationName);
         _curAnimationName = animationName;
@@ -223,15 +373,143 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
     } while (animationData->needUpdate(toFrameIdx));
 }
 
+bool SkeletonCache::startBuild(AnimationData *animationData) {
+    auto *animation = findAnimation(animationData->_animationName);
+    if (!animation) return false;
+
+    auto task = std::make_shared<BuildTask>();
+    auto *skeletonData = _skeleton->getData();
+    task->skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+    auto *skin = _skeleton->getSkin();
+    if (skin) task->skeleton->setSkin(skin);
+    task->skeleton->setToSetupPose();
+    auto &srcSlots = _skeleton->getSlots();
+    auto &dstSlots = task->skeleton->getSlots();
+    for (std::size_t i = 0, n = srcSlots.size(); i < n; i++) {
+        dstSlots[i]->setAttachment(srcSlots[i]->getAttachment());
+    }
+    task->skeleton->getColor().set(_skeleton->getColor());
+    task->stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+    task->state = new (__FILE__, __LINE__) AnimationState(task->stateData);
+    task->entry = task->state->setAnimation(0, animation, false);
+    task->clipper = new (__FILE__, __LINE__) SkeletonClipping();
+
+    task->signature = computeSignature(animationData->_animationName);
+    task->textureCount = _skinTextureCount;
+    task->savePath = getCachePath(task->signature);
+
+    // bake the first frame at once, so the animation shows before the worker is done
+    advance(task->skeleton, task->state, FrameTime);
+    bakeFrame(task->skeleton, task->clipper, _textures, true, task->arrays);
+    task->totalTime = FrameTime;
+    task->isComplete = task->entry->isComplete();
+    task->textures = _textures;
+
+    animationData->_file.close();
+    animationData->_arrays = task->arrays;
+    animationData->bindArrays();
+    animationData->_totalTime = task->totalTime;
+    animationData->_isComplete = task->isComplete;
+    if (!animationData->needUpdate(-1)) {
+        return true;
+    }
+
+    animationData->_task = task;
+    LegacyThreadPool::getDefaultThreadPool()->pushTask([task](int /*tid*/) {
+        task->succeeded = true;
+        while (!task->isComplete && task->totalTime <= MaxCacheTime) {
+            if (task->canceled.load(std::memory_order_relaxed)) {
+                task->succeeded = false;
+                break;
+            }
+            advance(task->skeleton, task->state, FrameTime);
+            if (!bakeFrame(task->skeleton, task->clipper, task->textures, false, task->arrays)) {
+                task->succeeded = false;
+                break;
+            }
+            task->totalTime += FrameTime;
+            task->isComplete = task->entry->isComplete();
+        }
+        if (task->succeeded && !task->savePath.empty()) {
+            task->saved = AnimationData::writeFile(task->arrays, task->isComplete, task->totalTime, task->savePath, task->signature, task->textureCount);
+        }
+        task->finish();
+    });
+    return true;
+}
+
+void SkeletonCache::pollBuild(AnimationData *animationData) {
+    auto task = animationData->_task;
+    if (!task || !task->done.load(std::memory_order_acquire)) return;
+    animationData->_task = nullptr;
+
+    if (!task->succeeded) {
+        // a texture outside the skins was met, bake on the main thread which can add it
+        animationData->reset();
+        animationData->_buildFailed = true;
+        return;
+    }
+
+    // map the file the worker saved, its pages are shared with every process reading it
+    if (task->saved && animationData->load(task->savePath, task->signature, task->textureCount)) {
+        return;
+    }
+    animationData->_arrays = std::move(task->arrays);
+    animationData->bindArrays();
+    animationData->_totalTime = task->totalTime;
+    animationData->_isComplete = task->isComplete;
+}
+
+void SkeletonCache::cancelBuild(AnimationData *animationData) {
+    auto &task = animationData->_task;
+    if (!task) return;
+    task->canceled.store(true, std::memory_order_relaxed);
+    _canceledTasks.push_back(task);
+    task = nullptr;
+
+    _canceledTasks.erase(std::remove_if(_canceledTasks.begin(), _canceledTasks.end(), [](const std::shared_ptr<BuildTask> &t) {
+                             return t->done.load(std::memory_order_acquire);
+                         }),
+                         _canceledTasks.end());
+}
+
 void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
-    std::size_t frameIndex = animationData->getFrameCount();
-    FrameData *frameData = animationData->buildFrameData(frameIndex);
+    bakeFrame(_skeleton, _clipper, _textures, true, animationData->_arrays);
+    animationData->bindArrays();
+}
 
-    if (!_skeleton) return;
+bool SkeletonCache::bakeFrame(Skeleton *skeleton, SkeletonClipping *clipper, std::vector<cc::middleware::Texture2D *> &textures, bool canAddTexture, FrameArrays &out) {
+    out.frames.emplace_back();
+    auto frameIndex = out.frames.size() - 1;
+    auto vertexBase = static_cast<uint32_t>(out.vertices.size());
+    auto indexBase = static_cast<uint32_t>(out.indices.size());
+    auto segmentBase = static_cast<uint32_t>(out.segments.size());
+    auto colorBase = static_cast<uint32_t>(out.colors.size());
+    auto boneBase = static_cast<uint32_t>(out.bones.size());
+
+    auto finishFrame = [&]() {
+        FrameData &frameData = out.frames[frameIndex];
+        frameData.boneOffset = boneBase;
+        frameData.boneCount = static_cast<uint32_t>(out.bones.size()) - boneBase;
+        frameData.colorOffset = colorBase;
+        frameData.colorCount = static_cast<uint32_t>(out.colors.size()) - colorBase;
+        frameData.segmentOffset = segmentBase;
+        frameData.segmentCount = static_cast<uint32_t>(out.segments.size()) - segmentBase;
+        frameData.vertexFloatOffset = vertexBase;
+        frameData.vertexFloatCount = static_cast<uint32_t>(out.vertices.size()) - vertexBase;
+        frameData.indexOffset = indexBase;
+        frameData.indexCount = static_cast<uint32_t>(out.indices.size()) - indexBase;
+    };
+
+    if (!skeleton) {
+        finishFrame();
+        return true;
+    }
 
     // If opacity is 0,then return.
-    if (_skeleton->getColor().a == 0) {
-        return;
+    if (skeleton->getColor().a == 0) {
+        finishFrame();
+        return true;
     }
 
     Color4F preColor(-1.0F, -1.0F, -1.0F, -1.0F);
@@ -243,16 +521,19 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
     Color4B finalDardk;
 
     AttachmentVertices *attachmentVertices = nullptr;
-    middleware::IOBuffer &vb = frameData->vb;
-    middleware::IOBuffer &ib = frameData->ib;
+    std::vector<float> &vb = out.vertices;
+    std::vector<uint16_t> &ib = out.indices;
+    // write positions, the arrays are trimmed to them at the end of the frame
+    std::size_t vbPos = vb.size();
+    std::size_t ibPos = ib.size();
 
     // vertex size int bytes with two color
     int vbs2 = sizeof(V3F_T2F_C4B_C4B);
     // vertex size in floats with two color
     int vs2 = static_cast<int32_t>(vbs2 / sizeof(float));
 
-    int vbSize = 0;
-    int ibSize = 0;
+    int vbFloats = 0;
+    int ibCount = 0;
 
     int preBlendMode = -1;
     int preTextureIndex = -1;
@@ -262,25 +543,36 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
     int curISegLen = 0;
     int curVSegLen = 0;
 
-    int materialLen = 0;
     Slot *slot = nullptr;
+    bool succeeded = true;
 
     middleware::Texture2D *texture = nullptr;
 
+    auto checkSpace = [&](int floats, int indices) {
+        if (vb.size() < vbPos + floats) vb.resize(vbPos + floats);
+        if (ib.size() < ibPos + indices) ib.resize(ibPos + indices);
+    };
+
     auto flush = [&]() {
         // fill pre segment count field
         if (preISegWritePos != -1) {
-            SegmentData *preSegmentData = frameData->buildSegmentData(materialLen - 1);
-            preSegmentData->indexCount = curISegLen;
-            preSegmentData->vertexFloatCount = curVSegLen;
+            SegmentData &preSegmentData = out.segments.back();
+            preSegmentData.indexCount = curISegLen;
+            preSegmentData.vertexFloatCount = curVSegLen;
         }
 
-        SegmentData *segmentData = frameData->buildSegmentData(materialLen);
-        segmentData->setTexture(texture);
-        segmentData->blendMode = slot->getData().getBlendMode();
+        int textureIndex = findTexture(textures, texture, canAddTexture);
+        if (textureIndex < 0) {
+            succeeded = false;
+            textureIndex = 0;
+        }
+        out.segments.emplace_back();
+        SegmentData &segmentData = out.segments.back();
+        segmentData.textureIndex = textureIndex;
+        segmentData.blendMode = slot->getData().getBlendMode();
 
         // save new segment count pos field
-        preISegWritePos = static_cast<int>(ib.getCurPos() / sizeof(uint16_t));
+        preISegWritePos = static_cast<int>(ibPos);
         // reset pre blend mode to current
         preBlendMode = static_cast<int>(slot->getData().getBlendMode());
         // reset pre texture index to current
@@ -289,26 +581,23 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
         curISegLen = 0;
         // reset vertex segmentation count
         curVSegLen = 0;
-        // material length increased
-        materialLen++;
     };
 
-    auto &bones = _skeleton->getBones();
+    auto &bones = skeleton->getBones();
     for (std::size_t i = 0, n = bones.size(); i < n; i++) {
         auto &bone = bones[i];
-        auto boneCount = frameData->getBoneCount();
-        BoneData *boneData = frameData->buildBoneData(boneCount);
-        auto &matm = boneData->globalTransformMatrix.m;
-        matm[0] = bone->getA();
-        matm[1] = bone->getC();
-        matm[4] = bone->getB();
-        matm[5] = bone->getD();
-        matm[12] = bone->getWorldX();
-        matm[13] = bone->getWorldY();
-    }
-
-    auto &drawOrder = _skeleton->getDrawOrder();
-    for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+        out.bones.emplace_back();
+        BoneData &boneData = out.bones.back();
+        boneData.a = bone->getA();
+        boneData.b = bone->getB();
+        boneData.c = bone->getC();
+        boneData.d = bone->getD();
+        boneData.worldX = bone->getWorldX();
+        boneData.worldY = bone->getWorldY();
+    }
+
+    auto &drawOrder = skeleton->getDrawOrder();
+    for (size_t i = 0, n = drawOrder.size(); i < n && succeeded; ++i) {
         slot = drawOrder[i];
 
         if (slot->getBone().isActive() == false) {
@@ -316,7 +605,7 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
         }
 
         if (!slot->getAttachment()) {
-            _clipper->clipEnd(*slot);
+            clipper->clipEnd(*slot);
             continue;
         }
         const spine::Color &slotColor = slot->getColor();
@@ -329,24 +618,23 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
 
             // Early exit if attachment is invisible
             if (attachment->getColor().a == 0) {
-                _clipper->clipEnd(*slot);
+                clipper->clipEnd(*slot);
                 continue;
             }
 
             trianglesTwoColor.vertCount = attachmentVertices->_triangles->vertCount;
-            vbSize = static_cast<int32_t>(trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B));
-            vb.checkSpace(vbSize, true);
-            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
+            trianglesTwoColor.indexCount = attachmentVertices->_triangles->indexCount;
+            vbFloats = trianglesTwoColor.vertCount * vs2;
+            ibCount = trianglesTwoColor.indexCount;
+            checkSpace(vbFloats, ibCount);
+            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.data() + vbPos);
             for (int ii = 0; ii < trianglesTwoColor.vertCount; ii++) {
                 trianglesTwoColor.verts[ii].texCoord = attachmentVertices->_triangles->verts[ii].texCoord;
             }
             attachment->computeWorldVertices(slot->getBone(), reinterpret_cast<float *>(trianglesTwoColor.verts), 0, vs2);
 
-            trianglesTwoColor.indexCount = attachmentVertices->_triangles->indexCount;
-            ibSize = static_cast<int32_t>(trianglesTwoColor.indexCount * sizeof(uint16_t));
-            ib.checkSpace(ibSize, true);
-            trianglesTwoColor.indices = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-            memcpy(trianglesTwoColor.indices, attachmentVertices->_triangles->indices, ibSize);
+            trianglesTwoColor.indices = ib.data() + ibPos;
+            memcpy(trianglesTwoColor.indices, attachmentVertices->_triangles->indices, ibCount * sizeof(uint16_t));
 
             attachmentColor = attachment->getColor();
 
@@ -356,43 +644,42 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
 
             // Early exit if attachment is invisible
             if (attachment->getColor().a == 0) {
-                _clipper->clipEnd(*slot);
+                clipper->clipEnd(*slot);
                 continue;
             }
 
             trianglesTwoColor.vertCount = attachmentVertices->_triangles->vertCount;
-            vbSize = static_cast<int32_t>(trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B));
-            vb.checkSpace(vbSize, true);
-            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
+            trianglesTwoColor.indexCount = attachmentVertices->_triangles->indexCount;
+            vbFloats = trianglesTwoColor.vertCount * vs2;
+            ibCount = trianglesTwoColor.indexCount;
+            checkSpace(vbFloats, ibCount);
+            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.data() + vbPos);
             for (int ii = 0; ii < trianglesTwoColor.vertCount; ii++) {
                 trianglesTwoColor.verts[ii].texCoord = attachmentVertices->_triangles->verts[ii].texCoord;
             }
             attachment->computeWorldVertices(*slot, 0, attachment->getWorldVerticesLength(), reinterpret_cast<float *>(trianglesTwoColor.verts), 0, vs2);
 
-            trianglesTwoColor.indexCount = attachmentVertices->_triangles->indexCount;
-            ibSize = static_cast<int32_t>(trianglesTwoColor.indexCount * sizeof(uint16_t));
-            ib.checkSpace(ibSize, true);
-            trianglesTwoColor.indices = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-            memcpy(trianglesTwoColor.indices, attachmentVertices->_triangles->indices, ibSize);
+            trianglesTwoColor.indices = ib.data() + ibPos;
+            memcpy(trianglesTwoColor.indices, attachmentVertices->_triangles->indices, ibCount * sizeof(uint16_t));
             attachmentColor = attachment->getColor();
         } else if (slot->getAttachment()->getRTTI().isExactly(ClippingAttachment::rtti)) {
             auto *clip = dynamic_cast<ClippingAttachment *>(slot->getAttachment());
-            _clipper->clipStart(*slot, clip);
+            clipper->clipStart(*slot, clip);
             continue;
         } else {
-            _clipper->clipEnd(*slot);
+            clipper->clipEnd(*slot);
             continue;
         }
-        color.a = _skeleton->getColor().a * slotColor.a * attachmentColor.a * 255;
+        color.a = skeleton->getColor().a * slotColor.a * attachmentColor.a * 255;
         // skip rendering if the color of this attachment is 0
         if (color.a == 0) {
-            _clipper->clipEnd(*slot);
+            clipper->clipEnd(*slot);
             continue;
         }
 
-        float red = _skeleton->getColor().r * attachmentColor.r * 255;
-        float green = _skeleton->getColor().g * attachmentColor.g * 255;
-        float blue = _skeleton->getColor().b * attachmentColor.b * 255;
+        float red = skeleton->getColor().r * attachmentColor.r * 255;
+        float green = skeleton->getColor().g * attachmentColor.g * 255;
+        float blue = skeleton->getColor().b * attachmentColor.b * 255;
 
         color.r = red * slotColor.r;
         color.g = green * slotColor.g;
@@ -423,38 +710,35 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
         if (preColor != color || preDarkColor != darkColor) {
             preColor = color;
             preDarkColor = darkColor;
-            auto colorCount = frameData->getColorCount();
-            if (colorCount > 0) {
-                ColorData *preColorData = frameData->buildColorData(colorCount - 1);
-                preColorData->vertexFloatOffset = static_cast<int>(vb.getCurPos() / sizeof(float));
+            if (out.colors.size() > colorBase) {
+                out.colors.back().vertexFloatOffset = static_cast<int>(vbPos - vertexBase);
             }
-            ColorData *colorData = frameData->buildColorData(colorCount);
-            colorData->finalColor = finalColor;
-            colorData->darkColor = finalDardk;
+            out.colors.emplace_back();
+            ColorData &colorData = out.colors.back();
+            colorData.finalColor = finalColor;
+            colorData.darkColor = finalDardk;
         }
 
         // Two color tint logic
-        if (_clipper->isClipping()) {
-            _clipper->clipTriangles(reinterpret_cast<float *>(&trianglesTwoColor.verts[0].vertex), trianglesTwoColor.indices, trianglesTwoColor.indexCount, reinterpret_cast<float *>(&trianglesTwoColor.verts[0].texCoord), vs2);
+        if (clipper->isClipping()) {
+            clipper->clipTriangles(reinterpret_cast<float *>(&trianglesTwoColor.verts[0].vertex), trianglesTwoColor.indices, trianglesTwoColor.indexCount, reinterpret_cast<float *>(&trianglesTwoColor.verts[0].texCoord), vs2);
 
-            if (_clipper->getClippedTriangles().size() == 0) {
-                _clipper->clipEnd(*slot);
+            if (clipper->getClippedTriangles().size() == 0) {
+                clipper->clipEnd(*slot);
                 continue;
             }
 
-            trianglesTwoColor.vertCount = static_cast<int>(_clipper->getClippedVertices().size()) >> 1;
-            vbSize = static_cast<int32_t>(trianglesTwoColor.vertCount * sizeof(V3F_T2F_C4B_C4B));
-            vb.checkSpace(vbSize, true);
-            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.getCurBuffer());
-
-            trianglesTwoColor.indexCount = static_cast<int>(_clipper->getClippedTriangles().size());
-            ibSize = static_cast<int32_t>(trianglesTwoColor.indexCount * sizeof(uint16_t));
-            ib.checkSpace(ibSize, true);
-            trianglesTwoColor.indices = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-            memcpy(trianglesTwoColor.indices, _clipper->getClippedTriangles().buffer(), sizeof(uint16_t) * _clipper->getClippedTriangles().size());
+            trianglesTwoColor.vertCount = static_cast<int>(clipper->getClippedVertices().size()) >> 1;
+            trianglesTwoColor.indexCount = static_cast<int>(clipper->getClippedTriangles().size());
+            vbFloats = trianglesTwoColor.vertCount * vs2;
+            ibCount = trianglesTwoColor.indexCount;
+            checkSpace(vbFloats, ibCount);
+            trianglesTwoColor.verts = reinterpret_cast<V3F_T2F_C4B_C4B *>(vb.data() + vbPos);
+            trianglesTwoColor.indices = ib.data() + ibPos;
+            memcpy(trianglesTwoColor.indices, clipper->getClippedTriangles().buffer(), sizeof(uint16_t) * clipper->getClippedTriangles().size());
 
-            float *verts = _clipper->getClippedVertices().buffer();
-            float *uvs = _clipper->getClippedUVs().buffer();
+            float *verts = clipper->getClippedVertices().buffer();
+            float *uvs = clipper->getClippedUVs().buffer();
 
             for (int v = 0, vn = trianglesTwoColor.vertCount, vv = 0; v < vn; ++v, vv += 2) {
                 V3F_T2F_C4B_C4B *vertex = trianglesTwoColor.verts + v;
@@ -480,39 +764,42 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
             flush();
         }
 
-        if (vbSize > 0 && ibSize > 0) {
+        if (vbFloats > 0 && ibCount > 0) {
             auto vertexOffset = curVSegLen / vs2;
 
             if (vertexOffset > 0) {
-                auto *ibBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-                for (uint32_t ii = 0, nn = ibSize / sizeof(uint16_t); ii < nn; ii++) {
+                uint16_t *ibBuffer = ib.data() + ibPos;
+                for (int ii = 0; ii < ibCount; ii++) {
                     ibBuffer[ii] += vertexOffset;
                 }
             }
-            vb.move(vbSize);
-            ib.move(ibSize);
+            vbPos += vbFloats;
+            ibPos += ibCount;
 
             // Record this turn index segmentation count,it will store in material buffer in the end.
-            curISegLen += static_cast<int32_t>(ibSize / sizeof(uint16_t));
-            curVSegLen += static_cast<int32_t>(vbSize / sizeof(float));
+            curISegLen += ibCount;
+            curVSegLen += vbFloats;
         }
 
-        _clipper->clipEnd(*slot);
+        clipper->clipEnd(*slot);
     } // End slot traverse
 
-    _clipper->clipEnd();
+    clipper->clipEnd();
 
     if (preISegWritePos != -1) {
-        SegmentData *preSegmentData = frameData->buildSegmentData(materialLen - 1);
-        preSegmentData->indexCount = curISegLen;
-        preSegmentData->vertexFloatCount = curVSegLen;
+        SegmentData &preSegmentData = out.segments.back();
+        preSegmentData.indexCount = curISegLen;
+        preSegmentData.vertexFloatCount = curVSegLen;
     }
 
-    auto colorCount = frameData->getColorCount();
-    if (colorCount > 0) {
-        ColorData *preColorData = frameData->buildColorData(colorCount - 1);
-        preColorData->vertexFloatOffset = static_cast<int>(vb.getCurPos() / sizeof(float));
+    if (out.colors.size() > colorBase) {
+        out.colors.back().vertexFloatOffset = static_cast<int>(vbPos - vertexBase);
     }
+
+    vb.resize(vbPos);
+    ib.resize(ibPos);
+    finishFrame();
+    return succeeded;
 }
 
 void SkeletonCache::onAnimationStateEvent(TrackEntry *entry, EventType type, Event *event) {
@@ -531,6 +818,7 @@ void SkeletonCache::onAnimationStateEvent(TrackEntry *entry, EventType type, Eve
 
 void SkeletonCache::resetAllAnimationData() {
     for (auto &animationCache : _animationCaches) {
+        cancelBuild(animationCache.second);
         animationCache.second->reset();
     }
 }
@@ -538,6 +826,7 @@ void SkeletonCache::resetAllAnimationData() {
 void SkeletonCache::resetAnimationData(const std::string &animationName) {
     for (auto &animationCache : _animationCaches) {
         if (animationCache.second->_animationName == animationName) {
+            cancelBuild(animationCache.second);
             animationCache.second->reset();
             break;
         }
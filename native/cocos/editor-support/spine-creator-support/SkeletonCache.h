@@ -29,8 +29,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
-#include "IOBuffer.h"
+#include "BakedFrameFile.h"
 #include "SkeletonAnimation.h"
 #include "middleware-adapter.h"
 
@@ -38,71 +40,58 @@ namespace spine {
 class SkeletonCache : public SkeletonAnimation {
 public:
     struct SegmentData {
-        friend class SkeletonCache;
-
-        SegmentData();
-        ~SegmentData();
-
-        void setTexture(cc::middleware::Texture2D *value);
-        cc::middleware::Texture2D *getTexture() const;
-
-    public:
         int indexCount = 0;
         int vertexFloatCount = 0;
         int blendMode = 0;
-
-    private:
-        cc::middleware::Texture2D *_texture = nullptr;
+        // index in the texture table of the skeleton cache, see getTexture
+        int textureIndex = 0;
     };
 
+    // affine part of the bone world transform
     struct BoneData {
-        cc::Mat4 globalTransformMatrix;
+        float a = 1.0F;
+        float b = 0.0F;
+        float c = 0.0F;
+        float d = 1.0F;
+        float worldX = 0.0F;
+        float worldY = 0.0F;
+
+        void toMat4(cc::Mat4 &out) const;
     };
 
     struct ColorData {
         cc::middleware::Color4B finalColor;
         cc::middleware::Color4B darkColor;
+        // relative to the first vertex float of the frame
         int vertexFloatOffset = 0;
     };
 
+    // ranges of one frame in the contiguous arrays of its animation
     struct FrameData {
-        friend class SkeletonCache;
-
-        FrameData();
-        ~FrameData();
-
-        const std::vector<BoneData *> &getBones() const {
-            return _bones;
-        }
-        std::size_t getBoneCount() const;
-
-        const std::vector<ColorData *> &getColors() const {
-            return _colors;
-        }
-        std::size_t getColorCount() const;
-
-        const std::vector<SegmentData *> &getSegments() const {
-            return _segments;
-        }
-        std::size_t getSegmentCount() const;
+        uint32_t boneOffset = 0;
+        uint32_t boneCount = 0;
+        uint32_t colorOffset = 0;
+        uint32_t colorCount = 0;
+        uint32_t segmentOffset = 0;
+        uint32_t segmentCount = 0;
+        uint32_t vertexFloatOffset = 0;
+        uint32_t vertexFloatCount = 0;
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
+    };
 
-    private:
-        // if segment data is empty, it will build new one.
-        SegmentData *buildSegmentData(std::size_t index);
-        // if color data is empty, it will build new one.
-        ColorData *buildColorData(std::size_t index);
-        // if bone data is empty, it will build new one.
-        BoneData *buildBoneData(std::size_t index);
-
-        std::vector<BoneData *> _bones;
-        std::vector<ColorData *> _colors;
-        std::vector<SegmentData *> _segments;
-
-    public:
-        cc::middleware::IOBuffer ib;
-        cc::middleware::IOBuffer vb;
+    // all frames of an animation, each kind of data stored back to back
+    struct FrameArrays {
+        std::vector<FrameData> frames;
+        std::vector<BoneData> bones;
+        std::vector<ColorData> colors;
+        std::vector<SegmentData> segments;
+        std::vector<float> vertices;
+        std::vector<uint16_t> indices;
     };
 
+    struct BuildTask;
+
     struct AnimationData {
         friend class SkeletonCache;
 
@@ -110,21 +99,47 @@ public:
         ~AnimationData();
         void reset();
 
-        FrameData *getFrameData(std::size_t frameIdx) const;
-        std::size_t getFrameCount() const;
+        const FrameData *getFrameData(std::size_t frameIdx) const;
+        std::size_t getFrameCount() const { return _view.frameCount; }
+
+        const BoneData *getBones(const FrameData &frame) const { return _view.bones + frame.boneOffset; }
+        const ColorData *getColors(const FrameData &frame) const { return _view.colors + frame.colorOffset; }
+        const SegmentData *getSegments(const FrameData &frame) const { return _view.segments + frame.segmentOffset; }
+        const float *getVertices(const FrameData &frame) const { return _view.vertices + frame.vertexFloatOffset; }
+        const uint16_t *getIndices(const FrameData &frame) const { return _view.indices + frame.indexOffset; }
 
         bool isComplete() const { return _isComplete; }
+        // the remaining frames are baked on a background thread, only the first one is available meanwhile
+        bool isBuilding() const { return _task != nullptr; }
         bool needUpdate(int toFrameIdx) const;
 
-    private:
-        // if frame is empty, it will build new one.
-        FrameData *buildFrameData(std::size_t frameIdx);
+        /**
+         * Writes the baked frames to a file which load maps into memory, so identical
+         * skeletons in later sessions skip baking and share the pages of the file.
+         * The signature and texture count must match the ones passed to save.
+         */
+        bool save(const std::string &path, uint64_t signature, uint32_t textureCount) const;
+        bool load(const std::string &path, uint64_t signature, uint32_t textureCount);
 
     private:
+        // point the views at the owned arrays
+        void bindArrays();
+        // point the views into the mapped file after validating it
+        bool bindFile(uint64_t signature, uint32_t textureCount);
+        static bool writeFile(const FrameArrays &arrays, bool isComplete, float totalTime, const std::string &path, uint64_t signature, uint32_t textureCount);
+
         std::string _animationName = "";
         bool _isComplete = false;
-        float _totalTime = 0.0f;
-        std::vector<FrameData *> _frames;
+        float _totalTime = 0.0F;
+        // set when the background build gave up, the animation is then baked on the main thread
+        bool _buildFailed = false;
+        std::shared_ptr<BuildTask> _task;
+
+        FrameArrays _arrays;
+        cc::middleware::MappedFile _file;
+
+        // views of either the owned arrays or the mapped file
+        cc::middleware::BakedFrameFile<FrameArrays>::View _view;
     };
 
     SkeletonCache();
@@ -143,15 +158,47 @@ public:
     void resetAllAnimationData();
     void resetAnimationData(const std::string &animationName);
 
+    cc::middleware::Texture2D *getTexture(int index) const;
+
+    /**
+     * Whether to bake animations on a background thread. The first frame is baked at once,
+     * the others are published by updateToFrame when the whole animation is done.
+     */
+    static void setBackgroundBuildEnabled(bool enabled) { backgroundBuildEnabled = enabled; }
+    static bool isBackgroundBuildEnabled() { return backgroundBuildEnabled; }
+    // directory to save baked animations to and load them from, disabled if empty
+    static void setCacheDirectory(const std::string &dir) { cacheDirectory = dir; }
+    static const std::string &getCacheDirectory() { return cacheDirectory; }
+
 private:
     void renderAnimationFrame(AnimationData *animationData);
+    // returns false if it meets a texture which is not in textures and can't add it
+    static bool bakeFrame(Skeleton *skeleton, SkeletonClipping *clipper, std::vector<cc::middleware::Texture2D *> &textures, bool canAddTexture, FrameArrays &out);
+    static int findTexture(std::vector<cc::middleware::Texture2D *> &textures, cc::middleware::Texture2D *texture, bool canAdd);
+
+    void initTextures();
+    uint64_t computeSignature(const std::string &animationName) const;
+    std::string getCachePath(uint64_t signature) const;
+    bool startBuild(AnimationData *animationData);
+    void pollBuild(AnimationData *animationData);
+    void cancelBuild(AnimationData *animationData);
 
 public:
     static float FrameTime;
     static float MaxCacheTime;
 
 private:
+    static bool backgroundBuildEnabled;
+    static std::string cacheDirectory;
+
     std::string _curAnimationName = "";
     std::map<std::string, AnimationData *> _animationCaches;
+    // textures of all skins in first seen order, frames refer to them by index
+    std::vector<cc::middleware::Texture2D *> _textures;
+    uint32_t _skinTextureCount = 0;
+    // hash of the skeleton data and the atlas regions its attachments use
+    uint64_t _contentHash = 0;
+    // builds which were canceled but may still run, waited for on destruction
+    std::vector<std::shared_ptr<BuildTask>> _canceledTasks;
 };
 } // namespace spine
@@ -120,6 +120,15 @@ void SkeletonCacheAnimation::update(float dt) {
 
     if (!_animationData) return;
 
+    if (_animationData->isBuilding()) {
+        // hold the first frame until the background build is published
+        _skeletonCache->updateToFrame(_animationName);
+        if (_animationData->isBuilding()) {
+            _curFrameIndex = 0;
+            return;
+        }
+    }
+
     if (_accTime <= 0.00001 && _playCount == 0) {
         if (_startListener) {
             _startListener(_animationName);
@@ -155,14 +164,14 @@ void SkeletonCacheAnimation::update(float dt) {
 
 void SkeletonCacheAnimation::render(float /*dt*/) {
     if (!_animationData) return;
-    SkeletonCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
+    const SkeletonCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
     if (!frameData) return;
     auto *entity = _entity;
     entity->clearDynamicRenderDrawInfos();
 
-    const auto &segments = frameData->getSegments();
-    const auto &colors = frameData->getColors();
-    if (segments.empty() || colors.empty()) return;
+    if (frameData->segmentCount == 0 || frameData->colorCount == 0) return;
+    const SkeletonCache::SegmentData *segments = _animationData->getSegments(*frameData);
+    const SkeletonCache::ColorData *colors = _animationData->getColors(*frameData);
 
     auto *mgr = MiddlewareManager::getInstance();
 
@@ -180,8 +189,8 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
     middleware::MeshBuffer *mb = mgr->getMeshBuffer(vertexFormat);
     middleware::IOBuffer &vb = mb->getVB();
     middleware::IOBuffer &ib = mb->getIB();
-    const auto &srcVB = frameData->vb;
-    const auto &srcIB = frameData->ib;
+    const auto *srcVB = reinterpret_cast<const char *>(_animationData->getVertices(*frameData));
+    const auto *srcIB = reinterpret_cast<const char *>(_animationData->getIndices(*frameData));
 
     // vertex size int bytes with one color
     int vbs1 = sizeof(V3F_T2F_C4B);
@@ -197,8 +206,8 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
 
     auto &nodeWorldMat = entity->getNode()->getWorldMatrix();
 
-    int colorOffset = 0;
-    SkeletonCache::ColorData *nowColor = colors[colorOffset++];
+    uint32_t colorOffset = 0;
+    const SkeletonCache::ColorData *nowColor = &colors[colorOffset++];
     auto maxVFOffset = nowColor->vertexFloatOffset;
 
     Color4B finalColor;
@@ -236,7 +245,7 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
         needColor = true;
     }
 
-    auto handleColor = [&](SkeletonCache::ColorData *colorData) {
+    auto handleColor = [&](const SkeletonCache::ColorData *colorData) {
         tempA = colorData->finalColor.a * _entity->getOpacity();
         multiplier = _premultipliedAlpha ? tempA / 255 : 1;
         tempR = _nodeColor.r * multiplier;
@@ -256,7 +265,8 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
 
     handleColor(nowColor);
     int segmentCount = 0;
-    for (auto *segment : segments) {
+    for (uint32_t segmentIndex = 0; segmentIndex < frameData->segmentCount; segmentIndex++) {
+        const SkeletonCache::SegmentData *segment = &segments[segmentIndex];
         srcVertexBytes = static_cast<int32_t>(segment->vertexFloatCount * sizeof(float));
         if (!_useTint) {
             tintBytes = static_cast<int32_t>(segment->vertexFloatCount / vs2 * sizeof(float));
@@ -269,7 +279,7 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
         curDrawInfo = requestDrawInfo(segmentCount++);
         entity->addDynamicRenderDrawInfo(curDrawInfo);
         // fill new texture index
-        curTexture = static_cast<cc::Texture2D *>(segment->getTexture()->getRealTexture());
+        curTexture = static_cast<cc::Texture2D *>(_skeletonCache->getTexture(segment->textureIndex)->getRealTexture());
         gfx::Texture *texture = curTexture->getGFXTexture();
         gfx::Sampler *sampler = curTexture->getGFXSampler();
         curDrawInfo->setTexture(texture);
@@ -303,12 +313,12 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
         dstVertexBuffer = reinterpret_cast<float *>(vb.getCurBuffer());
         dstColorBuffer = reinterpret_cast<unsigned int *>(vb.getCurBuffer());
         if (!_useTint) {
-            char *srcBuffer = reinterpret_cast<char *>(srcVB.getBuffer()) + srcVertexBytesOffset;
+            const char *srcBuffer = srcVB + srcVertexBytesOffset;
             for (std::size_t srcBufferIdx = 0; srcBufferIdx < srcVertexBytes; srcBufferIdx += vbs2) {
                 vb.writeBytes(srcBuffer + srcBufferIdx, vbs);
             }
         } else {
-            vb.writeBytes(reinterpret_cast<char *>(srcVB.getBuffer()) + srcVertexBytesOffset, vertexBytes);
+            vb.writeBytes(srcVB + srcVertexBytesOffset, vertexBytes);
         }
         // batch handle
         if (_enableBatch) {
@@ -324,8 +334,8 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
             int srcVertexFloatOffset = static_cast<int16_t>(srcVertexBytesOffset / sizeof(float));
             if (_useTint) {
                 for (auto colorIndex = 0; colorIndex < vertexFloats; colorIndex += vs, srcVertexFloatOffset += vs2) {
-                    if (srcVertexFloatOffset >= maxVFOffset) {
-                        nowColor = colors[colorOffset++];
+                    if (srcVertexFloatOffset >= maxVFOffset && colorOffset < frameData->colorCount) {
+                        nowColor = &colors[colorOffset++];
                         handleColor(nowColor);
                         maxVFOffset = nowColor->vertexFloatOffset;
                     }
@@ -334,8 +344,8 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
                 }
             } else {
                 for (auto colorIndex = 0; colorIndex < vertexFloats; colorIndex += vs, srcVertexFloatOffset += vs2) {
-                    if (srcVertexFloatOffset >= maxVFOffset) {
-                        nowColor = colors[colorOffset++];
+                    if (srcVertexFloatOffset >= maxVFOffset && colorOffset < frameData->colorCount) {
+                        nowColor = &colors[colorOffset++];
                         handleColor(nowColor);
                         maxVFOffset = nowColor->vertexFloatOffset;
                     }
@@ -352,7 +362,7 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
         ib.checkSpace(indexBytes, true);
         dstIndexOffset = static_cast<int32_t>(ib.getCurPos() / sizeof(uint16_t));
         dstIndexBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-        ib.writeBytes(reinterpret_cast<char *>(srcIB.getBuffer()) + srcIndexBytesOffset, indexBytes);
+        ib.writeBytes(srcIB + srcIndexBytesOffset, indexBytes);
         for (auto indexPos = 0; indexPos < segment->indexCount; indexPos++) {
             dstIndexBuffer[indexPos] += dstVertexOffset;
         }
@@ -369,13 +379,13 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
     }
 
     if (_useAttach) {
-        const auto &bonesData = frameData->getBones();
-        auto boneCount = frameData->getBoneCount();
+        const SkeletonCache::BoneData *bonesData = _animationData->getBones(*frameData);
+        cc::Mat4 boneMat;
 
-        for (std::size_t i = 0, n = boneCount; i < n; i++) {
-            auto *bone = bonesData[i];
+        for (uint32_t i = 0, n = frameData->boneCount; i < n; i++) {
+            bonesData[i].toMat4(boneMat);
             attachInfo->checkSpace(sizeof(cc::Mat4), true);
-            attachInfo->writeBytes(reinterpret_cast<const char *>(&bone->globalTransformMatrix), sizeof(cc::Mat4));
+            attachInfo->writeBytes(reinterpret_cast<const char *>(&boneMat), sizeof(cc::Mat4));
         }
     }
 }
@@ -29,6 +29,7 @@
 
 #include "SkeletonCacheMgr.h"
 #include "base/DeferredReleasePool.h"
+#include "platform/FileUtils.h"
 
 namespace spine {
 SkeletonCacheMgr *SkeletonCacheMgr::instance = nullptr;
@@ -44,6 +45,13 @@ SkeletonCache *SkeletonCacheMgr::buildSkeletonCache(const std::string &uuid) {
     return animation;
 }
 
+void SkeletonCacheMgr::setCacheDirectory(const std::string &dir) {
+    if (!dir.empty() && !cc::FileUtils::getInstance()->isDirectoryExist(dir)) {
+        cc::FileUtils::getInstance()->createDirectory(dir);
+    }
+    SkeletonCache::setCacheDirectory(dir);
+}
+
 void SkeletonCacheMgr::removeSkeletonCache(const std::string &uuid) {
     auto it = _caches.find(uuid);
     if (it != _caches.end()) {
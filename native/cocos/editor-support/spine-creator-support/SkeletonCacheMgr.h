@@ -52,6 +52,10 @@ public:
     void removeSkeletonCache(const std::string &uuid);
     SkeletonCache *buildSkeletonCache(const std::string &uuid);
 
+    // baked animations are saved to and mapped from this directory, disabled if empty
+    void setCacheDirectory(const std::string &dir);
+    void setBackgroundBuildEnabled(bool enabled) { SkeletonCache::setBackgroundBuildEnabled(enabled); }
+
 private:
     static SkeletonCacheMgr *instance;
     cc::RefMap<std::string, SkeletonCache *> _caches;
@@ -64,6 +64,26 @@ enum DebugType {
     MESH,
     BONES
 };
+
+static void getBlendFactors(int blendMode, bool premultipliedAlpha, int &blendSrc, int &blendDst) {
+    switch (blendMode) {
+        case BlendMode_Additive:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE);
+            break;
+        case BlendMode_Multiply:
+            blendSrc = static_cast<int>(BlendFactor::DST_COLOR);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode_Screen:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
+            break;
+        default:
+            blendSrc = static_cast<int>(premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
+            blendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
+    }
+}
 SkeletonRenderer *SkeletonRenderer::create() {
     return new SkeletonRenderer();
 }
@@ -335,23 +355,7 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
         entity->addDynamicRenderDrawInfo(curDrawInfo);
         // prepare to fill new segment field
         curBlendMode = slot->getData().getBlendMode();
-        switch (curBlendMode) {
-            case BlendMode_Additive:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE);
-                break;
-            case BlendMode_Multiply:
-                curBlendSrc = static_cast<int>(BlendFactor::DST_COLOR);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-                break;
-            case BlendMode_Screen:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_COLOR);
-                break;
-            default:
-                curBlendSrc = static_cast<int>(_premultipliedAlpha ? BlendFactor::ONE : BlendFactor::SRC_ALPHA);
-                curBlendDst = static_cast<int>(BlendFactor::ONE_MINUS_SRC_ALPHA);
-        }
+        getBlendFactors(curBlendMode, _premultipliedAlpha, curBlendSrc, curBlendDst);
         auto *material = requestMaterial(curBlendSrc, curBlendDst);
         curDrawInfo->setMaterial(material);
         gfx::Texture *texture = curTexture->getGFXTexture();
@@ -792,6 +796,61 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
     }
 }
 
+bool SkeletonRenderer::prepareParallelRender(int &vertexFormat) {
+    // attach info is shared by all instances, the debug buffer is created lazily
+    // and a vertex effect delegate may be shared, so these instances are rendered on main thread
+    if (!_skeleton || !_entity || _useAttach || _debugBones || _debugSlots || _debugMesh || _effectDelegate) {
+        return false;
+    }
+    // resolving the node transform may walk parents shared with other instances
+    _entity->getNode()->updateWorldTransform();
+
+    // render requests a draw info for every texture or blend mode change and one more for a full mesh buffer,
+    // draw infos and materials are created here since they can only be created on main thread
+    cc::Texture2D *preTexture = nullptr;
+    int preBlendMode = -1;
+    int drawInfoCount = 1;
+    uint32_t blendModeMask = 0;
+    auto &drawOrder = _skeleton->getDrawOrder();
+    for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+        Slot *slot = drawOrder[i];
+        Attachment *attachment = slot->getAttachment();
+        if (!attachment) {
+            continue;
+        }
+        AttachmentVertices *attachmentVertices = nullptr;
+        if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+            attachmentVertices = reinterpret_cast<AttachmentVertices *>(static_cast<RegionAttachment *>(attachment)->getRendererObject());
+        } else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+            attachmentVertices = static_cast<AttachmentVertices *>(static_cast<MeshAttachment *>(attachment)->getRendererObject());
+        } else {
+            continue;
+        }
+        auto *texture = (cc::Texture2D *)attachmentVertices->_texture->getRealTexture();
+        const int blendMode = static_cast<int>(slot->getData().getBlendMode());
+        if (texture != preTexture || blendMode != preBlendMode) {
+            drawInfoCount++;
+            preTexture = texture;
+            preBlendMode = blendMode;
+        }
+        blendModeMask |= 1U << blendMode;
+    }
+    for (int i = 0; i < drawInfoCount; ++i) {
+        requestDrawInfo(i);
+    }
+    for (int blendMode = 0; blendModeMask; ++blendMode, blendModeMask >>= 1) {
+        if (blendModeMask & 1U) {
+            int blendSrc = 0;
+            int blendDst = 0;
+            getBlendFactors(blendMode, _premultipliedAlpha, blendSrc, blendDst);
+            requestMaterial(blendSrc, blendDst);
+        }
+    }
+
+    vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
+    return true;
+}
+
 cc::Rect SkeletonRenderer::getBoundingBox() const {
     static cc::middleware::IOBuffer buffer(1024);
     float *worldVertices = nullptr;
@@ -62,6 +62,7 @@ public:
 
     void update(float deltaTime) override {}
     void render(float deltaTime) override;
+    bool prepareParallelRender(int &vertexFormat) override;
     virtual cc::Rect getBoundingBox() const;
 
     Skeleton *getSkeleton() const;
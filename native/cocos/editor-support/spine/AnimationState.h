@@ -385,6 +385,8 @@ public:
 
     void disableQueue();
     void enableQueue();
+    /// Raises the events queued while the queue was disabled.
+    void drainQueue();
 
 private:
     AnimationStateData* _data;
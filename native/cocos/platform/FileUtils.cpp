@@ -25,6 +25,7 @@
 #include "platform/FileUtils.h"
 
 #include <cstring>
+#include <sstream>
 #include <stack>
 
 #include <cerrno>
@@ -525,6 +526,7 @@ bool FileUtils::writeDataToFile(const Data &data, const ccstd::string &fullPath)
         fwrite(data.getBytes(), size, 1, fp);
 
         fclose(fp);
+        _fullPathCache.invalidateNegative();
 
         return true;
     } while (false);
@@ -536,11 +538,12 @@ bool FileUtils::init() {
     addSearchPath("Resources", true);
     addSearchPath("data", true);
     _searchPathArray.push_back(_defaultResRootPath);
+    updateSearchPathState();
     return true;
 }
 
 void FileUtils::purgeCachedEntries() {
-    _fullPathCache.clear();
+    _fullPathCache.invalidate();
 }
 
 ccstd::string FileUtils::getStringFromFile(const ccstd::string &filename) {
@@ -661,25 +664,46 @@ ccstd::string FileUtils::fullPathForFilename(const ccstd::string &filename) cons
         return normalizePath(filename);
     }
 
-    // Already Cached ?
-    auto cacheIter = _fullPathCache.find(filename);
-    if (cacheIter != _fullPathCache.end()) {
-        return cacheIter->second;
-    }
+    // Read the generations before the search paths, so that a result computed with stale ones is not cached.
+    const uint32_t generation = _fullPathCache.getGeneration();
+    const uint32_t negativeGeneration = _fullPathCache.getNegativeGeneration();
 
+    // Already Cached ?
     ccstd::string fullpath;
+    switch (_fullPathCache.find(filename, &fullpath)) {
+        case FullPathCache::Lookup::FOUND:
+            return fullpath;
+        case FullPathCache::Lookup::NOT_FOUND:
+            return "";
+        default:
+            break;
+    }
 
-    for (const auto &searchIt : _searchPathArray) {
-        fullpath = this->getPathForFilename(filename, searchIt);
+    auto state = getSearchPathState();
+    if (state) {
+        for (size_t i = 0; i < state->searchPaths.size(); ++i) {
+            const auto &searchPath = state->searchPaths[i];
+            const auto &manifest = state->manifests[i];
+            if (manifest) {
+                // The manifest lists every file under the search path, no need to ask the file system.
+                if (manifest->count(filename) == 0) {
+                    continue;
+                }
+                fullpath = normalizePath(searchPath + filename);
+            } else {
+                fullpath = this->getPathForFilename(filename, searchPath);
+            }
 
-        if (!fullpath.empty()) {
-            // Using the filename passed in as key.
-            _fullPathCache.emplace(filename, fullpath);
-            return fullpath;
+            if (!fullpath.empty()) {
+                // Using the filename passed in as key.
+                _fullPathCache.insert(filename, fullpath, generation, negativeGeneration);
+                return fullpath;
+            }
         }
     }
 
-    // The file wasn't found, return empty string.
+    // The file wasn't found, remember it and return empty string.
+    _fullPathCache.insert(filename, "", generation, negativeGeneration);
     return "";
 }
 
@@ -705,7 +729,6 @@ const ccstd::string &FileUtils::getDefaultResourceRootPath() const {
 
 void FileUtils::setDefaultResourceRootPath(const ccstd::string &path) {
     if (_defaultResRootPath != path) {
-        _fullPathCache.clear();
         _defaultResRootPath = path;
         if (!_defaultResRootPath.empty() && _defaultResRootPath[_defaultResRootPath.length() - 1] != '/') {
             _defaultResRootPath += '/';
@@ -720,49 +743,98 @@ void FileUtils::setSearchPaths(const ccstd::vector<ccstd::string> &searchPaths)
     bool existDefaultRootPath = false;
     _originalSearchPaths = searchPaths;
 
-    _fullPathCache.clear();
     _searchPathArray.clear();
 
     for (const auto &path : _originalSearchPaths) {
-        ccstd::string prefix;
-        ccstd::string fullPath;
-
-        if (!isAbsolutePath(path)) { // Not an absolute path
-            prefix = _defaultResRootPath;
-        }
-        fullPath = prefix + path;
-        if (!path.empty() && path[path.length() - 1] != '/') {
-            fullPath += "/";
-        }
         if (!existDefaultRootPath && path == _defaultResRootPath) {
             existDefaultRootPath = true;
         }
-        _searchPathArray.push_back(fullPath);
+        _searchPathArray.push_back(getFullSearchPath(path));
     }
 
     if (!existDefaultRootPath) {
         // CC_LOG_DEBUG("Default root path doesn't exist, adding it.");
         _searchPathArray.push_back(_defaultResRootPath);
     }
+    updateSearchPathState();
 }
 
 void FileUtils::addSearchPath(const ccstd::string &searchpath, bool front) {
+    ccstd::string path = getFullSearchPath(searchpath);
+    if (front) {
+        _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
+        _searchPathArray.insert(_searchPathArray.begin(), path);
+    } else {
+        _originalSearchPaths.push_back(searchpath);
+        _searchPathArray.push_back(path);
+    }
+    updateSearchPathState();
+}
+
+ccstd::string FileUtils::getFullSearchPath(const ccstd::string &path) const {
     ccstd::string prefix;
-    if (!isAbsolutePath(searchpath)) {
+    if (!isAbsolutePath(path)) { // Not an absolute path
         prefix = _defaultResRootPath;
     }
 
-    ccstd::string path = prefix + searchpath;
+    ccstd::string fullPath = prefix + path;
     if (!path.empty() && path[path.length() - 1] != '/') {
-        path += "/";
+        fullPath += "/";
     }
-    if (front) {
-        _originalSearchPaths.insert(_originalSearchPaths.begin(), searchpath);
-        _searchPathArray.insert(_searchPathArray.begin(), path);
+    return fullPath;
+}
+
+std::shared_ptr<const FileUtils::SearchPathState> FileUtils::getSearchPathState() const {
+    return std::atomic_load(&_searchPathState);
+}
+
+void FileUtils::updateSearchPathState() {
+    auto state = std::make_shared<SearchPathState>();
+    state->searchPaths = _searchPathArray;
+    state->manifests.reserve(_searchPathArray.size());
+    for (const auto &searchPath : _searchPathArray) {
+        auto iter = _searchPathManifests.find(searchPath);
+        state->manifests.emplace_back(iter != _searchPathManifests.end() ? iter->second : nullptr);
+    }
+    std::atomic_store(&_searchPathState, std::shared_ptr<const SearchPathState>(std::move(state)));
+    // After publishing the new state, see FullPathCache::getGeneration().
+    _fullPathCache.invalidate();
+}
+
+void FileUtils::setSearchPathManifest(const ccstd::string &searchPath, const ccstd::vector<ccstd::string> &files) {
+    ccstd::string fullPath = getFullSearchPath(searchPath);
+    if (files.empty()) {
+        _searchPathManifests.erase(fullPath);
     } else {
-        _originalSearchPaths.push_back(searchpath);
-        _searchPathArray.push_back(path);
+        _searchPathManifests[fullPath] = std::make_shared<const SearchPathManifest>(files.begin(), files.end());
     }
+    updateSearchPathState();
+}
+
+bool FileUtils::loadSearchPathManifest(const ccstd::string &searchPath, const ccstd::string &manifestFile) {
+    ccstd::string content = getStringFromFile(manifestFile);
+    if (content.empty()) {
+        return false;
+    }
+
+    ccstd::vector<ccstd::string> files;
+    std::istringstream stream(content);
+    ccstd::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            files.emplace_back(std::move(line));
+        }
+    }
+    setSearchPathManifest(searchPath, files);
+    return true;
+}
+
+void FileUtils::setNegativeLookupCacheEnabled(bool enabled) {
+    _fullPathCache.setNegativeLookupEnabled(enabled);
+    _fullPathCache.invalidateNegative();
 }
 
 ccstd::string FileUtils::getFullPathForDirectoryAndFilename(const ccstd::string &directory, const ccstd::string &filename) const {
@@ -800,18 +872,24 @@ bool FileUtils::isDirectoryExist(const ccstd::string &dirPath) const {
         return isDirectoryExistInternal(normalizePath(dirPath));
     }
 
+    const uint32_t generation = _fullPathCache.getGeneration();
+    const uint32_t negativeGeneration = _fullPathCache.getNegativeGeneration();
+
     // Already Cached ?
-    auto cacheIter = _fullPathCache.find(dirPath);
-    if (cacheIter != _fullPathCache.end()) {
-        return isDirectoryExistInternal(cacheIter->second);
+    ccstd::string fullpath;
+    if (_fullPathCache.find(dirPath, &fullpath) == FullPathCache::Lookup::FOUND) {
+        return isDirectoryExistInternal(fullpath);
     }
 
-    ccstd::string fullpath;
-    for (const auto &searchIt : _searchPathArray) {
+    auto state = getSearchPathState();
+    if (!state) {
+        return false;
+    }
+    for (const auto &searchIt : state->searchPaths) {
         // searchPath + file_path
         fullpath = fullPathForFilename(searchIt + dirPath);
         if (isDirectoryExistInternal(fullpath)) {
-            _fullPathCache.emplace(dirPath, fullpath);
+            _fullPathCache.insert(dirPath, fullpath, generation, negativeGeneration);
             return true;
         }
     }
@@ -1085,6 +1163,7 @@ bool FileUtils::renameFile(const ccstd::string &oldfullpath, const ccstd::string
         CC_LOG_ERROR("Fail to rename file %s to %s !Error code is %d", oldfullpath.c_str(), newfullpath.c_str(), errorCode);
         return false;
     }
+    _fullPathCache.invalidateNegative();
     return true;
 }
 
@@ -24,13 +24,16 @@
 
 #pragma once
 
+#include <memory>
 #include <type_traits>
 #include "base/Data.h"
 #include "base/Macros.h"
 #include "base/Value.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/container/vector.h"
+#include "platform/FullPathCache.h"
 
 namespace cc {
 
@@ -139,6 +142,7 @@ public:
 
     /**
      *  Purges full path caches.
+     *  @note If failed lookups are cached, call it after files were added to a search path without using FileUtils.
      */
     virtual void purgeCachedEntries();
 
@@ -349,6 +353,33 @@ public:
      */
     virtual const ccstd::vector<ccstd::string> &getOriginalSearchPaths() const;
 
+    /**
+     *  Sets a prebuilt manifest of the files under a search path.
+     *  A search path with a manifest is checked with a hash lookup instead of asking the file system when resolving a file name,
+     *  so the manifest must list every file under it. File names are matched as they are passed to 'fullPathForFilename'.
+     *
+     *  @param searchPath The search path, as passed to 'setSearchPaths' or 'addSearchPath'.
+     *  @param files The file paths relative to the search path, such as "textures/hero.png". An empty array removes the manifest.
+     */
+    void setSearchPathManifest(const ccstd::string &searchPath, const ccstd::vector<ccstd::string> &files);
+
+    /**
+     *  Loads the manifest of a search path from a text file listing one relative file path per line.
+     *
+     *  @param searchPath The search path, as passed to 'setSearchPaths' or 'addSearchPath'.
+     *  @param manifestFile The manifest file, it could be a relative or absolute path.
+     *  @return True if the manifest file could be read.
+     *  @see setSearchPathManifest
+     */
+    bool loadSearchPathManifest(const ccstd::string &searchPath, const ccstd::string &manifestFile);
+
+    /**
+     *  Sets whether the file names that could not be found are cached. Disabled by default.
+     *  Only writes and renames done through FileUtils invalidate the failed lookups, so enable it only when
+     *  downloaders and hot updates do not add files to the search paths, or call 'purgeCachedEntries' after they do.
+     */
+    void setNegativeLookupCacheEnabled(bool enabled);
+
     /**
      *  Gets the writable path.
      *  @return  The path that can be write/read a file in
@@ -535,8 +566,8 @@ public:
      */
     virtual long getFileSize(const ccstd::string &filepath); //NOLINT(google-runtime-int)
 
-    /** Returns the full path cache. */
-    const ccstd::unordered_map<ccstd::string, ccstd::string> &getFullPathCache() const { return _fullPathCache; }
+    /** Returns a copy of the full path cache. */
+    ccstd::unordered_map<ccstd::string, ccstd::string> getFullPathCache() const { return _fullPathCache.snapshot(); }
 
     virtual ccstd::string normalizePath(const ccstd::string &path) const;
     virtual ccstd::string getFileDir(const ccstd::string &path) const;
@@ -598,6 +629,34 @@ protected:
      */
     ccstd::vector<ccstd::string> _originalSearchPaths;
 
+    using SearchPathManifest = ccstd::unordered_set<ccstd::string>;
+
+    /**
+     * Immutable copy of the search paths and their manifests read by 'fullPathForFilename',
+     * replaced as a whole whenever they change so that worker threads never see a partial update.
+     */
+    struct SearchPathState {
+        ccstd::vector<ccstd::string> searchPaths;
+        ccstd::vector<std::shared_ptr<const SearchPathManifest>> manifests;
+    };
+
+    std::shared_ptr<const SearchPathState> getSearchPathState() const;
+
+    /**
+     * Publishes _searchPathArray and the manifests to the resolving threads and invalidates the full path cache.
+     * Must be called after _searchPathArray is modified.
+     */
+    void updateSearchPathState();
+
+    ccstd::string getFullSearchPath(const ccstd::string &path) const;
+
+    /**
+     * The manifests set by 'setSearchPathManifest', indexed by full search path.
+     */
+    ccstd::unordered_map<ccstd::string, std::shared_ptr<const SearchPathManifest>> _searchPathManifests;
+
+    std::shared_ptr<const SearchPathState> _searchPathState;
+
     /**
      *  The default root path of resources.
      *  If the default root path of resources needs to be changed, do it in the `init` method of FileUtils's subclass.
@@ -608,10 +667,10 @@ protected:
     ccstd::string _defaultResRootPath;
 
     /**
-     *  The full path cache. When a file is found, it will be added into this cache.
-     *  This variable is used for improving the performance of file search.
+     *  The full path cache. When a file is looked up, the result will be added into this cache.
+     *  This variable is used for improving the performance of file search, it is safe to use from any thread.
      */
-    mutable ccstd::unordered_map<ccstd::string, ccstd::string> _fullPathCache;
+    mutable FullPathCache _fullPathCache;
 
     /**
      * Writable path.
@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "platform/FullPathCache.h"
+
+#include <functional>
+
+namespace cc {
+
+FullPathCache::Shard &FullPathCache::getShard(const ccstd::string &key) const {
+    // the maps inside a shard use the low bits of the same hash, pick the shard from higher ones
+    const size_t hash = std::hash<ccstd::string>{}(key);
+    return _shards[(hash >> 16U) % SHARD_COUNT];
+}
+
+FullPathCache::Lookup FullPathCache::find(const ccstd::string &key, ccstd::string *fullPath) const {
+    const uint32_t generation = getGeneration();
+    const uint32_t negativeGeneration = getNegativeGeneration();
+    Shard &shard = getShard(key);
+    return shard.lock.lockRead([&]() {
+        if (shard.generation != generation) {
+            return Lookup::MISS;
+        }
+        auto iter = shard.entries.find(key);
+        if (iter == shard.entries.end()) {
+            return Lookup::MISS;
+        }
+        const Entry &entry = iter->second;
+        if (entry.fullPath.empty()) {
+            return entry.negativeGeneration == negativeGeneration ? Lookup::NOT_FOUND : Lookup::MISS;
+        }
+        *fullPath = entry.fullPath;
+        return Lookup::FOUND;
+    });
+}
+
+void FullPathCache::insert(const ccstd::string &key, const ccstd::string &fullPath, uint32_t generation, uint32_t negativeGeneration) {
+    if (fullPath.empty() && !isNegativeLookupEnabled()) {
+        return;
+    }
+    Shard &shard = getShard(key);
+    shard.lock.lockWrite([&]() {
+        // resolved against search paths or files that changed in the meantime
+        if (generation != getGeneration()) {
+            return;
+        }
+        if (fullPath.empty() && negativeGeneration != getNegativeGeneration()) {
+            return;
+        }
+        if (shard.generation != generation) {
+            shard.entries.clear();
+            shard.generation = generation;
+        }
+        shard.entries[key] = Entry{fullPath, negativeGeneration};
+    });
+}
+
+void FullPathCache::invalidate() {
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void FullPathCache::invalidateNegative() {
+    _negativeGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+ccstd::unordered_map<ccstd::string, ccstd::string> FullPathCache::snapshot() const {
+    ccstd::unordered_map<ccstd::string, ccstd::string> result;
+    const uint32_t generation = getGeneration();
+    for (Shard &shard : _shards) {
+        shard.lock.lockRead([&]() {
+            if (shard.generation != generation) {
+                return;
+            }
+            for (const auto &pair : shard.entries) {
+                if (!pair.second.fullPath.empty()) {
+                    result.emplace(pair.first, pair.second.fullPath);
+                }
+            }
+        });
+    }
+    return result;
+}
+
+} // namespace cc
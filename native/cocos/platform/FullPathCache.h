@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/threading/ReadWriteLock.h"
+
+namespace cc {
+
+/**
+ * Concurrent cache of resolved full paths used by FileUtils.
+ * Entries are spread over shards guarded by read write locks so lookups from loader and audio threads
+ * only contend when they hit the same shard while it is being written.
+ * Invalidation bumps a generation counter instead of clearing, stale shards are dropped on their next write.
+ * Negative entries (files that could not be found) are opt-in, as files written outside of FileUtils can not invalidate them.
+ * They are stored as empty paths and have their own generation, so creating a file only invalidates the misses.
+ */
+class CC_DLL FullPathCache final {
+public:
+    enum class Lookup {
+        MISS,
+        FOUND,
+        NOT_FOUND,
+    };
+
+    static constexpr uint32_t SHARD_COUNT = 16;
+
+    FullPathCache() = default;
+    ~FullPathCache() = default;
+
+    /**
+     * Generations must be read before resolving a path and passed back to insert(),
+     * so a result computed with stale search paths is never cached.
+     */
+    inline uint32_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
+    inline uint32_t getNegativeGeneration() const { return _negativeGeneration.load(std::memory_order_acquire); }
+
+    Lookup find(const ccstd::string &key, ccstd::string *fullPath) const;
+    /** Caches a resolved path, an empty fullPath records a failed lookup. */
+    void insert(const ccstd::string &key, const ccstd::string &fullPath, uint32_t generation, uint32_t negativeGeneration);
+
+    /** Drops every entry, called when the search paths change. */
+    void invalidate();
+    /** Drops the failed lookups only, called when files may have been created. */
+    void invalidateNegative();
+
+    inline void setNegativeLookupEnabled(bool enabled) { _negativeLookupEnabled.store(enabled, std::memory_order_relaxed); }
+    inline bool isNegativeLookupEnabled() const { return _negativeLookupEnabled.load(std::memory_order_relaxed); }
+
+    /** Copies the valid positive entries. */
+    ccstd::unordered_map<ccstd::string, ccstd::string> snapshot() const;
+
+private:
+    struct Entry {
+        ccstd::string fullPath;
+        uint32_t negativeGeneration{0};
+    };
+
+    struct Shard {
+        ReadWriteLock lock;
+        ccstd::unordered_map<ccstd::string, Entry> entries;
+        uint32_t generation{0};
+    };
+
+    Shard &getShard(const ccstd::string &key) const;
+
+    mutable std::array<Shard, SHARD_COUNT> _shards;
+    std::atomic<uint32_t> _generation{0};
+    std::atomic<uint32_t> _negativeGeneration{0};
+    std::atomic<bool> _negativeLookupEnabled{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(FullPathCache);
+};
+
+} // namespace cc
@@ -243,6 +243,7 @@ bool FileUtilsOpenHarmony::renameFile(const std::string &oldfullpath, const std:
         }
         return false;
     }
+    _fullPathCache.invalidateNegative();
     return true;
 }
 
@@ -250,6 +250,7 @@ bool FileUtilsWin32::renameFile(const ccstd::string &oldfullpath, const ccstd::s
     }
 
     if (MoveFile(_wOld.c_str(), _wNew.c_str())) {
+        _fullPathCache.invalidateNegative();
         return true;
     } else {
         CC_LOG_ERROR("Fail to rename file %s to %s !Error code is 0x%x", oldfullpath.c_str(), newfullpath.c_str(), GetLastError());
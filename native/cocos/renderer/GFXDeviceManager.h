@@ -117,6 +117,21 @@ public:
         return nullptr;
     }
 
+    // headless device which only counts API calls and simulates resource memory,
+    // for measuring the CPU side cost of rendering without a GPU.
+    static Device *createEmpty() {
+        DeviceInfo deviceInfo{pipeline::bindingMappingInfo};
+        return DeviceManager::createEmpty(deviceInfo);
+    }
+
+    static Device *createEmpty(const DeviceInfo &info) {
+        if (Device::instance) return Device::instance;
+
+        Device *device = nullptr;
+        tryCreate<EmptyDevice>(info, &device);
+        return device;
+    }
+
     static bool isDetachDeviceThread() {
         return DETACH_DEVICE_THREAD && Device::isSupportDetachDeviceThread;
     }
@@ -60,9 +60,26 @@ void TextureBufferPool::destroy() {
         CC_SAFE_DESTROY_AND_DELETE(chunk.texture);
     }
     _chunks.clear();
+    _chunkCount = 0;
     _handles.clear();
 }
 
+uint32_t TextureBufferPool::getCapacity() const {
+    uint32_t capacity = 0;
+    for (const auto &chunk : _chunks) {
+        capacity += chunk.size;
+    }
+    return capacity;
+}
+
+uint32_t TextureBufferPool::getUsedSize() const {
+    uint32_t used = 0;
+    for (const auto &handle : _handles) {
+        used += static_cast<uint32_t>(handle.end - handle.start);
+    }
+    return used;
+}
+
 ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     if (_useMcDonaldAlloc) {
         return mcDonaldAlloc(size);
@@ -80,7 +97,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -94,7 +111,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -120,7 +137,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -134,7 +151,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -168,7 +185,7 @@ uint32_t TextureBufferPool::createChunk(uint32_t length) {
     chunk.size = texSize;
     chunk.start = 0;
     chunk.end = static_cast<index_t>(texSize);
-    _chunks[_chunkCount] = chunk;
+    _chunks.emplace_back(chunk);
     return _chunkCount++;
 }
 
@@ -246,7 +263,7 @@ index_t TextureBufferPool::findAvailableSpace(uint32_t size, index_t chunkIdx) c
                 handles.emplace_back(h);
             }
         }
-        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start - b.start; });
+        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start < b.start; });
         for (auto handle : handles) {
             if ((start + size) <= handle.start) {
                 isFound = true;
@@ -301,7 +318,7 @@ ITextureBufferHandle TextureBufferPool::mcDonaldAlloc(uint32_t size) {
     // create a new one
     auto targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto newChunk = _chunks[createChunk(texLength)];
+    auto &newChunk = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -72,6 +72,12 @@ public:
     uint32_t createChunk(uint32_t length);
     void update(const ITextureBufferHandle &handle, ArrayBuffer *buffer);
 
+    inline uint32_t getChunkCount() const { return _chunkCount; }
+    // total bytes of all chunk textures
+    uint32_t getCapacity() const;
+    // total bytes of all allocated handles
+    uint32_t getUsedSize() const;
+
 private:
     index_t findAvailableSpace(uint32_t size, index_t chunkIdx) const;
 
@@ -40,6 +40,8 @@ public:
     ~BufferAgent() override;
 
     void update(const void *buffer, uint32_t size) override;
+    void updateRange(const void *buffer, uint32_t offset, uint32_t size) override;
+    bool isRangeUpdateSupported() const override { return _actor->isRangeUpdateSupported(); }
 
     static void getActorBuffer(const BufferAgent *buffer, MessageQueue *mq, uint32_t size, uint8_t **pActorBuffer, bool *pNeedFreeing);
 
@@ -90,6 +90,12 @@ void Buffer::write(const uint8_t *value, uint32_t offset, uint32_t size) const {
     memcpy(dst + offset, value, size);
 }
 
+void Buffer::updateRange(const void *buffer, uint32_t offset, uint32_t size) {
+    // without in place range updates only full updates from the start are allowed
+    CC_ASSERT(!offset);
+    update(buffer, offset + size);
+}
+
 void Buffer::update() {
     flush(getStagingAddress());
 }
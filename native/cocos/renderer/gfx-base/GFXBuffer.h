@@ -55,6 +55,13 @@ public:
 
     void update();
 
+    // Whether updateRange() writes into the buffer in place. Backends keeping per-frame instances
+    // of host visible buffers need every update to cover all the contents in use instead.
+    virtual bool isRangeUpdateSupported() const { return false; }
+
+    // Uploads `size` bytes from `buffer` to [offset, offset + size) of this buffer.
+    virtual void updateRange(const void *buffer, uint32_t offset, uint32_t size);
+
     inline BufferUsage getUsage() const { return _usage; }
     inline MemoryUsage getMemUsage() const { return _memUsage; }
     inline uint32_t getStride() const { return _stride; }
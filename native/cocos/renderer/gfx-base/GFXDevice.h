@@ -112,6 +112,8 @@ public:
     inline const ccstd::string &getRenderer() const { return _renderer; }
     inline const ccstd::string &getVendor() const { return _vendor; }
     inline bool hasFeature(Feature feature) const { return _features[toNumber(feature)]; }
+    // whether command buffers could be recorded on multiple threads and secondary command buffers are supported
+    inline bool isMultithreadedCommandRecording() const { return _multithreadedCommandRecording; }
     inline FormatFeature getFormatFeatures(Format format) const { return _formatFeatures[toNumber(format)]; }
 
     inline const BindingMappingInfo &bindingMappingInfo() const { return _bindingMappingInfo; }
@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#include "GFXParallelCommandRecorder.h"
+#include <algorithm>
+#include "GFXCommandBuffer.h"
+#include "GFXDevice.h"
+#include "base/job-system/JobSystem.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+namespace gfx {
+
+ParallelCommandRecorder::ParallelCommandRecorder(Device *device)
+: _device(device) {
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder() {
+    for (auto *cmdBuff : _secondaryCmdBuffs) {
+        CC_SAFE_DESTROY_AND_DELETE(cmdBuff);
+    }
+    _secondaryCmdBuffs.clear();
+}
+
+bool ParallelCommandRecorder::isParallelRecordingSupported() const {
+    // metal creates the encoders of secondary command buffers when the primary one begins the render pass,
+    // which is replayed after the secondary ones on the device thread.
+    return _device->isMultithreadedCommandRecording() && _device->getGfxAPI() != API::METAL;
+}
+
+uint32_t ParallelCommandRecorder::computeSliceCount(uint32_t drawCount) const {
+    if (!isParallelRecordingSupported()) {
+        return 0;
+    }
+    // the calling thread records a slice too
+    const uint32_t maxSliceCount = JobSystem::getInstance()->threadCount() + 1;
+    const uint32_t sliceCount = std::min(maxSliceCount, drawCount / _minDrawsPerSlice);
+    return sliceCount > 1 ? sliceCount : 0;
+}
+
+void ParallelCommandRecorder::prepareSecondaryCommandBuffers(CommandBuffer *primaryCmdBuff, uint32_t count) {
+    while (_secondaryCmdBuffs.size() < count) {
+        _secondaryCmdBuffs.push_back(_device->createCommandBuffer({primaryCmdBuff->getQueue(), CommandBufferType::SECONDARY}));
+    }
+}
+
+void ParallelCommandRecorder::recordRenderPass(CommandBuffer *cmdBuff, RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea,
+                                               const Color *colors, float depth, uint32_t stencil, uint32_t drawCount, const RecordFunc &record) {
+    CC_PROFILE(ParallelCommandRecorderRecordRenderPass);
+    uint32_t sliceCount = computeSliceCount(drawCount);
+    if (!sliceCount) {
+        _sliceCount = 0;
+        cmdBuff->beginRenderPass(renderPass, fbo, renderArea, colors, depth, stencil);
+        if (drawCount) {
+            record(cmdBuff, 0, drawCount);
+        }
+        cmdBuff->endRenderPass();
+        return;
+    }
+
+    const uint32_t drawsPerSlice = (drawCount - 1) / sliceCount + 1; // ceil(drawCount / sliceCount)
+    sliceCount = (drawCount - 1) / drawsPerSlice + 1;                // no empty slice at the end
+    _sliceCount = sliceCount;
+    prepareSecondaryCommandBuffers(cmdBuff, sliceCount);
+    CommandBuffer *const *secondaryCmdBuffs = _secondaryCmdBuffs.data();
+
+    // begin the render pass before the slices are recorded, some backends set up secondary command buffers here
+    cmdBuff->beginRenderPass(renderPass, fbo, renderArea, colors, depth, stencil, secondaryCmdBuffs, sliceCount);
+
+    auto recordSlice = [&](uint32_t i) {
+        CommandBuffer *secondaryCmdBuff = secondaryCmdBuffs[i];
+        const uint32_t begin = i * drawsPerSlice;
+        const uint32_t end = std::min(begin + drawsPerSlice, drawCount);
+        secondaryCmdBuff->begin(renderPass, 0, fbo);
+        record(secondaryCmdBuff, begin, end);
+        secondaryCmdBuff->end();
+    };
+
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(1U, sliceCount, 1U, recordSlice);
+    g.run();
+    recordSlice(0);
+    g.waitForAll();
+
+    // with a device thread, the secondary command buffers have to be replayed before the primary one executes them
+    _device->flushCommands(secondaryCmdBuffs, sliceCount);
+
+    cmdBuff->execute(secondaryCmdBuffs, sliceCount);
+    cmdBuff->endRenderPass();
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <functional>
+#include "GFXDef.h"
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+// Records the draws of a render pass on job system workers.
+// The draw list is split into continuous slices, each slice is recorded into its own secondary command buffer,
+// which are then executed by the primary command buffer in slice order.
+// Devices without secondary command buffer support record all draws inline on the calling thread.
+class CC_DLL ParallelCommandRecorder final {
+public:
+    // records draws in [begin, end) of the draw list, slices are recorded concurrently.
+    // no state is inherited by secondary command buffers, so pipeline states and descriptor sets should be bound in every slice.
+    using RecordFunc = std::function<void(CommandBuffer *cmdBuff, uint32_t begin, uint32_t end)>;
+
+    static constexpr uint32_t DEFAULT_MIN_DRAWS_PER_SLICE = 64;
+
+    explicit ParallelCommandRecorder(Device *device);
+    ~ParallelCommandRecorder();
+    ParallelCommandRecorder(ParallelCommandRecorder const &) = delete;
+    ParallelCommandRecorder(ParallelCommandRecorder &&) = delete;
+    ParallelCommandRecorder &operator=(ParallelCommandRecorder const &) = delete;
+    ParallelCommandRecorder &operator=(ParallelCommandRecorder &&) = delete;
+
+    // cmdBuff should be a primary command buffer which has begun and is outside of any render pass.
+    // the render pass is begun, recorded and ended in it, only render passes with a single subpass are supported.
+    void recordRenderPass(CommandBuffer *cmdBuff, RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea,
+                          const Color *colors, float depth, uint32_t stencil, uint32_t drawCount, const RecordFunc &record);
+
+    inline void setMinDrawsPerSlice(uint32_t count) { _minDrawsPerSlice = count ? count : 1; }
+    inline uint32_t getMinDrawsPerSlice() const { return _minDrawsPerSlice; }
+
+    // whether the device is able to execute secondary command buffers recorded on other threads
+    bool isParallelRecordingSupported() const;
+    // number of secondary command buffers used by the last render pass, 0 if it was recorded inline
+    inline uint32_t getSliceCount() const { return _sliceCount; }
+    inline const ccstd::vector<CommandBuffer *> &getSecondaryCommandBuffers() const { return _secondaryCmdBuffs; }
+
+private:
+    uint32_t computeSliceCount(uint32_t drawCount) const;
+    void prepareSecondaryCommandBuffers(CommandBuffer *primaryCmdBuff, uint32_t count);
+
+    Device *_device{nullptr};
+    ccstd::vector<CommandBuffer *> _secondaryCmdBuffs;
+    uint32_t _minDrawsPerSlice{DEFAULT_MIN_DRAWS_PER_SLICE};
+    uint32_t _sliceCount{0};
+};
+
+} // namespace gfx
+} // namespace cc
@@ -23,23 +23,47 @@
 ****************************************************************************/
 
 #include "EmptyBuffer.h"
+#include "EmptyDevice.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyBuffer::doInit(const BufferInfo &info) {
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().bufferSize += _size;
+    ++device->_resourceStats.bufferCount;
+    ++device->_resourceStats.bufferAllocations;
+    _memoryAllocated = true;
 }
 
 void EmptyBuffer::doInit(const BufferViewInfo &info) {
 }
 
 void EmptyBuffer::doResize(uint32_t size, uint32_t count) {
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().bufferSize -= _size;
+    device->getMemoryStatus().bufferSize += size;
+    ++device->_resourceStats.bufferAllocations;
 }
 
 void EmptyBuffer::doDestroy() {
+    if (!_memoryAllocated) {
+        return;
+    }
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().bufferSize -= _size;
+    --device->_resourceStats.bufferCount;
+    _memoryAllocated = false;
 }
 
 void EmptyBuffer::update(const void *buffer, uint32_t size) {
+    auto &stats = EmptyDevice::getInstance()->_resourceStats;
+    ++stats.bufferUpdates;
+    stats.bufferUpdateSize += size;
+}
+
+void EmptyBuffer::updateRange(const void *buffer, uint32_t /*offset*/, uint32_t size) {
+    update(buffer, size);
 }
 
 } // namespace gfx
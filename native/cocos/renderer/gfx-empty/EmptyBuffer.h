@@ -32,12 +32,16 @@ namespace gfx {
 class CC_DLL EmptyBuffer final : public Buffer {
 public:
     void update(const void *buffer, uint32_t size) override;
+    void updateRange(const void *buffer, uint32_t offset, uint32_t size) override;
+    bool isRangeUpdateSupported() const override { return true; }
 
 protected:
     void doInit(const BufferInfo &info) override;
     void doInit(const BufferViewInfo &info) override;
     void doResize(uint32_t size, uint32_t count) override;
     void doDestroy() override;
+
+    bool _memoryAllocated{false};
 };
 
 } // namespace gfx
@@ -34,95 +34,151 @@ void EmptyCommandBuffer::doDestroy() {
 }
 
 void EmptyCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
+    _stats = {};
+    _numDrawCalls = 0;
+    _numInstances = 0;
+    _numTriangles = 0;
 }
 
 void EmptyCommandBuffer::end() {
 }
 
 void EmptyCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
+    ++_stats.commands;
+    ++_stats.renderPasses;
 }
 
 void EmptyCommandBuffer::endRenderPass() {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::insertMarker(const MarkerInfo &marker) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::beginMarker(const MarkerInfo &marker) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::endMarker() {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    ++_stats.commands;
+    for (uint32_t i = 0; i < count; ++i) {
+        _stats += static_cast<EmptyCommandBuffer *>(cmdBuffs[i])->_stats;
+        _numDrawCalls += cmdBuffs[i]->getNumDrawCalls();
+        _numInstances += cmdBuffs[i]->getNumInstances();
+        _numTriangles += cmdBuffs[i]->getNumTris();
+    }
 }
 
 void EmptyCommandBuffer::bindPipelineState(PipelineState *pso) {
+    ++_stats.commands;
+    ++_stats.pipelineStateBinds;
 }
 
 void EmptyCommandBuffer::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    ++_stats.commands;
+    ++_stats.descriptorSetBinds;
 }
 
 void EmptyCommandBuffer::bindInputAssembler(InputAssembler *ia) {
+    ++_stats.commands;
+    ++_stats.inputAssemblerBinds;
 }
 
 void EmptyCommandBuffer::setViewport(const Viewport &vp) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setScissor(const Rect &rect) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setLineWidth(float width) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setDepthBias(float constant, float clamp, float slope) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setBlendConstants(const Color &constants) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setDepthBound(float minBounds, float maxBounds) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::nextSubpass() {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::draw(const DrawInfo &info) {
+    ++_stats.commands;
+    ++_stats.drawCalls;
+    _stats.instances += info.instanceCount;
+    ++_numDrawCalls;
+    _numInstances += info.instanceCount;
 }
 
 void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    ++_stats.commands;
+    ++_stats.bufferUpdates;
+    _stats.bufferUpdateSize += size;
 }
 
 void EmptyCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    ++_stats.commands;
+    ++_stats.textureTransfers;
 }
 
 void EmptyCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    ++_stats.commands;
+    ++_stats.textureTransfers;
 }
 
 void EmptyCommandBuffer::copyTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    ++_stats.commands;
+    ++_stats.textureTransfers;
 }
 
 void EmptyCommandBuffer::resolveTexture(Texture *srcTexture, Texture *dstTexture, const TextureCopy *regions, uint32_t count) {
+    ++_stats.commands;
+    ++_stats.textureTransfers;
 }
 
 void EmptyCommandBuffer::dispatch(const DispatchInfo &info) {
+    ++_stats.commands;
+    ++_stats.dispatches;
 }
 
-void EmptyCommandBuffer::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {}
+void EmptyCommandBuffer::pipelineBarrier(const GeneralBarrier *barrier, const BufferBarrier *const *bufferBarriers, const Buffer *const *buffers, uint32_t bufferCount, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    ++_stats.commands;
+    ++_stats.barriers;
+}
 
 void EmptyCommandBuffer::beginQuery(QueryPool *queryPool, uint32_t id) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::endQuery(QueryPool *queryPool, uint32_t id) {
+    ++_stats.commands;
 }
 
 void EmptyCommandBuffer::resetQueryPool(QueryPool *queryPool) {
+    ++_stats.commands;
 }
 
 } // namespace gfx
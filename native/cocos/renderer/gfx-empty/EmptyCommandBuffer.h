@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "EmptyStats.h"
 #include "gfx-base/GFXCommandBuffer.h"
 
 namespace cc {
@@ -63,9 +64,14 @@ public:
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
 
+    // commands recorded since last begin(), including the executed secondary command buffers
+    inline const EmptyCommandStats &getStats() const { return _stats; }
+
 protected:
     void doInit(const CommandBufferInfo &info) override;
     void doDestroy() override;
+
+    EmptyCommandStats _stats;
 };
 
 } // namespace gfx
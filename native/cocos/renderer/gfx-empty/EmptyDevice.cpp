@@ -89,7 +89,12 @@ void EmptyDevice::acquire(Swapchain *const * /*swapchains*/, uint32_t /*count*/)
 }
 
 void EmptyDevice::present() {
-    std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    _lastFrameCommandStats = _frameCommandStats;
+    _frameCommandStats = {};
+
+    if (_presentInterval) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(_presentInterval));
+    }
 }
 
 CommandBuffer *EmptyDevice::createCommandBuffer(const CommandBufferInfo & /*info*/, bool /*hasAgent*/) {
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "EmptyStats.h"
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -77,15 +78,31 @@ public:
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
 
+    // commands submitted in the last presented frame
+    inline const EmptyCommandStats &getFrameCommandStats() const { return _lastFrameCommandStats; }
+    inline const EmptyResourceStats &getResourceStats() const { return _resourceStats; }
+
+    // present() sleeps for the interval to simulate vsync, set it to 0 for benchmarks
+    inline void setPresentInterval(uint32_t milliseconds) { _presentInterval = milliseconds; }
+    inline uint32_t getPresentInterval() const { return _presentInterval; }
+
 protected:
     static EmptyDevice *instance;
 
     friend class DeviceManager;
+    friend class EmptyBuffer;
+    friend class EmptyTexture;
+    friend class EmptyQueue;
 
     EmptyDevice();
 
     bool doInit(const DeviceInfo &info) override;
     void doDestroy() override;
+
+    EmptyCommandStats _frameCommandStats;
+    EmptyCommandStats _lastFrameCommandStats;
+    EmptyResourceStats _resourceStats;
+    uint32_t _presentInterval{16};
 };
 
 } // namespace gfx
@@ -23,6 +23,8 @@
 ****************************************************************************/
 
 #include "EmptyQueue.h"
+#include "EmptyCommandBuffer.h"
+#include "EmptyDevice.h"
 
 namespace cc {
 namespace gfx {
@@ -34,6 +36,10 @@ void EmptyQueue::doDestroy() {
 }
 
 void EmptyQueue::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    auto &frameStats = EmptyDevice::getInstance()->_frameCommandStats;
+    for (uint32_t i = 0; i < count; ++i) {
+        frameStats += static_cast<EmptyCommandBuffer *>(cmdBuffs[i])->getStats();
+    }
 }
 
 } // namespace gfx
@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2020-2023 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+
+namespace cc {
+namespace gfx {
+
+// The empty device does no GPU work, it counts API calls and simulates resource memory instead,
+// so that the CPU side cost of rendering could be measured without a GPU.
+
+struct EmptyCommandStats {
+    uint32_t commands{0};
+    uint32_t renderPasses{0};
+    uint32_t pipelineStateBinds{0};
+    uint32_t descriptorSetBinds{0};
+    uint32_t inputAssemblerBinds{0};
+    uint32_t drawCalls{0};
+    uint32_t instances{0};
+    uint32_t dispatches{0};
+    uint32_t bufferUpdates{0};
+    uint64_t bufferUpdateSize{0};
+    uint32_t textureTransfers{0};
+    uint32_t barriers{0};
+
+    inline EmptyCommandStats &operator+=(const EmptyCommandStats &rhs) {
+        commands += rhs.commands;
+        renderPasses += rhs.renderPasses;
+        pipelineStateBinds += rhs.pipelineStateBinds;
+        descriptorSetBinds += rhs.descriptorSetBinds;
+        inputAssemblerBinds += rhs.inputAssemblerBinds;
+        drawCalls += rhs.drawCalls;
+        instances += rhs.instances;
+        dispatches += rhs.dispatches;
+        bufferUpdates += rhs.bufferUpdates;
+        bufferUpdateSize += rhs.bufferUpdateSize;
+        textureTransfers += rhs.textureTransfers;
+        barriers += rhs.barriers;
+        return *this;
+    }
+};
+
+struct EmptyResourceStats {
+    // alive resources
+    uint32_t bufferCount{0};
+    uint32_t textureCount{0};
+    // resource memory allocated since the device was created
+    uint32_t bufferAllocations{0};
+    uint32_t textureAllocations{0};
+    // updates made outside of command buffers, e.g. Buffer::update
+    uint32_t bufferUpdates{0};
+    uint64_t bufferUpdateSize{0};
+};
+
+} // namespace gfx
+} // namespace cc
@@ -23,12 +23,18 @@
 ****************************************************************************/
 
 #include "EmptyTexture.h"
+#include "EmptyDevice.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
 namespace gfx {
 
 void EmptyTexture::doInit(const TextureInfo &info) {
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().textureSize += _size;
+    ++device->_resourceStats.textureCount;
+    ++device->_resourceStats.textureAllocations;
+    _memoryAllocated = true;
 }
 
 void EmptyTexture::doInit(const TextureViewInfo &info) {
@@ -38,9 +44,23 @@ void EmptyTexture::doInit(const SwapchainTextureInfo &info) {
 }
 
 void EmptyTexture::doDestroy() {
+    if (!_memoryAllocated) {
+        return;
+    }
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().textureSize -= _size;
+    --device->_resourceStats.textureCount;
+    _memoryAllocated = false;
 }
 
 void EmptyTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
+    if (!_memoryAllocated) {
+        return;
+    }
+    auto *device = EmptyDevice::getInstance();
+    device->getMemoryStatus().textureSize -= _size;
+    device->getMemoryStatus().textureSize += size;
+    ++device->_resourceStats.textureAllocations;
 }
 
 } // namespace gfx
@@ -37,6 +37,8 @@ protected:
     void doInit(const SwapchainTextureInfo &info) override;
     void doDestroy() override;
     void doResize(uint32_t width, uint32_t height, uint32_t size) override;
+
+    bool _memoryAllocated{false};
 };
 
 } // namespace gfx
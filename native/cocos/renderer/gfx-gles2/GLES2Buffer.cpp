@@ -92,5 +92,10 @@ void GLES2Buffer::update(const void *buffer, uint32_t size) {
     cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), _gpuBuffer, buffer, 0U, size);
 }
 
+void GLES2Buffer::updateRange(const void *buffer, uint32_t offset, uint32_t size) {
+    CC_PROFILE(GLES2BufferUpdateRange);
+    cmdFuncGLES2UpdateBuffer(GLES2Device::getInstance(), _gpuBuffer, buffer, offset, size);
+}
+
 } // namespace gfx
 } // namespace cc
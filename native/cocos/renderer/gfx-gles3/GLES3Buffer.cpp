@@ -101,5 +101,10 @@ void GLES3Buffer::update(const void *buffer, uint32_t size) {
     cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), _gpuBuffer, buffer, 0U, size);
 }
 
+void GLES3Buffer::updateRange(const void *buffer, uint32_t offset, uint32_t size) {
+    CC_PROFILE(GLES3BufferUpdateRange);
+    cmdFuncGLES3UpdateBuffer(GLES3Device::getInstance(), _gpuBuffer, buffer, offset, size, false);
+}
+
 } // namespace gfx
 } // namespace cc
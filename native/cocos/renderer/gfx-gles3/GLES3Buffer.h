@@ -38,6 +38,8 @@ public:
     ~GLES3Buffer() override;
 
     void update(const void *buffer, uint32_t size) override;
+    void updateRange(const void *buffer, uint32_t offset, uint32_t size) override;
+    bool isRangeUpdateSupported() const override { return true; }
 
     inline GLES3GPUBuffer *gpuBuffer() const { return _gpuBuffer; }
 
@@ -2592,12 +2592,14 @@ void cmdFuncGLES3PopGroupMarker(GLES3Device *device) {
     }
 }
 
-static void uploadBufferData(GLenum target, GLintptr offset, GLsizeiptr length, const void *buffer) {
+static void uploadBufferData(GLenum target, GLintptr offset, GLsizeiptr length, const void *buffer, bool invalidateBuffer) {
 #if 0
     GL_CHECK(glBufferSubData(target, offset, length, buffer));
 #else
+    // orphan the whole buffer only if the rest of its contents is not needed any more
+    const GLbitfield invalidateBit = invalidateBuffer ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT;
     void *dst{nullptr};
-    GL_CHECK(dst = glMapBufferRange(target, offset, length, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    GL_CHECK(dst = glMapBufferRange(target, offset, length, GL_MAP_WRITE_BIT | invalidateBit));
     if (!dst) {
         GL_CHECK(glBufferSubData(target, offset, length, buffer));
         return;
@@ -2607,7 +2609,7 @@ static void uploadBufferData(GLenum target, GLintptr offset, GLsizeiptr length,
 #endif
 }
 
-void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint32_t offset, uint32_t size) {
+void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint32_t offset, uint32_t size, bool invalidateBuffer) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
         memcpy(reinterpret_cast<uint8_t *>(gpuBuffer->indirects.data()) + offset, buffer, size);
@@ -2625,7 +2627,7 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glArrayBuffer = gpuBuffer->glBuffer;
                 }
-                uploadBufferData(GL_ARRAY_BUFFER, offset, size, buffer);
+                uploadBufferData(GL_ARRAY_BUFFER, offset, size, buffer, invalidateBuffer);
                 break;
             }
             case GL_ELEMENT_ARRAY_BUFFER: {
@@ -2638,7 +2640,7 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glElementArrayBuffer = gpuBuffer->glBuffer;
                 }
-                uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, offset, size, buffer);
+                uploadBufferData(GL_ELEMENT_ARRAY_BUFFER, offset, size, buffer, invalidateBuffer);
                 break;
             }
             case GL_UNIFORM_BUFFER: {
@@ -2646,7 +2648,7 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glUniformBuffer = gpuBuffer->glBuffer;
                 }
-                uploadBufferData(GL_UNIFORM_BUFFER, offset, size, buffer);
+                uploadBufferData(GL_UNIFORM_BUFFER, offset, size, buffer, invalidateBuffer);
                 break;
             }
             case GL_SHADER_STORAGE_BUFFER: {
@@ -2654,7 +2656,7 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glShaderStorageBuffer = gpuBuffer->glBuffer;
                 }
-                uploadBufferData(GL_SHADER_STORAGE_BUFFER, offset, size, buffer);
+                uploadBufferData(GL_SHADER_STORAGE_BUFFER, offset, size, buffer, invalidateBuffer);
                 break;
             }
             default:
@@ -287,7 +287,8 @@ void cmdFuncGLES3UpdateBuffer(GLES3Device *device,
                               GLES3GPUBuffer *gpuBuffer,
                               const void *buffer,
                               uint32_t offset,
-                              uint32_t size);
+                              uint32_t size,
+                              bool invalidateBuffer = true);
 
 void cmdFuncGLES3CopyBuffersToTexture(GLES3Device *device,
                                       const uint8_t *const *buffers,
@@ -165,6 +165,25 @@ void BufferValidator::update(const void *buffer, uint32_t size) {
     _actor->update(buffer, size);
 }
 
+void BufferValidator::updateRange(const void *buffer, uint32_t offset, uint32_t size) {
+    CC_ASSERT(isInited());
+
+    // Cannot update through buffer views.
+    CC_ASSERT(!_isBufferView);
+    // Indirect buffers are always updated from the first draw info.
+    CC_ASSERT(!hasFlag(_usage, BufferUsageBit::INDIRECT));
+    CC_ASSERT(size && offset + size <= _size);
+    CC_ASSERT(buffer);
+    // Partial updates need the backend to write in place.
+    CC_ASSERT(!offset || isRangeUpdateSupported());
+
+    ++_totalUpdateTimes;
+
+    /////////// execute ///////////
+
+    _actor->updateRange(buffer, offset, size);
+}
+
 void BufferValidator::sanityCheck(const void *buffer, uint32_t size) {
     uint64_t cur = DeviceValidator::getInstance()->currentFrame();
 
@@ -36,6 +36,8 @@ public:
     ~BufferValidator() override;
 
     void update(const void *buffer, uint32_t size) override;
+    void updateRange(const void *buffer, uint32_t offset, uint32_t size) override;
+    bool isRangeUpdateSupported() const override { return _actor->isRangeUpdateSupported(); }
 
     void sanityCheck(const void *buffer, uint32_t size);
 
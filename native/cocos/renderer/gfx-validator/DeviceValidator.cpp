@@ -84,6 +84,7 @@ bool DeviceValidator::doInit(const DeviceInfo &info) {
     _renderer = _actor->getRenderer();
     _vendor = _actor->getVendor();
     _caps = _actor->_caps;
+    _multithreadedCommandRecording = _actor->_multithreadedCommandRecording;
     memcpy(_features.data(), _actor->_features.data(), static_cast<uint32_t>(Feature::COUNT) * sizeof(bool));
     memcpy(_formatFeatures.data(), _actor->_formatFeatures.data(), static_cast<uint32_t>(Format::COUNT) * sizeof(FormatFeatureBit));
 
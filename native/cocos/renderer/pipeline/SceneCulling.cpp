@@ -29,8 +29,10 @@
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
 #include "base/std/container/map.h"
+#include "base/threading/FrameArena.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
+#include "core/geometry/FrustumCulling.h"
 #include "core/geometry/Intersect.h"
 #include "core/geometry/Sphere.h"
 #include "core/platform/Debug.h"
@@ -134,6 +136,27 @@ void shadowCulling(const RenderPipeline *pipeline, const scene::Camera *camera,
 
     if (csmLayers->getLayerObjects().empty()) return;
 
+    // the layer has been tested against every layer object by the fused pass in sceneCulling
+    const uint32_t viewBit = csmLayers->getLayerViewBit(layer);
+    auto &visibleMasks = csmLayers->getLayerObjectVisibleMasks();
+    if (viewBit != 0 && visibleMasks.size() == csmLayers->getLayerObjects().size()) {
+        const auto &layerObjects = csmLayers->getLayerObjects();
+        const auto &insideMasks = csmLayers->getLayerObjectInsideMasks();
+        const bool removeDuplicates = layer->getLevel() < static_cast<uint32_t>(mainLight->getCSMLevel()) &&
+                                      mainLight->getCSMOptimizationMode() == scene::CSMOptimizationMode::REMOVE_DUPLICATES;
+        for (size_t i = 0; i < layerObjects.size(); ++i) {
+            if (!(visibleMasks[i] & viewBit)) {
+                continue;
+            }
+            layer->addShadowObject(RenderObject{layerObjects[i]});
+            if (removeDuplicates && (insideMasks[i] & viewBit)) {
+                // completely covered by this layer, invisible to the following layers
+                visibleMasks[i] = 0;
+            }
+        }
+        return;
+    }
+
     for (auto it = csmLayers->getLayerObjects().begin(); it != csmLayers->getLayerObjects().end();) {
         const auto *model = it->model;
         if (!model || !model->isEnabled() || !model->getNode()) {
@@ -199,74 +222,84 @@ void sceneCulling(const RenderPipeline *pipeline, scene::Camera *camera) {
         }
     }
 
+    // Test each shadow caster against every shadow layer in a single sweep,
+    // shadowCulling consumes the per-layer bits later instead of testing the layer objects again.
+    geometry::FrustumSoA viewFrustums;
+    const bool shadowMapEnabled = shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP &&
+                                  mainLight && mainLight->getNode();
+    csmLayers->gatherViewFrustums(&viewFrustums, shadowMapEnabled ? mainLight : nullptr);
+    const uint32_t layerViewMask = csmLayers->getLayerViewMask();
+
     const scene::Octree *octree = scene->getOctree();
-    if (octree && octree->isEnabled()) {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (scene->isCulledByLod(camera, model)) {
-                    continue;
-                }
-
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
-
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
-
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
-
-                    if (!modelWorldBounds && (skyBox == nullptr || skyBox->getModel() != model)) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
-                }
+    const bool useOctree = octree && octree->isEnabled();
+    const auto &models = scene->getModels();
+
+    // without octree the camera frustum tests the world bounds of all models in one batched pass,
+    // RenderScene::update keeps them index-aligned with the models
+    ccstd::pmr::vector<uint8_t> cameraVisible(FrameArena::getInstance()->getThreadResource());
+    if (!useOctree) {
+        const auto &worldBounds = scene->getModelWorldBounds();
+        CC_ASSERT(worldBounds.size() == models.size());
+        cameraVisible.resize(worldBounds.size());
+        camera->getFrustum().cullAABBs(worldBounds, cameraVisible.data());
+    }
+
+    const auto visibility = camera->getVisibility();
+    for (size_t i = 0; i < models.size(); ++i) {
+        const auto &model = models[i];
+        // filter model by view visibility
+        if (!model->isEnabled() || scene->isCulledByLod(camera, model)) {
+            continue;
+        }
+
+        const auto *const node = model->getNode();
+        const bool visibleByLayer = (node && ((visibility & node->getLayer()) == node->getLayer())) ||
+                                    (visibility & static_cast<uint32_t>(model->getVisFlags()));
+        const auto *modelWorldBounds = model->getWorldBounds();
+
+        // shadow layers need the per-layer bits of each caster, tested in one sweep over all view frustums
+        uint32_t visibleMask = 0;
+        uint32_t insideMask = 0;
+        if (modelWorldBounds && layerViewMask && model->isCastShadow()) {
+            viewFrustums.aabbFrustums(*modelWorldBounds, &visibleMask, &insideMask);
+        }
+
+        const RenderObject renderObject = genRenderObject(model, camera);
+
+        // cast shadow render Object
+        if (model->isCastShadow()) {
+            csmLayers->addCastShadowObject(RenderObject{renderObject});
+            const bool shadowVisible = node && visibleByLayer && modelWorldBounds;
+            csmLayers->addLayerObject(renderObject, shadowVisible ? visibleMask & layerViewMask : 0U, insideMask & layerViewMask);
+        }
+
+        if (!visibleByLayer) {
+            continue;
+        }
+        if (!modelWorldBounds) {
+            if (!useOctree || skyBox == nullptr || skyBox->getModel() != model) {
+                sceneData->addRenderObject(RenderObject{renderObject});
             }
+            continue;
+        }
+
+        // frustum culling, done by octree query below if enabled
+        if (!useOctree && cameraVisible[i]) {
+            sceneData->addRenderObject(RenderObject{renderObject});
         }
+    }
 
-        ccstd::vector<const scene::Model *> models;
-        models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
-        for (const auto &model : models) {
+    if (useOctree) {
+        // culling results only live in this frame, collect them in the thread's frame arena
+        ccstd::pmr::vector<const scene::Model *> visibleModels(FrameArena::getInstance()->getThreadResource());
+        visibleModels.reserve(models.size() / 4);
+        octree->queryVisibility(camera, camera->getFrustum(), false, visibleModels);
+        for (const auto &model : visibleModels) {
             if (scene->isCulledByLod(camera, model)) {
                 continue;
             }
             sceneData->addRenderObject(genRenderObject(model, camera));
         }
-    } else {
-        for (const auto &model : scene->getModels()) {
-            // filter model by view visibility
-            if (model->isEnabled()) {
-                if (scene->isCulledByLod(camera, model)) {
-                    continue;
-                }
-                const auto visibility = camera->getVisibility();
-                const auto *const node = model->getNode();
-
-                // cast shadow render Object
-                if (model->isCastShadow()) {
-                    csmLayers->addCastShadowObject(genRenderObject(model, camera));
-                    csmLayers->addLayerObject(genRenderObject(model, camera));
-                }
-
-                if ((model->getNode() && ((visibility & node->getLayer()) == node->getLayer())) ||
-                    (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
-                    const auto *modelWorldBounds = model->getWorldBounds();
-                    if (!modelWorldBounds) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                        continue;
-                    }
-
-                    // frustum culling
-                    if (modelWorldBounds->aabbFrustum(camera->getFrustum())) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
-                    }
-                }
-            }
-        }
     }
 
     csmLayers = nullptr;
@@ -22,6 +22,7 @@
 
 #include "CSMLayers.h"
 #include "core/Root.h"
+#include "core/geometry/FrustumCulling.h"
 #include "gfx-base/GFXDevice.h"
 #include "pipeline/PipelineSceneData.h"
 #include "pipeline/RenderPipeline.h"
@@ -276,6 +277,39 @@ void CSMLayers::calculateCSM(const scene::Camera *camera, const scene::Direction
     }
 }
 
+void CSMLayers::gatherViewFrustums(geometry::FrustumSoA *frustums, const scene::DirectionalLight *dirLight) {
+    _layerViewBits.fill(0U);
+    _specialLayerViewBit = 0U;
+    _layerViewMask = 0U;
+
+    if (!dirLight || !dirLight->isShadowEnabled()) {
+        return;
+    }
+
+    if (dirLight->isShadowFixedArea()) {
+        _specialLayerViewBit = 1U << frustums->addFrustum(_specialLayer->getValidFrustum());
+        _layerViewMask = _specialLayerViewBit;
+        return;
+    }
+
+    for (uint32_t i = 0; i < _levelCount; ++i) {
+        _layerViewBits[i] = 1U << frustums->addFrustum(_layers[i]->getValidFrustum());
+        _layerViewMask |= _layerViewBits[i];
+    }
+}
+
+uint32_t CSMLayers::getLayerViewBit(const ShadowTransformInfo *layer) const {
+    if (layer == _specialLayer) {
+        return _specialLayerViewBit;
+    }
+    for (uint32_t i = 0; i < _layers.size(); ++i) {
+        if (_layers[i] == layer) {
+            return _layerViewBits[i];
+        }
+    }
+    return 0U;
+}
+
 Mat4 CSMLayers::getCameraWorldMatrix(const scene::Camera *camera) {
     const Node *cameraNode = camera->getNode();
     const Vec3 &position = cameraNode->getWorldPosition();
@@ -31,6 +31,9 @@
 #include "scene/Shadow.h"
 
 namespace cc {
+namespace geometry {
+class FrustumSoA;
+} // namespace geometry
 namespace pipeline {
 class PipelineSceneData;
 
@@ -134,7 +137,29 @@ public:
     inline RenderObjectList &getLayerObjects() { return _layerObjects; }
     inline void setLayerObjects(RenderObjectList &&ro) { _layerObjects = std::forward<RenderObjectList>(ro); }
     inline void addLayerObject(RenderObject &&obj) { _layerObjects.emplace_back(obj); }
-    inline void clearLayerObjects() { _layerObjects.clear(); }
+    inline void clearLayerObjects() {
+        _layerObjects.clear();
+        _layerObjectVisibleMasks.clear();
+        _layerObjectInsideMasks.clear();
+    }
+
+    // Layer objects with per-view masks computed by the fused culling pass in sceneCulling.
+    inline void addLayerObject(const RenderObject &obj, uint32_t visibleMask, uint32_t insideMask) {
+        _layerObjects.emplace_back(obj);
+        _layerObjectVisibleMasks.emplace_back(visibleMask);
+        _layerObjectInsideMasks.emplace_back(insideMask);
+    }
+    inline ccstd::vector<uint32_t> &getLayerObjectVisibleMasks() { return _layerObjectVisibleMasks; }
+    inline const ccstd::vector<uint32_t> &getLayerObjectInsideMasks() const { return _layerObjectInsideMasks; }
+
+    /**
+     * @en Append the valid frustums of all active layers to the view frustums tested by sceneCulling.
+     * @zh 将所有生效层级的有效视锥体添加到 sceneCulling 一次性测试的视锥体集合中。
+     */
+    void gatherViewFrustums(geometry::FrustumSoA *frustums, const scene::DirectionalLight *dirLight);
+    // Bit of the layer in the layer object masks, 0 if the layer is not tested by the fused culling pass.
+    uint32_t getLayerViewBit(const ShadowTransformInfo *layer) const;
+    inline uint32_t getLayerViewMask() const { return _layerViewMask; }
 
     inline const ccstd::array<CSMLayerInfo *, 4> &getLayers() const { return _layers; }
 
@@ -159,6 +184,12 @@ private:
 
     RenderObjectList _castShadowObjects;
     RenderObjectList _layerObjects;
+    ccstd::vector<uint32_t> _layerObjectVisibleMasks;
+    ccstd::vector<uint32_t> _layerObjectInsideMasks;
+
+    ccstd::array<uint32_t, 4> _layerViewBits{};
+    uint32_t _specialLayerViewBit{0U};
+    uint32_t _layerViewMask{0U};
 };
 } // namespace pipeline
 } // namespace cc
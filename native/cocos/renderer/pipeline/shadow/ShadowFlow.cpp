@@ -170,7 +170,7 @@ void ShadowFlow::renderStage(gfx::DescriptorSet *globalDS, scene::Camera *camera
 void ShadowFlow::lightCollecting() {
     _validLights.clear();
 
-    const ccstd::vector<const scene::Light *> validPunctualLights = _pipeline->getPipelineSceneData()->getValidPunctualLights();
+    const auto &validPunctualLights = _pipeline->getPipelineSceneData()->getValidPunctualLights();
     for (const scene::Light *light : validPunctualLights) {
         if (light->getType() == scene::LightType::SPOT) {
             const auto *spotLight = static_cast<const scene::SpotLight *>(light);
@@ -69,6 +69,12 @@ const ccstd::string CC_DISABLE_DIRECTIONAL_LIGHT = "CC_DISABLE_DIRECTIONAL_LIGHT
 const ccstd::vector<cc::scene::IMacroPatch> STATIC_LIGHTMAP_PATHES{{"CC_USE_LIGHTMAP", 1}};
 const ccstd::vector<cc::scene::IMacroPatch> STATIONARY_LIGHTMAP_PATHES{{"CC_USE_LIGHTMAP", 2}};
 const ccstd::vector<cc::scene::IMacroPatch> HIGHP_LIGHTMAP_PATHES{{"CC_LIGHT_MAP_VERSION", 2}};
+
+enum ReflectionProbeDataBit : uint8_t {
+    REFLECTION_PROBE_DATA = 0x01,
+    REFLECTION_PROBE_BLEND_DATA = 0x02,
+    REFLECTION_PROBE_SKYBOX_BLEND_DATA = 0x04,
+};
 } // namespace
 
 namespace cc {
@@ -120,14 +126,25 @@ void Model::updateTransform(uint32_t stamp) {
         }
     }
 
+    if (syncWorldTransform()) {
+        transformWorldBounds();
+    }
+}
+
+bool Model::syncWorldTransform() {
     Node *node = _transform;
     if (node->getChangedFlags() || node->isTransformDirty()) {
         node->updateWorldTransform();
         _localDataUpdated = true;
-        if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
-            _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
-            _worldBoundsDirty = true;
-        }
+        return true;
+    }
+    return false;
+}
+
+void Model::transformWorldBounds() {
+    if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
+        _modelBounds->transform(_transform->getWorldMatrix(), _worldBounds);
+        _worldBoundsDirty = true;
     }
 }
 
@@ -170,6 +187,12 @@ void Model::updateUBOs(uint32_t stamp) {
         }
     }
 
+    if (prepareLocalUBOs(stamp) && writeLocalUBOs()) {
+        flushLocalUBOs();
+    }
+}
+
+bool Model::prepareLocalUBOs(uint32_t stamp) {
     for (SubModel *subModel : _subModels) {
         subModel->update();
     }
@@ -177,15 +200,55 @@ void Model::updateUBOs(uint32_t stamp) {
 
     updateSHUBOs();
 
-    const auto *pipeline = Root::getInstance()->getPipeline();
-    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
-    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
-
     if (!_localDataUpdated) {
-        return;
+        return false;
     }
     _localDataUpdated = false;
     getTransform()->updateWorldTransform();
+    updateReflectionProbeData();
+    return true;
+}
+
+void Model::updateReflectionProbeData() {
+    _reflectionProbeDataMask = 0;
+    auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
+    if (!probe) {
+        return;
+    }
+    _reflectionProbeDataMask |= REFLECTION_PROBE_DATA;
+    if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
+        const Vec3 up = probe->getNode()->getUp();
+        _reflectionProbeData[0] = {up.x, up.y, up.z, 1.F};
+        _reflectionProbeData[1] = {1.F, 0.F, 0.F, 1.F};
+    } else {
+        uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
+        const Vec3 &worldPos = probe->getNode()->getWorldPosition();
+        _reflectionProbeData[0] = {worldPos.x, worldPos.y, worldPos.z, 0.F};
+        _reflectionProbeData[1] = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+    }
+    if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
+        _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
+        if (blendProbe) {
+            uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
+            const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
+            Vec3 boudingBox = blendProbe->getBoudingSize();
+            _reflectionProbeData[2] = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
+            _reflectionProbeData[3] = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
+            _reflectionProbeDataMask |= REFLECTION_PROBE_BLEND_DATA;
+        } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
+            // blend with skybox
+            _reflectionProbeData[2] = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
+            _reflectionProbeDataMask |= REFLECTION_PROBE_SKYBOX_BLEND_DATA;
+        }
+    }
+}
+
+bool Model::writeLocalUBOs() {
+    const auto *pipeline = Root::getInstance()->getPipeline();
+    const auto *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
+    const auto forceUpdateUBO = shadowInfo->isEnabled() && shadowInfo->getType() == ShadowType::PLANAR;
+
     const auto &worldMatrix = getTransform()->getWorldMatrix();
     bool hasNonInstancingPass = false;
     for (const auto &subModel : _subModels) {
@@ -207,44 +270,27 @@ void Model::updateUBOs(uint32_t stamp) {
         _localBuffer->write(_lightmapUVParam, sizeof(float) * pipeline::UBOLocal::LIGHTINGMAP_UVPARAM);
         _localBuffer->write(_shadowBias, sizeof(float) * (pipeline::UBOLocal::LOCAL_SHADOW_BIAS));
 
-        auto *probe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeId);
-        auto *blendProbe = scene::ReflectionProbeManager::getInstance()->getReflectionProbeById(_reflectionProbeBlendId);
-        if (probe) {
-            if (probe->getProbeType() == scene::ReflectionProbe::ProbeType::PLANAR) {
-                const Vec4 plane = {probe->getNode()->getUp().x, probe->getNode()->getUp().y, probe->getNode()->getUp().z, 1.F};
-                _localBuffer->write(plane, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 depthScale = {1.F, 0.F, 0.F, 1.F};
-                _localBuffer->write(depthScale, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            } else {
-                uint16_t mipAndUseRGBE = probe->isRGBE() ? 1000 : 0;
-                const Vec4 pos = {probe->getNode()->getWorldPosition().x, probe->getNode()->getWorldPosition().y, probe->getNode()->getWorldPosition().z, 0.F};
-                _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
-                const Vec4 boxSize = {probe->getBoudingSize().x, probe->getBoudingSize().y, probe->getBoudingSize().z, static_cast<float>(probe->getCubeMap() ? probe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
-            }
-            if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES ||
-                _reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                if (blendProbe) {
-                    uint16_t mipAndUseRGBE = blendProbe->isRGBE() ? 1000 : 0;
-                    const Vec3 worldPos = blendProbe->getNode()->getWorldPosition();
-                    Vec3 boudingBox = blendProbe->getBoudingSize();
-                    const Vec4 pos = {worldPos.x, worldPos.y, worldPos.z, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                    const Vec4 boxSize = {boudingBox.x, boudingBox.y, boudingBox.z, static_cast<float>(blendProbe->getCubeMap() ? blendProbe->getCubeMap()->mipmapLevel() + mipAndUseRGBE : 1 + mipAndUseRGBE)};
-                    _localBuffer->write(boxSize, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
-                } else if (_reflectionProbeType == scene::UseReflectionProbeType::BLEND_PROBES_AND_SKYBOX) {
-                    // blend with skybox
-                    const Vec4 pos = {0.F, 0.F, 0.F, _reflectionProbeBlendWeight};
-                    _localBuffer->write(pos, sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
-                }
-            }
+        if (_reflectionProbeDataMask & REFLECTION_PROBE_DATA) {
+            _localBuffer->write(_reflectionProbeData[0], sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA1));
+            _localBuffer->write(_reflectionProbeData[1], sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_DATA2));
         }
-
-        _localBuffer->update();
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
+        if (_reflectionProbeDataMask & (REFLECTION_PROBE_BLEND_DATA | REFLECTION_PROBE_SKYBOX_BLEND_DATA)) {
+            _localBuffer->write(_reflectionProbeData[2], sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA1));
         }
+        if (_reflectionProbeDataMask & REFLECTION_PROBE_BLEND_DATA) {
+            _localBuffer->write(_reflectionProbeData[3], sizeof(float) * (pipeline::UBOLocal::REFLECTION_PROBE_BLEND_DATA2));
+        }
+
+        return true;
+    }
+    return false;
+}
+
+void Model::flushLocalUBOs() {
+    _localBuffer->update();
+    const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+    if (enableOcclusionQuery) {
+        updateWorldBoundUBOs();
     }
 }
 
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <tuple>
 #include "base/Ptr.h"
@@ -144,6 +145,14 @@ public:
     void updateSHUBOs();
     void updateOctree();
     void updateWorldBoundUBOs();
+
+    // Split steps of updateTransform & updateUBOs used by RenderScene's parallel update, called in this order.
+    // transformWorldBounds and writeLocalUBOs are safe on job workers, the others must run on main thread.
+    bool syncWorldTransform();
+    void transformWorldBounds();
+    bool prepareLocalUBOs(uint32_t stamp);
+    bool writeLocalUBOs();
+    void flushLocalUBOs();
     void updateLocalShadowBias();
     void updateReflectionProbeCubemap(TextureCube *texture);
     void updateReflectionProbePlanarMap(gfx::Texture *texture);
@@ -257,6 +266,7 @@ protected:
     void updateAttributesAndBinding(index_t subModelIndex);
     bool isLightProbeAvailable() const;
     void updateSHBuffer();
+    void updateReflectionProbeData();
 
     // Please declare variables in descending order of memory size occupied by variables.
     Type _type{Type::DEFAULT};
@@ -284,6 +294,7 @@ protected:
     IntrusivePtr<geometry::AABB> _modelBounds;
     IntrusivePtr<Texture2D> _lightmap;
 
+    uint8_t _reflectionProbeDataMask{0};
     bool _enabled{false};
     bool _castShadow{false};
     bool _receiveShadow{false};
@@ -301,6 +312,8 @@ protected:
 
     Vec4 _shadowBias{0.F, 0.F, -1.F, -1.F};
     Vec4 _lightmapUVParam;
+    // REFLECTION_PROBE_DATA1/2 and REFLECTION_PROBE_BLEND_DATA1/2, resolved on main thread since probe nodes are read
+    std::array<Vec4, 4> _reflectionProbeData;
 
     // For JS
     // CallbacksInvoker _eventProcessor;
@@ -23,8 +23,9 @@
 ****************************************************************************/
 
 #include "Octree.h"
-#include <future>
 #include <utility>
+#include "base/job-system/JobSystem.h"
+#include "profiler/Profiler.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
 
@@ -221,7 +222,8 @@ void OctreeNode::gatherModels(ccstd::vector<Model *> &results) const { // NOLINT
     }
 }
 
-void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+template <typename ResultList>
+void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const {
     const auto visibility = camera->getVisibility();
     for (auto *model : _models) {
         if (!model->isEnabled()) {
@@ -249,35 +251,31 @@ void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum
     }
 }
 
-void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
+template <typename ResultList>
+void OctreeNode::gatherCullingTasks(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, uint32_t taskDepth, ResultList &results, ccstd::vector<const OctreeNode *> &tasks) const { // NOLINT(misc-no-recursion)
+    // subtrees at task depth are culled by job workers, they test their own bounds.
+    if (_depth >= taskDepth) {
+        tasks.push_back(this);
+        return;
+    }
+
     geometry::AABB box;
     geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
     if (!box.aabbFrustum(frustum)) {
         return;
     }
 
-    ccstd::array<std::future<ccstd::vector<const Model *>>, OCTREE_CHILDREN_NUM> futures{};
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            futures[i] = std::async(std::launch::async, [=, &frustum] {
-                ccstd::vector<const Model *> models;
-                _children[i]->queryVisibilitySequentially(camera, frustum, isShadow, models);
-                return models;
-            });
-        }
-    }
-
     doQueryVisibility(camera, frustum, isShadow, results);
 
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        if (_children[i]) {
-            auto models = futures[i].get();
-            results.insert(results.end(), models.begin(), models.end());
+    for (auto *child : _children) {
+        if (child) {
+            child->gatherCullingTasks(camera, frustum, isShadow, taskDepth, results, tasks);
         }
     }
 }
 
-void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const { // NOLINT(misc-no-recursion)
+template <typename ResultList>
+void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const { // NOLINT(misc-no-recursion)
     geometry::AABB box;
     geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
     if (!box.aabbFrustum(frustum)) {
@@ -394,13 +392,71 @@ void Octree::update(Model *model) {
 }
 
 void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const {
-    if (_totalCount > USE_MULTI_THRESHOLD) {
-        _root->queryVisibilityParallelly(camera, frustum, isShadow, results);
+    doQueryVisibility(camera, frustum, isShadow, results);
+}
+
+void Octree::queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::pmr::vector<const Model *> &results) const {
+    doQueryVisibility(camera, frustum, isShadow, results);
+}
+
+template <typename ResultList>
+void Octree::doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const {
+    CC_PROFILE(OctreeQueryVisibility);
+    if (_totalCount > USE_MULTI_THRESHOLD && JobSystem::getInstance()->threadCount() > 1) {
+        queryVisibilityParallelly(camera, frustum, isShadow, results);
     } else {
         _root->queryVisibilitySequentially(camera, frustum, isShadow, results);
     }
 }
 
+uint32_t Octree::getCullingTaskDepth(uint32_t workerCount) const {
+    // every level multiplies the number of subtrees by up to 8,
+    // descend until there are enough subtrees to keep all workers busy.
+    const uint32_t wantedTasks = workerCount * OCTREE_TASKS_PER_WORKER;
+    uint32_t depth = 1;
+    uint32_t capacity = OCTREE_CHILDREN_NUM;
+    while (capacity < wantedTasks && depth + 1 < _maxDepth) {
+        capacity *= OCTREE_CHILDREN_NUM;
+        depth++;
+    }
+    return depth;
+}
+
+template <typename ResultList>
+void Octree::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const {
+    auto *jobSystem = JobSystem::getInstance();
+    const uint32_t taskDepth = getCullingTaskDepth(jobSystem->threadCount());
+
+    _cullingTasks.clear();
+    _root->gatherCullingTasks(camera, frustum, isShadow, taskDepth, results, _cullingTasks);
+
+    const auto taskCount = static_cast<uint32_t>(_cullingTasks.size());
+    CC_PROFILE_RENDER_UPDATE(OctreeCullingTaskDepth, taskDepth);
+    CC_PROFILE_RENDER_UPDATE(OctreeCullingTasks, taskCount);
+    if (taskCount == 0) {
+        return;
+    }
+
+    if (_cullingTaskResults.size() < taskCount) {
+        _cullingTaskResults.resize(taskCount);
+    }
+
+    JobGraph g(jobSystem);
+    g.createForEachIndexJob(0U, taskCount, 1U, [&](uint32_t i) {
+        auto &taskResults = _cullingTaskResults[i];
+        taskResults.clear();
+        _cullingTasks[i]->queryVisibilitySequentially(camera, frustum, isShadow, taskResults);
+    });
+    g.run();
+    g.waitForAll();
+
+    // merge in task order so that the result is deterministic
+    for (uint32_t i = 0; i < taskCount; ++i) {
+        const auto &taskResults = _cullingTaskResults[i];
+        results.insert(results.end(), taskResults.begin(), taskResults.end());
+    }
+}
+
 bool Octree::isInside(Model *model) const {
     const BBox &rootBox = _root->getBox();
     BBox modelBox = BBox(*model->getWorldBounds());
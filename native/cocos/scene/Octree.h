@@ -27,6 +27,7 @@
 #include "base/Macros.h"
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 #include "core/geometry/AABB.h"
 #include "math/Vec3.h"
 
@@ -43,6 +44,7 @@ const Vec3 DEFAULT_WORLD_MIN_POS = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3 DEFAULT_WORLD_MAX_POS = {1024.0F, 1024.0F, 1024.0F};
 const float OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD = 1024; // use parallel culling if greater than this value
+constexpr int OCTREE_TASKS_PER_WORKER = 4;  // subtrees dispatched per job worker in parallel culling
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -151,9 +153,12 @@ private:
     void remove(Model *model);
     void onRemoved();
     void gatherModels(ccstd::vector<Model *> &results) const;
-    void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
-    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
-    void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
+    template <typename ResultList>
+    void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const;
+    template <typename ResultList>
+    void gatherCullingTasks(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, uint32_t taskDepth, ResultList &results, ccstd::vector<const OctreeNode *> &tasks) const;
+    template <typename ResultList>
+    void queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const;
 
     Octree *_owner{nullptr};
     OctreeNode *_parent{nullptr};
@@ -217,17 +222,27 @@ public:
     // return octree depth
     inline uint32_t getMaxDepth() const { return _maxDepth; }
 
-    // view frustum culling
+    // view frustum culling, the results could also be collected in frame transient memory, e.g. from FrameArena
     void queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<const Model *> &results) const;
+    void queryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::pmr::vector<const Model *> &results) const;
 
 private:
     bool isInside(Model *model) const;
     bool isOutside(Model *model) const;
+    uint32_t getCullingTaskDepth(uint32_t workerCount) const;
+    template <typename ResultList>
+    void doQueryVisibility(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const;
+    template <typename ResultList>
+    void queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ResultList &results) const;
 
     OctreeNode *_root{nullptr};
     uint32_t _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t _totalCount{0};
 
+    // reused between queries so that steady-state parallel culling does not allocate
+    mutable ccstd::vector<const OctreeNode *> _cullingTasks;
+    mutable ccstd::vector<ccstd::vector<const Model *>> _cullingTaskResults;
+
     bool _enabled{false};
     Vec3 _minPos;
     Vec3 _maxPos;
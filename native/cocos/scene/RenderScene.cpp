@@ -25,10 +25,13 @@
 #include "scene/RenderScene.h"
 #include "scene/Camera.h"
 
+#include <algorithm>
 #include <utility>
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/std/container/unordered_set.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "profiler/Profiler.h"
@@ -48,6 +51,31 @@
 namespace cc {
 namespace scene {
 
+namespace {
+constexpr size_t PARALLEL_UPDATE_THRESHOLD = 1024; // update models in parallel if greater than this value
+constexpr uint32_t PARALLEL_UPDATE_CHUNK_SIZE = 256;
+
+enum ParallelUpdateFlag : uint8_t {
+    TRANSFORM_CHANGED = 0x01,
+    LOCAL_DATA_UPDATED = 0x02,
+    LOCAL_BUFFER_WRITTEN = 0x04,
+};
+
+template <typename F>
+void forEachModelChunk(uint32_t modelCount, F &&func) {
+    const uint32_t chunkCount = (modelCount + PARALLEL_UPDATE_CHUNK_SIZE - 1) / PARALLEL_UPDATE_CHUNK_SIZE;
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(0U, chunkCount, 1U, [modelCount, &func](uint32_t chunk) {
+        const uint32_t end = std::min((chunk + 1) * PARALLEL_UPDATE_CHUNK_SIZE, modelCount);
+        for (uint32_t i = chunk * PARALLEL_UPDATE_CHUNK_SIZE; i < end; ++i) {
+            func(i);
+        }
+    });
+    g.run();
+    g.waitForAll();
+}
+} // namespace
+
 /**
  * @zh 管理LODGroup的使用状态，包含使用层级及其上的model可见相机列表；便于判断当前model是否被LODGroup裁剪
  * @en Manage the usage status of LODGroup, including the usage level and the list of visible cameras on its models; easy to determine whether the current mod is cropped by LODGroup。
@@ -83,7 +111,19 @@ public:
 
     void clearCache();
 
+    inline uint32_t getRecomputedPairCount() const { return _recomputedPairCount; }
+    inline uint32_t getReusedPairCount() const { return _reusedPairCount; }
+
 private:
+    struct CameraProjectionInfo {
+        float projScale{0.F};
+        CameraProjection projection{CameraProjection::UNKNOWN};
+        bool initialized{false};
+    };
+
+    void collectDirtyCameras();
+    bool updateLodInfo(const LODGroup *lodGroup, const Camera *camera, LODInfo &lodInfo);
+
     /**
      * @zh LOD使用的model集合以及每个model当前能被看到的相机列表；包含每个LODGroup的每一级LOD
      * @en The set of models used by the LOD and the list of cameras that each models can currently be seen, contains each level of LOD for each LODGroup.
@@ -108,6 +148,29 @@ private:
      */
     ccstd::unordered_map<const LODGroup *, ccstd::unordered_map<uint8_t, ccstd::vector<const Model *>>> _levelModels;
 
+    /**
+     * @zh 相机上一次计算 LOD 时的投影参数，用于判断投影是否变化
+     * @en Projection parameters of each camera when LOD was last computed, used to detect projection changes.
+     */
+    ccstd::unordered_map<const Camera *, CameraProjectionInfo> _cameraProjections;
+
+    /**
+     * @zh 本帧视图或投影发生变化的相机
+     * @en Cameras whose view or projection changed in this frame.
+     */
+    ccstd::vector<std::pair<const Camera *, ccstd::unordered_map<const LODGroup *, LODInfo> *>> _dirtyCameras;
+
+    /**
+     * @zh 缓存的 LOD 层级对所有相机都可能过期的 LODGroup：上次更新后加入的、被禁用的，以及锁定期间节点发生变换的。
+     * 在下一次正常计算所有相机的层级后移除。
+     * @en LODGroups whose cached levels may be stale for every camera: groups added since the last update, disabled groups,
+     * and locked groups whose node moved. They are removed once their levels are recomputed for all cameras.
+     */
+    ccstd::unordered_set<const LODGroup *> _dirtyLodGroups;
+
+    uint32_t _recomputedPairCount{0};
+    uint32_t _reusedPairCount{0};
+
     RenderScene *_renderScene{nullptr};
 };
 
@@ -155,6 +218,14 @@ bool RenderScene::isCulledByLod(const Camera *camera, const Model *model) const
     return _lodStateCache->isLodModelCulled(camera, model);
 }
 
+uint32_t RenderScene::getLodRecomputedPairCount() const {
+    return _lodStateCache->getRecomputedPairCount();
+}
+
+uint32_t RenderScene::getLodReusedPairCount() const {
+    return _lodStateCache->getReusedPairCount();
+}
+
 void RenderScene::setMainLight(DirectionalLight *dl) {
     _mainLight = dl;
     if (_mainLight) _mainLight->activate();
@@ -178,19 +249,146 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &light : _rangedDirLights) {
         light->update();
     }
+    if (_rootNode) {
+        _transformSolver.setParallelEnabled(_parallelUpdateEnabled);
+        _transformSolver.solve(_rootNode);
+        CC_PROFILE_RENDER_UPDATE(TransformSolverUpdatedNodes, _transformSolver.getUpdatedNodeCount());
+    }
+    const bool parallel = _parallelUpdateEnabled && JobSystem::getInstance()->threadCount() > 1;
+    _skinningModels.clear();
+    if (parallel && _models.size() > PARALLEL_UPDATE_THRESHOLD) {
+        updateModelsParallelly(stamp);
+    } else {
+        updateModels(stamp, parallel);
+    }
+    if (!_skinningModels.empty()) {
+        updateSkinningModelsParallelly(stamp);
+    }
+    _modelWorldBoundsDirty = true;
+
+    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
+    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
+    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+
+    _lodStateCache->updateLodState();
+    CC_PROFILE_RENDER_UPDATE(LodRecomputedPairs, _lodStateCache->getRecomputedPairCount());
+    CC_PROFILE_RENDER_UPDATE(LodReusedPairs, _lodStateCache->getReusedPairCount());
+}
+
+void RenderScene::updateModels(uint32_t stamp, bool deferSkinning) {
     for (const auto &model : _models) {
-        if (model->isEnabled()) {
+        if (deferSkinning && model->isEnabled() && model->getType() == Model::Type::SKINNING) {
+            _skinningModels.emplace_back(static_cast<SkinningModel *>(model.get()));
+        } else if (model->isEnabled()) {
             model->updateTransform(stamp);
             model->updateUBOs(stamp);
             model->updateOctree();
         }
     }
+}
 
-    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
-    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
-    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+void RenderScene::updateModelsParallelly(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateModelsParallelly);
+    _parallelModels.clear();
+    _parallelModelFlags.clear();
 
-    _lodStateCache->updateLodState();
+    // Node transforms share parents and gfx commands are single producer, so both are resolved on main thread,
+    // only bounds and UBO staging data are computed on workers. The steps keep the order of updateTransform & updateUBOs.
+    for (const auto &model : _models) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (model->getType() == Model::Type::SKINNING) {
+            _skinningModels.emplace_back(static_cast<SkinningModel *>(model.get()));
+            continue;
+        }
+        if (model->getType() != Model::Type::DEFAULT) {
+            model->updateTransform(stamp);
+            model->updateUBOs(stamp);
+            model->updateOctree();
+            continue;
+        }
+        _parallelModels.emplace_back(model.get());
+        _parallelModelFlags.emplace_back(model->syncWorldTransform() ? TRANSFORM_CHANGED : 0);
+    }
+
+    const auto modelCount = static_cast<uint32_t>(_parallelModels.size());
+    forEachModelChunk(modelCount, [this](uint32_t i) {
+        if (_parallelModelFlags[i] & TRANSFORM_CHANGED) {
+            _parallelModels[i]->transformWorldBounds();
+        }
+    });
+
+    // sub models and light probes read the new bounds, reflection probe nodes are read here as well
+    for (uint32_t i = 0; i < modelCount; ++i) {
+        if (_parallelModels[i]->prepareLocalUBOs(stamp)) {
+            _parallelModelFlags[i] |= LOCAL_DATA_UPDATED;
+        }
+    }
+
+    forEachModelChunk(modelCount, [this](uint32_t i) {
+        auto &flags = _parallelModelFlags[i];
+        if ((flags & LOCAL_DATA_UPDATED) && _parallelModels[i]->writeLocalUBOs()) {
+            flags |= LOCAL_BUFFER_WRITTEN;
+        }
+    });
+
+    // merge: upload buffers and reinsert moved models into octree in scene order
+    for (uint32_t i = 0; i < modelCount; ++i) {
+        Model *model = _parallelModels[i];
+        if (_parallelModelFlags[i] & LOCAL_BUFFER_WRITTEN) {
+            model->flushLocalUBOs();
+        }
+        model->updateOctree();
+    }
+}
+
+void RenderScene::updateSkinningModelsParallelly(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateSkinningModels);
+    // Joint transforms are shared between models of one hierarchy and gfx commands are single producer,
+    // so both are resolved on main thread, bounds and joint palettes are computed on workers, one model per task.
+    for (SkinningModel *model : _skinningModels) {
+        model->syncJointTransforms(stamp);
+    }
+
+    const auto modelCount = static_cast<uint32_t>(_skinningModels.size());
+    if (modelCount > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, modelCount, 1U, [this](uint32_t i) {
+            _skinningModels[i]->updateJointPalette();
+        });
+        g.run();
+        g.waitForAll();
+    } else {
+        _skinningModels[0]->updateJointPalette();
+    }
+
+    // submit all joint buffer updates of the frame together, in scene order
+    for (SkinningModel *model : _skinningModels) {
+        model->flushJointBuffers(stamp);
+        model->updateOctree();
+    }
+    CC_PROFILE_RENDER_UPDATE(ParallelSkinningModels, modelCount);
+}
+
+const geometry::AABBSoA &RenderScene::getModelWorldBounds() const {
+    if (_modelWorldBoundsDirty) {
+        syncModelWorldBounds();
+        _modelWorldBoundsDirty = false;
+    }
+    return _modelWorldBounds;
+}
+
+void RenderScene::syncModelWorldBounds() const {
+    const auto modelCount = static_cast<uint32_t>(_models.size());
+    for (uint32_t i = 0; i < modelCount; ++i) {
+        const auto *worldBounds = _models[i]->getWorldBounds();
+        if (worldBounds && _models[i]->isEnabled()) {
+            _modelWorldBounds.set(i, *worldBounds);
+        } else {
+            _modelWorldBounds.setEmpty(i);
+        }
+    }
 }
 
 void RenderScene::destroy() {
@@ -201,6 +399,8 @@ void RenderScene::destroy() {
     removeLODGroups();
     removeModels();
     _lodStateCache->clearCache();
+    _rootNode = nullptr;
+    _transformSolver.reset();
 }
 
 void RenderScene::addCamera(Camera *camera) {
@@ -343,6 +543,11 @@ void RenderScene::removeRangedDirLights() {
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
     _models.emplace_back(model);
+    if (model->getWorldBounds()) {
+        _modelWorldBounds.add(*model->getWorldBounds());
+    } else {
+        _modelWorldBounds.addEmpty();
+    }
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
@@ -356,6 +561,7 @@ void RenderScene::removeModel(Model *model) {
         }
         _lodStateCache->removeModel(model);
         model->detachFromScene();
+        _modelWorldBounds.erase(static_cast<uint32_t>(iter - _models.begin()));
         _models.erase(iter);
     } else {
         CC_LOG_WARNING("Try to remove invalid model.");
@@ -372,6 +578,7 @@ void RenderScene::removeModels() {
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _modelWorldBounds.clear();
 }
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
@@ -418,6 +625,7 @@ void LodStateCache::removeCamera(const Camera *camera) {
     if (_lodStateInCamera.count(camera) != 0) {
         _lodStateInCamera.erase(camera);
     }
+    _cameraProjections.erase(camera);
 }
 
 void LodStateCache::addLodGroup(const LODGroup *lodGroup) {
@@ -445,6 +653,7 @@ void LodStateCache::removeLodGroup(const LODGroup *lodGroup) {
         visibleCamera.second.erase(lodGroup);
     }
     _levelModels.erase(lodGroup);
+    _dirtyLodGroups.erase(lodGroup);
 }
 
 void LodStateCache::removeModel(const Model *model) {
@@ -466,104 +675,115 @@ void LodStateCache::updateLodState() {
                 vecModels.push_back(model);
             }
         }
+        _dirtyLodGroups.insert(addedLodGroup);
     }
     _newAddedLodGroupVec.clear();
 
+    collectDirtyCameras();
+    _recomputedPairCount = 0;
+    _reusedPairCount = 0;
+
     //update current visible lod index & model's visible cameras list
     for (const auto &lodGroup : _renderScene->getLODGroups()) {
-        if (lodGroup->isEnabled()) {
-            const auto &lodLevels = lodGroup->getLockedLODLevels();
-            // lodLevels is not empty, indicating that the user force to use certain layers of LOD
-            if (!lodLevels.empty()) {
-                //Update the dirty flag to make it easier to update the visible index of lod after lifting the forced use of lod.
-                if (lodGroup->getNode()->getChangedFlags() > 0) {
-                    for (auto &visibleCamera : _lodStateInCamera) {
-                        auto &lodInfo = visibleCamera.second[lodGroup];
-                        lodInfo.transformDirty = true;
-                    }
+        if (!lodGroup->isEnabled()) {
+            // cameras may move while the group is disabled, recompute all pairs after it is enabled again.
+            _dirtyLodGroups.insert(lodGroup);
+            continue;
+        }
+        const auto &lodLevels = lodGroup->getLockedLODLevels();
+        // lodLevels is not empty, indicating that the user force to use certain layers of LOD
+        if (!lodLevels.empty()) {
+            //Update the dirty flag to make it easier to update the visible index of lod after lifting the forced use of lod.
+            if (lodGroup->getNode()->getChangedFlags() > 0) {
+                for (auto &visibleCamera : _lodStateInCamera) {
+                    auto &lodInfo = visibleCamera.second[lodGroup];
+                    lodInfo.transformDirty = true;
                 }
-                //Update the visible camera list of all models on lodGroup when the visible level changes.
-                if (lodGroup->isLockLevelChanged()) {
-                    lodGroup->resetLockChangeFlag();
-                    const auto &lodModels = _levelModels[lodGroup];
-                    for (const auto &level : lodModels) {
-                        const auto &vecModels = lodModels.at(level.first);
-                        for (const auto &model : vecModels) {
-                            _modelsInLODGroup[model].clear();
-                        }
+                _dirtyLodGroups.insert(lodGroup);
+            }
+            //Update the visible camera list of all models on lodGroup when the visible level changes.
+            if (lodGroup->isLockLevelChanged()) {
+                lodGroup->resetLockChangeFlag();
+                const auto &lodModels = _levelModels[lodGroup];
+                for (const auto &level : lodModels) {
+                    const auto &vecModels = lodModels.at(level.first);
+                    for (const auto &model : vecModels) {
+                        _modelsInLODGroup[model].clear();
                     }
+                }
 
-                    for (uint8_t visibleIndex : lodLevels) {
-                        const auto &vecModels = lodModels.at(visibleIndex);
-                        for (const auto &model : vecModels) {
-                            if (model->getNode() && model->getNode()->isActive()) {
-                                auto &modelInfo = _modelsInLODGroup[model];
-                                for (const auto &visibleCamera : _lodStateInCamera) {
-                                    modelInfo.emplace(visibleCamera.first, true);
-                                }
+                for (uint8_t visibleIndex : lodLevels) {
+                    const auto &vecModels = lodModels.at(visibleIndex);
+                    for (const auto &model : vecModels) {
+                        if (model->getNode() && model->getNode()->isActive()) {
+                            auto &modelInfo = _modelsInLODGroup[model];
+                            for (const auto &visibleCamera : _lodStateInCamera) {
+                                modelInfo.emplace(visibleCamera.first, true);
                             }
                         }
                     }
                 }
-                continue;
             }
+            continue;
+        }
 
-            //Normal Process, no LOD is forced.
-            bool hasUpdated = false;
+        //Normal Process, no LOD is forced.
+        bool hasUpdated = false;
+        const auto cameraCount = static_cast<uint32_t>(_lodStateInCamera.size());
+        //Changes in the matrix of the node where lodGroup is located or the transformDirty marker is true, etc. All cameras need to recalculate the visible level of LOD.
+        auto dirtyIter = _dirtyLodGroups.find(lodGroup);
+        if (lodGroup->getNode()->getChangedFlags() > 0 || dirtyIter != _dirtyLodGroups.end()) {
             for (auto &visibleCamera : _lodStateInCamera) {
-                auto cameraChangeFlags = visibleCamera.first->getNode()->getChangedFlags();
-                auto lodGroupChangeFlags = lodGroup->getNode()->getChangedFlags();
-                auto &lodInfo = visibleCamera.second[lodGroup];
-                //Changes in the camera matrix or changes in the matrix of the node where lodGroup is located or the transformDirty marker is true, etc. All need to recalculate the visible level of LOD.
-                if (cameraChangeFlags > 0 || lodGroupChangeFlags > 0 || lodInfo.transformDirty) {
-                    if (lodInfo.transformDirty) {
-                        lodInfo.transformDirty = false;
-                    }
-
-                    int8_t index = lodGroup->getVisibleLODLevel(visibleCamera.first);
-                    if (index != lodInfo.usedLevel) {
-                        lodInfo.lastUsedLevel = lodInfo.usedLevel;
-                        lodInfo.usedLevel = index;
-                        hasUpdated = true;
-                    }
-                }
+                hasUpdated |= updateLodInfo(lodGroup, visibleCamera.first, visibleCamera.second[lodGroup]);
             }
+            if (dirtyIter != _dirtyLodGroups.end()) {
+                _dirtyLodGroups.erase(dirtyIter);
+            }
+            _recomputedPairCount += cameraCount;
+        } else {
+            //Static lodGroup, only cameras whose view or projection changed need to recalculate.
+            for (const auto &dirtyCamera : _dirtyCameras) {
+                hasUpdated |= updateLodInfo(lodGroup, dirtyCamera.first, (*dirtyCamera.second)[lodGroup]);
+            }
+            const auto dirtyCameraCount = static_cast<uint32_t>(_dirtyCameras.size());
+            _recomputedPairCount += dirtyCameraCount;
+            _reusedPairCount += cameraCount - dirtyCameraCount;
+        }
 
-            //The LOD of the last frame is forced to be used, the list of visible cameras of modelInfo needs to be updated.
-            const auto &lodModels = _levelModels[lodGroup];
-            if (lodGroup->isLockLevelChanged()) {
-                lodGroup->resetLockChangeFlag();
+        //The LOD of the last frame is forced to be used, the list of visible cameras of modelInfo needs to be updated.
+        const auto &lodModels = _levelModels[lodGroup];
+        if (lodGroup->isLockLevelChanged()) {
+            lodGroup->resetLockChangeFlag();
 
-                for (const auto &level : lodModels) {
-                    const auto &vecModels = lodModels.at(level.first);
+            for (const auto &level : lodModels) {
+                const auto &vecModels = lodModels.at(level.first);
+                for (const auto &model : vecModels) {
+                    _modelsInLODGroup[model].clear();
+                }
+            }
+            hasUpdated = true;
+        } else if (hasUpdated) {
+            for (auto &visibleCamera : _lodStateInCamera) {
+                const auto &lodInfo = visibleCamera.second[lodGroup];
+                int8_t usedLevel = lodInfo.usedLevel;
+                if (lodInfo.usedLevel != lodInfo.lastUsedLevel && lodInfo.lastUsedLevel >= 0) {
+                    const auto &vecModels = lodModels.at(static_cast<uint8_t>(lodInfo.lastUsedLevel));
                     for (const auto &model : vecModels) {
                         _modelsInLODGroup[model].clear();
                     }
                 }
-                hasUpdated = true;
-            } else if (hasUpdated) {
-                for (auto &visibleCamera : _lodStateInCamera) {
-                    const auto &lodInfo = visibleCamera.second[lodGroup];
-                    int8_t usedLevel = lodInfo.usedLevel;
-                    if (lodInfo.usedLevel != lodInfo.lastUsedLevel && lodInfo.lastUsedLevel >= 0) {
-                        const auto &vecModels = lodModels.at(static_cast<uint8_t>(lodInfo.lastUsedLevel));
-                        for (const auto &model : vecModels) {
-                            _modelsInLODGroup[model].clear();
-                        }
-                    }
-                }
             }
-            //Update the visible camera list of all models on lodGroup.
-            if (hasUpdated) {
-                for (auto &visibleCamera : _lodStateInCamera) {
-                    int8_t usedLevel = visibleCamera.second[lodGroup].usedLevel;
-                    if (usedLevel >= 0) {
-                        const auto &vecModels = lodModels.at(static_cast<uint8_t>(usedLevel));
-                        for (const auto &model : vecModels) {
-                            if (model->getNode() && model->getNode()->isActive()) {
-                                auto &modelInfo = _modelsInLODGroup[model];
-                                modelInfo.emplace(visibleCamera.first, true);
-                            }
+        }
+        //Update the visible camera list of all models on lodGroup.
+        if (hasUpdated) {
+            for (auto &visibleCamera : _lodStateInCamera) {
+                int8_t usedLevel = visibleCamera.second[lodGroup].usedLevel;
+                if (usedLevel >= 0) {
+                    const auto &vecModels = lodModels.at(static_cast<uint8_t>(usedLevel));
+                    for (const auto &model : vecModels) {
+                        if (model->getNode() && model->getNode()->isActive()) {
+                            auto &modelInfo = _modelsInLODGroup[model];
+                            modelInfo.emplace(visibleCamera.first, true);
                         }
                     }
                 }
@@ -572,6 +792,33 @@ void LodStateCache::updateLodState() {
     }
 }
 
+void LodStateCache::collectDirtyCameras() {
+    _dirtyCameras.clear();
+    for (auto &visibleCamera : _lodStateInCamera) {
+        const auto *camera = visibleCamera.first;
+        // LODGroup::getVisibleLODLevel depends on camera position, projection type and matProj.m[5]
+        const float projScale = camera->getMatProj().m[5];
+        auto &projInfo = _cameraProjections[camera];
+        if (!projInfo.initialized || projInfo.projection != camera->getProjectionType() || projInfo.projScale != projScale || camera->getNode()->getChangedFlags() > 0) {
+            projInfo.projScale = projScale;
+            projInfo.projection = camera->getProjectionType();
+            projInfo.initialized = true;
+            _dirtyCameras.emplace_back(camera, &visibleCamera.second);
+        }
+    }
+}
+
+bool LodStateCache::updateLodInfo(const LODGroup *lodGroup, const Camera *camera, LODInfo &lodInfo) {
+    lodInfo.transformDirty = false;
+    int8_t index = lodGroup->getVisibleLODLevel(camera);
+    if (index != lodInfo.usedLevel) {
+        lodInfo.lastUsedLevel = lodInfo.usedLevel;
+        lodInfo.usedLevel = index;
+        return true;
+    }
+    return false;
+}
+
 bool LodStateCache::isLodModelCulled(const Camera *camera, const Model *model) {
     const auto &itModel = _modelsInLODGroup.find(model);
     if (itModel == _modelsInLODGroup.end()) {
@@ -587,6 +834,9 @@ void LodStateCache::clearCache() {
     _modelsInLODGroup.clear();
     _lodStateInCamera.clear();
     _newAddedLodGroupVec.clear();
+    _cameraProjections.clear();
+    _dirtyCameras.clear();
+    _dirtyLodGroups.clear();
 }
 
 } // namespace scene
@@ -29,6 +29,8 @@
 #include "base/RefCounted.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "core/geometry/FrustumCulling.h"
+#include "core/scene-graph/TransformSolver.h"
 #include <cocos/scene/raytracing/RayTracing.h>
 
 namespace cc {
@@ -79,6 +81,16 @@ public:
     void removeLODGroup(LODGroup *group);
     void removeLODGroups();
     bool isCulledByLod(const Camera *camera, const Model *model) const;
+    /**
+     * @en Number of camera and LOD group pairs whose LOD level was recomputed in the last update.
+     * @zh 上一次更新中重新计算 LOD 层级的相机与 LODGroup 组合数量。
+     */
+    uint32_t getLodRecomputedPairCount() const;
+    /**
+     * @en Number of camera and LOD group pairs whose LOD level was reused from the cache in the last update.
+     * @zh 上一次更新中直接复用缓存 LOD 层级的相机与 LODGroup 组合数量。
+     */
+    uint32_t getLodReusedPairCount() const;
 
     void unsetMainLight(DirectionalLight *dl);
     void addDirectionalLight(DirectionalLight *dl);
@@ -122,16 +134,49 @@ public:
     inline const ccstd::vector<IntrusivePtr<PointLight>> &getPointLights() const { return _pointLights; }
     inline const ccstd::vector<IntrusivePtr<RangedDirectionalLight>> &getRangedDirLights() const { return _rangedDirLights; }
     inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
+    /**
+     * @en World bounds of all models in structure of arrays, index aligned with getModels().
+     * Disabled models and models without bounds are stored as empty boxes.
+     * Synced from the models on the first access after update(), so scenes culled by the octree never pay for it.
+     * @zh 以 SoA 形式存储的所有模型的世界包围盒，下标与 getModels() 一致。
+     * 未启用或没有包围盒的模型存储为空包围盒。在 update() 之后首次访问时从模型同步，使用八叉树剔除的场景不会产生此开销。
+     */
+    const geometry::AABBSoA &getModelWorldBounds() const;
     inline Octree *getOctree() const { return _octree; }
     void updateOctree(Model *model);
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
 
+    /**
+     * @en Whether to update native model transforms and UBOs on job system workers for large scenes.
+     * Skinning models are then updated in a separate phase, with one model per task. Disabled by default.
+     * @zh 模型数量较多时，是否在 JobSystem 的工作线程上并行更新模型变换与 UBO。
+     * 开启后蒙皮模型在单独的阶段中更新，每个任务处理一个模型。默认关闭。
+     */
+    inline void setParallelUpdateEnabled(bool val) { _parallelUpdateEnabled = val; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
+    /**
+     * @en The root node whose hierarchy transforms are resolved breadth first before the models are updated.
+     * @zh 在更新模型之前，以广度优先方式解算其层级变换的根节点。
+     */
+    inline void setRootNode(Node *node) { _rootNode = node; }
+    inline Node *getRootNode() const { return _rootNode; }
+    inline const TransformSolver &getTransformSolver() const { return _transformSolver; }
+
 private:
+    void updateModels(uint32_t stamp, bool deferSkinning);
+    void updateModelsParallelly(uint32_t stamp);
+    void updateSkinningModelsParallelly(uint32_t stamp);
+    void syncModelWorldBounds() const;
+
     ccstd::string _name;
     uint64_t _modelId{0};
     IntrusivePtr<DirectionalLight> _mainLight;
     IntrusivePtr<LodStateCache> _lodStateCache;
     ccstd::vector<IntrusivePtr<Model>> _models;
+    // synced lazily by the culling, which only sees a const scene
+    mutable geometry::AABBSoA _modelWorldBounds;
+    mutable bool _modelWorldBoundsDirty{true};
     ccstd::vector<IntrusivePtr<Camera>> _cameras;
     ccstd::vector<IntrusivePtr<DirectionalLight>> _directionalLights;
     ccstd::vector<IntrusivePtr<LODGroup>> _lodGroups;
@@ -141,6 +186,14 @@ private:
     ccstd::vector<IntrusivePtr<RangedDirectionalLight>> _rangedDirLights;
     ccstd::vector<DrawBatch2D *> _batches;
     Octree *_octree{nullptr};
+    Node *_rootNode{nullptr};
+    TransformSolver _transformSolver;
+
+    // structure of arrays for the parallel update, reused between frames
+    ccstd::vector<Model *> _parallelModels;
+    ccstd::vector<uint8_t> _parallelModelFlags;
+    ccstd::vector<SkinningModel *> _skinningModels;
+    bool _parallelUpdateEnabled{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
@@ -0,0 +1,312 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "cocos/base/Log.h"
+#include "gtest/gtest.h"
+
+#if CC_USE_DRAGONBONES
+    #include "cocos/base/DeferredReleasePool.h"
+    #include "cocos/editor-support/dragonbones-creator-support/ArmatureCache.h"
+    #include "cocos/editor-support/dragonbones-creator-support/ArmatureCacheMgr.h"
+    #include "cocos/editor-support/dragonbones-creator-support/CCFactory.h"
+    #if defined(__linux__)
+        #include <unistd.h>
+    #endif
+
+namespace {
+
+using ArmatureCache = dragonBones::ArmatureCache;
+
+constexpr uint32_t ARMATURE_COUNT = 100;
+constexpr uint32_t FRAME_COUNT = 120;
+constexpr uint32_t BONE_COUNT = 40;
+constexpr uint32_t SLOT_COUNT = 40;
+// quads with the x, y, z, u, v, color layout of VF_XYZUVC
+constexpr uint32_t VERTEX_FLOATS = 6;
+constexpr uint32_t SLOT_VERTEX_COUNT = 4;
+constexpr uint32_t SLOT_INDEX_COUNT = 6;
+constexpr uint32_t SEGMENT_COUNT = 4;
+constexpr uint32_t TEXTURE_COUNT = 2;
+
+constexpr const char *ARMATURE_NAME = "armature";
+constexpr const char *ANIMATION_NAME = "walk";
+constexpr const char *ATLAS_NAME = "armatureBenchAtlas";
+constexpr uint32_t ATLAS_SIZE = 256;
+
+std::string tempFilePath(const char *name) {
+    const char *dir = std::getenv("TMPDIR");
+    std::string path = dir ? dir : ".";
+    return path + "/" + name;
+}
+
+// frames shaped like the output of ArmatureCache::renderAnimationFrame
+void bakeFrames(ArmatureCache::FrameArrays &out) {
+    const uint32_t slotsPerSegment = SLOT_COUNT / SEGMENT_COUNT;
+    for (uint32_t f = 0; f < FRAME_COUNT; ++f) {
+        ArmatureCache::FrameData frame;
+        frame.boneOffset = static_cast<uint32_t>(out.bones.size());
+        frame.boneCount = BONE_COUNT;
+        frame.colorOffset = static_cast<uint32_t>(out.colors.size());
+        frame.colorCount = 1;
+        frame.segmentOffset = static_cast<uint32_t>(out.segments.size());
+        frame.segmentCount = SEGMENT_COUNT;
+        frame.vertexFloatOffset = static_cast<uint32_t>(out.vertices.size());
+        frame.vertexFloatCount = SLOT_COUNT * SLOT_VERTEX_COUNT * VERTEX_FLOATS;
+        frame.indexOffset = static_cast<uint32_t>(out.indices.size());
+        frame.indexCount = SLOT_COUNT * SLOT_INDEX_COUNT;
+        out.frames.push_back(frame);
+
+        for (uint32_t b = 0; b < BONE_COUNT; ++b) {
+            ArmatureCache::BoneData bone;
+            bone.tx = static_cast<float>(f);
+            bone.ty = static_cast<float>(b);
+            out.bones.push_back(bone);
+        }
+        ArmatureCache::ColorData color;
+        color.color = {255, 255, 255, 255};
+        color.vertexFloatOffset = frame.vertexFloatCount;
+        out.colors.push_back(color);
+
+        for (uint32_t s = 0; s < SEGMENT_COUNT; ++s) {
+            ArmatureCache::SegmentData segment;
+            segment.textureIndex = static_cast<int>(s % TEXTURE_COUNT);
+            segment.vertexFloatCount = slotsPerSegment * SLOT_VERTEX_COUNT * VERTEX_FLOATS;
+            segment.indexCount = slotsPerSegment * SLOT_INDEX_COUNT;
+            out.segments.push_back(segment);
+        }
+        for (uint32_t v = 0; v < SLOT_COUNT * SLOT_VERTEX_COUNT * VERTEX_FLOATS; ++v) {
+            out.vertices.push_back(static_cast<float>(f * 1000 + v));
+        }
+        for (uint32_t s = 0; s < slotsPerSegment * SEGMENT_COUNT; ++s) {
+            const auto base = static_cast<uint16_t>((s % slotsPerSegment) * SLOT_VERTEX_COUNT);
+            const uint16_t quad[SLOT_INDEX_COUNT] = {base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2), base, static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3)};
+            out.indices.insert(out.indices.end(), quad, quad + SLOT_INDEX_COUNT);
+        }
+    }
+}
+
+// a chain of bones with one textured slot each, every bone turning over FRAME_COUNT frames
+std::string armatureJson() {
+    std::string bones = R"({"name":"root"})";
+    std::string slots;
+    std::string displays;
+    std::string timelines;
+    for (uint32_t i = 0; i < BONE_COUNT; ++i) {
+        const auto name = std::to_string(i);
+        const auto parent = i == 0 ? std::string("root") : "b" + std::to_string(i - 1);
+        bones += R"(,{"name":"b)" + name + R"(","parent":")" + parent + R"(","length":8,"transform":{"x":8}})";
+        if (i > 0) {
+            slots += ",";
+            displays += ",";
+            timelines += ",";
+        }
+        slots += R"({"name":"s)" + name + R"(","parent":"b)" + name + R"("})";
+        displays += R"({"name":"s)" + name + R"(","display":[{"name":"part)" + std::to_string(i % 2) + R"("}]})";
+        timelines += R"({"name":"b)" + name + R"(","rotateFrame":[{"duration":)" + std::to_string(FRAME_COUNT / 2) +
+                     R"(,"tweenEasing":0,"rotate":0},{"duration":)" + std::to_string(FRAME_COUNT / 2) +
+                     R"(,"tweenEasing":0,"rotate":30},{"duration":0,"rotate":0}]})";
+    }
+    return R"({"frameRate":60,"name":"bench","version":"5.5","compatibleVersion":"5.5","armature":[{"type":"Armature","frameRate":60,"name":")" +
+           std::string(ARMATURE_NAME) + R"(","bone":[)" + bones + R"(],"slot":[)" + slots + R"(],"skin":[{"slot":[)" + displays +
+           R"(]}],"animation":[{"duration":)" + std::to_string(FRAME_COUNT) + R"(,"playTimes":1,"name":")" + ANIMATION_NAME +
+           R"(","bone":[)" + timelines + "]}]}]}";
+}
+
+std::string atlasJson() {
+    return R"({"name":"bench","imagePath":"bench.png","width":256,"height":256,"SubTexture":[)"
+           R"({"name":"part0","x":0,"y":0,"width":32,"height":32},{"name":"part1","x":32,"y":0,"width":32,"height":32}]})";
+}
+
+std::string armatureKey(uint32_t index) {
+    char key[32];
+    snprintf(key, sizeof(key), "armatureBench%03u", index);
+    return key;
+}
+
+// resident set of the process, 0 where it can not be read
+std::size_t residentBytes() {
+    #if defined(__linux__)
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    unsigned long size = 0;     // NOLINT(google-runtime-int)
+    unsigned long resident = 0; // NOLINT(google-runtime-int)
+    const int read = fscanf(file, "%lu %lu", &size, &resident);
+    fclose(file);
+    return read == 2 ? static_cast<std::size_t>(resident) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+    #else
+    return 0;
+    #endif
+}
+
+std::size_t residentGrowth(std::size_t before) {
+    const auto after = residentBytes();
+    return after > before ? after - before : 0;
+}
+
+class ArmatureCacheBenchmark : public testing::Test {
+protected:
+    void SetUp() override {
+        _cacheDirectory = ArmatureCache::getCacheDirectory();
+        _directory = std::filesystem::temp_directory_path() / "armature_cache_benchmark";
+        std::filesystem::remove_all(_directory);
+        std::filesystem::create_directories(_directory);
+
+        _texture = new cc::middleware::Texture2D();
+        _texture->addRef();
+        _texture->setPixelsWide(ATLAS_SIZE);
+        _texture->setPixelsHigh(ATLAS_SIZE);
+
+        auto *factory = dragonBones::CCFactory::getFactory();
+        factory->parseTextureAtlasData(atlasJson().c_str(), _texture, ATLAS_NAME);
+        const auto json = armatureJson();
+        for (uint32_t i = 0; i < ARMATURE_COUNT; ++i) {
+            ASSERT_NE(factory->parseDragonBonesData(json.c_str(), armatureKey(i)), nullptr);
+        }
+    }
+
+    void TearDown() override {
+        releaseCaches();
+        auto *factory = dragonBones::CCFactory::getFactory();
+        for (uint32_t i = 0; i < ARMATURE_COUNT; ++i) {
+            factory->removeDragonBonesData(armatureKey(i));
+        }
+        factory->removeTextureAtlasData(ATLAS_NAME);
+        _texture->release();
+        ArmatureCache::setCacheDirectory(_cacheDirectory);
+        std::filesystem::remove_all(_directory);
+    }
+
+    // what the first play of every armature costs, baking frames or mapping them from disk
+    double playAll() {
+        auto *mgr = dragonBones::ArmatureCacheMgr::getInstance();
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < ARMATURE_COUNT; ++i) {
+            auto *cache = mgr->buildArmatureCache(ARMATURE_NAME, armatureKey(i), ATLAS_NAME);
+            cache->buildAnimationData(ANIMATION_NAME);
+            cache->updateToFrame(ANIMATION_NAME);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    static void releaseCaches() {
+        auto *mgr = dragonBones::ArmatureCacheMgr::getInstance();
+        for (uint32_t i = 0; i < ARMATURE_COUNT; ++i) {
+            mgr->removeArmatureCache(armatureKey(i));
+        }
+        cc::DeferredReleasePool::clear();
+    }
+
+    static ArmatureCache::AnimationData *animationData(uint32_t index) {
+        auto *cache = dragonBones::ArmatureCacheMgr::getInstance()->buildArmatureCache(ARMATURE_NAME, armatureKey(index), ATLAS_NAME);
+        return cache->getAnimationData(ANIMATION_NAME);
+    }
+
+    std::string _cacheDirectory;
+    std::filesystem::path _directory;
+    cc::middleware::Texture2D *_texture{nullptr};
+};
+
+} // namespace
+
+TEST(armatureCacheTest, blobRoundTrip) {
+    ArmatureCache::FrameArrays arrays;
+    bakeFrames(arrays);
+    auto path = tempFilePath("armature_cache_round_trip.dbc");
+    ASSERT_TRUE(ArmatureCache::AnimationData::writeFile(arrays, true, FRAME_COUNT * ArmatureCache::FrameTime, path, 7, TEXTURE_COUNT));
+
+    ArmatureCache::AnimationData data;
+    EXPECT_FALSE(data.load(path, 8, TEXTURE_COUNT));
+    EXPECT_FALSE(data.load(path, 7, TEXTURE_COUNT - 1));
+    ASSERT_TRUE(data.load(path, 7, TEXTURE_COUNT));
+    EXPECT_TRUE(data.isMapped());
+    EXPECT_TRUE(data.isComplete());
+    ASSERT_EQ(data.getFrameCount(), FRAME_COUNT);
+    EXPECT_EQ(data.getFrameData(FRAME_COUNT), nullptr);
+
+    for (uint32_t f = 0; f < FRAME_COUNT; f += 17) {
+        const auto *frame = data.getFrameData(f);
+        ASSERT_NE(frame, nullptr);
+        const auto &expected = arrays.frames[f];
+        ASSERT_EQ(frame->vertexFloatCount, expected.vertexFloatCount);
+        ASSERT_EQ(frame->indexCount, expected.indexCount);
+        EXPECT_EQ(memcmp(data.getVertices(*frame), arrays.vertices.data() + expected.vertexFloatOffset, expected.vertexFloatCount * sizeof(float)), 0);
+        EXPECT_EQ(memcmp(data.getIndices(*frame), arrays.indices.data() + expected.indexOffset, expected.indexCount * sizeof(uint16_t)), 0);
+        EXPECT_EQ(data.getBones(*frame)[3].tx, static_cast<float>(f));
+        EXPECT_EQ(data.getSegments(*frame)[1].textureIndex, 1);
+    }
+
+    // a frame pointing past the arrays is rejected instead of read out of the mapping
+    data.reset();
+    ArmatureCache::FrameArrays broken = arrays;
+    broken.frames.back().indexOffset = static_cast<uint32_t>(broken.indices.size());
+    ASSERT_TRUE(ArmatureCache::AnimationData::writeFile(broken, true, 1.0F, path, 7, TEXTURE_COUNT));
+    EXPECT_FALSE(data.load(path, 7, TEXTURE_COUNT));
+    EXPECT_EQ(data.getFrameCount(), 0);
+    remove(path.c_str());
+}
+
+TEST_F(ArmatureCacheBenchmark, firstPlayAndResidentMemory) {
+    // no cache directory, every armature advances and renders all of its frames on first play
+    ArmatureCache::setCacheDirectory("");
+    auto rss = residentBytes();
+    const double bake = playAll();
+    const auto bakeResident = residentGrowth(rss);
+    const auto *baked = animationData(0);
+    ASSERT_NE(baked, nullptr);
+    EXPECT_FALSE(baked->isMapped());
+    EXPECT_TRUE(baked->isComplete());
+    const auto frameCount = baked->getFrameCount();
+    EXPECT_GT(frameCount, 0U);
+    releaseCaches();
+
+    // the offline bake, writes one file per armature
+    ArmatureCache::setCacheDirectory(_directory.string());
+    playAll();
+    releaseCaches();
+
+    // first play with the files present maps the frames instead of baking them
+    rss = residentBytes();
+    const double map = playAll();
+    const auto mapResident = residentGrowth(rss);
+    for (uint32_t i = 0; i < ARMATURE_COUNT; ++i) {
+        const auto *mapped = animationData(i);
+        ASSERT_NE(mapped, nullptr);
+        EXPECT_TRUE(mapped->isMapped());
+        EXPECT_EQ(mapped->getFrameCount(), frameCount);
+    }
+
+    CC_LOG_INFO("armature cache %u armatures x %zu frames first play: bake %.3f ms +%zu KB resident, mapped %.3f ms +%zu KB resident",
+                ARMATURE_COUNT, frameCount, bake, bakeResident / 1024, map, mapResident / 1024);
+    EXPECT_LT(map, bake);
+    EXPECT_LE(mapResident, bakeResident);
+}
+
+#endif
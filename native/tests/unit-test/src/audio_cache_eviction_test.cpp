@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cocos/base/Macros.h"
+#include "gtest/gtest.h"
+
+#if CC_USE_AUDIO && (CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX)
+    #include "cocos/audio/include/AudioEngine.h"
+    #include "cocos/platform/FileUtils.h"
+
+namespace {
+
+constexpr uint32_t SAMPLE_RATE = 22050;
+constexpr uint32_t FRAME_COUNT = SAMPLE_RATE / 2;
+// mono 16 bit pcm, small enough to be decoded into the cache instead of streamed
+constexpr uint64_t SOUND_BYTES = FRAME_COUNT * 2;
+
+void writeLE(FILE *file, uint32_t value, uint32_t byteCount) {
+    for (uint32_t i = 0; i < byteCount; ++i) {
+        fputc(static_cast<int>((value >> (i * 8)) & 0xFF), file);
+    }
+}
+
+bool writeWav(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const uint32_t dataSize = FRAME_COUNT * 2;
+    fwrite("RIFF", 1, 4, file);
+    writeLE(file, 36 + dataSize, 4);
+    fwrite("WAVEfmt ", 1, 8, file);
+    writeLE(file, 16, 4);
+    writeLE(file, 1, 2); // pcm
+    writeLE(file, 1, 2); // channels
+    writeLE(file, SAMPLE_RATE, 4);
+    writeLE(file, SAMPLE_RATE * 2, 4);
+    writeLE(file, 2, 2);
+    writeLE(file, 16, 2);
+    fwrite("data", 1, 4, file);
+    writeLE(file, dataSize, 4);
+    for (uint32_t i = 0; i < FRAME_COUNT; ++i) {
+        writeLE(file, (i * 64) & 0x3FFF, 2);
+    }
+    return fclose(file) == 0;
+}
+
+// caches add their size to the usage once they are decoded
+bool waitForMemoryUsage(uint64_t bytes) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cc::AudioEngine::getCacheStats().memoryUsage != bytes) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+class AudioCacheEvictionTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (!cc::FileUtils::getInstance()) {
+            _fileUtils = cc::createFileUtils();
+        }
+        const auto directory = std::filesystem::temp_directory_path();
+        for (const char *name : {"a", "b", "c"}) {
+            _paths.emplace_back((directory / (std::string("audio_cache_eviction_test_") + name + ".wav")).string());
+            ASSERT_TRUE(writeWav(_paths.back()));
+        }
+    }
+
+    void TearDown() override {
+        cc::AudioEngine::end();
+        for (const auto &path : _paths) {
+            remove(path.c_str());
+        }
+        delete _fileUtils;
+    }
+
+    cc::FileUtils *_fileUtils{nullptr};
+    std::vector<std::string> _paths;
+};
+
+} // namespace
+
+TEST_F(AudioCacheEvictionTest, evictsLeastRecentlyUsedUnpinnedCaches) {
+    if (!cc::AudioEngine::lazyInit()) {
+        GTEST_SKIP() << "no OpenAL device";
+    }
+    const std::string &a = _paths[0];
+    const std::string &b = _paths[1];
+    const std::string &c = _paths[2];
+    const auto initial = cc::AudioEngine::getCacheStats();
+    cc::AudioEngine::setCacheMemoryBudget(0);
+
+    // a is used first, but its player pins it
+    const int audioID = cc::AudioEngine::play2d(a, true, 0.F);
+    ASSERT_NE(audioID, cc::AudioEngine::INVALID_AUDIO_ID);
+    ASSERT_TRUE(waitForMemoryUsage(SOUND_BYTES));
+    cc::AudioEngine::preload(b);
+    ASSERT_TRUE(waitForMemoryUsage(2 * SOUND_BYTES));
+    cc::AudioEngine::preload(c);
+    ASSERT_TRUE(waitForMemoryUsage(3 * SOUND_BYTES));
+
+    // over the budget, b is the least recently used cache that isn't pinned
+    cc::AudioEngine::setCacheMemoryBudget(SOUND_BYTES * 5 / 2);
+    auto stats = cc::AudioEngine::getCacheStats();
+    EXPECT_EQ(stats.misses - initial.misses, 3);
+    EXPECT_EQ(stats.hits - initial.hits, 0);
+    EXPECT_EQ(stats.evictions - initial.evictions, 1);
+    EXPECT_EQ(stats.evictedBytes - initial.evictedBytes, SOUND_BYTES);
+    EXPECT_EQ(stats.memoryUsage, 2 * SOUND_BYTES);
+
+    cc::AudioEngine::preload(a);
+    cc::AudioEngine::preload(c);
+    stats = cc::AudioEngine::getCacheStats();
+    EXPECT_EQ(stats.hits - initial.hits, 2);
+    EXPECT_EQ(stats.misses - initial.misses, 3);
+
+    // the evicted sound misses and is decoded again
+    cc::AudioEngine::preload(b);
+    stats = cc::AudioEngine::getCacheStats();
+    EXPECT_EQ(stats.misses - initial.misses, 4);
+    ASSERT_TRUE(waitForMemoryUsage(3 * SOUND_BYTES));
+
+    // stopping the player unpins a, which is the least recently used now
+    cc::AudioEngine::stop(audioID);
+    stats = cc::AudioEngine::getCacheStats();
+    EXPECT_EQ(stats.evictions - initial.evictions, 2);
+    EXPECT_EQ(stats.evictedBytes - initial.evictedBytes, 2 * SOUND_BYTES);
+    EXPECT_EQ(stats.memoryUsage, 2 * SOUND_BYTES);
+    cc::AudioEngine::preload(c);
+    cc::AudioEngine::preload(b);
+    EXPECT_EQ(cc::AudioEngine::getCacheStats().hits - initial.hits, 4);
+}
+
+#endif
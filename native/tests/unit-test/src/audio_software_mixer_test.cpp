@@ -0,0 +1,246 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include "cocos/base/Log.h"
+#include "cocos/base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+#if CC_USE_AUDIO
+    #include "cocos/audio/common/mixer/MixerKernels.h"
+    #include "cocos/audio/common/mixer/SoftwareMixer.h"
+
+namespace {
+
+constexpr uint32_t MIX_SAMPLE_RATE = 48000;
+constexpr uint32_t VOICE_COUNT = 256;
+constexpr uint32_t RENDER_FRAMES = 512;
+constexpr uint32_t RENDER_SECONDS = 1;
+
+ccstd::vector<float> createNoise(std::mt19937 &rng, size_t count) {
+    std::uniform_real_distribution<float> sample(-1.F, 1.F);
+    ccstd::vector<float> out(count);
+    for (auto &s : out) {
+        s = sample(rng);
+    }
+    return out;
+}
+
+ccstd::vector<int16_t> toI16(const ccstd::vector<float> &in) {
+    ccstd::vector<int16_t> out(in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        out[i] = static_cast<int16_t>(std::lround(std::max(-1.F, std::min(in[i], 32767.F / 32768.F)) * 32768.F));
+    }
+    return out;
+}
+
+// per sample reference of the mixer: linear interpolation at double precision, constant volume
+void renderScalar(const ccstd::vector<cc::SoftwareMixer::TrackSource> &sources, const ccstd::vector<double> &positions,
+                  float volume, float *out, uint32_t frameCount) {
+    std::fill(out, out + frameCount * 2, 0.F);
+    for (size_t t = 0; t < sources.size(); ++t) {
+        const auto &source = sources[t];
+        const auto *data = static_cast<const int16_t *>(source.data);
+        const double step = static_cast<double>(source.sampleRate) / MIX_SAMPLE_RATE;
+        double position = positions[t];
+        for (uint32_t i = 0; i < frameCount; ++i, position += step) {
+            const auto idx = static_cast<uint32_t>(position);
+            if (idx >= source.frameCount) {
+                break;
+            }
+            const uint32_t next = std::min(idx + 1, source.frameCount - 1);
+            const auto fraction = static_cast<float>(position - idx);
+            for (uint32_t c = 0; c < 2; ++c) {
+                const uint32_t sc = source.channelCount == 1 ? 0 : c;
+                const float a = data[idx * source.channelCount + sc] / 32768.F;
+                const float b = data[next * source.channelCount + sc] / 32768.F;
+                out[2 * i + c] += (a + (b - a) * fraction) * volume;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(audioMixerKernelsTest, mixMatchesScalar) {
+    std::mt19937 rng(1);
+    constexpr uint32_t FRAMES = 37;
+    const auto mono = createNoise(rng, FRAMES);
+    const auto stereo = createNoise(rng, FRAMES * 2);
+    const auto base = createNoise(rng, FRAMES * 2);
+
+    auto out = base;
+    cc::mixer::mixMonoToStereo(out.data(), mono.data(), FRAMES, 0.25F, 0.75F, 0.01F, -0.01F);
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        EXPECT_NEAR(out[2 * i], base[2 * i] + mono[i] * (0.25F + 0.01F * i), 1e-5F);
+        EXPECT_NEAR(out[2 * i + 1], base[2 * i + 1] + mono[i] * (0.75F - 0.01F * i), 1e-5F);
+    }
+
+    out = base;
+    cc::mixer::mixStereo(out.data(), stereo.data(), FRAMES, 0.5F, 0.F, -0.005F, 0.02F);
+    for (uint32_t i = 0; i < FRAMES; ++i) {
+        EXPECT_NEAR(out[2 * i], base[2 * i] + stereo[2 * i] * (0.5F - 0.005F * i), 1e-5F);
+        EXPECT_NEAR(out[2 * i + 1], base[2 * i + 1] + stereo[2 * i + 1] * (0.02F * i), 1e-5F);
+    }
+
+    const ccstd::vector<float> loud{-2.F, -1.F, -0.5F, 0.F, 0.25F, 0.5F, 1.F, 3.F, 0.1F};
+    ccstd::vector<int16_t> pcm(loud.size());
+    cc::mixer::convertToI16(pcm.data(), loud.data(), loud.size());
+    const int16_t expected[] = {-32768, -32768, -16384, 0, 8192, 16384, 32767, 32767, 3277};
+    for (size_t i = 0; i < loud.size(); ++i) {
+        EXPECT_NEAR(pcm[i], expected[i], 1);
+    }
+}
+
+TEST(audioMixerKernelsTest, resampleMatchesScalar) {
+    std::mt19937 rng(2);
+    constexpr uint32_t IN_FRAMES = 101;
+    for (uint32_t channelCount = 1; channelCount <= 2; ++channelCount) {
+        const auto in = createNoise(rng, IN_FRAMES * channelCount);
+        for (const uint32_t inRate : {22050U, 44100U, 96000U}) {
+            const uint64_t step = (static_cast<uint64_t>(inRate) << 32) / MIX_SAMPLE_RATE;
+            ccstd::vector<float> out(1024 * channelCount);
+            uint64_t position = 0;
+            const uint32_t written = cc::mixer::resampleLinear(out.data(), 1024, in.data(), IN_FRAMES, channelCount, &position, step);
+            EXPECT_EQ(written, static_cast<uint32_t>(((static_cast<uint64_t>(IN_FRAMES) << 32) + step - 1) / step));
+            for (uint32_t i = 0; i < written; ++i) {
+                const uint64_t pos = step * i;
+                const auto idx = static_cast<uint32_t>(pos >> 32);
+                const uint32_t next = std::min(idx + 1, IN_FRAMES - 1);
+                const float fraction = static_cast<float>(pos & 0xFFFFFFFFULL) / 4294967296.F;
+                for (uint32_t c = 0; c < channelCount; ++c) {
+                    const float a = in[idx * channelCount + c];
+                    const float b = in[next * channelCount + c];
+                    EXPECT_NEAR(out[i * channelCount + c], a + (b - a) * fraction, 1e-5F);
+                }
+            }
+        }
+    }
+}
+
+TEST(softwareMixerTest, tracks) {
+    cc::SoftwareMixer mixer(MIX_SAMPLE_RATE);
+    ccstd::vector<int16_t> ones(100, 16384);
+    ccstd::vector<float> stereo(2 * 50);
+    for (uint32_t i = 0; i < 50; ++i) {
+        stereo[2 * i] = 0.25F;
+        stereo[2 * i + 1] = -0.25F;
+    }
+
+    EXPECT_EQ(mixer.addTrack({}), cc::SoftwareMixer::INVALID_TRACK);
+    const int mono = mixer.addTrack({ones.data(), 100, 1, MIX_SAMPLE_RATE, cc::SoftwareMixer::SampleFormat::I16});
+    const int looped = mixer.addTrack({stereo.data(), 50, 2, MIX_SAMPLE_RATE / 2, cc::SoftwareMixer::SampleFormat::FLOAT}, true);
+    ASSERT_NE(mono, cc::SoftwareMixer::INVALID_TRACK);
+    ASSERT_NE(looped, cc::SoftwareMixer::INVALID_TRACK);
+    mixer.setVolume(mono, 1.F, 0.5F);
+    EXPECT_EQ(mixer.getActiveTrackCount(), 2);
+
+    ccstd::vector<float> out(2 * 300);
+    mixer.render(out.data(), 300);
+    for (uint32_t i = 0; i < 300; ++i) {
+        const float left = i < 100 ? 0.5F : 0.F;
+        const float right = i < 100 ? 0.25F : 0.F;
+        EXPECT_NEAR(out[2 * i], left + 0.25F, 1e-5F);
+        EXPECT_NEAR(out[2 * i + 1], right - 0.25F, 1e-5F);
+    }
+    EXPECT_TRUE(mixer.isFinished(mono));
+    EXPECT_FALSE(mixer.isFinished(looped));
+    // 300 output frames at half rate consume 150 source frames of the 50 frame loop
+    EXPECT_EQ(mixer.getPosition(looped), 0);
+
+    // ramp the looped track down to silence over 100 frames
+    mixer.removeTrack(mono);
+    mixer.setVolume(looped, 0.F, 0.F, 100);
+    ccstd::vector<int16_t> pcm(2 * 200);
+    mixer.render(pcm.data(), 200);
+    EXPECT_NEAR(pcm[0], 8192, 1);
+    EXPECT_NEAR(pcm[2 * 50], 4096, 2);
+    EXPECT_EQ(pcm[2 * 100], 0);
+    EXPECT_EQ(pcm[2 * 199 + 1], 0);
+
+    mixer.setPaused(looped, true);
+    EXPECT_EQ(mixer.getActiveTrackCount(), 1);
+    const int reused = mixer.addTrack({ones.data(), 100, 1, MIX_SAMPLE_RATE, cc::SoftwareMixer::SampleFormat::I16});
+    EXPECT_EQ(reused, mono);
+}
+
+TEST(softwareMixerBenchmark, voices) {
+    std::mt19937 rng(3);
+    const uint32_t sampleRates[] = {22050, 44100, 48000, 32000};
+    ccstd::vector<ccstd::vector<int16_t>> pcm;
+    ccstd::vector<cc::SoftwareMixer::TrackSource> sources;
+    pcm.reserve(VOICE_COUNT);
+    for (uint32_t v = 0; v < VOICE_COUNT; ++v) {
+        const uint32_t channelCount = 1 + v % 2;
+        const uint32_t sampleRate = sampleRates[v % 4];
+        pcm.emplace_back(toI16(createNoise(rng, static_cast<size_t>(sampleRate) * RENDER_SECONDS * channelCount + channelCount)));
+        sources.push_back({pcm.back().data(), sampleRate * RENDER_SECONDS + 1, channelCount, sampleRate, cc::SoftwareMixer::SampleFormat::I16});
+    }
+
+    constexpr float VOLUME = 1.F / VOICE_COUNT;
+    cc::SoftwareMixer mixer(MIX_SAMPLE_RATE);
+    for (const auto &source : sources) {
+        mixer.setVolume(mixer.addTrack(source), VOLUME, VOLUME);
+    }
+
+    constexpr uint32_t BLOCK_COUNT = MIX_SAMPLE_RATE * RENDER_SECONDS / RENDER_FRAMES;
+    ccstd::vector<float> expected(2 * RENDER_FRAMES);
+    ccstd::vector<float> out(2 * RENDER_FRAMES);
+    ccstd::vector<double> positions(VOICE_COUNT, 0.0);
+
+    // the first block must match the per sample reference
+    renderScalar(sources, positions, VOLUME, expected.data(), RENDER_FRAMES);
+    mixer.render(out.data(), RENDER_FRAMES);
+    for (uint32_t i = 0; i < 2 * RENDER_FRAMES; ++i) {
+        EXPECT_NEAR(out[i], expected[i], 1e-4F);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t block = 0; block < BLOCK_COUNT; ++block) {
+        renderScalar(sources, positions, VOLUME, expected.data(), RENDER_FRAMES);
+        for (uint32_t v = 0; v < VOICE_COUNT; ++v) {
+            positions[v] += static_cast<double>(RENDER_FRAMES) * sources[v].sampleRate / MIX_SAMPLE_RATE;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double scalar = std::chrono::duration<double, std::milli>(end - start).count();
+
+    for (uint32_t v = 0; v < VOICE_COUNT; ++v) {
+        mixer.setPosition(static_cast<int>(v), 0);
+    }
+    start = std::chrono::steady_clock::now();
+    for (uint32_t block = 0; block < BLOCK_COUNT; ++block) {
+        mixer.render(out.data(), RENDER_FRAMES);
+    }
+    end = std::chrono::steady_clock::now();
+    const double mixed = std::chrono::duration<double, std::milli>(end - start).count();
+
+    CC_LOG_INFO("software mixer %u voices, %u s of audio: scalar %.3f ms, mixer %.3f ms", VOICE_COUNT, RENDER_SECONDS, scalar, mixed);
+    EXPECT_GT(scalar, 0.0);
+    EXPECT_GT(mixed, 0.0);
+}
+
+#endif
@@ -0,0 +1,104 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "cocos/base/Macros.h"
+#include "gtest/gtest.h"
+
+#if CC_USE_AUDIO && (CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX || CC_PLATFORM == CC_PLATFORM_QNX)
+    #include "cocos/audio/oalsoft/AudioPlayer.h"
+    #include "cocos/audio/oalsoft/AudioStreamer.h"
+
+namespace {
+
+// a player without a source or cache, exposing the flags shared with the streamer
+class StreamedPlayer : public cc::AudioPlayer {
+public:
+    StreamedPlayer() { _alSource = 0; }
+
+    using cc::AudioPlayer::_isStreamAdded;
+    using cc::AudioPlayer::_isStreamReleased;
+};
+
+bool waitForRelease(const StreamedPlayer &player) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!player._isStreamReleased.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// commands of one producer are dequeued in order, so the commands enqueued
+// by this thread before are processed once the marker is released
+void waitForCommands(cc::AudioStreamer &streamer) {
+    StreamedPlayer marker;
+    streamer.removeVoice(&marker);
+    ASSERT_TRUE(waitForRelease(marker));
+}
+
+} // namespace
+
+TEST(AudioStreamerTest, removeBeforeLateAdd) {
+    cc::AudioStreamer streamer;
+    streamer.start();
+
+    // play2d on the cache loading task has flagged the player, but its ADD isn't dequeued yet
+    StreamedPlayer player;
+    player._isStreamAdded.store(true, std::memory_order_release);
+    streamer.removeVoice(&player);
+    waitForCommands(streamer);
+    EXPECT_FALSE(player._isStreamReleased.load(std::memory_order_acquire));
+
+    // the late ADD from another thread cancels the removal instead of opening a voice,
+    // which would dereference the missing cache
+    std::thread loader([&]() {
+        EXPECT_TRUE(streamer.addVoice(&player, 0));
+    });
+    loader.join();
+    EXPECT_TRUE(waitForRelease(player));
+    streamer.stop();
+}
+
+TEST(AudioStreamerTest, stopReleasesPendingRemovals) {
+    cc::AudioStreamer streamer;
+    streamer.start();
+
+    StreamedPlayer player;
+    player._isStreamAdded.store(true, std::memory_order_release);
+    streamer.removeVoice(&player);
+    waitForCommands(streamer);
+    EXPECT_FALSE(player._isStreamReleased.load(std::memory_order_acquire));
+
+    // the ADD never arrives, stopping must not leave destroy() waiting forever
+    streamer.stop();
+    EXPECT_TRUE(player._isStreamReleased.load(std::memory_order_acquire));
+    EXPECT_FALSE(streamer.addVoice(&player, 0));
+}
+
+#endif
@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "batcher2d_test_utils.h"
+#include "cocos/2d/renderer/Batcher2d.h"
+#include "cocos/core/Root.h"
+#include "cocos/math/Vec4.h"
+#include "cocos/scene/Pass.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace batcher2dtest;
+
+class Batcher2dIncrementalBatchingTest : public Batcher2dTest {
+protected:
+    void SetUp() override {
+        Batcher2dTest::SetUp();
+        _res.materials[0] = createMaterial("batcher2d-test-tinted-sprite", 4, true);
+    }
+
+    // the next frame sees no vertex data written by JS, as after Batcher2d::uploadBuffers
+    static void endFrame(UIScene &ui) {
+        Node::resetChangedFlags();
+        ui.meshBuffer.setDirty(false);
+    }
+};
+
+TEST_F(Batcher2dIncrementalBatchingTest, uploadsMaterialUniformsOfReusedRoots) {
+    Batcher2d batcher(Root::getInstance());
+    UIScene ui;
+    buildUIScene(ui, batcher, _res, false);
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), 0U);
+
+    // a uniform set from script keeps the material hash, so the roots stay cached
+    auto *material = _res.materials[0].get();
+    const auto hash = material->getHash();
+    const auto &passes = *material->getPasses();
+    ASSERT_FALSE(passes.empty());
+    endFrame(ui);
+    material->setPropertyVec4(TINT_UNIFORM, Vec4(1.F, 0.5F, 0.25F, 1.F));
+    EXPECT_EQ(material->getHash(), hash);
+    EXPECT_TRUE(passes[0]->isRootBufferDirty());
+
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+    EXPECT_FALSE(passes[0]->isRootBufferDirty());
+}
+
+TEST_F(Batcher2dIncrementalBatchingTest, reusesUnchangedRootsAfterMaterialChange) {
+    Batcher2d batcher(Root::getInstance());
+    Batcher2d referenceBatcher(Root::getInstance());
+    referenceBatcher.setIncrementalBatchingEnabled(false);
+    UIScene ui;
+    UIScene reference;
+    buildUIScene(ui, batcher, _res, false);
+    buildUIScene(reference, referenceBatcher, _res, false);
+
+    runFrame(batcher, ui);
+    runFrame(referenceBatcher, reference);
+    expectSameBatches(reference, ui);
+    endFrame(ui);
+    endFrame(reference);
+
+    runFrame(batcher, ui);
+    runFrame(referenceBatcher, reference);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+    EXPECT_EQ(referenceBatcher.getReusedRootNodeCount(), 0U);
+    expectSameBatches(reference, ui);
+    endFrame(ui);
+    endFrame(reference);
+
+    // a node of the second root switches material, only that root is batched again
+    const uint32_t changed = CHILD_COUNT + 2;
+    getDrawInfo(ui, changed)->setMaterial(_res.materials[1]);
+    getDrawInfo(reference, changed)->setMaterial(_res.materials[1]);
+    runFrame(batcher, ui);
+    runFrame(referenceBatcher, reference);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT - 1);
+    expectSameBatches(reference, ui);
+    endFrame(ui);
+    endFrame(reference);
+
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+}
+
+TEST_F(Batcher2dIncrementalBatchingTest, invalidatesOnMeshBufferChange) {
+    Batcher2d batcher(Root::getInstance());
+    UIScene ui;
+    buildUIScene(ui, batcher, _res, false);
+    runFrame(batcher, ui);
+    endFrame(ui);
+
+    // syncing the same buffers again, as middleware does every frame, keeps the caches
+    batcher.syncMeshBuffersToNative(0, {&ui.meshBuffer});
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+    endFrame(ui);
+
+    // vertex data written by JS
+    ui.meshBuffer.setDirty(true);
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), 0U);
+    endFrame(ui);
+
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+    endFrame(ui);
+
+    // a new buffer list drops every cache
+    UIMeshBuffer extraBuffer;
+    extraBuffer.initialize(ccstd::vector<gfx::Attribute>(*batcher.getDefaultAttribute()), true);
+    batcher.syncMeshBuffersToNative(0, {&ui.meshBuffer, &extraBuffer});
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), 0U);
+    endFrame(ui);
+
+    runFrame(batcher, ui);
+    EXPECT_EQ(batcher.getReusedRootNodeCount(), ROOT_COUNT);
+    batcher.syncMeshBuffersToNative(0, {&ui.meshBuffer});
+}
@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include "batcher2d_test_utils.h"
+#include "cocos/2d/renderer/Batcher2d.h"
+#include "cocos/core/Root.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+using namespace batcher2dtest;
+
+class Batcher2dParallelWalkTest : public Batcher2dTest {
+protected:
+    // runs a frame, moves one root and runs another, the batchers have to agree after both
+    void expectParallelMatchesSerial(bool withMasks) {
+        Batcher2d serialBatcher(Root::getInstance());
+        Batcher2d parallelBatcher(Root::getInstance());
+        serialBatcher.setParallelWalkEnabled(false);
+        parallelBatcher.setParallelWalkEnabled(true);
+
+        UIScene serial;
+        UIScene parallel;
+        buildUIScene(serial, serialBatcher, _res, withMasks);
+        buildUIScene(parallel, parallelBatcher, _res, withMasks);
+
+        runFrame(serialBatcher, serial);
+        runFrame(parallelBatcher, parallel);
+        EXPECT_FALSE(serial.batches.empty());
+        expectSameResults(serial, parallel);
+        EXPECT_EQ(serialBatcher.getReusedRootNodeCount(), parallelBatcher.getReusedRootNodeCount());
+        if (withMasks) {
+            const auto masked = std::count_if(serial.batches.begin(), serial.batches.end(), [](const BatchInfo &batch) { return batch.stencilTest != 0; });
+            const auto clears = std::count_if(serial.batches.begin(), serial.batches.end(), [](const BatchInfo &batch) { return batch.maskClear; });
+            EXPECT_GT(masked, 0);
+            EXPECT_EQ(clears, 2);
+        }
+
+        // move one root, the others may reuse their batches in both modes
+        Node::resetChangedFlags();
+        serial.rootNodes[1]->setPosition(-5.F, 7.F, 0.F);
+        parallel.rootNodes[1]->setPosition(-5.F, 7.F, 0.F);
+        runFrame(serialBatcher, serial);
+        runFrame(parallelBatcher, parallel);
+        expectSameResults(serial, parallel);
+        EXPECT_EQ(serialBatcher.getReusedRootNodeCount(), parallelBatcher.getReusedRootNodeCount());
+    }
+};
+
+TEST_F(Batcher2dParallelWalkTest, matchesSerialWalk) {
+    expectParallelMatchesSerial(false);
+}
+
+TEST_F(Batcher2dParallelWalkTest, matchesSerialWalkWithMasks) {
+    expectParallelMatchesSerial(true);
+}
@@ -0,0 +1,268 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include "batcher2d_test_utils.h"
+#include "cocos/application/ApplicationManager.h"
+#include "cocos/bindings/jswrapper/SeApi.h"
+#include "cocos/core/Root.h"
+#include "cocos/core/assets/EffectAsset.h"
+#include "cocos/core/builtin/BuiltinResMgr.h"
+#include "cocos/renderer/core/ProgramLib.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/scene/DrawBatch2D.h"
+#include "cocos/scene/Pass.h"
+#include "cocos/scene/RenderScene.h"
+
+using namespace cc;
+
+namespace batcher2dtest {
+
+const char *const TINT_UNIFORM = "tint";
+
+namespace {
+
+constexpr uint16_t QUAD_INDICES[INDEX_COUNT] = {0, 1, 2, 1, 3, 2};
+
+EntityAttrLayout *getEntityAttrs(RenderEntity *entity) {
+    uint8_t *data{nullptr};
+    size_t length{0};
+    entity->getEntitySharedBufferForJS()->getArrayBufferData(&data, &length);
+    return reinterpret_cast<EntityAttrLayout *>(data);
+}
+
+void addQuad(UIScene &ui, const UIResources &res, Node *node, MaskMode maskMode) {
+    const auto index = static_cast<uint32_t>(ui.nodes.size());
+    ui.nodes.emplace_back(node);
+    node->setPosition(static_cast<float>(index % 5) * 10.F, static_cast<float>(index % 3) * 20.F, 0.F);
+    node->setScale(1.F + static_cast<float>(index % 2), 1.F, 1.F);
+    node->setActiveInHierarchy(index % 11 != 10);
+
+    auto *entity = ccnew RenderEntity(RenderEntityType::STATIC);
+    entity->setNode(node);
+    entity->setStaticDrawInfoSize(1);
+    auto *attrs = getEntityAttrs(entity);
+    attrs->enabledIndex = 1;
+    attrs->maskMode = static_cast<uint8_t>(maskMode);
+    attrs->localOpacity = index % 7 == 6 ? 0.F : 1.F - static_cast<float>(index % 4) * 0.2F;
+    attrs->colorR = static_cast<uint8_t>(index * 13);
+    attrs->colorG = static_cast<uint8_t>(index * 29);
+
+    float *layout = ui.layouts.data() + index * VERTEX_COUNT * STRIDE;
+    for (uint32_t v = 0; v < VERTEX_COUNT; ++v) {
+        auto *vertex = reinterpret_cast<Render2dLayout *>(layout + v * STRIDE);
+        vertex->position.set(static_cast<float>(v & 1U), static_cast<float>(v >> 1U), 0.F);
+    }
+    uint16_t *quadIndices = ui.indices.data() + index * INDEX_COUNT;
+    for (uint32_t i = 0; i < INDEX_COUNT; ++i) {
+        quadIndices[i] = static_cast<uint16_t>(QUAD_INDICES[i] + index * VERTEX_COUNT);
+    }
+
+    // the data hash stands for material and texture, like the hash of a sprite
+    const uint32_t kind = index % 3;
+    auto *drawInfo = entity->getStaticRenderDrawInfo(0);
+    drawInfo->setDrawInfoType(static_cast<uint32_t>(RenderDrawInfoType::COMP));
+    drawInfo->setMeshBuffer(&ui.meshBuffer);
+    drawInfo->setVbBuffer(ui.vData.data() + index * VERTEX_COUNT * STRIDE);
+    drawInfo->setIbBuffer(quadIndices);
+    drawInfo->setIDataBuffer(ui.iData.data());
+    drawInfo->setVbCount(VERTEX_COUNT);
+    drawInfo->setIbCount(INDEX_COUNT);
+    drawInfo->setStride(STRIDE);
+    drawInfo->setDataHash(1 + kind);
+    drawInfo->setMaterial(res.materials[kind == 2 ? 1 : 0]);
+    drawInfo->setTexture(res.textures[kind % 2]);
+    drawInfo->setSampler(res.sampler);
+    drawInfo->setRender2dBufferToNative(reinterpret_cast<uint8_t *>(layout));
+    drawInfo->setVertDirty(true);
+}
+
+void captureBatches(UIScene &ui) {
+    ui.batches.clear();
+    for (const auto *batch : ui.scene->getRenderScene()->getBatches()) {
+        BatchInfo info;
+        info.firstIndex = batch->getDrawInfo().firstIndex;
+        info.indexCount = batch->getDrawInfo().indexCount;
+        info.visFlags = batch->getVisFlags();
+        info.maskClear = batch->getModel() != nullptr;
+        if (!info.maskClear && batch->getDescriptorSet()) {
+            info.texture = batch->getDescriptorSet()->getTexture(static_cast<uint32_t>(pipeline::ModelLocalBindings::SAMPLER_SPRITE));
+        }
+        const auto &passes = batch->getPasses();
+        if (!passes.empty()) {
+            const auto *dss = passes[0]->getDepthStencilState();
+            info.program = passes[0]->getProgram();
+            info.stencilTest = dss->stencilTestFront;
+            info.stencilFunc = dss->stencilFuncFront;
+            info.stencilPassOp = dss->stencilPassOpFront;
+            info.stencilRef = dss->stencilRefFront;
+        }
+        ui.batches.emplace_back(info);
+    }
+}
+
+} // namespace
+
+Material *createMaterial(const ccstd::string &name, ccstd::hash_t hash, bool withUniform) {
+    IShaderInfo shader;
+    shader.name = name;
+    shader.hash = hash;
+    if (withUniform) {
+        IBlockInfo block;
+        block.binding = 0;
+        block.name = "TestParams";
+        block.members = {{TINT_UNIFORM, gfx::Type::FLOAT4, 1}};
+        block.stageFlags = gfx::ShaderStageFlagBit::FRAGMENT;
+        shader.blocks = {block};
+    }
+    ITechniqueInfo technique;
+    technique.passes.emplace_back();
+    technique.passes.back().program = name;
+
+    auto *effect = ccnew EffectAsset();
+    effect->setName(name);
+    effect->setShaders({shader});
+    effect->setTechniques({technique});
+    ProgramLib::getInstance()->registerEffect(effect);
+    EffectAsset::registerAsset(effect);
+
+    auto *material = ccnew Material();
+    IMaterialInfo info;
+    info.effectAsset = effect;
+    material->initialize(info);
+    return material;
+}
+
+void buildUIScene(UIScene &ui, Batcher2d &batcher, const UIResources &res, bool withMasks) {
+    ui.meshBuffer.initialize(ccstd::vector<gfx::Attribute>(*batcher.getDefaultAttribute()), true);
+    ui.meshBuffer.setVData(ui.vData.data());
+    ui.meshBuffer.setIData(ui.iData.data());
+    ui.meshBuffer.setByteOffset(static_cast<uint32_t>(ui.vData.size() * sizeof(float)));
+    batcher.syncMeshBuffersToNative(0, {&ui.meshBuffer});
+
+    const auto maskModeOf = [withMasks](uint32_t index) {
+        if (!withMasks) return MaskMode::NONE;
+        if (index == MASK_NODE) return MaskMode::MASK;
+        if (index == INVERTED_MASK_NODE) return MaskMode::MASK_INVERTED;
+        return MaskMode::NONE;
+    };
+
+    ui.scene = ccnew Scene("ui");
+    ui.scene->setActiveInHierarchy(true);
+    for (uint32_t r = 0; r < ROOT_COUNT; ++r) {
+        auto *root = ccnew Node("root");
+        root->setParent(ui.scene);
+        addQuad(ui, res, root, maskModeOf(static_cast<uint32_t>(ui.nodes.size())));
+        ui.rootNodes.emplace_back(root);
+        Node *parent = root;
+        for (uint32_t c = 0; c < CHILD_COUNT; ++c) {
+            auto *child = ccnew Node("child");
+            // alternate between siblings and deeper levels
+            child->setParent(c % 2 ? parent : root);
+            addQuad(ui, res, child, maskModeOf(static_cast<uint32_t>(ui.nodes.size())));
+            parent = child;
+        }
+    }
+    ui.scene->load();
+    batcher.syncRootNodesToNative(ccstd::vector<Node *>(ui.rootNodes));
+}
+
+RenderDrawInfo *getDrawInfo(const UIScene &ui, uint32_t nodeIndex) {
+    return static_cast<RenderEntity *>(ui.nodes[nodeIndex]->getUserData())->getRenderDrawInfoAt(0);
+}
+
+void runFrame(Batcher2d &batcher, UIScene &ui) {
+    ui.meshBuffer.setIndexOffset(0);
+    batcher.update();
+    captureBatches(ui);
+    ui.scene->getRenderScene()->removeBatches();
+    batcher.reset();
+}
+
+void expectSameBatches(const UIScene &expected, const UIScene &actual) {
+    ASSERT_EQ(expected.batches.size(), actual.batches.size());
+    for (size_t i = 0; i < expected.batches.size(); ++i) {
+        const auto &e = expected.batches[i];
+        const auto &a = actual.batches[i];
+        EXPECT_EQ(e.program, a.program) << "batch " << i;
+        EXPECT_EQ(e.texture, a.texture) << "batch " << i;
+        EXPECT_EQ(e.firstIndex, a.firstIndex) << "batch " << i;
+        EXPECT_EQ(e.indexCount, a.indexCount) << "batch " << i;
+        EXPECT_EQ(e.visFlags, a.visFlags) << "batch " << i;
+        EXPECT_EQ(e.maskClear, a.maskClear) << "batch " << i;
+        EXPECT_EQ(e.stencilTest, a.stencilTest) << "batch " << i;
+        EXPECT_EQ(e.stencilFunc, a.stencilFunc) << "batch " << i;
+        EXPECT_EQ(e.stencilPassOp, a.stencilPassOp) << "batch " << i;
+        EXPECT_EQ(e.stencilRef, a.stencilRef) << "batch " << i;
+    }
+}
+
+void expectSameResults(const UIScene &expected, const UIScene &actual) {
+    ASSERT_EQ(expected.vData.size(), actual.vData.size());
+    for (size_t i = 0; i < expected.vData.size(); ++i) {
+        EXPECT_FLOAT_EQ(expected.vData[i], actual.vData[i]) << "vertex float " << i;
+    }
+    EXPECT_EQ(expected.iData, actual.iData);
+    EXPECT_EQ(expected.meshBuffer.getIndexOffset(), actual.meshBuffer.getIndexOffset());
+    for (size_t i = 0; i < expected.nodes.size(); ++i) {
+        auto *expectedEntity = static_cast<RenderEntity *>(expected.nodes[i]->getUserData());
+        auto *actualEntity = static_cast<RenderEntity *>(actual.nodes[i]->getUserData());
+        EXPECT_FLOAT_EQ(expectedEntity->getOpacity(), actualEntity->getOpacity()) << "node " << i;
+        EXPECT_EQ(expectedEntity->getRenderDrawInfoAt(0)->getVertDirty(), actualEntity->getRenderDrawInfoAt(0)->getVertDirty());
+        EXPECT_EQ(expectedEntity->getEnumStencilStage(), actualEntity->getEnumStencilStage()) << "node " << i;
+    }
+    expectSameBatches(expected, actual);
+}
+
+void Batcher2dTest::SetUp() {
+    auto *root = Root::getInstance();
+    if (!root->getPipeline()) {
+        root->setRenderPipeline(ccnew HeadlessPipeline());
+    }
+    if (!CC_CURRENT_APPLICATION()) {
+        CC_APPLICATION_MANAGER()->createApplication<TestApplication>(0, nullptr);
+        _ownsApplication = true;
+    }
+
+    _res.materials[0] = createMaterial("batcher2d-test-sprite", 1);
+    _res.materials[1] = createMaterial("batcher2d-test-graphics", 2);
+    if (!BuiltinResMgr::getInstance()->get<Material>("default-clear-stencil")) {
+        BuiltinResMgr::getInstance()->addAsset("default-clear-stencil", createMaterial("batcher2d-test-clear-stencil", 3));
+    }
+
+    auto *device = root->getDevice();
+    for (auto *&texture : _res.textures) {
+        texture = device->createTexture({gfx::TextureType::TEX2D, gfx::TextureUsageBit::SAMPLED, gfx::Format::RGBA8, 4, 4});
+    }
+    _res.sampler = device->getSampler({});
+}
+
+void Batcher2dTest::TearDown() {
+    for (auto *&texture : _res.textures) {
+        CC_SAFE_DESTROY_AND_DELETE(texture);
+    }
+    if (_ownsApplication) {
+        CC_APPLICATION_MANAGER()->releaseAllApplications();
+    }
+}
+
+} // namespace batcher2dtest
@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include "cocos/2d/renderer/Batcher2d.h"
+#include "cocos/application/BaseApplication.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/assets/Material.h"
+#include "cocos/core/scene-graph/Scene.h"
+#include "cocos/renderer/pipeline/PipelineSceneData.h"
+#include "cocos/renderer/pipeline/RenderPipeline.h"
+#include "gtest/gtest.h"
+
+// a small UI scene and the engine state Batcher2d needs to turn it into DrawBatch2Ds without a real pipeline
+namespace batcher2dtest {
+
+constexpr uint32_t ROOT_COUNT = 4;
+constexpr uint32_t CHILD_COUNT = 6;
+constexpr uint32_t VERTEX_COUNT = 4;
+constexpr uint32_t INDEX_COUNT = 6;
+constexpr uint32_t STRIDE = sizeof(cc::Render2dLayout) / sizeof(float);
+constexpr uint32_t NODE_COUNT = ROOT_COUNT * (CHILD_COUNT + 1);
+// nodes of the second and third root whose next sibling in the chain is their child
+constexpr uint32_t MASK_NODE = 8;
+constexpr uint32_t INVERTED_MASK_NODE = 17;
+// the vec4 uniform of materials created with a uniform block
+extern const char *const TINT_UNIFORM;
+
+// sub models of the mask clear model need a pipeline, its scene data is all they read
+class HeadlessPipeline final : public cc::pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew cc::pipeline::PipelineSceneData();
+    }
+};
+
+// the batcher stamps the mask clear model with the frame count of the current engine
+class FrameCountEngine final : public cc::BaseEngine {
+public:
+    int32_t init() override { return 0; }
+    int32_t run() override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    int restart() override { return 0; }
+    void close() override {}
+    uint getTotalFrames() const override { return 1; }
+    void setPreferredFramesPerSecond(int /*fps*/) override {}
+    SchedulerPtr getScheduler() const override { return nullptr; }
+    bool isInited() const override { return true; }
+};
+
+class TestApplication final : public cc::BaseApplication {
+public:
+    int32_t init() override { return 0; }
+    int32_t run(int /*argc*/, const char ** /*argv*/) override { return 0; }
+    void pause() override {}
+    void resume() override {}
+    void restart() override {}
+    void close() override {}
+    cc::BaseEngine::Ptr getEngine() const override { return _engine; }
+    const std::vector<std::string> &getArguments() const override { return _arguments; }
+
+protected:
+    void setArgumentsInternal(int /*argc*/, const char * /*argv*/[]) override {}
+
+private:
+    cc::BaseEngine::Ptr _engine{std::make_shared<FrameCountEngine>()};
+    std::vector<std::string> _arguments;
+};
+
+// what the render pipeline sees of a DrawBatch2D, the batchers own different pools and descriptor sets
+struct BatchInfo {
+    ccstd::string program;
+    cc::gfx::Texture *texture{nullptr};
+    uint32_t firstIndex{0};
+    uint32_t indexCount{0};
+    uint32_t visFlags{0};
+    bool maskClear{false};
+    uint32_t stencilTest{0};
+    cc::gfx::ComparisonFunc stencilFunc{cc::gfx::ComparisonFunc::ALWAYS};
+    cc::gfx::StencilOp stencilPassOp{cc::gfx::StencilOp::KEEP};
+    uint32_t stencilRef{0};
+};
+
+// the materials, textures and samplers shared by the scenes of one test
+struct UIResources {
+    cc::IntrusivePtr<cc::Material> materials[2];
+    cc::gfx::Texture *textures[2]{};
+    cc::gfx::Sampler *sampler{nullptr};
+};
+
+// a UI scene with one quad per node
+struct UIScene {
+    cc::IntrusivePtr<cc::Scene> scene;
+    ccstd::vector<cc::Node *> nodes;
+    ccstd::vector<cc::Node *> rootNodes;
+    ccstd::vector<float> vData = ccstd::vector<float>(NODE_COUNT * VERTEX_COUNT * STRIDE, 0.F);
+    ccstd::vector<uint16_t> iData = ccstd::vector<uint16_t>(NODE_COUNT * INDEX_COUNT, 0);
+    ccstd::vector<float> layouts = ccstd::vector<float>(NODE_COUNT * VERTEX_COUNT * STRIDE, 0.F);
+    ccstd::vector<uint16_t> indices = ccstd::vector<uint16_t>(NODE_COUNT * INDEX_COUNT, 0);
+    cc::UIMeshBuffer meshBuffer;
+    ccstd::vector<BatchInfo> batches;
+};
+
+// one pass of an empty program, enough for the batcher to fill the passes and stencil states of its batches,
+// withUniform adds a material uniform block holding TINT_UNIFORM
+cc::Material *createMaterial(const ccstd::string &name, ccstd::hash_t hash, bool withUniform = false);
+
+void buildUIScene(UIScene &ui, cc::Batcher2d &batcher, const UIResources &res, bool withMasks);
+cc::RenderDrawInfo *getDrawInfo(const UIScene &ui, uint32_t nodeIndex);
+void runFrame(cc::Batcher2d &batcher, UIScene &ui);
+void expectSameBatches(const UIScene &expected, const UIScene &actual);
+void expectSameResults(const UIScene &expected, const UIScene &actual);
+
+// installs the pipeline, application, materials and textures a batcher needs
+class Batcher2dTest : public testing::Test {
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    UIResources _res;
+    bool _ownsApplication{false};
+};
+
+} // namespace batcher2dtest
@@ -0,0 +1,249 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/TransformSolver.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t BRANCHING = 3;
+constexpr uint32_t DEPTH = 5;
+
+// two identical hierarchies, one resolved by the solver and one by Node::updateWorldTransform
+struct Hierarchy {
+    IntrusivePtr<Node> root;
+    ccstd::vector<Node *> nodes;
+};
+
+void buildHierarchy(Hierarchy &hierarchy) {
+    hierarchy.root = ccnew Node("root");
+    hierarchy.nodes.clear();
+    hierarchy.nodes.emplace_back(hierarchy.root.get());
+    uint32_t levelBegin = 0;
+    for (uint32_t depth = 1; depth < DEPTH; ++depth) {
+        const auto levelEnd = static_cast<uint32_t>(hierarchy.nodes.size());
+        for (uint32_t i = levelBegin; i < levelEnd; ++i) {
+            for (uint32_t c = 0; c < BRANCHING; ++c) {
+                auto *child = ccnew Node();
+                child->setParent(hierarchy.nodes[i]);
+                hierarchy.nodes.emplace_back(child);
+            }
+        }
+        levelBegin = levelEnd;
+    }
+}
+
+void setLocalTransform(Node *node, uint32_t index, uint32_t frame) {
+    const auto t = static_cast<float>(index + frame);
+    node->setPosition(t * 0.1F, 1.F - t * 0.05F, 0.5F);
+    node->setRotationFromEuler(t * 3.F, t * 7.F, t * 11.F);
+    node->setScale(1.F + static_cast<float>(index % 3) * 0.5F, 1.F, 0.75F);
+}
+
+void expectSameWorldTransforms(const Hierarchy &expected, const Hierarchy &actual) {
+    ASSERT_EQ(expected.nodes.size(), actual.nodes.size());
+    for (size_t i = 0; i < expected.nodes.size(); ++i) {
+        // the solver has to leave every node up to date
+        EXPECT_FALSE(actual.nodes[i]->isTransformDirty());
+        EXPECT_TRUE(expected.nodes[i]->getWorldMatrix().approxEquals(actual.nodes[i]->getWorldMatrix()));
+        EXPECT_TRUE(expected.nodes[i]->getWorldPosition().approxEquals(actual.nodes[i]->getWorldPosition()));
+        EXPECT_TRUE(expected.nodes[i]->getWorldScale().approxEquals(actual.nodes[i]->getWorldScale()));
+    }
+}
+
+} // namespace
+
+TEST(TransformSolverTest, matchesRecursiveUpdate) {
+    Hierarchy expected;
+    Hierarchy actual;
+    buildHierarchy(expected);
+    buildHierarchy(actual);
+    for (uint32_t i = 0; i < expected.nodes.size(); ++i) {
+        setLocalTransform(expected.nodes[i], i, 0);
+        setLocalTransform(actual.nodes[i], i, 0);
+    }
+
+    TransformSolver solver;
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getNodeCount(), actual.nodes.size());
+    EXPECT_EQ(solver.getLevelCount(), DEPTH);
+    EXPECT_EQ(solver.getUpdatedNodeCount(), actual.nodes.size());
+    EXPECT_EQ(solver.getVisitedNodeCount(), actual.nodes.size());
+    expectSameWorldTransforms(expected, actual);
+
+    // nothing dirty, nothing walked
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getUpdatedNodeCount(), 0);
+    EXPECT_EQ(solver.getVisitedNodeCount(), 0);
+
+    // a dirty subtree updates the subtree only
+    Node *subtreeRoot = actual.nodes[1];
+    expected.nodes[1]->setPosition(3.F, 2.F, 1.F);
+    subtreeRoot->setPosition(3.F, 2.F, 1.F);
+    solver.solve(actual.root);
+    const uint32_t subtreeSize = 1 + BRANCHING + BRANCHING * BRANCHING + BRANCHING * BRANCHING * BRANCHING;
+    EXPECT_EQ(solver.getUpdatedNodeCount(), subtreeSize);
+    EXPECT_EQ(solver.getVisitedNodeCount(), subtreeSize);
+    expectSameWorldTransforms(expected, actual);
+}
+
+TEST(TransformSolverTest, walksDirtySubtreesOnly) {
+    Hierarchy expected;
+    Hierarchy actual;
+    buildHierarchy(expected);
+    buildHierarchy(actual);
+
+    TransformSolver solver;
+    solver.solve(actual.root);
+
+    // a clean sibling between two dirty leaves, and a dirty node under a dirty ancestor
+    const uint32_t leafBegin = static_cast<uint32_t>(actual.nodes.size()) - BRANCHING * BRANCHING;
+    const std::vector<uint32_t> dirtyIndices{leafBegin, leafBegin + 2, 2, 2 + BRANCHING * 2};
+    for (const uint32_t i : dirtyIndices) {
+        setLocalTransform(expected.nodes[i], i, 2);
+        setLocalTransform(actual.nodes[i], i, 2);
+    }
+    solver.solve(actual.root);
+    const uint32_t subtreeSize = 1 + BRANCHING + BRANCHING * BRANCHING + BRANCHING * BRANCHING * BRANCHING;
+    EXPECT_EQ(solver.getVisitedNodeCount(), 2 + subtreeSize);
+    EXPECT_EQ(solver.getUpdatedNodeCount(), 2 + subtreeSize);
+    expectSameWorldTransforms(expected, actual);
+
+    // a node resolved on demand leaves the rest of its dirty subtree to the solver
+    Node *subtreeRoot = actual.nodes[3];
+    expected.nodes[3]->setScale(2.F, 2.F, 2.F);
+    subtreeRoot->setScale(2.F, 2.F, 2.F);
+    subtreeRoot->updateWorldTransform();
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getVisitedNodeCount(), subtreeSize);
+    EXPECT_EQ(solver.getUpdatedNodeCount(), subtreeSize - 1);
+    expectSameWorldTransforms(expected, actual);
+
+    // the dirty roots of another hierarchy are ignored
+    expected.nodes[4]->setPosition(1.F, 1.F, 1.F);
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getVisitedNodeCount(), 0);
+}
+
+TEST(TransformSolverTest, keepsDirtyRootsPerSolver) {
+    Hierarchy expected;
+    Hierarchy first;
+    Hierarchy second;
+    buildHierarchy(expected);
+    buildHierarchy(first);
+    buildHierarchy(second);
+
+    TransformSolver firstSolver;
+    TransformSolver secondSolver;
+    firstSolver.solve(first.root);
+    secondSolver.solve(second.root);
+    const uint32_t subtreeSize = 1 + BRANCHING + BRANCHING * BRANCHING + BRANCHING * BRANCHING * BRANCHING;
+
+    // the second solver runs first, the dirty roots of the first hierarchy are kept for the first solver
+    expected.nodes[1]->setPosition(1.F, 2.F, 3.F);
+    first.nodes[1]->setPosition(1.F, 2.F, 3.F);
+    secondSolver.solve(second.root);
+    EXPECT_EQ(secondSolver.getVisitedNodeCount(), 0);
+    firstSolver.solve(first.root);
+    EXPECT_EQ(firstSolver.getVisitedNodeCount(), subtreeSize);
+    expectSameWorldTransforms(expected, first);
+
+    // a solver that skips some solves still gets the roots dirtied in between
+    expected.nodes[2]->setPosition(3.F, 2.F, 1.F);
+    first.nodes[2]->setPosition(3.F, 2.F, 1.F);
+    second.nodes[3]->setScale(2.F, 2.F, 2.F);
+    secondSolver.solve(second.root);
+    EXPECT_EQ(secondSolver.getVisitedNodeCount(), subtreeSize);
+    expected.nodes.back()->setPosition(0.F, 1.F, 0.F);
+    first.nodes.back()->setPosition(0.F, 1.F, 0.F);
+    secondSolver.solve(second.root);
+    EXPECT_EQ(secondSolver.getVisitedNodeCount(), 0);
+    firstSolver.solve(first.root);
+    EXPECT_EQ(firstSolver.getVisitedNodeCount(), subtreeSize + 1);
+    expectSameWorldTransforms(expected, first);
+    EXPECT_FALSE(second.nodes.back()->isTransformDirty());
+}
+
+TEST(TransformSolverTest, fullSolveAfterOverflow) {
+    Hierarchy first;
+    Hierarchy second;
+    buildHierarchy(first);
+    buildHierarchy(second);
+
+    TransformSolver firstSolver;
+    TransformSolver secondSolver;
+    firstSolver.solve(first.root);
+    secondSolver.solve(second.root);
+
+    // more dirty roots than Node::dirtyTransformRoots holds, dirtied and cleaned again by hand
+    IntrusivePtr<Node> other = ccnew Node();
+    for (uint32_t i = 0; i < 5000; ++i) {
+        other->setPosition(static_cast<float>(i), 0.F, 0.F);
+        other->updateWorldTransform();
+    }
+    first.nodes[1]->setPosition(1.F, 2.F, 3.F);
+    secondSolver.solve(second.root);
+    EXPECT_EQ(secondSolver.getVisitedNodeCount(), second.nodes.size());
+    firstSolver.solve(first.root);
+    EXPECT_EQ(firstSolver.getVisitedNodeCount(), first.nodes.size());
+    EXPECT_FALSE(first.nodes.back()->isTransformDirty());
+
+    // back to incremental solves
+    first.nodes[1]->setPosition(3.F, 2.F, 1.F);
+    firstSolver.solve(first.root);
+    EXPECT_LT(firstSolver.getVisitedNodeCount(), first.nodes.size());
+}
+
+TEST(TransformSolverTest, rebuildsOnHierarchyChange) {
+    Hierarchy expected;
+    Hierarchy actual;
+    buildHierarchy(expected);
+    buildHierarchy(actual);
+
+    TransformSolver solver;
+    solver.solve(actual.root);
+    const uint32_t nodeCount = solver.getNodeCount();
+
+    // move a leaf under the root, hold it while it is removed from its old parent
+    IntrusivePtr<Node> leaf = actual.nodes.back();
+    IntrusivePtr<Node> expectedLeaf = expected.nodes.back();
+    leaf->setParent(actual.root, true);
+    expectedLeaf->setParent(expected.root, true);
+    for (uint32_t i = 0; i < expected.nodes.size(); ++i) {
+        setLocalTransform(expected.nodes[i], i, 1);
+        setLocalTransform(actual.nodes[i], i, 1);
+    }
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getNodeCount(), nodeCount);
+    expectSameWorldTransforms(expected, actual);
+
+    // detach the leaf
+    leaf->setParent(nullptr);
+    solver.solve(actual.root);
+    EXPECT_EQ(solver.getNodeCount(), nodeCount - 1);
+}
@@ -0,0 +1,172 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+#include "platform/FileUtils.h"
+
+namespace {
+
+// Resolves against an in-memory file list and counts the file system probes.
+class FakeFileUtils : public cc::FileUtils {
+public:
+    explicit FakeFileUtils(std::set<ccstd::string> files) : _files(std::move(files)) {}
+
+    static void restoreInstance(cc::FileUtils *instance) { sharedFileUtils = instance; }
+
+    ccstd::string getWritablePath() const override { return ""; }
+
+    uint32_t getProbeCount() const { return _probeCount.load(); }
+    void resetProbeCount() { _probeCount = 0; }
+
+protected:
+    bool isFileExistInternal(const ccstd::string &filename) const override {
+        ++_probeCount;
+        return _files.count(filename) != 0;
+    }
+
+private:
+    std::set<ccstd::string> _files;
+    mutable std::atomic<uint32_t> _probeCount{0};
+};
+
+class FileUtilsPathCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _previous = cc::FileUtils::getInstance();
+        _fileUtils = new FakeFileUtils({"/a/x.png", "/b/x.png", "/b/y.png", "/c/z.png"});
+        _fileUtils->setSearchPaths({"/a/", "/b/"});
+    }
+
+    void TearDown() override {
+        delete _fileUtils;
+        FakeFileUtils::restoreInstance(_previous);
+    }
+
+    cc::FileUtils *_previous{nullptr};
+    FakeFileUtils *_fileUtils{nullptr};
+};
+
+} // namespace
+
+TEST_F(FileUtilsPathCacheTest, cachesFoundAndMissingFiles) {
+    // failed lookups are not cached unless enabled
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 6);
+    _fileUtils->setNegativeLookupCacheEnabled(true);
+
+    _fileUtils->resetProbeCount();
+    EXPECT_EQ(_fileUtils->fullPathForFilename("y.png"), "/b/y.png");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 2);
+    EXPECT_EQ(_fileUtils->fullPathForFilename("y.png"), "/b/y.png");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 2);
+
+    // "/a/", "/b/" and the default root path
+    _fileUtils->resetProbeCount();
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 3);
+    EXPECT_FALSE(_fileUtils->isFileExist("missing.png"));
+    EXPECT_EQ(_fileUtils->getProbeCount(), 3);
+
+    auto cache = _fileUtils->getFullPathCache();
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache["y.png"], "/b/y.png");
+
+    _fileUtils->setNegativeLookupCacheEnabled(false);
+    _fileUtils->resetProbeCount();
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 6);
+}
+
+TEST_F(FileUtilsPathCacheTest, searchPathChangesInvalidate) {
+    EXPECT_EQ(_fileUtils->fullPathForFilename("x.png"), "/a/x.png");
+    EXPECT_EQ(_fileUtils->fullPathForFilename("z.png"), "");
+
+    _fileUtils->addSearchPath("/c/", true);
+    EXPECT_EQ(_fileUtils->fullPathForFilename("z.png"), "/c/z.png");
+
+    _fileUtils->setSearchPaths({"/b/"});
+    EXPECT_EQ(_fileUtils->fullPathForFilename("x.png"), "/b/x.png");
+    EXPECT_EQ(_fileUtils->fullPathForFilename("z.png"), "");
+
+    _fileUtils->resetProbeCount();
+    _fileUtils->purgeCachedEntries();
+    EXPECT_EQ(_fileUtils->fullPathForFilename("x.png"), "/b/x.png");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 1);
+}
+
+TEST_F(FileUtilsPathCacheTest, manifestSkipsProbes) {
+    _fileUtils->setSearchPathManifest("/a/", {"x.png"});
+    _fileUtils->setSearchPathManifest("/b/", {"x.png", "y.png"});
+
+    EXPECT_EQ(_fileUtils->fullPathForFilename("y.png"), "/b/y.png");
+    EXPECT_EQ(_fileUtils->fullPathForFilename("x.png"), "/a/x.png");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 0);
+
+    // only the default root path has no manifest
+    EXPECT_EQ(_fileUtils->fullPathForFilename("missing.png"), "");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 1);
+
+    _fileUtils->setSearchPathManifest("/a/", {});
+    EXPECT_EQ(_fileUtils->fullPathForFilename("y.png"), "/b/y.png");
+    EXPECT_EQ(_fileUtils->getProbeCount(), 2);
+}
+
+TEST_F(FileUtilsPathCacheTest, concurrentLookups) {
+    std::atomic<bool> running{true};
+    std::atomic<uint32_t> failures{0};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; ++i) {
+        workers.emplace_back([&]() {
+            while (running) {
+                auto x = _fileUtils->fullPathForFilename("x.png");
+                auto y = _fileUtils->fullPathForFilename("y.png");
+                if ((x != "/a/x.png" && x != "/b/x.png") || y != "/b/y.png") {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        _fileUtils->setSearchPaths(i % 2 ? ccstd::vector<ccstd::string>{"/a/", "/b/"} : ccstd::vector<ccstd::string>{"/b/"});
+        _fileUtils->setSearchPathManifest("/b/", i % 3 ? ccstd::vector<ccstd::string>{} : ccstd::vector<ccstd::string>{"x.png", "y.png"});
+    }
+    running = false;
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(failures.load(), 0);
+
+    // the cache holds the results for the final search paths only
+    _fileUtils->setSearchPaths({"/b/"});
+    EXPECT_EQ(_fileUtils->fullPathForFilename("x.png"), "/b/x.png");
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+
+#include <thread>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/base/threading/FrameArena.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr uint32_t ELEMENT_COUNT = 1000;
+
+const uint32_t *fillFrame(cc::FrameArena *arena, uint32_t frame) {
+    ccstd::pmr::vector<uint32_t> list(arena->getThreadResource());
+    list.reserve(ELEMENT_COUNT);
+    for (uint32_t i = 0; i < ELEMENT_COUNT; ++i) {
+        list.push_back(frame);
+    }
+    // deallocation is a no-op, the memory stays readable until the arena is reset
+    return list.data();
+}
+
+} // namespace
+
+TEST(frameArenaTest, steadyState) {
+    cc::FrameArena arena;
+    ccstd::vector<const uint32_t *> frameData;
+    for (uint32_t frame = 0; frame < 10; ++frame) {
+        arena.beginFrame();
+        if (frame == 1) {
+            // the first frame created its arena
+            EXPECT_EQ(arena.getHeapAllocationCount(), 1);
+            EXPECT_GE(arena.getUsedSize(), ELEMENT_COUNT * sizeof(uint32_t));
+            EXPECT_EQ(arena.getCapacity(), cc::FrameArena::DEFAULT_ARENA_CAPACITY);
+        } else if (frame > cc::FrameArena::FRAME_BUFFER_COUNT) {
+            EXPECT_EQ(arena.getHeapAllocationCount(), 0);
+        }
+        frameData.push_back(fillFrame(&arena, frame));
+    }
+
+    for (uint32_t frame = cc::FrameArena::FRAME_BUFFER_COUNT; frame < frameData.size(); ++frame) {
+        // memory of FRAME_BUFFER_COUNT frames ago is reused
+        EXPECT_EQ(frameData[frame], frameData[frame - cc::FrameArena::FRAME_BUFFER_COUNT]);
+    }
+    // the last frames are still intact
+    const auto frameCount = static_cast<uint32_t>(frameData.size());
+    for (uint32_t frame = frameCount - cc::FrameArena::FRAME_BUFFER_COUNT; frame < frameCount; ++frame) {
+        EXPECT_EQ(frameData[frame][0], frame);
+        EXPECT_EQ(frameData[frame][ELEMENT_COUNT - 1], frame);
+    }
+}
+
+TEST(frameArenaTest, threadResource) {
+    constexpr uint32_t THREAD_COUNT = 4;
+    cc::FrameArena arena;
+    arena.beginFrame();
+
+    ccstd::vector<boost::container::pmr::memory_resource *> resources(THREAD_COUNT, nullptr);
+    ccstd::vector<std::thread> threads;
+    for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            resources[i] = arena.getThreadResource();
+            // same resource within a thread and a frame
+            EXPECT_EQ(resources[i], arena.getThreadResource());
+            fillFrame(&arena, i);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (uint32_t i = 0; i < THREAD_COUNT; ++i) {
+        for (uint32_t j = i + 1; j < THREAD_COUNT; ++j) {
+            EXPECT_NE(resources[i], resources[j]);
+        }
+    }
+
+    arena.beginFrame();
+    EXPECT_EQ(arena.getHeapAllocationCount(), THREAD_COUNT);
+    EXPECT_GE(arena.getUsedSize(), THREAD_COUNT * ELEMENT_COUNT * sizeof(uint32_t));
+}
+
+TEST(frameArenaTest, fallbackGrowth) {
+    constexpr size_t CAPACITY = 256;
+    cc::FrameArenaResource resource(CAPACITY);
+    {
+        ccstd::pmr::vector<uint8_t> list(&resource);
+        list.resize(CAPACITY * 4);
+        EXPECT_EQ(resource.getFallbackCount(), 1);
+    }
+
+    resource.reset();
+    EXPECT_EQ(resource.getFallbackCount(), 0);
+    EXPECT_GE(resource.getCapacity(), CAPACITY * 4);
+
+    ccstd::pmr::vector<uint8_t> grown(&resource);
+    grown.resize(CAPACITY * 4);
+    EXPECT_EQ(resource.getFallbackCount(), 0);
+}
@@ -0,0 +1,200 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+
+#include <chrono>
+#include <random>
+#include "cocos/base/Log.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/Frustum.h"
+#include "cocos/core/geometry/FrustumCulling.h"
+#include "cocos/core/geometry/Intersect.h"
+#include "cocos/math/Mat4.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr uint32_t BOX_COUNT = 100000;
+
+ccstd::vector<cc::geometry::AABB> createRandomBoxes(uint32_t count) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-120.F, 120.F);
+    std::uniform_real_distribution<float> extent(0.1F, 10.F);
+    ccstd::vector<cc::geometry::AABB> boxes;
+    boxes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        boxes.emplace_back(position(rng), position(rng), position(rng), extent(rng), extent(rng), extent(rng));
+    }
+    return boxes;
+}
+
+} // namespace
+
+TEST(geometryFrustumCullingTest, cullAABBs) {
+    cc::geometry::Frustum frustum;
+    cc::geometry::Frustum::createPerspective(&frustum, 1.F, 1.5F, 0.1F, 100.F, cc::Mat4::IDENTITY);
+
+    const auto boxes = createRandomBoxes(BOX_COUNT);
+    cc::geometry::AABBSoA soa;
+    for (const auto &box : boxes) {
+        soa.add(box);
+    }
+    EXPECT_EQ(soa.size(), BOX_COUNT);
+
+    ccstd::vector<uint8_t> mask(BOX_COUNT);
+    frustum.cullAABBs(soa, mask.data());
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < BOX_COUNT; ++i) {
+        if (boxes[i].aabbFrustum(frustum) != (mask[i] != 0)) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+
+    constexpr uint32_t ITERATION_COUNT = 10;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATION_COUNT; ++i) {
+        frustum.cullAABBs(soa, mask.data());
+    }
+    const auto end = std::chrono::steady_clock::now();
+    CC_LOG_INFO("cull %u boxes: %.3f ms", BOX_COUNT, std::chrono::duration<double, std::milli>(end - start).count() / ITERATION_COUNT);
+}
+
+TEST(geometryFrustumCullingTest, aabbSoAEdit) {
+    cc::geometry::Frustum frustum;
+    cc::geometry::Frustum::createOrthographic(&frustum, 10.F, 10.F, 1.F, 100.F, cc::Mat4::IDENTITY);
+
+    cc::geometry::AABBSoA soa;
+    soa.add(cc::geometry::AABB(0.F, 0.F, -10.F, 1.F, 1.F, 1.F));
+    soa.addEmpty();
+    soa.add(cc::geometry::AABB(100.F, 0.F, -10.F, 1.F, 1.F, 1.F));
+    soa.add(cc::geometry::AABB(1.F, 1.F, -20.F, 1.F, 1.F, 1.F));
+    soa.add(cc::geometry::AABB(2.F, 2.F, -30.F, 1.F, 1.F, 1.F));
+
+    uint8_t mask[5] = {};
+    frustum.cullAABBs(soa, mask);
+    EXPECT_NE(mask[0], 0);
+    EXPECT_EQ(mask[1], 0);
+    EXPECT_EQ(mask[2], 0);
+    EXPECT_NE(mask[3], 0);
+    EXPECT_NE(mask[4], 0);
+
+    soa.erase(1);
+    EXPECT_EQ(soa.size(), 4);
+    EXPECT_FLOAT_EQ(soa.getCenterX()[1], 100.F);
+    soa.set(1, cc::geometry::AABB(0.F, 0.F, -50.F, 1.F, 1.F, 1.F));
+    soa.setEmpty(0);
+    frustum.cullAABBs(soa, mask);
+    EXPECT_EQ(mask[0], 0);
+    EXPECT_NE(mask[1], 0);
+    EXPECT_NE(mask[2], 0);
+    EXPECT_NE(mask[3], 0);
+
+    soa.clear();
+    EXPECT_EQ(soa.size(), 0);
+}
+
+TEST(geometryFrustumCullingTest, aabbFrustums) {
+    cc::geometry::Frustum perspective;
+    cc::geometry::Frustum::createPerspective(&perspective, 1.F, 1.5F, 0.1F, 100.F, cc::Mat4::IDENTITY);
+    cc::Mat4 transform;
+    cc::Mat4::createTranslation(10.F, 0.F, 0.F, &transform);
+    cc::geometry::Frustum ortho;
+    cc::geometry::Frustum::createOrthographic(&ortho, 50.F, 50.F, 1.F, 80.F, transform);
+
+    cc::geometry::FrustumSoA frustums;
+    EXPECT_EQ(frustums.addFrustum(perspective), 0);
+    EXPECT_EQ(frustums.addFrustum(ortho), 1);
+
+    const cc::geometry::Frustum *list[] = {&perspective, &ortho};
+    uint32_t mismatches = 0;
+    for (const auto &box : createRandomBoxes(10000)) {
+        uint32_t visibleMask = 0;
+        uint32_t insideMask = 0;
+        frustums.aabbFrustums(box, &visibleMask, &insideMask);
+        for (uint32_t i = 0; i < 2; ++i) {
+            const bool visible = cc::geometry::aabbFrustum(box, *list[i]) != 0;
+            const bool inside = cc::geometry::aabbFrustumCompletelyInside(box, *list[i]) != 0;
+            if (visible != ((visibleMask >> i) & 1U) || inside != ((insideMask >> i) & 1U)) {
+                ++mismatches;
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(geometryFrustumCullingTest, aabbFrustumsCameraAndShadowLayers) {
+    // Camera frustum followed by the valid frustums of four shadow layers looking down a tilted light,
+    // as gathered by sceneCulling, padded with extra layers up to the kernel's frustum limit.
+    cc::Mat4 cameraTransform;
+    cc::Mat4::createLookAt(cc::Vec3(0.F, 20.F, 60.F), cc::Vec3::ZERO, cc::Vec3::UNIT_Y, &cameraTransform);
+    cameraTransform.inverse();
+    ccstd::vector<cc::geometry::Frustum> list(cc::geometry::FrustumSoA::MAX_FRUSTUM_COUNT);
+    cc::geometry::Frustum::createPerspective(&list[0], 1.F, 16.F / 9.F, 0.1F, 150.F, cameraTransform);
+
+    cc::Mat4 lightRotation;
+    cc::Mat4::createRotation(cc::Vec3(1.F, 0.F, 1.F).getNormalized(), -1.F, &lightRotation);
+    for (uint32_t i = 1; i < list.size(); ++i) {
+        const float size = 15.F * static_cast<float>(i);
+        cc::Mat4 translation;
+        cc::Mat4::createTranslation(4.F * static_cast<float>(i), 60.F, -3.F * static_cast<float>(i), &translation);
+        cc::Mat4 lightTransform;
+        cc::Mat4::multiply(translation, lightRotation, &lightTransform);
+        cc::geometry::Frustum::createOrthographic(&list[i], size, size, 0.1F, 200.F, lightTransform);
+    }
+
+    cc::geometry::FrustumSoA frustums;
+    frustums.addFrustum(list[0]);
+    frustums.clear();
+    for (uint32_t i = 0; i < list.size(); ++i) {
+        EXPECT_EQ(frustums.addFrustum(list[i]), i);
+    }
+    EXPECT_EQ(frustums.getFrustumCount(), cc::geometry::FrustumSoA::MAX_FRUSTUM_COUNT);
+
+    uint32_t mismatches = 0;
+    uint32_t visibleCount = 0;
+    uint32_t insideCount = 0;
+    for (const auto &box : createRandomBoxes(BOX_COUNT)) {
+        uint32_t visibleMask = 0;
+        uint32_t insideMask = 0;
+        frustums.aabbFrustums(box, &visibleMask, &insideMask);
+        EXPECT_EQ(visibleMask >> list.size(), 0);
+        EXPECT_EQ(insideMask & ~visibleMask, 0);
+        for (uint32_t i = 0; i < list.size(); ++i) {
+            const bool visible = cc::geometry::aabbFrustum(box, list[i]) != 0;
+            const bool inside = cc::geometry::aabbFrustumCompletelyInside(box, list[i]) != 0;
+            if (visible != ((visibleMask >> i) & 1U) || inside != ((insideMask >> i) & 1U)) {
+                ++mismatches;
+            }
+            visibleCount += visible ? 1 : 0;
+            insideCount += inside ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(mismatches, 0);
+    // make sure the boxes cover all three outcomes
+    EXPECT_GT(insideCount, 0);
+    EXPECT_LT(insideCount, visibleCount);
+    EXPECT_LT(visibleCount, BOX_COUNT * list.size());
+}
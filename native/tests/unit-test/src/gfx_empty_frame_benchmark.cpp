@@ -0,0 +1,512 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+// Headless frame benchmark on the empty gfx backend, which the unit tests create the Root with.
+// Synthetic scenes of N models, M sphere lights and K materials go through the engine's CPU side
+// stages of a forward frame: RenderScene::update (transforms and world bounds), pipeline::sceneCulling,
+// pipeline::validPunctualLightsCulling, command recording through gfx::ParallelCommandRecorder, and submission.
+// Models carry no materials, since compiling effects needs the script side, so render queue
+// sorting and batching are not measured; each culled model records one draw with one of K pipeline states.
+// Per stage timings and heap allocation counts are logged as JSON together with the commands and
+// buffer updates counted by the empty device, and written to the file in CC_BENCHMARK_OUTPUT if the
+// variable is set.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "base/threading/FrameArena.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/gfx-base/GFXParallelCommandRecorder.h"
+#include "renderer/gfx-empty/EmptyDevice.h"
+#include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "renderer/pipeline/SceneCulling.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+#include "scene/RenderWindow.h"
+#include "scene/SphereLight.h"
+
+using namespace cc;
+
+namespace {
+// every heap allocation of the test binary, engine containers included, counted from any thread
+std::atomic<uint64_t> heapAllocationCount{0};
+
+void *countedAllocate(std::size_t size) noexcept {
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+} // namespace
+
+// Replaces the global allocation functions of the test binary, the aligned forms keep the defaults.
+void *operator new(std::size_t size) {
+    if (void *p = countedAllocate(size)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) {
+    if (void *p = countedAllocate(size)) return p;
+    throw std::bad_alloc();
+}
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept { return countedAllocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept { return countedAllocate(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t /*size*/) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t /*size*/) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t & /*tag*/) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t & /*tag*/) noexcept { std::free(p); }
+
+namespace {
+
+// a pipeline without flows, the culling functions only read its scene data
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+};
+
+pipeline::RenderPipeline *ensurePipeline() {
+    auto *root = Root::getInstance();
+    if (!root) {
+        return nullptr;
+    }
+    if (!root->getPipeline()) {
+        root->setRenderPipeline(ccnew HeadlessPipeline());
+    }
+    return pipeline::RenderPipeline::getInstance();
+}
+
+struct BenchmarkConfig {
+    uint32_t modelCount{0};
+    uint32_t lightCount{0};
+    uint32_t materialCount{0};
+};
+
+enum class Stage : uint32_t {
+    SCENE_UPDATE,
+    CULLING,
+    LIGHT_CULLING,
+    RECORDING,
+    SUBMIT,
+    COUNT,
+};
+
+constexpr const char *STAGE_NAMES[] = {"sceneUpdate", "culling", "lightCulling", "recording", "submit"};
+constexpr uint32_t STAGE_COUNT = static_cast<uint32_t>(Stage::COUNT);
+constexpr uint32_t WARMUP_FRAME_COUNT = 4;
+constexpr uint32_t FRAME_COUNT = 32;
+constexpr uint32_t GRID_SIZE = 64;
+constexpr uint32_t SIZE = 64;
+
+struct StageStats {
+    double time{0.0}; // ms
+    uint64_t allocations{0};
+};
+
+class StageTimer final {
+public:
+    explicit StageTimer(StageStats *stats)
+    : _stats(stats),
+      _allocations(heapAllocationCount.load(std::memory_order_relaxed)),
+      _start(std::chrono::steady_clock::now()) {}
+
+    ~StageTimer() {
+        if (!_stats) return;
+        _stats->time += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+        _stats->allocations += heapAllocationCount.load(std::memory_order_relaxed) - _allocations;
+    }
+
+    StageTimer(StageTimer const &) = delete;
+    StageTimer &operator=(StageTimer const &) = delete;
+
+private:
+    StageStats *_stats{nullptr};
+    uint64_t _allocations{0};
+    std::chrono::steady_clock::time_point _start;
+};
+
+struct Material {
+    gfx::Shader *shader{nullptr};
+    gfx::PipelineState *pipelineState{nullptr};
+    gfx::Buffer *uniformBuffer{nullptr};
+    gfx::DescriptorSet *descriptorSet{nullptr};
+};
+
+class FrameBenchmark final {
+public:
+    FrameBenchmark(pipeline::RenderPipeline *pipeline, const BenchmarkConfig &config);
+    ~FrameBenchmark();
+    FrameBenchmark(FrameBenchmark const &) = delete;
+    FrameBenchmark &operator=(FrameBenchmark const &) = delete;
+
+    void runFrame(uint32_t frame, bool measured);
+    ccstd::string toJson() const;
+
+    inline double getVisibleModels() const { return static_cast<double>(_visibleModels) / std::max(_measuredFrames, 1U); }
+    inline double getValidLights() const { return static_cast<double>(_validLights) / std::max(_measuredFrames, 1U); }
+    inline double getDrawCalls() const { return static_cast<double>(_commandStats.drawCalls) / std::max(_measuredFrames, 1U); }
+
+private:
+    void createGfxResources();
+    void createScene();
+
+    pipeline::RenderPipeline *_pipeline{nullptr};
+    gfx::EmptyDevice *_device{nullptr};
+    BenchmarkConfig _config;
+    uint32_t _presentInterval{0};
+
+    gfx::DescriptorSetLayout *_materialSetLayout{nullptr};
+    gfx::DescriptorSetLayout *_localSetLayout{nullptr};
+    gfx::PipelineLayout *_pipelineLayout{nullptr};
+    gfx::Buffer *_vertexBuffer{nullptr};
+    gfx::InputAssembler *_inputAssembler{nullptr};
+    ccstd::vector<Material> _materials;
+    ccstd::vector<gfx::Buffer *> _localBuffers;
+    ccstd::vector<gfx::DescriptorSet *> _localDescriptorSets;
+    gfx::ParallelCommandRecorder _recorder;
+
+    scene::RenderWindow *_window{nullptr};
+    IntrusivePtr<scene::RenderScene> _scene;
+    IntrusivePtr<scene::Camera> _camera;
+    IntrusivePtr<Node> _root;
+    IntrusivePtr<Node> _cameraNode;
+    ccstd::vector<IntrusivePtr<Node>> _nodes;
+    ccstd::vector<IntrusivePtr<scene::SphereLight>> _lights;
+    ccstd::unordered_map<const scene::Model *, uint32_t> _modelIndices;
+
+    ccstd::vector<StageStats> _stages{STAGE_COUNT};
+    uint32_t _measuredFrames{0};
+    uint64_t _visibleModels{0};
+    uint64_t _validLights{0};
+    gfx::EmptyCommandStats _commandStats;
+    uint32_t _bufferUpdates{0};
+    uint64_t _bufferUpdateSize{0};
+};
+
+FrameBenchmark::FrameBenchmark(pipeline::RenderPipeline *pipeline, const BenchmarkConfig &config)
+: _pipeline(pipeline), _device(gfx::EmptyDevice::getInstance()), _config(config), _recorder(_device) {
+    // the device would otherwise sleep a vsync interval in every present
+    _presentInterval = _device->getPresentInterval();
+    _device->setPresentInterval(0);
+    createGfxResources();
+    createScene();
+}
+
+FrameBenchmark::~FrameBenchmark() {
+    _device->setPresentInterval(_presentInterval);
+    _scene->destroy();
+    _camera->destroy();
+    Root::getInstance()->destroyWindow(_window);
+
+    for (auto *descriptorSet : _localDescriptorSets) {
+        CC_SAFE_DESTROY_AND_DELETE(descriptorSet);
+    }
+    for (auto *buffer : _localBuffers) {
+        CC_SAFE_DESTROY_AND_DELETE(buffer);
+    }
+    for (auto &material : _materials) {
+        CC_SAFE_DESTROY_AND_DELETE(material.descriptorSet);
+        CC_SAFE_DESTROY_AND_DELETE(material.uniformBuffer);
+        CC_SAFE_DESTROY_AND_DELETE(material.pipelineState);
+        CC_SAFE_DESTROY_AND_DELETE(material.shader);
+    }
+    CC_SAFE_DESTROY_AND_DELETE(_inputAssembler);
+    CC_SAFE_DESTROY_AND_DELETE(_vertexBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_localSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_materialSetLayout);
+}
+
+void FrameBenchmark::createGfxResources() {
+    scene::IRenderWindowInfo windowInfo;
+    windowInfo.title = "benchmark";
+    windowInfo.width = SIZE;
+    windowInfo.height = SIZE;
+    windowInfo.renderPassInfo.colorAttachments.push_back({gfx::Format::RGBA8});
+    windowInfo.renderPassInfo.depthStencilAttachment.format = gfx::Format::DEPTH_STENCIL;
+    _window = Root::getInstance()->createWindow(windowInfo);
+
+    gfx::DescriptorSetLayoutInfo setLayoutInfo;
+    setLayoutInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::VERTEX | gfx::ShaderStageFlagBit::FRAGMENT});
+    _materialSetLayout = _device->createDescriptorSetLayout(setLayoutInfo);
+    _localSetLayout = _device->createDescriptorSetLayout(setLayoutInfo);
+
+    gfx::PipelineLayoutInfo pipelineLayoutInfo;
+    pipelineLayoutInfo.setLayouts.resize(pipeline::localSet + 1, nullptr);
+    pipelineLayoutInfo.setLayouts[pipeline::materialSet] = _materialSetLayout;
+    pipelineLayoutInfo.setLayouts[pipeline::localSet] = _localSetLayout;
+    _pipelineLayout = _device->createPipelineLayout(pipelineLayoutInfo);
+
+    const gfx::AttributeList attributes{{gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F}};
+    constexpr uint32_t vertexStride = 3 * sizeof(float);
+    _vertexBuffer = _device->createBuffer({gfx::BufferUsageBit::VERTEX, gfx::MemoryUsageBit::DEVICE, vertexStride * 36, vertexStride});
+    _inputAssembler = _device->createInputAssembler({attributes, {_vertexBuffer}});
+
+    _materials.resize(_config.materialCount);
+    for (uint32_t i = 0; i < _config.materialCount; ++i) {
+        auto &material = _materials[i];
+        gfx::ShaderInfo shaderInfo;
+        shaderInfo.name = "benchmark" + std::to_string(i);
+        shaderInfo.attributes = attributes;
+        material.shader = _device->createShader(shaderInfo);
+
+        gfx::PipelineStateInfo pipelineStateInfo;
+        pipelineStateInfo.shader = material.shader;
+        pipelineStateInfo.pipelineLayout = _pipelineLayout;
+        pipelineStateInfo.renderPass = _window->getFramebuffer()->getRenderPass();
+        pipelineStateInfo.inputState.attributes = attributes;
+        material.pipelineState = _device->createPipelineState(pipelineStateInfo);
+
+        material.uniformBuffer = _device->createBuffer({gfx::BufferUsageBit::UNIFORM, gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE, 4 * sizeof(Vec4), 4 * sizeof(Vec4)});
+        material.descriptorSet = _device->createDescriptorSet({_materialSetLayout});
+        material.descriptorSet->bindBuffer(0, material.uniformBuffer);
+        material.descriptorSet->update();
+    }
+
+    _localBuffers.resize(_config.modelCount);
+    _localDescriptorSets.resize(_config.modelCount);
+    for (uint32_t i = 0; i < _config.modelCount; ++i) {
+        _localBuffers[i] = _device->createBuffer({gfx::BufferUsageBit::UNIFORM, gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE, sizeof(Mat4), sizeof(Mat4)});
+        _localDescriptorSets[i] = _device->createDescriptorSet({_localSetLayout});
+        _localDescriptorSets[i]->bindBuffer(0, _localBuffers[i]);
+        _localDescriptorSets[i]->update();
+    }
+}
+
+void FrameBenchmark::createScene() {
+    _scene = ccnew scene::RenderScene();
+    _scene->initialize({"benchmark"});
+    _scene->setParallelUpdateEnabled(true);
+    _root = ccnew Node("root");
+    _scene->setRootNode(_root);
+
+    _nodes.reserve(_config.modelCount);
+    _modelIndices.reserve(_config.modelCount);
+    for (uint32_t i = 0; i < _config.modelCount; ++i) {
+        auto *node = ccnew Node();
+        node->setParent(_root);
+        _nodes.emplace_back(node);
+
+        auto *model = ccnew scene::Model();
+        model->initialize();
+        model->setNode(node);
+        model->setTransform(node);
+        model->createBoundingShape(Vec3{-0.5F, -0.5F, -0.5F}, Vec3{0.5F, 0.5F, 0.5F});
+        _scene->addModel(model);
+        _modelIndices.emplace(model, i);
+    }
+
+    _lights.reserve(_config.lightCount);
+    for (uint32_t i = 0; i < _config.lightCount; ++i) {
+        auto *light = ccnew scene::SphereLight();
+        light->initialize();
+        light->setPosition(Vec3(static_cast<float>((i * 7) % GRID_SIZE), 1.F, static_cast<float>((i * 13) % GRID_SIZE)));
+        light->setRange(4.F);
+        _scene->addSphereLight(light);
+        _lights.emplace_back(light);
+    }
+
+    // a camera at a corner of the grid, looking at its center
+    _cameraNode = ccnew Node("camera");
+    _cameraNode->setParent(_root);
+    _cameraNode->setPosition(static_cast<float>(GRID_SIZE) / 2.F, 8.F, static_cast<float>(GRID_SIZE) * 1.5F);
+    _cameraNode->lookAt(Vec3(static_cast<float>(GRID_SIZE) / 2.F, 0.F, static_cast<float>(GRID_SIZE) / 2.F));
+
+    _camera = ccnew scene::Camera(_device);
+    scene::ICameraInfo cameraInfo;
+    cameraInfo.name = "benchmark";
+    cameraInfo.node = _cameraNode;
+    cameraInfo.projection = scene::CameraProjection::PERSPECTIVE;
+    cameraInfo.window = _window;
+    _camera->initialize(cameraInfo);
+    _camera->setNearClip(0.1F);
+    _camera->setFarClip(static_cast<float>(GRID_SIZE) * 2.F);
+    _camera->setClearFlag(gfx::ClearFlagBit::ALL);
+    _scene->addCamera(_camera);
+}
+
+void FrameBenchmark::runFrame(uint32_t frame, bool measured) {
+    auto stage = [&](Stage s) { return measured ? &_stages[static_cast<uint32_t>(s)] : nullptr; };
+    FrameArena::getInstance()->beginFrame();
+    _device->acquire(nullptr, 0);
+
+    {
+        StageTimer timer(stage(Stage::SCENE_UPDATE));
+        for (uint32_t i = 0; i < _config.modelCount; ++i) {
+            const auto x = static_cast<float>(i % GRID_SIZE);
+            const auto z = static_cast<float>((i / GRID_SIZE) % GRID_SIZE);
+            const auto y = static_cast<float>(i / (GRID_SIZE * GRID_SIZE)) + static_cast<float>(frame % 8) * 0.25F;
+            _nodes[i]->setPosition(x, y, z);
+        }
+        _scene->update(frame);
+    }
+
+    auto *sceneData = _pipeline->getPipelineSceneData();
+    {
+        StageTimer timer(stage(Stage::CULLING));
+        _camera->update(true);
+        pipeline::sceneCulling(_pipeline, _camera);
+    }
+
+    {
+        StageTimer timer(stage(Stage::LIGHT_CULLING));
+        pipeline::validPunctualLightsCulling(_pipeline, _camera);
+    }
+
+    const auto &renderObjects = sceneData->getRenderObjects();
+    const gfx::EmptyResourceStats resourceStats = _device->getResourceStats();
+    gfx::CommandBuffer *cmdBuff = _device->getCommandBuffer();
+    {
+        StageTimer timer(stage(Stage::RECORDING));
+        const gfx::Color clearColor{0.F, 0.F, 0.F, 1.F};
+        cmdBuff->begin();
+        _recorder.recordRenderPass(cmdBuff, _window->getFramebuffer()->getRenderPass(), _window->getFramebuffer(), {0, 0, SIZE, SIZE}, &clearColor, 1.F, 0,
+                                   static_cast<uint32_t>(renderObjects.size()),
+                                   [&](gfx::CommandBuffer *sliceCmdBuff, uint32_t begin, uint32_t end) {
+                                       uint32_t currentMaterial = UINT32_MAX;
+                                       sliceCmdBuff->bindInputAssembler(_inputAssembler);
+                                       for (uint32_t i = begin; i < end; ++i) {
+                                           const uint32_t model = _modelIndices.at(renderObjects[i].model);
+                                           const uint32_t material = model % _config.materialCount;
+                                           if (material != currentMaterial) {
+                                               currentMaterial = material;
+                                               sliceCmdBuff->bindPipelineState(_materials[material].pipelineState);
+                                               sliceCmdBuff->bindDescriptorSet(pipeline::materialSet, _materials[material].descriptorSet);
+                                           }
+                                           sliceCmdBuff->bindDescriptorSet(pipeline::localSet, _localDescriptorSets[model]);
+                                           sliceCmdBuff->draw(_inputAssembler);
+                                       }
+                                   });
+        cmdBuff->end();
+    }
+
+    {
+        StageTimer timer(stage(Stage::SUBMIT));
+        _device->flushCommands(&cmdBuff, 1);
+        _device->getQueue()->submit(&cmdBuff, 1);
+    }
+    _device->present();
+
+    if (measured) {
+        ++_measuredFrames;
+        _visibleModels += renderObjects.size();
+        _validLights += sceneData->getValidPunctualLights().size();
+        // present moves the submitted commands into the stats of the last frame
+        _commandStats += _device->getFrameCommandStats();
+        _bufferUpdates += _device->getResourceStats().bufferUpdates - resourceStats.bufferUpdates;
+        _bufferUpdateSize += _device->getResourceStats().bufferUpdateSize - resourceStats.bufferUpdateSize;
+    }
+}
+
+ccstd::string FrameBenchmark::toJson() const {
+    const double frames = std::max(_measuredFrames, 1U);
+    char buffer[256];
+    ccstd::string json = "{";
+
+    snprintf(buffer, sizeof(buffer), R"("config":{"models":%u,"lights":%u,"materials":%u,"frames":%u,"workers":%u},)",
+             _config.modelCount, _config.lightCount, _config.materialCount, _measuredFrames, JobSystem::getInstance()->threadCount());
+    json += buffer;
+
+    json += R"("stages":{)";
+    double total = 0.0;
+    for (uint32_t i = 0; i < STAGE_COUNT; ++i) {
+        snprintf(buffer, sizeof(buffer), R"(%s"%s":{"timeMs":%.4f,"allocations":%.1f})",
+                 i ? "," : "", STAGE_NAMES[i], _stages[i].time / frames, static_cast<double>(_stages[i].allocations) / frames);
+        json += buffer;
+        total += _stages[i].time;
+    }
+    snprintf(buffer, sizeof(buffer), R"(},"frameTimeMs":%.4f,)", total / frames);
+    json += buffer;
+
+    snprintf(buffer, sizeof(buffer), R"("scene":{"visibleModels":%.1f,"validLights":%.1f},)", getVisibleModels(), getValidLights());
+    json += buffer;
+
+    snprintf(buffer, sizeof(buffer), R"("commands":{"commands":%.1f,"drawCalls":%.1f,"pipelineStateBinds":%.1f,"descriptorSetBinds":%.1f,"secondaryCommandBuffers":%u},)",
+             _commandStats.commands / frames, getDrawCalls(), _commandStats.pipelineStateBinds / frames, _commandStats.descriptorSetBinds / frames, _recorder.getSliceCount());
+    json += buffer;
+
+    snprintf(buffer, sizeof(buffer), R"("bufferUpdates":{"count":%.1f,"size":%.1f},)", _bufferUpdates / frames, static_cast<double>(_bufferUpdateSize) / frames);
+    json += buffer;
+
+    const auto &memoryStatus = _device->getMemoryStatus();
+    snprintf(buffer, sizeof(buffer), R"("memory":{"bufferSize":%u,"textureSize":%u},)", memoryStatus.bufferSize, memoryStatus.textureSize);
+    json += buffer;
+
+    snprintf(buffer, sizeof(buffer), R"("frameArena":{"heapAllocations":%u,"usedSize":%zu}})",
+             FrameArena::getInstance()->getHeapAllocationCount(), FrameArena::getInstance()->getUsedSize());
+    json += buffer;
+    return json;
+}
+
+} // namespace
+
+TEST(gfxEmptyFrameBenchmark, syntheticScenes) {
+    if (!gfx::EmptyDevice::getInstance()) {
+        GTEST_SKIP() << "the benchmark reads the command stats of the empty device";
+    }
+    auto *pipeline = ensurePipeline();
+    ASSERT_NE(pipeline, nullptr);
+
+    ccstd::string json = "[";
+    const BenchmarkConfig configs[] = {{1000, 8, 16}, {10000, 32, 64}, {50000, 64, 256}};
+    for (const auto &config : configs) {
+        FrameBenchmark benchmark(pipeline, config);
+        for (uint32_t frame = 0; frame < WARMUP_FRAME_COUNT + FRAME_COUNT; ++frame) {
+            benchmark.runFrame(frame, frame >= WARMUP_FRAME_COUNT);
+        }
+        // the camera sees part of the grid, so culling has to reject some models and lights
+        EXPECT_GT(benchmark.getVisibleModels(), 0.0);
+        EXPECT_LT(benchmark.getVisibleModels(), static_cast<double>(config.modelCount));
+        EXPECT_GT(benchmark.getValidLights(), 0.0);
+        // one draw per visible model, counted by the device through the secondary command buffers
+        EXPECT_EQ(benchmark.getDrawCalls(), benchmark.getVisibleModels());
+        if (json.size() > 1) {
+            json += ",";
+        }
+        json += benchmark.toJson();
+    }
+    json += "]";
+
+    CC_LOG_INFO("%s", json.c_str());
+    if (const char *path = getenv("CC_BENCHMARK_OUTPUT")) {
+        if (FILE *file = fopen(path, "w")) {
+            fputs(json.c_str(), file);
+            fclose(file);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+#include "cocos/renderer/gfx-base/GFXParallelCommandRecorder.h"
+#include "gtest/gtest.h"
+
+using namespace cc::gfx;
+
+namespace {
+
+constexpr uint32_t DRAW_COUNT = 1000;
+constexpr uint32_t SIZE = 16;
+
+} // namespace
+
+TEST(parallelCommandRecorderTest, recordRenderPass) {
+    Device *device = DeviceManager::createEmpty();
+    ASSERT_NE(device, nullptr);
+
+    Texture *colorTexture = device->createTexture({TextureType::TEX2D, TextureUsageBit::COLOR_ATTACHMENT, Format::RGBA8, SIZE, SIZE});
+    RenderPassInfo renderPassInfo;
+    renderPassInfo.colorAttachments.push_back({Format::RGBA8});
+    RenderPass *renderPass = device->createRenderPass(renderPassInfo);
+    Framebuffer *framebuffer = device->createFramebuffer({renderPass, {colorTexture}});
+
+    ParallelCommandRecorder recorder(device);
+    recorder.setMinDrawsPerSlice(16);
+
+    // every draw is recorded exactly once, so slices write disjoint elements
+    ccstd::vector<CommandBuffer *> recordedBy(DRAW_COUNT, nullptr);
+    ccstd::vector<uint32_t> recordCount(DRAW_COUNT, 0);
+
+    CommandBuffer *cmdBuff = device->getCommandBuffer();
+    const Color clearColor{0.F, 0.F, 0.F, 1.F};
+    cmdBuff->begin();
+    recorder.recordRenderPass(cmdBuff, renderPass, framebuffer, {0, 0, SIZE, SIZE}, &clearColor, 1.F, 0, DRAW_COUNT,
+                              [&](CommandBuffer *sliceCmdBuff, uint32_t begin, uint32_t end) {
+                                  EXPECT_LT(begin, end);
+                                  for (uint32_t i = begin; i < end; ++i) {
+                                      recordedBy[i] = sliceCmdBuff;
+                                      ++recordCount[i];
+                                  }
+                              });
+    cmdBuff->end();
+    device->flushCommands(&cmdBuff, 1);
+
+    for (uint32_t count : recordCount) {
+        EXPECT_EQ(count, 1);
+    }
+
+    const uint32_t sliceCount = recorder.getSliceCount();
+    if (recorder.isParallelRecordingSupported()) {
+        // the calling thread records a slice besides the job workers
+        EXPECT_GT(sliceCount, 1);
+    } else {
+        EXPECT_EQ(sliceCount, 0);
+    }
+
+    if (sliceCount) {
+        // slices are continuous and in the order of the secondary command buffers
+        const auto &secondaryCmdBuffs = recorder.getSecondaryCommandBuffers();
+        uint32_t slice = 0;
+        for (uint32_t i = 0; i < DRAW_COUNT; ++i) {
+            if (recordedBy[i] != secondaryCmdBuffs[slice]) {
+                ++slice;
+            }
+            ASSERT_LT(slice, sliceCount);
+            EXPECT_EQ(recordedBy[i], secondaryCmdBuffs[slice]);
+        }
+        EXPECT_EQ(slice + 1, sliceCount);
+    } else {
+        for (auto *recorded : recordedBy) {
+            EXPECT_EQ(recorded, cmdBuff);
+        }
+    }
+
+    CC_SAFE_DESTROY_AND_DELETE(framebuffer);
+    CC_SAFE_DESTROY_AND_DELETE(renderPass);
+    CC_SAFE_DESTROY_AND_DELETE(colorTexture);
+}
@@ -0,0 +1,204 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <string>
+#include "cocos/3d/assets/Mesh.h"
+#include "cocos/3d/assets/Skeleton.h"
+#include "cocos/3d/models/BakedSkinningModel.h"
+#include "cocos/3d/skeletal-animation/SkeletalAnimationUtils.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t JOINT_COUNT = 60;
+constexpr uint32_t TEXTURE_BYTES = JOINT_COUNT * 12 * sizeof(float);
+
+IntrusivePtr<Skeleton> createSkeleton(uint32_t seed) {
+    IntrusivePtr<Skeleton> skeleton = ccnew Skeleton();
+    ccstd::vector<ccstd::string> joints;
+    ccstd::vector<Mat4> bindposes;
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        joints.emplace_back("joint" + std::to_string(i));
+        Mat4 bindpose;
+        Mat4::createTranslation(static_cast<float>(seed), static_cast<float>(i), 0.F, &bindpose);
+        bindposes.emplace_back(bindpose);
+    }
+    skeleton->setJoints(joints);
+    skeleton->setBindposes(bindposes);
+    return skeleton;
+}
+
+struct JointTexturePoolFixture {
+    JointTexturePoolFixture() {
+        device = gfx::DeviceManager::createEmpty();
+        pool = ccnew JointTexturePool(device);
+        mesh = ccnew Mesh();
+        root = ccnew Node("root");
+    }
+
+    IJointTextureHandle *acquire(Skeleton *skeleton) {
+        auto handle = pool->getDefaultPoseTexture(skeleton, mesh, root);
+        return handle.has_value() ? handle.value() : nullptr;
+    }
+
+    gfx::Device *device{nullptr};
+    IntrusivePtr<JointTexturePool> pool;
+    IntrusivePtr<Mesh> mesh;
+    IntrusivePtr<Node> root;
+};
+
+} // namespace
+
+TEST(jointTexturePoolTest, lruEviction) {
+    JointTexturePoolFixture fixture;
+    ASSERT_NE(fixture.device, nullptr);
+    auto &pool = fixture.pool;
+    pool->setMemoryBudget(3 * TEXTURE_BYTES);
+
+    ccstd::vector<IntrusivePtr<Skeleton>> skeletons;
+    for (uint32_t i = 0; i < 4; ++i) {
+        skeletons.emplace_back(createSkeleton(i));
+    }
+    auto *a = fixture.acquire(skeletons[0]);
+    auto *b = fixture.acquire(skeletons[1]);
+    auto *c = fixture.acquire(skeletons[2]);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(pool->getStats().liveHandles, 3);
+    EXPECT_EQ(pool->getStats().usedBytes, 3 * TEXTURE_BYTES);
+
+    // released textures stay cached
+    pool->releaseHandle(a);
+    pool->releaseHandle(b);
+    pool->releaseHandle(c);
+    EXPECT_EQ(pool->getStats().liveHandles, 0);
+    EXPECT_EQ(pool->getStats().unusedHandles, 3);
+    EXPECT_EQ(fixture.acquire(skeletons[0]), a);
+    EXPECT_EQ(pool->getStats().unusedHandles, 2);
+
+    // b is the least recently used one
+    auto *d = fixture.acquire(skeletons[3]);
+    ASSERT_NE(d, nullptr);
+    auto stats = pool->getStats();
+    EXPECT_EQ(stats.evictionCount, 1);
+    EXPECT_EQ(stats.liveHandles, 2);
+    EXPECT_EQ(stats.unusedHandles, 1);
+    EXPECT_EQ(stats.usedBytes, 3 * TEXTURE_BYTES);
+    EXPECT_EQ(fixture.acquire(skeletons[2]), c);
+
+    // live textures are never evicted
+    pool->setMemoryBudget(TEXTURE_BYTES);
+    EXPECT_EQ(pool->getStats().liveHandles, 3);
+    EXPECT_EQ(pool->getStats().evictionCount, 1);
+
+    pool->releaseHandle(a);
+    pool->releaseHandle(c);
+    pool->releaseHandle(d);
+    stats = pool->getStats();
+    EXPECT_EQ(stats.unusedHandles, 1);
+    EXPECT_EQ(stats.usedBytes, TEXTURE_BYTES);
+    EXPECT_EQ(stats.evictionCount, 3);
+}
+
+TEST(jointTexturePoolTest, compact) {
+    JointTexturePoolFixture fixture;
+    ASSERT_NE(fixture.device, nullptr);
+    auto &pool = fixture.pool;
+
+    ccstd::vector<IntrusivePtr<Skeleton>> skeletons;
+    ccstd::vector<IJointTextureHandle *> handles;
+    for (uint32_t i = 0; i < 8; ++i) {
+        skeletons.emplace_back(createSkeleton(i));
+        handles.emplace_back(fixture.acquire(skeletons[i]));
+        ASSERT_NE(handles.back(), nullptr);
+    }
+    // leave holes in the chunk, half of them dropped for good and the other half kept unused
+    for (uint32_t i = 0; i < 8; i += 2) {
+        if (i % 4) {
+            pool->releaseSkeleton(skeletons[i]);
+        }
+        pool->releaseHandle(handles[i]);
+    }
+    EXPECT_EQ(pool->getStats().unusedHandles, 2);
+
+    ccstd::vector<ccstd::vector<uint8_t>> data;
+    ccstd::vector<gfx::Texture *> oldTextures;
+    ccstd::vector<uint32_t> oldOffsets;
+    for (uint32_t i = 1; i < 8; i += 2) {
+        const auto &array = handles[i]->data;
+        data.emplace_back(array.buffer()->getData(), array.buffer()->getData() + array.byteLength());
+        oldTextures.emplace_back(handles[i]->handle.texture);
+        oldOffsets.emplace_back(handles[i]->pixelOffset);
+    }
+
+    // a model bound to a handle that is going to move
+    IntrusivePtr<BakedSkinningModel> model = ccnew BakedSkinningModel();
+    model->bindSkeleton(skeletons[3], fixture.root, fixture.mesh);
+    model->applyJointTexture(handles[3]);
+    EXPECT_FLOAT_EQ(model->getJointMedium().jointTextureInfo[2], static_cast<float>(oldOffsets[1]) + 0.1F);
+    ASSERT_EQ(handles[3]->owners.size(), 1);
+
+    EXPECT_EQ(pool->compact(), 4);
+    auto stats = pool->getStats();
+    EXPECT_EQ(stats.liveHandles, 4);
+    EXPECT_EQ(stats.unusedHandles, 0);
+    EXPECT_EQ(stats.evictionCount, 2);
+    EXPECT_EQ(stats.relocationCount, 4);
+    EXPECT_EQ(stats.usedBytes, 4 * TEXTURE_BYTES);
+    EXPECT_EQ(stats.chunkCount, 1);
+
+    // live handles are packed from the start of the chunk and keep their data
+    ccstd::vector<uint32_t> offsets;
+    for (uint32_t i = 1, j = 0; i < 8; i += 2, ++j) {
+        EXPECT_EQ(handles[i]->version, 1);
+        EXPECT_NE(handles[i]->handle.texture, oldTextures[j]);
+        EXPECT_NE(handles[i]->pixelOffset, oldOffsets[j]);
+        offsets.emplace_back(handles[i]->pixelOffset);
+        const auto &array = handles[i]->data;
+        EXPECT_EQ(ccstd::vector<uint8_t>(array.buffer()->getData(), array.buffer()->getData() + array.byteLength()), data[j]);
+    }
+    std::sort(offsets.begin(), offsets.end());
+    for (uint32_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(offsets[i], i * pool->getPixelsPerJoint() * JOINT_COUNT);
+    }
+
+    // the owner was rebound to the new place before the old texture was destroyed
+    const auto &jointTextureInfo = model->getJointMedium().jointTextureInfo;
+    EXPECT_FLOAT_EQ(jointTextureInfo[0], static_cast<float>(handles[3]->handle.texture->getWidth()));
+    EXPECT_FLOAT_EQ(jointTextureInfo[2], static_cast<float>(handles[3]->pixelOffset) + 0.1F);
+    model->applyJointTexture(ccstd::nullopt);
+    EXPECT_TRUE(handles[3]->owners.empty());
+    model->destroy();
+
+    for (uint32_t i = 1; i < 8; i += 2) {
+        pool->releaseHandle(handles[i]);
+    }
+    pool->clear();
+}
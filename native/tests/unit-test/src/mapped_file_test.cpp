@@ -0,0 +1,86 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+#if CC_USE_MIDDLEWARE
+    #include "cocos/editor-support/MappedFile.h"
+
+namespace {
+
+std::string tempFilePath(const char *name) {
+    const char *dir = std::getenv("TMPDIR");
+    std::string path = dir ? dir : ".";
+    return path + "/" + name;
+}
+
+bool writeFile(const std::string &path, const std::vector<uint8_t> &bytes) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    auto written = fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+    return written == bytes.size();
+}
+
+} // namespace
+
+TEST(mappedFileTest, mapWholeFile) {
+    std::vector<uint8_t> bytes(70000);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    auto path = tempFilePath("mapped_file_test.bin");
+    ASSERT_TRUE(writeFile(path, bytes));
+
+    cc::middleware::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_TRUE(file.isOpen());
+    ASSERT_EQ(file.getSize(), bytes.size());
+    EXPECT_EQ(memcmp(file.getData(), bytes.data(), bytes.size()), 0);
+
+    file.close();
+    EXPECT_FALSE(file.isOpen());
+    EXPECT_EQ(file.getData(), nullptr);
+    EXPECT_EQ(file.getSize(), 0);
+    remove(path.c_str());
+}
+
+TEST(mappedFileTest, missingAndEmptyFiles) {
+    cc::middleware::MappedFile file;
+    EXPECT_FALSE(file.open(tempFilePath("mapped_file_test_missing.bin")));
+    EXPECT_FALSE(file.isOpen());
+
+    // an empty file has nothing to map
+    auto path = tempFilePath("mapped_file_test_empty.bin");
+    ASSERT_TRUE(writeFile(path, {}));
+    EXPECT_FALSE(file.open(path));
+    EXPECT_FALSE(file.isOpen());
+    remove(path.c_str());
+}
+
+#endif
@@ -0,0 +1,150 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cocos/base/std/container/vector.h"
+#include "cocos/base/threading/MessageQueue.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// the ENQUEUE_MESSAGE_* macros refer to it unqualified
+using cc::Message;
+
+constexpr uint32_t RECORDER_COUNT = 4;
+// large enough to make every recorder switch memory chunks a few times
+constexpr uint32_t MESSAGES_PER_RECORDER = 1000;
+constexpr uint32_t PAYLOAD_SIZE = 64;
+
+void record(cc::MessageRecorder *recorder, uint32_t recorderIndex, ccstd::vector<uint32_t> *executed) {
+    uint32_t payload[PAYLOAD_SIZE];
+    for (uint32_t i = 0; i < MESSAGES_PER_RECORDER; ++i) {
+        for (uint32_t &value : payload) {
+            value = recorderIndex * MESSAGES_PER_RECORDER + i;
+        }
+        const uint32_t *data = recorder->allocateAndCopy<uint32_t>(PAYLOAD_SIZE, payload);
+
+        ENQUEUE_MESSAGE_2(
+            recorder, RecordedMessage,
+            executed, executed,
+            data, data,
+            {
+                for (uint32_t j = 1; j < PAYLOAD_SIZE; ++j) {
+                    EXPECT_EQ(data[j], data[0]);
+                }
+                executed->push_back(data[0]);
+            });
+    }
+}
+
+void pushMarker(cc::MessageQueue *queue, ccstd::vector<uint32_t> *executed, uint32_t marker) {
+    ENQUEUE_MESSAGE_2(
+        queue, MarkerMessage,
+        executed, executed,
+        marker, marker,
+        {
+            executed->push_back(marker);
+        });
+}
+
+void runFrame(cc::MessageQueue *queue) {
+    // only touched by the consumer thread, or by this thread in immediate mode
+    ccstd::vector<uint32_t> executed;
+    constexpr uint32_t MARKER = 0xFFFFFFFF;
+    pushMarker(queue, &executed, MARKER);
+
+    ccstd::vector<std::thread> workers;
+    // start in reversed order, the result should not depend on it
+    for (uint32_t i = RECORDER_COUNT; i-- > 0;) {
+        workers.emplace_back(record, queue->getRecorder(i), i, &executed);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    queue->kickAndWait();
+
+    ASSERT_EQ(executed.size(), RECORDER_COUNT * MESSAGES_PER_RECORDER + 1);
+    EXPECT_EQ(executed[0], MARKER);
+    for (uint32_t i = 1; i < executed.size(); ++i) {
+        EXPECT_EQ(executed[i], i - 1);
+    }
+}
+
+} // namespace
+
+TEST(messageQueueTest, multiProducer) {
+    auto *queue = ccnew cc::MessageQueue;
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+    queue->setMultiProducerMode(RECORDER_COUNT);
+    EXPECT_TRUE(queue->isMultiProducerMode());
+
+    runFrame(queue);
+    // recorders are reusable after merged
+    runFrame(queue);
+
+    queue->terminateConsumerThread();
+    queue->setMultiProducerMode(0);
+    EXPECT_FALSE(queue->isMultiProducerMode());
+    delete queue;
+}
+
+TEST(messageQueueTest, multiProducerImmediateMode) {
+    auto *queue = ccnew cc::MessageQueue;
+    queue->setMultiProducerMode(RECORDER_COUNT);
+
+    runFrame(queue);
+
+    delete queue;
+}
+
+TEST(messageQueueTest, destroyRecorderWithoutMerging) {
+    auto *queue = ccnew cc::MessageQueue;
+    queue->setImmediateMode(false);
+    queue->setMultiProducerMode(1);
+    auto *recorder = queue->getRecorder(0);
+
+    // the messages hold a reference each, which is released only if they are destroyed
+    auto token = std::make_shared<uint32_t>(0);
+    uint32_t payload[PAYLOAD_SIZE]{};
+    const uint32_t messageCount = 2 * cc::MessageQueue::MEMORY_CHUNK_SIZE / (PAYLOAD_SIZE * sizeof(uint32_t));
+    for (uint32_t i = 0; i < messageCount; ++i) {
+        recorder->allocateAndCopy<uint32_t>(PAYLOAD_SIZE, payload);
+        ENQUEUE_MESSAGE_1(
+            recorder, TokenMessage,
+            token, token,
+            {
+                ++*token;
+            });
+    }
+    // a head message, and a switch and a head message for every chunk boundary crossed
+    EXPECT_GT(recorder->getMessageCount(), messageCount + 1);
+    EXPECT_EQ(token.use_count(), static_cast<long>(messageCount) + 1);
+
+    // dropped with the queue, before any kick merges the recorded messages
+    delete queue;
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_EQ(*token, 0);
+}
@@ -0,0 +1,333 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+
+#if CC_USE_MIDDLEWARE
+    #include "cocos/2d/renderer/Batcher2d.h"
+    #include "cocos/2d/renderer/UIMeshBuffer.h"
+    #include "cocos/base/job-system/JobSystem.h"
+    #include "cocos/core/Root.h"
+    #include "cocos/editor-support/MiddlewareManager.h"
+    #include "cocos/renderer/pipeline/PipelineSceneData.h"
+    #include "cocos/renderer/pipeline/RenderPipeline.h"
+    #if CC_USE_SPINE
+        #include "cocos/editor-support/spine-creator-support/SkeletonAnimation.h"
+        #include "cocos/editor-support/spine-creator-support/spine-cocos2dx.h"
+        #include "cocos/editor-support/spine/spine.h"
+    #endif
+
+using namespace cc;
+using cc::middleware::IMiddleware;
+using cc::middleware::MiddlewareManager;
+
+namespace {
+
+constexpr float DELTA_TIME = 1.F / 30.F;
+constexpr uint32_t FRAME_COUNT = 3;
+// more instances than the parallel threshold of MiddlewareManager
+constexpr uint32_t INSTANCE_COUNT = 48;
+constexpr uint32_t VERTEX_FLOATS = VF_XYZUVC;
+// more vertices than the two buffers reserved for a segment hold
+constexpr uint32_t OVERFLOW_QUAD_COUNT = MAX_VERTEX_BUFFER_SIZE / 2;
+
+// Writes quads the way SkeletonRenderer does, and records draws like its RenderDrawInfos.
+class QuadMiddleware final : public IMiddleware {
+public:
+    struct Draw {
+        UIMeshBuffer *meshBuffer{nullptr};
+        uint32_t indexOffset{0};
+        uint32_t indexCount{0};
+    };
+
+    QuadMiddleware(MiddlewareManager *manager, uint32_t id, uint32_t quadCount, bool parallelRender, std::vector<uint32_t> *events)
+    : _manager(manager), _id(id), _quadCount(quadCount), _parallelRender(parallelRender), _events(events) {}
+
+    void update(float /*dt*/) override {
+        ++_frame;
+        _events->push_back(_id);
+    }
+
+    bool isParallelUpdateSafe() const override { return true; }
+
+    void updateParallelly(float /*dt*/) override {
+        ++_frame;
+        ++_pendingEvents;
+    }
+
+    void dispatchEvents() override {
+        for (; _pendingEvents > 0; --_pendingEvents) {
+            _events->push_back(_id);
+        }
+    }
+
+    bool prepareParallelRender(int &vertexFormat) override {
+        vertexFormat = VF_XYZUVC;
+        return _parallelRender;
+    }
+
+    void render(float /*dt*/) override {
+        _draws.clear();
+        auto *mb = _manager->getMeshBuffer(VF_XYZUVC);
+        auto &vb = mb->getVB();
+        auto &ib = mb->getIB();
+        constexpr uint32_t vbSize = 4 * VERTEX_FLOATS * sizeof(float);
+        constexpr uint32_t ibSize = 6 * sizeof(uint16_t);
+
+        beginDraw(mb);
+        for (uint32_t quad = 0; quad < _quadCount; ++quad) {
+            // a full vertex buffer is uploaded and the following quads go to the next one
+            if (vb.checkSpace(vbSize, true)) {
+                beginDraw(mb);
+            }
+            ib.checkSpace(ibSize, true);
+            const auto vertexOffset = static_cast<uint16_t>(vb.getCurPos() / (VERTEX_FLOATS * sizeof(float)));
+            for (uint32_t corner = 0; corner < 4; ++corner) {
+                for (uint32_t i = 0; i < VERTEX_FLOATS; ++i) {
+                    vb.writeFloat32(static_cast<float>(_id * 1000 + _frame * 100 + corner * 10 + i) + static_cast<float>(quad) / 65536.F);
+                }
+            }
+            for (uint16_t index : {0, 1, 2, 1, 3, 2}) {
+                ib.writeUint16(vertexOffset + index);
+            }
+            _draws.back().indexCount += 6;
+        }
+    }
+
+    // vertices of the triangles in draw order, independent of the buffers and offsets they were written to
+    std::vector<float> getTriangleVertices() const {
+        std::vector<float> vertices;
+        for (const auto &draw : _draws) {
+            const uint16_t *indices = draw.meshBuffer->getIData() + draw.indexOffset;
+            for (uint32_t i = 0; i < draw.indexCount; ++i) {
+                const float *vertex = draw.meshBuffer->getVData() + indices[i] * VERTEX_FLOATS;
+                vertices.insert(vertices.end(), vertex, vertex + VERTEX_FLOATS);
+            }
+        }
+        return vertices;
+    }
+
+    const std::vector<Draw> &getDraws() const { return _draws; }
+
+private:
+    void beginDraw(middleware::MeshBuffer *mb) {
+        _draws.push_back({mb->getUIMeshBuffer(), static_cast<uint32_t>(mb->getIB().getCurPos() / sizeof(uint16_t)), 0});
+    }
+
+    MiddlewareManager *_manager{nullptr};
+    uint32_t _id{0};
+    uint32_t _quadCount{0};
+    bool _parallelRender{true};
+    std::vector<uint32_t> *_events{nullptr};
+    uint32_t _frame{0};
+    uint32_t _pendingEvents{0};
+    std::vector<Draw> _draws;
+};
+
+// a pipeline without flows, setting it creates the batcher the mesh buffers are synced to
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+};
+
+class MiddlewareManagerParallelTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (JobSystem::getInstance()->threadCount() < 2) {
+            GTEST_SKIP() << "the parallel paths need more than one job system worker";
+        }
+        auto *root = Root::getInstance();
+        if (!root->getPipeline()) {
+            root->setRenderPipeline(ccnew HeadlessPipeline());
+        }
+        ASSERT_NE(root->getBatcher2D(), nullptr);
+        _parallel.setParallelEnabled(true);
+    }
+
+    void TearDown() override {
+        // the batcher must not keep the buffers of the destroyed managers
+        if (auto *batcher = Root::getInstance()->getBatcher2D()) {
+            batcher->syncMeshBuffersToNative(65534, {});
+            batcher->syncMeshBuffersToNative(65535, {});
+        }
+    }
+
+    void addInstances(uint32_t overflowIndex) {
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i) {
+            const uint32_t quadCount = i == overflowIndex ? OVERFLOW_QUAD_COUNT : 10 + i * 7;
+            // some instances can't leave main thread and are rendered in between the segments
+            const bool parallelRender = i % 10 != 3;
+            _serialInstances.push_back(std::make_unique<QuadMiddleware>(&_serial, i, quadCount, parallelRender, &_serialEvents));
+            _parallelInstances.push_back(std::make_unique<QuadMiddleware>(&_parallel, i, quadCount, parallelRender, &_parallelEvents));
+            _serial.addTimer(_serialInstances.back().get());
+            _parallel.addTimer(_parallelInstances.back().get());
+        }
+    }
+
+    void runFrame() {
+        _serial.update(DELTA_TIME);
+        _serial.render(DELTA_TIME);
+        _parallel.update(DELTA_TIME);
+        _parallel.render(DELTA_TIME);
+    }
+
+    void expectSameOutput() {
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i) {
+            auto expected = _serialInstances[i]->getTriangleVertices();
+            EXPECT_FALSE(expected.empty());
+            EXPECT_EQ(_parallelInstances[i]->getTriangleVertices(), expected) << "instance " << i;
+        }
+        // events are raised on main thread in update order
+        EXPECT_EQ(_parallelEvents, _serialEvents);
+    }
+
+    // whether the instance was rendered into the buffers shared by main thread
+    bool isRenderedOnMainThread(uint32_t index) {
+        const auto &shared = _parallel.getMeshBuffer(VF_XYZUVC)->uiMeshBuffers();
+        for (const auto &draw : _parallelInstances[index]->getDraws()) {
+            if (std::find(shared.begin(), shared.end(), draw.meshBuffer) == shared.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    MiddlewareManager _serial;
+    MiddlewareManager _parallel;
+    std::vector<std::unique_ptr<QuadMiddleware>> _serialInstances;
+    std::vector<std::unique_ptr<QuadMiddleware>> _parallelInstances;
+    std::vector<uint32_t> _serialEvents;
+    std::vector<uint32_t> _parallelEvents;
+};
+
+} // namespace
+
+TEST_F(MiddlewareManagerParallelTest, matchesSerialOutput) {
+    addInstances(INSTANCE_COUNT);
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        runFrame();
+        expectSameOutput();
+        EXPECT_TRUE(isRenderedOnMainThread(3));
+        EXPECT_FALSE(isRenderedOnMainThread(0));
+    }
+    EXPECT_EQ(_parallelEvents.size(), INSTANCE_COUNT * FRAME_COUNT);
+}
+
+TEST_F(MiddlewareManagerParallelTest, rendersOverflowedSegmentAgain) {
+    constexpr uint32_t overflowIndex = INSTANCE_COUNT / 2;
+    addInstances(overflowIndex);
+
+    // the segment runs out of its locked buffers and is rendered again into the shared ones
+    runFrame();
+    expectSameOutput();
+    EXPECT_GT(_serialInstances[overflowIndex]->getDraws().size(), 2U);
+    EXPECT_TRUE(isRenderedOnMainThread(overflowIndex));
+
+    // growth reserved enough buffers for the segment to be filled on the worker
+    for (uint32_t frame = 1; frame < FRAME_COUNT; ++frame) {
+        runFrame();
+        expectSameOutput();
+        EXPECT_FALSE(isRenderedOnMainThread(overflowIndex));
+    }
+}
+
+    #if CC_USE_SPINE
+
+namespace {
+
+// an event halfway through a looping animation, so every skeleton raises event and complete callbacks
+const char *const EVENT_SKELETON_JSON =
+    R"({"skeleton":{"hash":"middleware-manager-parallel-test","spine":"3.8.99"},)"
+    R"("bones":[{"name":"root"}],)"
+    R"("events":{"hit":{}},)"
+    R"("animations":{"attack":{"events":[{"time":0.05,"name":"hit"}],)"
+    R"("bones":{"root":{"rotate":[{"time":0,"angle":0},{"time":0.1,"angle":90}]}}}}})";
+
+enum class SpineEvent : uint32_t {
+    HIT,
+    COMPLETE,
+};
+
+} // namespace
+
+TEST(MiddlewareManagerParallelSpineTest, drainsEventQueuesOnMainThread) {
+    if (JobSystem::getInstance()->threadCount() < 2) {
+        GTEST_SKIP() << "the parallel update needs more than one job system worker";
+    }
+    auto *atlas = new (__FILE__, __LINE__) spine::Atlas("", 0, "", nullptr, false);
+    auto *attachmentLoader = new (__FILE__, __LINE__) spine::Cocos2dAtlasAttachmentLoader(atlas);
+    spine::SkeletonJson json(attachmentLoader);
+    auto *skeletonData = json.readSkeletonData(EVENT_SKELETON_JSON);
+    ASSERT_NE(skeletonData, nullptr);
+
+    const auto mainThread = std::this_thread::get_id();
+    MiddlewareManager managers[2];
+    managers[1].setParallelEnabled(true);
+    std::vector<std::pair<uint32_t, SpineEvent>> events[2];
+    std::vector<spine::SkeletonAnimation *> skeletons;
+    for (uint32_t m = 0; m < 2; ++m) {
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i) {
+            auto *skeleton = spine::SkeletonAnimation::createWithData(skeletonData, false);
+            skeleton->addRef();
+            auto *log = &events[m];
+            skeleton->setEventListener([log, i, mainThread](spine::TrackEntry * /*entry*/, spine::Event * /*event*/) {
+                EXPECT_EQ(std::this_thread::get_id(), mainThread);
+                log->emplace_back(i, SpineEvent::HIT);
+            });
+            skeleton->setCompleteListener([log, i, mainThread](spine::TrackEntry * /*entry*/) {
+                EXPECT_EQ(std::this_thread::get_id(), mainThread);
+                log->emplace_back(i, SpineEvent::COMPLETE);
+            });
+            // out of phase, so the skeletons raise their events in different frames
+            skeleton->setAnimation(0, "attack", true)->setTrackTime(static_cast<float>(i % 4) * 0.025F);
+            ASSERT_TRUE(skeleton->isParallelUpdateSafe());
+            managers[m].addTimer(skeleton);
+            skeletons.push_back(skeleton);
+        }
+    }
+
+    for (uint32_t frame = 0; frame < 8; ++frame) {
+        managers[0].update(DELTA_TIME);
+        managers[1].update(DELTA_TIME);
+        EXPECT_EQ(events[1], events[0]) << "frame " << frame;
+    }
+    EXPECT_FALSE(events[0].empty());
+
+    for (auto *skeleton : skeletons) {
+        skeleton->release();
+    }
+    delete skeletonData;
+    delete attachmentLoader;
+    delete atlas;
+}
+
+    #endif // CC_USE_SPINE
+
+#endif // CC_USE_MIDDLEWARE
@@ -0,0 +1,212 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <iterator>
+#include <vector>
+
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "gtest/gtest.h"
+#include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "scene/Camera.h"
+#include "scene/LODGroup.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+#include "scene/RenderWindow.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t GROUP_COUNT = 4;
+constexpr uint32_t CAMERA_COUNT = 2;
+constexpr uint32_t PAIR_COUNT = GROUP_COUNT * CAMERA_COUNT;
+constexpr float SCREEN_USAGES[] = {0.5F, 0.2F, 0.05F};
+
+// a pipeline without flows, RenderScene::update only reads its scene data
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+};
+
+class RenderSceneLodUpdateTest : public testing::Test {
+protected:
+    void SetUp() override {
+        auto *root = Root::getInstance();
+        if (!root->getPipeline()) {
+            root->setRenderPipeline(ccnew HeadlessPipeline());
+        }
+        ASSERT_NE(root->getPipeline(), nullptr);
+
+        _scene = ccnew scene::RenderScene();
+        _scene->initialize({"lod"});
+        _root = ccnew Node("root");
+        _scene->setRootNode(_root);
+
+        scene::IRenderWindowInfo windowInfo;
+        windowInfo.title = "lod";
+        windowInfo.width = 64;
+        windowInfo.height = 64;
+        windowInfo.renderPassInfo.colorAttachments.push_back({gfx::Format::RGBA8});
+        windowInfo.renderPassInfo.depthStencilAttachment.format = gfx::Format::DEPTH_STENCIL;
+        _window = root->createWindow(windowInfo);
+
+        // cameras are registered before the groups, and see the layer of their nodes
+        for (uint32_t i = 0; i < CAMERA_COUNT; ++i) {
+            auto *node = ccnew Node("camera");
+            node->setParent(_root);
+            node->setPosition(0.F, 0.F, 10.F + static_cast<float>(i) * 10.F);
+            _cameraNodes.emplace_back(node);
+
+            auto *camera = ccnew scene::Camera(root->getDevice());
+            scene::ICameraInfo cameraInfo;
+            cameraInfo.name = "lod";
+            cameraInfo.node = node;
+            cameraInfo.projection = scene::CameraProjection::PERSPECTIVE;
+            cameraInfo.window = _window;
+            camera->initialize(cameraInfo);
+            camera->setVisibility(0xFFFFFFFFU);
+            _scene->addCamera(camera);
+            _cameras.emplace_back(camera);
+        }
+
+        // three levels with one model each, a row of groups in front of the cameras
+        for (uint32_t i = 0; i < GROUP_COUNT; ++i) {
+            auto *node = ccnew Node("lod");
+            node->setParent(_root);
+            node->setPosition(static_cast<float>(i) * 4.F, 0.F, 0.F);
+            _groupNodes.emplace_back(node);
+
+            auto *group = ccnew scene::LODGroup();
+            group->setNode(node);
+            for (uint8_t level = 0; level < std::size(SCREEN_USAGES); ++level) {
+                auto *model = ccnew scene::Model();
+                model->initialize();
+                model->setNode(node);
+                model->setTransform(node);
+                auto *lod = ccnew scene::LODData();
+                lod->setScreenUsagePercentage(SCREEN_USAGES[level]);
+                lod->addModel(model);
+                group->insertLOD(level, lod);
+            }
+            _scene->addLODGroup(group);
+            _groups.emplace_back(group);
+        }
+    }
+
+    void TearDown() override {
+        if (!_scene) {
+            return;
+        }
+        _scene->destroy();
+        for (auto &camera : _cameras) {
+            camera->destroy();
+        }
+        Root::getInstance()->destroyWindow(_window);
+    }
+
+    void runFrame() {
+        for (auto &camera : _cameras) {
+            camera->update();
+        }
+        _scene->update(_frame++);
+        // every selected level is the one the group computes from scratch
+        for (const auto &camera : _cameras) {
+            for (const auto &group : _groups) {
+                // disabled groups keep the levels of the frame they were disabled in
+                if (!group->isEnabled()) {
+                    continue;
+                }
+                const int8_t level = group->getVisibleLODLevel(camera);
+                for (uint8_t i = 0; i < group->getLodCount(); ++i) {
+                    const auto *model = group->getLodDataArray()[i]->getModels()[0].get();
+                    EXPECT_EQ(_scene->isCulledByLod(camera, model), i != level) << "frame " << _frame << " level " << static_cast<int>(i);
+                }
+            }
+        }
+        Node::resetChangedFlags();
+    }
+
+    void expectPairs(uint32_t recomputed, uint32_t reused) {
+        EXPECT_EQ(_scene->getLodRecomputedPairCount(), recomputed);
+        EXPECT_EQ(_scene->getLodReusedPairCount(), reused);
+    }
+
+    IntrusivePtr<scene::RenderScene> _scene;
+    IntrusivePtr<Node> _root;
+    scene::RenderWindow *_window{nullptr};
+    std::vector<IntrusivePtr<Node>> _cameraNodes;
+    std::vector<IntrusivePtr<scene::Camera>> _cameras;
+    std::vector<IntrusivePtr<Node>> _groupNodes;
+    std::vector<IntrusivePtr<scene::LODGroup>> _groups;
+    uint32_t _frame{0};
+};
+
+} // namespace
+
+TEST_F(RenderSceneLodUpdateTest, recomputesOnlyDirtyPairs) {
+    // new groups are computed for every camera
+    runFrame();
+    expectPairs(PAIR_COUNT, 0);
+
+    // nothing moved, every pair is reused
+    runFrame();
+    expectPairs(0, PAIR_COUNT);
+
+    // a moved camera recomputes its pairs with all groups, and switches to a finer level of the nearest group
+    const int8_t farLevel = _groups[0]->getVisibleLODLevel(_cameras[0]);
+    _cameraNodes[0]->setPosition(0.F, 0.F, 2.F);
+    runFrame();
+    expectPairs(GROUP_COUNT, PAIR_COUNT - GROUP_COUNT);
+    EXPECT_LT(_groups[0]->getVisibleLODLevel(_cameras[0]), farLevel);
+
+    // a moved group recomputes its pairs with all cameras
+    _groupNodes[1]->setPosition(4.F, 0.F, 9.F);
+    runFrame();
+    expectPairs(CAMERA_COUNT, PAIR_COUNT - CAMERA_COUNT);
+
+    // a projection change makes the camera dirty like a move does
+    _cameras[1]->setFov(_cameras[1]->getFov() * 0.5F);
+    runFrame();
+    expectPairs(GROUP_COUNT, PAIR_COUNT - GROUP_COUNT);
+
+    runFrame();
+    expectPairs(0, PAIR_COUNT);
+}
+
+TEST_F(RenderSceneLodUpdateTest, recomputesGroupsEnabledAgain) {
+    runFrame();
+
+    // the camera moves while the group is disabled, its pairs are stale once it is enabled
+    _groups[0]->setEnabled(false);
+    _cameraNodes[0]->setPosition(0.F, 0.F, 2.F);
+    runFrame();
+    // the pairs of a disabled group are neither recomputed nor reused
+    expectPairs(GROUP_COUNT - 1, GROUP_COUNT - 1);
+    _groups[0]->setEnabled(true);
+    runFrame();
+    expectPairs(CAMERA_COUNT, PAIR_COUNT - CAMERA_COUNT);
+}
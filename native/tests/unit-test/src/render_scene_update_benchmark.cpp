@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+#include <chrono>
+
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t FRAME_COUNT = 16;
+
+// a pipeline without flows, RenderScene::update only reads its scene data
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+};
+
+bool ensurePipeline() {
+    auto *root = Root::getInstance();
+    if (!root) {
+        return false;
+    }
+    if (!root->getPipeline()) {
+        root->setRenderPipeline(ccnew HeadlessPipeline());
+    }
+    return root->getPipeline() != nullptr;
+}
+
+double benchmarkRenderSceneUpdate(uint32_t modelCount, bool parallel) {
+    IntrusivePtr<scene::RenderScene> renderScene = ccnew scene::RenderScene();
+    renderScene->initialize({"benchmark"});
+    renderScene->setParallelUpdateEnabled(parallel);
+
+    IntrusivePtr<Node> root = ccnew Node("root");
+    renderScene->setRootNode(root);
+    ccstd::vector<IntrusivePtr<Node>> nodes;
+    nodes.reserve(modelCount);
+    for (uint32_t i = 0; i < modelCount; ++i) {
+        auto *node = ccnew Node();
+        node->setParent(root);
+        nodes.emplace_back(node);
+
+        auto *model = ccnew scene::Model();
+        model->initialize();
+        model->setNode(node);
+        model->setTransform(node);
+        model->createBoundingShape(Vec3{-1.F, -1.F, -1.F}, Vec3{1.F, 1.F, 1.F});
+        renderScene->addModel(model);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (uint32_t i = 0; i < modelCount; ++i) {
+            nodes[i]->setPosition(static_cast<float>(i % 256), static_cast<float>(frame), static_cast<float>(i / 256));
+        }
+        renderScene->update(frame);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    renderScene->destroy();
+    return std::chrono::duration<double, std::milli>(end - start).count() / FRAME_COUNT;
+}
+
+} // namespace
+
+TEST(renderSceneUpdateBenchmark, models) {
+    ASSERT_TRUE(ensurePipeline());
+
+    for (uint32_t modelCount : {1000U, 10000U, 100000U}) {
+        const double serial = benchmarkRenderSceneUpdate(modelCount, false);
+        const double parallel = benchmarkRenderSceneUpdate(modelCount, true);
+        CC_LOG_INFO("RenderScene::update %6u models, %u workers: serial %.3f ms, parallel %.3f ms",
+                    modelCount, JobSystem::getInstance()->threadCount(), serial, parallel);
+        EXPECT_GT(serial, 0.0);
+        EXPECT_GT(parallel, 0.0);
+    }
+}
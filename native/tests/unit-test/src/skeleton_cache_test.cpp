@@ -0,0 +1,257 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+#if CC_USE_SPINE
+    #include "cocos/editor-support/spine-creator-support/SkeletonCache.h"
+    #include "cocos/editor-support/spine-creator-support/spine-cocos2dx.h"
+    #include "cocos/editor-support/spine/spine.h"
+
+namespace {
+
+// one bone turning for half a second, attachments are not needed to bake bone frames
+std::string skeletonJson(const char *hash) {
+    return std::string(R"({"skeleton":{"hash":")") + hash + R"(","spine":"3.8.99"},)"
+           R"("bones":[{"name":"root"},{"name":"arm","parent":"root","length":10}],)"
+           R"("slots":[{"name":"armSlot","bone":"arm"}],)"
+           R"("animations":{"move":{"bones":{"arm":{"rotate":[{"time":0,"angle":0},{"time":0.5,"angle":90}]}}}}})";
+}
+
+std::string tempFilePath(const char *name) {
+    const char *dir = std::getenv("TMPDIR");
+    std::string path = dir ? dir : ".";
+    return path + "/" + name;
+}
+
+std::vector<uint8_t> readFile(const std::string &path) {
+    std::vector<uint8_t> bytes;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) return bytes;
+    fseek(file, 0, SEEK_END);
+    bytes.resize(static_cast<std::size_t>(ftell(file)));
+    fseek(file, 0, SEEK_SET);
+    auto read = fread(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+    bytes.resize(read);
+    return bytes;
+}
+
+bool writeFile(const std::string &path, const std::vector<uint8_t> &bytes) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    auto written = fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+    return written == bytes.size();
+}
+
+class SkeletonCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _backgroundBuild = spine::SkeletonCache::isBackgroundBuildEnabled();
+        _cacheDirectory = spine::SkeletonCache::getCacheDirectory();
+        _atlas = new (__FILE__, __LINE__) spine::Atlas("", 0, "", nullptr, false);
+        _attachmentLoader = new (__FILE__, __LINE__) spine::Cocos2dAtlasAttachmentLoader(_atlas);
+    }
+
+    void TearDown() override {
+        for (auto *cache : _caches) {
+            cache->release();
+        }
+        delete _attachmentLoader;
+        delete _atlas;
+        spine::SkeletonCache::setBackgroundBuildEnabled(_backgroundBuild);
+        spine::SkeletonCache::setCacheDirectory(_cacheDirectory);
+    }
+
+    spine::SkeletonCache *createCache(const char *hash) {
+        spine::SkeletonJson json(_attachmentLoader);
+        auto *skeletonData = json.readSkeletonData(skeletonJson(hash).c_str());
+        EXPECT_NE(skeletonData, nullptr);
+        auto *cache = new spine::SkeletonCache();
+        cache->addRef();
+        cache->initWithData(skeletonData, true);
+        _caches.push_back(cache);
+        return cache;
+    }
+
+    // bakes the whole animation on the calling thread
+    spine::SkeletonCache::AnimationData *bake(spine::SkeletonCache *cache) {
+        spine::SkeletonCache::setBackgroundBuildEnabled(false);
+        auto *animationData = cache->buildAnimationData("move");
+        cache->updateToFrame("move");
+        return animationData;
+    }
+
+    // polls like the per frame render does until the worker has published the animation
+    static bool waitForBuild(spine::SkeletonCache *cache, spine::SkeletonCache::AnimationData *animationData) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (animationData->isBuilding() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            cache->updateToFrame("move");
+        }
+        return !animationData->isBuilding();
+    }
+
+    bool _backgroundBuild{true};
+    std::string _cacheDirectory;
+    spine::Atlas *_atlas{nullptr};
+    spine::AttachmentLoader *_attachmentLoader{nullptr};
+    std::vector<spine::SkeletonCache *> _caches;
+};
+
+void expectSameFrames(const spine::SkeletonCache::AnimationData *a, const spine::SkeletonCache::AnimationData *b) {
+    ASSERT_EQ(a->getFrameCount(), b->getFrameCount());
+    EXPECT_EQ(a->isComplete(), b->isComplete());
+    for (std::size_t i = 0; i < a->getFrameCount(); i++) {
+        const auto *frameA = a->getFrameData(i);
+        const auto *frameB = b->getFrameData(i);
+        ASSERT_EQ(frameA->boneCount, frameB->boneCount);
+        EXPECT_EQ(memcmp(a->getBones(*frameA), b->getBones(*frameB), frameA->boneCount * sizeof(spine::SkeletonCache::BoneData)), 0);
+        EXPECT_EQ(frameA->segmentCount, frameB->segmentCount);
+        EXPECT_EQ(frameA->indexCount, frameB->indexCount);
+    }
+}
+
+} // namespace
+
+TEST_F(SkeletonCacheTest, saveAndLoad) {
+    auto *baked = bake(createCache("save-and-load"));
+    ASSERT_NE(baked, nullptr);
+    ASSERT_GT(baked->getFrameCount(), 1);
+    EXPECT_TRUE(baked->isComplete());
+
+    auto path = tempFilePath("skeleton_cache_test.skc");
+    ASSERT_TRUE(baked->save(path, 0x123456789abcdef0ULL, 0));
+
+    spine::SkeletonCache::AnimationData loaded;
+    ASSERT_TRUE(loaded.load(path, 0x123456789abcdef0ULL, 0));
+    expectSameFrames(baked, &loaded);
+
+    // a mapped animation is not written again
+    EXPECT_FALSE(loaded.save(tempFilePath("skeleton_cache_test_copy.skc"), 0x123456789abcdef0ULL, 0));
+    remove(path.c_str());
+}
+
+TEST_F(SkeletonCacheTest, loadRejectsMismatchedOrDamagedFiles) {
+    auto *baked = bake(createCache("rejects"));
+    ASSERT_NE(baked, nullptr);
+    auto path = tempFilePath("skeleton_cache_test_rejects.skc");
+    ASSERT_TRUE(baked->save(path, 42, 0));
+    auto bytes = readFile(path);
+    ASSERT_FALSE(bytes.empty());
+
+    spine::SkeletonCache::AnimationData loaded;
+    // only the upper half of the signature differs
+    EXPECT_FALSE(loaded.load(path, 42 | (1ULL << 40), 0));
+    EXPECT_EQ(loaded.getFrameCount(), 0);
+    EXPECT_FALSE(loaded.load(path, 42, 1));
+    EXPECT_FALSE(loaded.load(tempFilePath("skeleton_cache_test_missing.skc"), 42, 0));
+
+    auto truncated = bytes;
+    truncated.pop_back();
+    ASSERT_TRUE(writeFile(path, truncated));
+    EXPECT_FALSE(loaded.load(path, 42, 0));
+
+    // the frames come right after the header, which is whatever the arrays leave over
+    const auto *lastFrame = baked->getFrameData(baked->getFrameCount() - 1);
+    auto arraysSize = baked->getFrameCount() * sizeof(spine::SkeletonCache::FrameData) +
+                      (lastFrame->boneOffset + lastFrame->boneCount) * sizeof(spine::SkeletonCache::BoneData) +
+                      (lastFrame->colorOffset + lastFrame->colorCount) * sizeof(spine::SkeletonCache::ColorData) +
+                      (lastFrame->segmentOffset + lastFrame->segmentCount) * sizeof(spine::SkeletonCache::SegmentData) +
+                      (lastFrame->vertexFloatOffset + lastFrame->vertexFloatCount) * sizeof(float) +
+                      (lastFrame->indexOffset + lastFrame->indexCount) * sizeof(uint16_t);
+    ASSERT_LT(arraysSize, bytes.size());
+    auto corrupted = bytes;
+    spine::SkeletonCache::FrameData frame;
+    auto *frameBytes = corrupted.data() + (bytes.size() - arraysSize);
+    memcpy(&frame, frameBytes, sizeof(frame));
+    frame.boneOffset = 0xffffff00U;
+    memcpy(frameBytes, &frame, sizeof(frame));
+    ASSERT_TRUE(writeFile(path, corrupted));
+    EXPECT_FALSE(loaded.load(path, 42, 0));
+    EXPECT_EQ(loaded.getFrameCount(), 0);
+
+    ASSERT_TRUE(writeFile(path, bytes));
+    EXPECT_TRUE(loaded.load(path, 42, 0));
+    remove(path.c_str());
+}
+
+TEST_F(SkeletonCacheTest, publishBackgroundBuild) {
+    auto *serial = bake(createCache("background"));
+    ASSERT_NE(serial, nullptr);
+
+    spine::SkeletonCache::setBackgroundBuildEnabled(true);
+    auto *cache = createCache("background");
+    auto *animationData = cache->buildAnimationData("move");
+    cache->updateToFrame("move");
+    // only the first frame is there until the worker is done
+    ASSERT_TRUE(animationData->isBuilding());
+    EXPECT_EQ(animationData->getFrameCount(), 1);
+    EXPECT_NE(animationData->getFrameData(0), nullptr);
+
+    ASSERT_TRUE(waitForBuild(cache, animationData));
+    expectSameFrames(serial, animationData);
+}
+
+TEST_F(SkeletonCacheTest, cacheFilesFollowSkeletonContent) {
+    auto directory = std::filesystem::path(tempFilePath("skeleton_cache_test_dir"));
+    std::filesystem::remove_all(directory);
+    ASSERT_TRUE(std::filesystem::create_directories(directory));
+    spine::SkeletonCache::setCacheDirectory(directory.string());
+    spine::SkeletonCache::setBackgroundBuildEnabled(true);
+
+    auto *first = createCache("content-a");
+    auto *built = first->buildAnimationData("move");
+    first->updateToFrame("move");
+    ASSERT_TRUE(waitForBuild(first, built));
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+
+    // the same skeleton maps the saved file instead of baking
+    auto *second = createCache("content-a");
+    auto *mapped = second->buildAnimationData("move");
+    second->updateToFrame("move");
+    EXPECT_FALSE(mapped->isBuilding());
+    expectSameFrames(built, mapped);
+
+    // a re-exported skeleton with the same names must not pick up the old frames
+    auto *changed = createCache("content-b");
+    auto *rebuilt = changed->buildAnimationData("move");
+    changed->updateToFrame("move");
+    EXPECT_TRUE(rebuilt->isBuilding());
+    ASSERT_TRUE(waitForBuild(changed, rebuilt));
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 2);
+
+    std::filesystem::remove_all(directory);
+}
+
+#endif
@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cstring>
+#include <random>
+#include "cocos/base/Log.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/animation/SkinningPalette.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr uint32_t CHARACTER_COUNT = 100;
+constexpr uint32_t JOINT_COUNT = 60;
+constexpr uint32_t TOTAL_JOINT_COUNT = CHARACTER_COUNT * JOINT_COUNT;
+constexpr uint32_t FRAME_COUNT = 100;
+
+struct SkinningInputs {
+    ccstd::vector<cc::Mat4> worlds;
+    ccstd::vector<cc::Mat4> bindposes;
+    ccstd::vector<cc::geometry::AABB> bounds;
+    ccstd::vector<const cc::Mat4 *> worldPtrs;
+    ccstd::vector<const cc::Mat4 *> bindposePtrs;
+    ccstd::vector<const cc::geometry::AABB *> boundPtrs;
+};
+
+cc::Mat4 createRandomMatrix(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> angle(-180.F, 180.F);
+    std::uniform_real_distribution<float> position(-10.F, 10.F);
+    std::uniform_real_distribution<float> scale(0.5F, 2.F);
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(angle(rng), angle(rng), angle(rng), &rotation);
+    cc::Mat4 out;
+    cc::Mat4::fromRTS(rotation, cc::Vec3{position(rng), position(rng), position(rng)}, cc::Vec3{scale(rng), scale(rng), scale(rng)}, &out);
+    return out;
+}
+
+void createInputs(SkinningInputs &inputs) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-1.F, 1.F);
+    std::uniform_real_distribution<float> extent(0.05F, 0.5F);
+    inputs.worlds.reserve(TOTAL_JOINT_COUNT);
+    inputs.bindposes.reserve(TOTAL_JOINT_COUNT);
+    inputs.bounds.reserve(TOTAL_JOINT_COUNT);
+    for (uint32_t i = 0; i < TOTAL_JOINT_COUNT; ++i) {
+        inputs.worlds.emplace_back(createRandomMatrix(rng));
+        inputs.bindposes.emplace_back(createRandomMatrix(rng));
+        inputs.bounds.emplace_back(position(rng), position(rng), position(rng), extent(rng), extent(rng), extent(rng));
+    }
+    for (uint32_t i = 0; i < TOTAL_JOINT_COUNT; ++i) {
+        inputs.worldPtrs.emplace_back(&inputs.worlds[i]);
+        inputs.bindposePtrs.emplace_back(&inputs.bindposes[i]);
+        inputs.boundPtrs.emplace_back(&inputs.bounds[i]);
+    }
+}
+
+// the per joint path SkinningModel used before the batched kernel
+void computeJointPalettesScalar(const SkinningInputs &inputs, uint32_t begin, float *dst) {
+    cc::Mat4 mat;
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        cc::Mat4::multiply(inputs.worlds[begin + i], inputs.bindposes[begin + i], &mat);
+        float *out = dst + i * cc::JOINT_PALETTE_STRIDE;
+        memcpy(out, mat.m, sizeof(float) * 12);
+        out[3] = mat.m[12];
+        out[7] = mat.m[13];
+        out[11] = mat.m[14];
+    }
+}
+
+void computeJointBoundsScalar(const SkinningInputs &inputs, uint32_t begin, cc::Vec3 *outMin, cc::Vec3 *outMax) {
+    outMin->set(INFINITY, INFINITY, INFINITY);
+    outMax->set(-INFINITY, -INFINITY, -INFINITY);
+    cc::geometry::AABB ab;
+    cc::Vec3 v1;
+    cc::Vec3 v2;
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        inputs.bounds[begin + i].transform(inputs.worlds[begin + i], &ab);
+        ab.getBoundary(&v1, &v2);
+        cc::Vec3::min(*outMin, v1, outMin);
+        cc::Vec3::max(*outMax, v2, outMax);
+    }
+}
+
+} // namespace
+
+TEST(skinningPaletteTest, matchesScalarPath) {
+    SkinningInputs inputs;
+    createInputs(inputs);
+
+    ccstd::vector<float> expected(JOINT_COUNT * cc::JOINT_PALETTE_STRIDE);
+    ccstd::vector<float> palette(JOINT_COUNT * cc::JOINT_PALETTE_STRIDE);
+    ccstd::vector<float *> dsts(JOINT_COUNT);
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        dsts[i] = palette.data() + i * cc::JOINT_PALETTE_STRIDE;
+    }
+    for (uint32_t c = 0; c < CHARACTER_COUNT; ++c) {
+        const uint32_t begin = c * JOINT_COUNT;
+        computeJointPalettesScalar(inputs, begin, expected.data());
+        cc::computeJointPalettes(inputs.worldPtrs.data() + begin, inputs.bindposePtrs.data() + begin, dsts.data(), JOINT_COUNT, 4);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(palette[i], expected[i], 1e-3F);
+        }
+
+        cc::Vec3 expectedMin;
+        cc::Vec3 expectedMax;
+        cc::Vec3 min;
+        cc::Vec3 max;
+        computeJointBoundsScalar(inputs, begin, &expectedMin, &expectedMax);
+        cc::computeJointBounds(inputs.worldPtrs.data() + begin, inputs.boundPtrs.data() + begin, JOINT_COUNT, &min, &max);
+        EXPECT_NEAR(min.x, expectedMin.x, 1e-3F);
+        EXPECT_NEAR(min.y, expectedMin.y, 1e-3F);
+        EXPECT_NEAR(min.z, expectedMin.z, 1e-3F);
+        EXPECT_NEAR(max.x, expectedMax.x, 1e-3F);
+        EXPECT_NEAR(max.y, expectedMax.y, 1e-3F);
+        EXPECT_NEAR(max.z, expectedMax.z, 1e-3F);
+    }
+}
+
+TEST(skinningPaletteTest, textureLayout) {
+    SkinningInputs inputs;
+    createInputs(inputs);
+
+    // the real-time joint texture keeps the three rows of a joint in three texture rows
+    constexpr uint32_t WIDTH = 256;
+    ccstd::vector<float> expected(JOINT_COUNT * cc::JOINT_PALETTE_STRIDE);
+    ccstd::vector<float> texture(4 * WIDTH * 3);
+    ccstd::vector<float *> dsts(JOINT_COUNT);
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        dsts[i] = texture.data() + i * 4;
+    }
+    computeJointPalettesScalar(inputs, 0, expected.data());
+    cc::computeJointPalettes(inputs.worldPtrs.data(), inputs.bindposePtrs.data(), dsts.data(), JOINT_COUNT, 4 * WIDTH);
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        for (uint32_t r = 0; r < 3; ++r) {
+            for (uint32_t k = 0; k < 4; ++k) {
+                EXPECT_NEAR(texture[4 * (i + r * WIDTH) + k], expected[i * cc::JOINT_PALETTE_STRIDE + r * 4 + k], 1e-3F);
+            }
+        }
+    }
+
+    cc::Vec3 min;
+    cc::Vec3 max;
+    cc::computeJointBounds(nullptr, nullptr, 0, &min, &max);
+    EXPECT_EQ(min.x, INFINITY);
+    EXPECT_EQ(max.x, -INFINITY);
+}
+
+TEST(skinningPaletteBenchmark, charactersJoints) {
+    SkinningInputs inputs;
+    createInputs(inputs);
+
+    ccstd::vector<float> palette(TOTAL_JOINT_COUNT * cc::JOINT_PALETTE_STRIDE);
+    ccstd::vector<float *> dsts(TOTAL_JOINT_COUNT);
+    for (uint32_t i = 0; i < TOTAL_JOINT_COUNT; ++i) {
+        dsts[i] = palette.data() + i * cc::JOINT_PALETTE_STRIDE;
+    }
+    cc::Vec3 min;
+    cc::Vec3 max;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (uint32_t c = 0; c < CHARACTER_COUNT; ++c) {
+            const uint32_t begin = c * JOINT_COUNT;
+            computeJointBoundsScalar(inputs, begin, &min, &max);
+            computeJointPalettesScalar(inputs, begin, palette.data() + begin * cc::JOINT_PALETTE_STRIDE);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double scalar = std::chrono::duration<double, std::milli>(end - start).count() / FRAME_COUNT;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (uint32_t c = 0; c < CHARACTER_COUNT; ++c) {
+            const uint32_t begin = c * JOINT_COUNT;
+            cc::computeJointBounds(inputs.worldPtrs.data() + begin, inputs.boundPtrs.data() + begin, JOINT_COUNT, &min, &max);
+            cc::computeJointPalettes(inputs.worldPtrs.data() + begin, inputs.bindposePtrs.data() + begin, dsts.data() + begin, JOINT_COUNT, 4);
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    const double batched = std::chrono::duration<double, std::milli>(end - start).count() / FRAME_COUNT;
+
+    CC_LOG_INFO("skinning palette %u characters x %u joints: scalar %.3f ms, batched %.3f ms", CHARACTER_COUNT, JOINT_COUNT, scalar, batched);
+    EXPECT_GT(scalar, 0.0);
+    EXPECT_GT(batched, 0.0);
+}
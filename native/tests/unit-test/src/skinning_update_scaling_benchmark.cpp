@@ -0,0 +1,238 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include "cocos/3d/assets/Mesh.h"
+#include "cocos/3d/assets/Skeleton.h"
+#include "cocos/3d/models/SkinningModel.h"
+#include "cocos/base/Log.h"
+#include "cocos/base/job-system/JobSystem.h"
+#include "cocos/base/std/container/string.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/core/Root.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/math/Vec3.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/renderer/pipeline/PipelineSceneData.h"
+#include "cocos/renderer/pipeline/RenderPipeline.h"
+#include "cocos/scene/RenderScene.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t JOINT_COUNT = 60;
+constexpr uint32_t FRAME_COUNT = 60;
+constexpr float BONE_LENGTH = 0.1F;
+
+// a pipeline without flows, RenderScene::update only reads its scene data
+class HeadlessPipeline final : public pipeline::RenderPipeline {
+public:
+    HeadlessPipeline() {
+        _pipelineSceneData = ccnew pipeline::PipelineSceneData();
+    }
+};
+
+bool ensurePipeline() {
+    auto *root = Root::getInstance();
+    if (!root) {
+        return false;
+    }
+    if (!root->getPipeline()) {
+        root->setRenderPipeline(ccnew HeadlessPipeline());
+    }
+    // the uniform capacity is set by the global descriptor set manager of a real pipeline
+    if (pipeline::SkinningJointCapacity::jointUniformCapacity < JOINT_COUNT) {
+        pipeline::SkinningJointCapacity::jointUniformCapacity = JOINT_COUNT;
+        pipeline::UBOSkinning::initLayout(JOINT_COUNT);
+    }
+    return root->getPipeline() != nullptr;
+}
+
+// joints form a chain along y, joint i is at (0, i * BONE_LENGTH, 0) in bind pose
+ccstd::string jointPath(uint32_t index) {
+    ccstd::string path = "joint0";
+    for (uint32_t i = 1; i <= index; ++i) {
+        path += "/joint" + std::to_string(i);
+    }
+    return path;
+}
+
+IntrusivePtr<Skeleton> createSkeleton() {
+    IntrusivePtr<Skeleton> skeleton = ccnew Skeleton();
+    ccstd::vector<ccstd::string> joints;
+    ccstd::vector<Mat4> bindposes;
+    for (uint32_t i = 0; i < JOINT_COUNT; ++i) {
+        joints.emplace_back(jointPath(i));
+        Mat4 bindpose;
+        Mat4::createTranslation(0.F, -BONE_LENGTH * static_cast<float>(i), 0.F, &bindpose);
+        bindposes.emplace_back(bindpose);
+    }
+    skeleton->setJoints(joints);
+    skeleton->setBindposes(bindposes);
+    return skeleton;
+}
+
+// two vertices per joint, each fully weighted to its joint
+IntrusivePtr<Mesh> createMesh() {
+    constexpr uint32_t vertexCount = JOINT_COUNT * 2;
+    constexpr uint32_t stride = 3 * sizeof(float) + 4 * sizeof(uint16_t) + 4 * sizeof(float);
+    Uint8Array data(vertexCount * stride);
+    uint8_t *dst = data.buffer()->getData();
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        const float side = (i % 2) ? 0.05F : -0.05F;
+        const float position[3] = {side, BONE_LENGTH * static_cast<float>(i / 2) + side, side};
+        const uint16_t joints[4] = {static_cast<uint16_t>(i / 2), 0, 0, 0};
+        const float weights[4] = {1.F, 0.F, 0.F, 0.F};
+        uint8_t *vertex = dst + i * stride;
+        memcpy(vertex, position, sizeof(position));
+        memcpy(vertex + sizeof(position), joints, sizeof(joints));
+        memcpy(vertex + sizeof(position) + sizeof(joints), weights, sizeof(weights));
+    }
+
+    Mesh::IVertexBundle vertexBundle;
+    vertexBundle.view = {0, vertexCount * stride, vertexCount, stride};
+    vertexBundle.attributes = {
+        {gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F},
+        {gfx::ATTR_NAME_JOINTS, gfx::Format::RGBA16UI},
+        {gfx::ATTR_NAME_WEIGHTS, gfx::Format::RGBA32F},
+    };
+    Mesh::ISubMesh primitive;
+    primitive.vertexBundelIndices = {0};
+    primitive.primitiveMode = gfx::PrimitiveMode::TRIANGLE_LIST;
+
+    Mesh::IStruct meshStruct;
+    meshStruct.vertexBundles = {vertexBundle};
+    meshStruct.primitives = {primitive};
+    meshStruct.minPosition = Vec3{-0.05F, -0.05F, -0.05F};
+    meshStruct.maxPosition = Vec3{0.05F, BONE_LENGTH * static_cast<float>(JOINT_COUNT - 1) + 0.05F, 0.05F};
+
+    IntrusivePtr<Mesh> mesh = ccnew Mesh();
+    mesh->setStruct(meshStruct);
+    mesh->setData(data);
+    return mesh;
+}
+
+struct Character {
+    IntrusivePtr<Node> root;
+    ccstd::vector<Node *> joints;
+    IntrusivePtr<SkinningModel> model;
+};
+
+struct SkinningResult {
+    double ms{0.0};
+    ccstd::vector<geometry::AABB> worldBounds;
+};
+
+// every joint of every character is animated each frame, only RenderScene::update is timed
+SkinningResult benchmarkSkinningUpdate(uint32_t characterCount, bool parallel, Skeleton *skeleton, Mesh *mesh) {
+    IntrusivePtr<scene::RenderScene> renderScene = ccnew scene::RenderScene();
+    renderScene->initialize({"benchmark"});
+    renderScene->setParallelUpdateEnabled(parallel);
+
+    IntrusivePtr<Node> sceneRoot = ccnew Node("root");
+    renderScene->setRootNode(sceneRoot);
+    ccstd::vector<Character> characters(characterCount);
+    for (uint32_t i = 0; i < characterCount; ++i) {
+        auto &character = characters[i];
+        character.root = ccnew Node("character");
+        character.root->setParent(sceneRoot);
+        character.root->setPosition(static_cast<float>(i % 32), 0.F, static_cast<float>(i / 32));
+        Node *parent = character.root;
+        for (uint32_t j = 0; j < JOINT_COUNT; ++j) {
+            auto *joint = ccnew Node("joint" + std::to_string(j));
+            joint->setParent(parent);
+            joint->setPosition(0.F, j ? BONE_LENGTH : 0.F, 0.F);
+            character.joints.emplace_back(joint);
+            parent = joint;
+        }
+
+        character.model = ccnew SkinningModel();
+        character.model->initialize();
+        character.model->setNode(character.root);
+        character.model->bindSkeleton(skeleton, character.root, mesh);
+        character.model->createBoundingShape(*mesh->getMinPosition(), *mesh->getMaxPosition());
+        renderScene->addModel(character.model);
+    }
+
+    std::chrono::steady_clock::duration elapsed{};
+    for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (uint32_t i = 0; i < characterCount; ++i) {
+            for (uint32_t j = 0; j < JOINT_COUNT; ++j) {
+                Quaternion rotation;
+                Quaternion::fromEuler(0.F, 0.F, 10.F * std::sin(static_cast<float>(frame + i + j) * 0.1F), &rotation);
+                characters[i].joints[j]->setRotation(rotation);
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        renderScene->update(frame);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    SkinningResult result;
+    result.ms = std::chrono::duration<double, std::milli>(elapsed).count() / FRAME_COUNT;
+    for (const auto &character : characters) {
+        result.worldBounds.emplace_back(*character.model->getWorldBounds());
+    }
+
+    renderScene->destroy();
+    return result;
+}
+
+} // namespace
+
+TEST(skinningUpdateScalingBenchmark, renderSceneUpdate) {
+    ASSERT_TRUE(ensurePipeline());
+    IntrusivePtr<Skeleton> skeleton = createSkeleton();
+    IntrusivePtr<Mesh> mesh = createMesh();
+
+    for (uint32_t characterCount : {50U, 150U, 300U}) {
+        // the serial run updates every model in updateModels, the parallel run goes through the skinning phase
+        const SkinningResult serial = benchmarkSkinningUpdate(characterCount, false, skeleton, mesh);
+        const SkinningResult parallel = benchmarkSkinningUpdate(characterCount, true, skeleton, mesh);
+        CC_LOG_INFO("RenderScene::update %u skinning models x %u joints, %u workers: serial %.3f ms, parallel %.3f ms, speedup %.2fx",
+                    characterCount, JOINT_COUNT, JobSystem::getInstance()->threadCount(), serial.ms, parallel.ms, serial.ms / parallel.ms);
+        EXPECT_GT(serial.ms, 0.0);
+        EXPECT_GT(parallel.ms, 0.0);
+
+        ASSERT_EQ(serial.worldBounds.size(), parallel.worldBounds.size());
+        for (uint32_t i = 0; i < characterCount; ++i) {
+            const auto &expected = serial.worldBounds[i];
+            const auto &actual = parallel.worldBounds[i];
+            // the joint bounds reach past the bind pose of the mesh once the chain bends
+            EXPECT_GT(expected.halfExtents.x, 0.05F);
+            EXPECT_FLOAT_EQ(actual.center.x, expected.center.x);
+            EXPECT_FLOAT_EQ(actual.center.y, expected.center.y);
+            EXPECT_FLOAT_EQ(actual.center.z, expected.center.z);
+            EXPECT_FLOAT_EQ(actual.halfExtents.x, expected.halfExtents.x);
+            EXPECT_FLOAT_EQ(actual.halfExtents.y, expected.halfExtents.y);
+            EXPECT_FLOAT_EQ(actual.halfExtents.z, expected.halfExtents.z);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <random>
+#include "cocos/3d/assets/SparseMorph.h"
+#include "cocos/base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr uint32_t VERTEX_COUNT = 5000;
+constexpr uint32_t TARGET_COUNT = 52;
+
+// a facial rig like target, only a small region of the mesh is displaced
+ccstd::vector<float> createDisplacements(std::mt19937 &rng) {
+    std::uniform_real_distribution<float> value(-1.F, 1.F);
+    std::uniform_int_distribution<uint32_t> region(0, VERTEX_COUNT - VERTEX_COUNT / 10);
+    ccstd::vector<float> displacements(3 * VERTEX_COUNT, 0.F);
+    const uint32_t begin = region(rng);
+    for (uint32_t i = begin; i < begin + VERTEX_COUNT / 10; ++i) {
+        displacements[3 * i + 0] = value(rng);
+        displacements[3 * i + 1] = value(rng);
+        displacements[3 * i + 2] = i % 3 ? value(rng) : 0.F;
+    }
+    return displacements;
+}
+
+} // namespace
+
+TEST(sparseMorphTest, build) {
+    const float displacements[] = {
+        0.F, 0.F, 0.F,
+        1.F, 0.F, 0.F,
+        0.F, 0.F, 0.F,
+        0.F, 0.F, -2.F};
+    cc::SparseMorphTarget target;
+    target.build(displacements, 4);
+    ASSERT_EQ(target.size(), 2);
+    EXPECT_EQ(target.indices[0], 1);
+    EXPECT_EQ(target.indices[1], 3);
+    const ccstd::vector<float> deltas{1.F, 0.F, 0.F, 0.F, 0.F, 0.F, -2.F, 0.F};
+    EXPECT_EQ(target.deltas, deltas);
+}
+
+TEST(sparseMorphTest, accumulateMatchesDense) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> weight(0.F, 1.F);
+    ccstd::vector<ccstd::vector<float>> dense;
+    ccstd::vector<cc::SparseMorphTarget> sparse(TARGET_COUNT);
+    for (uint32_t t = 0; t < TARGET_COUNT; ++t) {
+        dense.emplace_back(createDisplacements(rng));
+        sparse[t].build(dense[t].data(), VERTEX_COUNT);
+        EXPECT_LE(sparse[t].size(), VERTEX_COUNT / 10);
+    }
+
+    ccstd::vector<float> expected(4 * VERTEX_COUNT, 0.F);
+    ccstd::vector<float> values(4 * VERTEX_COUNT, 0.F);
+    for (uint32_t t = 0; t < TARGET_COUNT; ++t) {
+        const float w = weight(rng);
+        for (uint32_t i = 0; i < VERTEX_COUNT; ++i) {
+            expected[4 * i + 0] += dense[t][3 * i + 0] * w;
+            expected[4 * i + 1] += dense[t][3 * i + 1] * w;
+            expected[4 * i + 2] += dense[t][3 * i + 2] * w;
+        }
+        cc::accumulateSparseMorph(sparse[t], w, values.data());
+    }
+    for (uint32_t i = 0; i < 4 * VERTEX_COUNT; ++i) {
+        EXPECT_NEAR(values[i], expected[i], 1e-4F);
+    }
+}
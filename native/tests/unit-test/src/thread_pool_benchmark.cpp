@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+#include <vector>
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include "cocos/base/Log.h"
+#include "cocos/base/ThreadPool.h"
+#include "cocos/base/std/container/vector.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+constexpr int WORKER_COUNT = 4;
+constexpr int TASKS_PER_PRODUCER = 20000;
+
+// Pushes tiny tasks of every type from several producers at once, returns the milliseconds until all of them have run.
+double runContention(cc::LegacyThreadPool *pool, int producerCount) {
+    using TaskType = cc::LegacyThreadPool::TaskType;
+    static constexpr TaskType TASK_TYPES[] = {TaskType::DEFAULT, TaskType::NETWORK, TaskType::IO, TaskType::AUDIO};
+
+    std::atomic<int> finished{0};
+    const int taskCount = producerCount * TASKS_PER_PRODUCER;
+    const auto start = std::chrono::steady_clock::now();
+
+    ccstd::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([pool, &finished]() {
+            auto task = [&finished](int /*threadId*/) { ++finished; };
+            for (int i = 0; i < TASKS_PER_PRODUCER; ++i) {
+                pool->pushTask(task, TASK_TYPES[i % 4]);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    const auto deadline = start + std::chrono::seconds(30);
+    while (finished < taskCount && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(finished, taskCount);
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+TEST(threadPoolBenchmark, contention) {
+    auto *pool = cc::LegacyThreadPool::newFixedThreadPool(WORKER_COUNT);
+    for (int producerCount : {1, 2, 4, 8}) {
+        const double ms = runContention(pool, producerCount);
+        CC_LOG_INFO("%d producers, %d tasks: %.3f ms", producerCount, producerCount * TASKS_PER_PRODUCER, ms);
+    }
+    CC_LOG_INFO("stolen tasks: %llu", static_cast<unsigned long long>(pool->getStolenTaskNum()));
+    EXPECT_EQ(pool->getTaskNum(), 0);
+    delete pool;
+}
+
+TEST(threadPoolBenchmark, taskTypeAffinity) {
+    auto *pool = cc::LegacyThreadPool::newFixedThreadPool(WORKER_COUNT);
+    pool->setTaskTypeAffinity(cc::LegacyThreadPool::TaskType::AUDIO, 1);
+
+    std::atomic<int> finished{0};
+    auto task = [&finished](int threadId) {
+        EXPECT_GE(threadId, 0);
+        EXPECT_LT(threadId, WORKER_COUNT);
+        ++finished;
+    };
+    for (int i = 0; i < 100; ++i) {
+        pool->pushTask(task, cc::LegacyThreadPool::TaskType::AUDIO);
+    }
+    // the destructor waits for all the pushed tasks
+    delete pool;
+    EXPECT_EQ(finished, 100);
+}
+
+TEST(threadPoolBenchmark, shrinkingPoolKeepsTasks) {
+    // threads beyond the minimum retire as soon as they are idle, racing with the producers
+    auto *pool = cc::LegacyThreadPool::newCachedThreadPool(1, WORKER_COUNT, 0, WORKER_COUNT, WORKER_COUNT);
+    for (int round = 0; round < 20; ++round) {
+        runContention(pool, 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(pool->getTaskNum(), 0);
+    delete pool;
+}
+
+TEST(threadPoolBenchmark, idleThreadsSleep) {
+    auto *pool = cc::LegacyThreadPool::newFixedThreadPool(WORKER_COUNT);
+    runContention(pool, 1);
+
+    // one long task keeps a thread busy, the others have nothing to steal and must not spin
+    std::atomic<bool> released{false};
+    pool->pushTask([&released](int /*threadId*/) {
+        while (!released) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    const std::clock_t cpuStart = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    released = true;
+    CC_LOG_INFO("cpu time of an idle pool over 200 ms: %.3f ms", cpuMs);
+    EXPECT_LT(cpuMs, 100.0);
+    delete pool;
+}
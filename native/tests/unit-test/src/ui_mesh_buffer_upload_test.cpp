@@ -0,0 +1,92 @@
+/****************************************************************************
+ Copyright (c) 2024 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+****************************************************************************/
+
+#include "cocos/2d/renderer/UIMeshBuffer.h"
+#include "cocos/base/std/container/vector.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+constexpr uint32_t FLOATS_PER_VERTEX = 9;
+constexpr uint32_t VERTEX_BYTES = FLOATS_PER_VERTEX * sizeof(float);
+constexpr uint32_t VERTEX_COUNT = 64;
+constexpr uint32_t INDEX_COUNT = 96;
+
+ccstd::vector<gfx::Attribute> createAttributes() {
+    return {
+        {"a_position", gfx::Format::RGB32F},
+        {"a_texCoord", gfx::Format::RG32F},
+        {"a_color", gfx::Format::RGBA32F},
+    };
+}
+
+} // namespace
+
+TEST(uiMeshBufferUploadTest, uploadDirtyRanges) {
+    gfx::Device *device = gfx::DeviceManager::createEmpty();
+    ASSERT_NE(device, nullptr);
+
+    ccstd::vector<float> vData(VERTEX_COUNT * FLOATS_PER_VERTEX, 0.F);
+    ccstd::vector<uint16_t> iData(INDEX_COUNT, 0);
+
+    UIMeshBuffer meshBuffer;
+    meshBuffer.initialize(createAttributes(), true);
+    meshBuffer.setVData(vData.data());
+    meshBuffer.setIData(iData.data());
+    ASSERT_NE(meshBuffer.requireFreeIA(device), nullptr);
+
+    meshBuffer.setByteOffset(VERTEX_COUNT * VERTEX_BYTES);
+    meshBuffer.setIndexOffset(INDEX_COUNT);
+
+    // nothing written yet
+    EXPECT_EQ(meshBuffer.uploadBuffers(), 0);
+
+    // the first upload grows the gpu buffers, which needs all the data in use
+    meshBuffer.markVertexRange(0, VERTEX_BYTES);
+    EXPECT_EQ(meshBuffer.uploadBuffers(), VERTEX_COUNT * VERTEX_BYTES + INDEX_COUNT * sizeof(uint16_t));
+
+    // native writes only upload the merged ranges
+    meshBuffer.markVertexRange(4 * VERTEX_BYTES, 8 * VERTEX_BYTES);
+    meshBuffer.markVertexRange(12 * VERTEX_BYTES, 16 * VERTEX_BYTES);
+    meshBuffer.markIndexRange(6, 12);
+    EXPECT_EQ(meshBuffer.uploadBuffers(), 12 * VERTEX_BYTES + 6 * sizeof(uint16_t));
+
+    // ranges are consumed by the upload
+    EXPECT_EQ(meshBuffer.uploadBuffers(), 0);
+
+    // ranges past the data in use are clamped
+    meshBuffer.setIndexOffset(12);
+    meshBuffer.markIndexRange(6, INDEX_COUNT);
+    EXPECT_EQ(meshBuffer.uploadBuffers(), 6 * sizeof(uint16_t));
+
+    // the dirty mark set by the script side uploads all the data in use
+    meshBuffer.setDirty(true);
+    EXPECT_EQ(meshBuffer.uploadBuffers(), VERTEX_COUNT * VERTEX_BYTES + 12 * sizeof(uint16_t));
+    EXPECT_FALSE(meshBuffer.getDirty());
+
+    meshBuffer.destroy();
+}